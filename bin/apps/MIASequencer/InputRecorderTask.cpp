@@ -0,0 +1,165 @@
+/**
+ * @file InputRecorderTask.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implementation of the InputRecorderTask class.
+ */
+
+// The associated header file.
+#include "InputRecorderTask.hpp"
+// Used for error handling.
+#include "MIAException.hpp"
+
+#if defined(__linux__)
+    #include <X11/XKBlib.h>
+    #include <X11/Xproto.h>
+    #include <X11/keysym.h>
+#endif
+
+using virtual_keys::InputEvent;
+
+
+InputRecorderTask::~InputRecorderTask()
+{
+    // Stop before the displays are closed since the recorder thread uses them.
+    stop();
+#if defined(__linux__)
+    if (control && context)
+        XRecordFreeContext(control, context);
+    if (recording)
+        XCloseDisplay(recording);
+    if (control)
+        XCloseDisplay(control);
+#endif
+}
+
+
+void InputRecorderTask::initialize()
+{
+#if defined(__linux__)
+    // The Record extension requires one connection to control the context and another on
+    // which the intercepted data is delivered.
+    control = XOpenDisplay(nullptr);
+    recording = XOpenDisplay(nullptr);
+    int major = 0, minor = 0;
+    if (!control || !recording || !XRecordQueryVersion(control, &major, &minor))
+        throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable,
+                                  "record: no X display with the Record extension");
+
+    // Resolve every key code once, so the recorder thread does not need the control connection.
+    int maxKeyCode = 0;
+    XDisplayKeycodes(control, &minKeyCode, &maxKeyCode);
+    keyCodes.assign(static_cast<std::size_t>(maxKeyCode - minKeyCode + 1), 0);
+    for (int keyCode = minKeyCode; keyCode <= maxKeyCode; ++keyCode)
+    {
+        KeySym keySym = XkbKeycodeToKeysym(control, static_cast<KeyCode>(keyCode), 0, 0);
+        std::uint32_t code = 0;
+        if (keySym >= 0x20 && keySym <= 0x7e)
+            code = static_cast<std::uint32_t>(keySym);
+        else if (keySym == XK_Return || keySym == XK_Tab || keySym == XK_Num_Lock)
+            code = static_cast<std::uint32_t>(keySym);
+        else if (keySym == XK_Shift_L || keySym == XK_Shift_R)
+            code = virtual_keys::keysym::SHIFT_L;
+        keyCodes[static_cast<std::size_t>(keyCode - minKeyCode)] = code;
+    }
+
+    XRecordRange* range = XRecordAllocRange();
+    if (!range)
+        throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable, "record: unable to allocate a range");
+    range->device_events.first = KeyPress;
+    range->device_events.last = ButtonRelease;
+    XRecordClientSpec clients = XRecordAllClients;
+    context = XRecordCreateContext(control, 0, &clients, 1, &range, 1);
+    XFree(range);
+    if (!context)
+        throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable, "record: unable to create a context");
+
+    // The context must exist on the server before the recording connection enables it.
+    XSync(control, False);
+    if (!XRecordEnableContextAsync(recording, context, &InputRecorderTask::intercept, reinterpret_cast<XPointer>(this)))
+        throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable, "record: unable to enable the context");
+    enabled = true;
+
+    addWatchedFd(ConnectionNumber(recording));
+#else
+    throw error::MIAException(error::ErrorCode::Linux_Only_Feature, "Recording input");
+#endif
+}
+
+
+void InputRecorderTask::stop()
+{
+#if defined(__linux__)
+    if (enabled)
+    {
+        XRecordDisableContext(control, context);
+        XFlush(control);
+        enabled = false;
+    }
+#endif
+    threading::BackgroundTask::stop();
+}
+
+
+std::vector<sequencer::RecordedEvent> InputRecorderTask::takeEvents()
+{
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    std::vector<sequencer::RecordedEvent> taken;
+    taken.swap(events);
+    return taken;
+}
+
+
+void InputRecorderTask::run()
+{
+#if defined(__linux__)
+    XRecordProcessReplies(recording);
+#endif
+}
+
+
+#if defined(__linux__)
+void InputRecorderTask::intercept(XPointer closure, XRecordInterceptData* data)
+{
+    auto* task = reinterpret_cast<InputRecorderTask*>(closure);
+    if (data->category == XRecordFromServer && data->data != nullptr)
+    {
+        const xEvent* event = reinterpret_cast<const xEvent*>(data->data);
+        int type = event->u.u.type & 0x7f;
+        std::chrono::nanoseconds time = std::chrono::milliseconds(data->server_time);
+
+        sequencer::RecordedEvent recorded;
+        recorded.time = time;
+        recorded.event.pressed = type == KeyPress || type == ButtonPress;
+
+        std::lock_guard<std::mutex> lock(task->eventsMutex);
+        if (type == KeyPress || type == KeyRelease)
+        {
+            int index = event->u.u.detail - task->minKeyCode;
+            if (index >= 0 && static_cast<std::size_t>(index) < task->keyCodes.size() && task->keyCodes[index] != 0)
+            {
+                recorded.event.type = InputEvent::Type::KEY;
+                recorded.event.code = task->keyCodes[index];
+                task->events.push_back(recorded);
+            }
+        }
+        else if (type == ButtonPress || type == ButtonRelease)
+        {
+            // Record where the button was pressed before the press itself.
+            if (type == ButtonPress)
+            {
+                sequencer::RecordedEvent move;
+                move.time = time;
+                move.event.type = InputEvent::Type::MOVE_TO;
+                move.event.x = event->u.keyButtonPointer.rootX;
+                move.event.y = event->u.keyButtonPointer.rootY;
+                task->events.push_back(move);
+            }
+            recorded.event.type = InputEvent::Type::BUTTON;
+            recorded.event.code = event->u.u.detail;
+            task->events.push_back(recorded);
+        }
+    }
+    XRecordFreeData(data);
+}
+#endif
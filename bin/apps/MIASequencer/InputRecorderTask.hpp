@@ -0,0 +1,109 @@
+/**
+ * @file InputRecorderTask.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Defines the InputRecorderTask class, a background task which captures global keyboard
+ *     and mouse events for the MacroRecorder. On Linux, the events are intercepted with the
+ *     X Record extension and the task blocks on the recording connection with epoll, so it
+ *     uses no CPU between events.
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "BackgroundTask.hpp"
+// Used for the recorded event type.
+#include "MacroRecorder.hpp"
+
+/// Used for preprocessor definitions.
+#include "Constants.hpp"
+
+#if defined(__linux__)
+    #include <X11/Xlib.h>
+    #include <X11/extensions/record.h>
+#endif
+
+/**
+ * This class provides a threaded task which records every key press, key release and mouse
+ * button event on the display (whichever window has focus), along with the pointer position
+ * of each button event. Events are timestamped with the X server event time (ms), so the
+ * timing is unaffected by how the task batches its reads. Keys are recorded with the key
+ * identifiers used by InputEvent; keys which have none (e.g., control) are not recorded.
+ */
+class InputRecorderTask : public threading::BackgroundTask
+{
+public:
+
+    /**
+     * @brief Constructs an idle recorder.
+     */
+    InputRecorderTask() = default;
+
+    /**
+     * @brief Stops recording and closes the X connections.
+     */
+    ~InputRecorderTask();
+
+    /**
+     * @brief Connects to the display and starts intercepting events. Must be called before start().
+     * @throws MIAException(Input_Backend_Unavailable) - If there is no display or no Record extension.
+     * @throws MIAException(Linux_Only_Feature) - On platforms other than Linux.
+     */
+    void initialize();
+
+    /**
+     * @brief Stops intercepting events and stops the task.
+     */
+    void stop() override;
+
+    /**
+     * @brief Removes and returns the events recorded so far. Safe to call while recording.
+     * @return [std::vector<sequencer::RecordedEvent>] - The events in order.
+     */
+    std::vector<sequencer::RecordedEvent> takeEvents();
+
+protected:
+
+    /**
+     * @brief Processes the intercepted events which are ready on the recording connection.
+     */
+    void run() override;
+
+private:
+
+    /// Guards events, which are written by the recorder thread.
+    std::mutex eventsMutex;
+
+    /// The events recorded so far.
+    std::vector<sequencer::RecordedEvent> events;
+
+#if defined(__linux__)
+
+    /**
+     * @brief Receives the intercepted data from the X server (called by XRecordProcessReplies).
+     * @param closure[XPointer] - The InputRecorderTask.
+     * @param data[XRecordInterceptData*] - The intercepted data, which is freed here.
+     */
+    static void intercept(XPointer closure, XRecordInterceptData* data);
+
+    /// The connection used to create and disable the record context.
+    Display* control{nullptr};
+
+    /// The connection the intercepted events are delivered on (watched by the task).
+    Display* recording{nullptr};
+
+    /// The record context, or 0 if none was created.
+    XRecordContext context{0};
+
+    /// True while the context is enabled.
+    bool enabled{false};
+
+    /// The key identifier (see InputEvent) for each X key code, or 0 for keys not recorded.
+    std::vector<std::uint32_t> keyCodes;
+
+    /// The smallest X key code.
+    int minKeyCode{0};
+#endif
+}; // class InputRecorderTask
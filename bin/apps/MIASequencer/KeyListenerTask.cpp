@@ -3,19 +3,61 @@
  * @author Antonius Torode
  * @date 06/25/2025
  * Description:
- *     TODO
+ *     Implements the KeyListenerTask global hotkey listener.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <iostream>
 #include "KeyListenerTask.hpp"
-#include "Timing.hpp"
 
 #if defined(IS_WINDOWS)
     #include <windows.h>
 #elif defined(__linux__)
     #include <X11/keysym.h>
+    #include <X11/XKBlib.h>
 #endif
 
+namespace
+{
+#if defined(IS_WINDOWS)
+    /// The rate at which keys are sampled on Windows, which has no readiness notification.
+    constexpr std::chrono::milliseconds POLL_INTERVAL{5};
+#elif defined(__linux__)
+    /// X event timestamps older than this are assumed to come from an unrelated clock.
+    constexpr std::chrono::milliseconds MAX_EVENT_AGE{60000};
+
+    /**
+     * @brief Converts the X server timestamp of an event to a KeyListenerTask::Clock time.
+     *
+     * A local X server stamps events with its monotonic clock in milliseconds, truncated to
+     * 32 bits, which is the clock behind std::chrono::steady_clock. The age of the event is
+     * taken in 32-bit arithmetic so wrap-around is handled. If the age is implausible (e.g. a
+     * remote server with its own clock), the time the events were read is used instead.
+     * @param serverTime[Time] - The event timestamp.
+     * @param woken[KeyListenerTask::Clock::time_point] - When the listener woke to read events.
+     * @return [KeyListenerTask::Clock::time_point] - The time of the event, at or before woken.
+     */
+    KeyListenerTask::Clock::time_point fromServerTime(Time serverTime, KeyListenerTask::Clock::time_point woken)
+    {
+        using std::chrono::milliseconds;
+        const auto wokenMs = std::chrono::duration_cast<milliseconds>(woken.time_since_epoch()).count();
+        const std::uint32_t age = static_cast<std::uint32_t>(wokenMs) - static_cast<std::uint32_t>(serverTime);
+        if (age > static_cast<std::uint32_t>(MAX_EVENT_AGE.count()))
+            return woken;
+        return KeyListenerTask::Clock::time_point(milliseconds(wokenMs - static_cast<std::int64_t>(age)));
+    }
+#endif
+
+    /**
+     * @brief Converts a duration to fractional microseconds for output.
+     * @param duration[std::chrono::nanoseconds] - The duration.
+     * @return [double] - The duration in microseconds.
+     */
+    double toMicroseconds(std::chrono::nanoseconds duration)
+    { return static_cast<double>(duration.count()) / 1000.0; }
+} // anonymous namespace
+
 
 KeyListenerTask::KeyListenerTask()
 #if defined(__linux__)
@@ -37,16 +79,37 @@ KeyListenerTask::KeyListenerTask(char keyCode) : keyCode(keyCode)
 
 KeyListenerTask::~KeyListenerTask()
 {
+    // Stop before the display is closed since the listener thread uses it.
+    stop();
 #if defined(__linux__)
-    if (grabbed) 
-        XUngrabKey(display, linuxKeyCode, modifiers, root);
-        
-    if (display) 
+    if (display)
+    {
+        for (const Hotkey& hotkey : hotkeys)
+            if (hotkey.grabbed)
+                setGrab(hotkey, false);
         XCloseDisplay(display);
+    }
 #endif
 }
 
 
+void KeyListenerTask::addHotkey(char key, unsigned int modifiers, std::function<void()> callback)
+{
+    Hotkey hotkey;
+    hotkey.key = key;
+    hotkey.modifiers = modifiers;
+    hotkey.callback = std::move(callback);
+    hotkeys.push_back(std::move(hotkey));
+}
+
+
+KeyListenerTask::LatencyStats KeyListenerTask::getLatencyStats() const
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return latencyStats;
+}
+
+
 void KeyListenerTask::initialize()
 {
 if (!isActive())
@@ -55,32 +118,179 @@ if (!isActive())
     return;
 }
 
-#if defined(__linux__)
-    if (display && root) 
+    if (keyCode != '\0' && !toggleRegistered)
     {
-        linuxKeyCode = charToKeyCode(keyCode); // Set the linux key code value.
-        XGrabKey(display, linuxKeyCode, modifiers, root, True, GrabModeAsync, GrabModeAsync);
+        addHotkey(keyCode, ANY, [this] { toggleCondition(); });
+        toggleRegistered = true;
+    }
+
+#if defined(IS_WINDOWS)
+    for (Hotkey& hotkey : hotkeys)
+    {
+        hotkey.platformCode = static_cast<unsigned int>(VkKeyScanA(hotkey.key) & 0xFF);
+        hotkey.grabbed = true;
+    }
+    if (getMode() == threading::TaskMode::CONTINUOUS)
+        setPeriodic(POLL_INTERVAL);
+
+#elif defined(__linux__)
+    if (display && root)
+    {
+        for (Hotkey& hotkey : hotkeys)
+        {
+            if (hotkey.grabbed)
+                continue;
+            hotkey.platformCode = charToKeyCode(hotkey.key);
+            if (hotkey.platformCode == 0)
+                continue;
+            setGrab(hotkey, true);
+            hotkey.grabbed = true;
+        }
+
+        // Report held keys as a single press rather than a stream of repeated presses.
+        XkbSetDetectableAutoRepeat(display, True, nullptr);
+        XSelectInput(display, root, KeyPressMask | KeyReleaseMask);
         XFlush(display);
-        XSelectInput(display, root, KeyPressMask);
-        grabbed = true;
+
+        if (!watching)
+        {
+            addWatchedFd(ConnectionNumber(display));
+            watching = true;
+        }
+
+        // Xlib may already have queued events while setting up, which would not make the
+        // connection readable, so drain the queue once after starting.
+        notify();
+    }
+    else if (getMode() == threading::TaskMode::CONTINUOUS)
+    {
+        // Nothing can be listened to, so idle until stopped.
+        setEventDriven();
     }
 #endif
 }
 
 
-#if defined(__linux__)
-unsigned int KeyListenerTask::charToKeyCode(char c) 
+bool KeyListenerTask::onKeyEdge(std::size_t index, bool pressed, Clock::time_point detected)
+{
+    Hotkey& hotkey = hotkeys[index];
+    if (!pressed)
+    {
+        hotkey.down = false;
+        return false;
+    }
+    if (hotkey.down)
+        return false;
+    hotkey.down = true;
+
+    if (hotkey.lastAccepted != Clock::time_point{} && detected - hotkey.lastAccepted < debounce)
+        return false;
+    hotkey.lastAccepted = detected;
+
+    // Clamped so a detection time slightly ahead of this thread's clock can't skew the stats.
+    std::chrono::nanoseconds latency = std::max(std::chrono::nanoseconds(0),
+                                                std::chrono::nanoseconds(Clock::now() - detected));
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (latencyStats.count == 0 || latency < latencyStats.min)
+            latencyStats.min = latency;
+        if (latency > latencyStats.max)
+            latencyStats.max = latency;
+        latencyStats.total += latency;
+        ++latencyStats.count;
+    }
+
+    if (context != nullptr && context->verboseMode)
+        std::cout << "Hotkey '" << hotkey.key << "' pressed (latency: "
+                  << toMicroseconds(latency) << " us)" << std::endl;
+
+    if (hotkey.callback)
+        hotkey.callback();
+    return true;
+}
+
+
+void KeyListenerTask::doWhenStopped()
+{
+    LatencyStats stats = getLatencyStats();
+    if (context != nullptr && context->verboseMode && stats.count > 0)
+        std::cout << "Hotkey latency over " << stats.count << " presses: min "
+                  << toMicroseconds(stats.min) << " us, mean "
+                  << toMicroseconds(stats.mean()) << " us, max "
+                  << toMicroseconds(stats.max) << " us" << std::endl;
+}
+
+
+#if defined(IS_WINDOWS)
+unsigned int KeyListenerTask::heldModifiers() const
+{
+    auto isDown = [](int key) { return (GetAsyncKeyState(key) & 0x8000) != 0; };
+    unsigned int held = NONE;
+    if (isDown(VK_SHIFT))
+        held |= SHIFT;
+    if (isDown(VK_CONTROL))
+        held |= CONTROL;
+    if (isDown(VK_MENU))
+        held |= ALT;
+    if (isDown(VK_LWIN) || isDown(VK_RWIN))
+        held |= SUPER;
+    return held;
+}
+
+#elif defined(__linux__)
+unsigned int KeyListenerTask::charToKeyCode(char c)
 {
     char str[2] = {c, '\0'};
     KeySym keysym = XStringToKeysym(str);
-    
-    if (keysym == NoSymbol) 
+
+    if (keysym == NoSymbol)
         return 0;
-        
+
     return XKeysymToKeycode(display, keysym);
 }
+
+
+unsigned int KeyListenerTask::toX11Mask(unsigned int flags)
+{
+    unsigned int mask = 0;
+    if (flags & SHIFT)
+        mask |= ShiftMask;
+    if (flags & CONTROL)
+        mask |= ControlMask;
+    if (flags & ALT)
+        mask |= Mod1Mask;
+    if (flags & SUPER)
+        mask |= Mod4Mask;
+    return mask;
+}
+
+
+void KeyListenerTask::setGrab(const Hotkey& hotkey, bool grab)
+{
+    if (hotkey.modifiers & ANY)
+    {
+        if (grab)
+            XGrabKey(display, hotkey.platformCode, AnyModifier, root, True, GrabModeAsync, GrabModeAsync);
+        else
+            XUngrabKey(display, hotkey.platformCode, AnyModifier, root);
+        return;
+    }
+
+    // Caps Lock (LockMask) and Num Lock (usually Mod2Mask) are part of the grab match, so
+    // grab every combination of them to match the hotkey regardless of the lock states.
+    const unsigned int mask = toX11Mask(hotkey.modifiers);
+    for (unsigned int locks : {0u, static_cast<unsigned int>(LockMask), static_cast<unsigned int>(Mod2Mask),
+                               static_cast<unsigned int>(LockMask | Mod2Mask)})
+    {
+        if (grab)
+            XGrabKey(display, hotkey.platformCode, mask | locks, root, True, GrabModeAsync, GrabModeAsync);
+        else
+            XUngrabKey(display, hotkey.platformCode, mask | locks, root);
+    }
+}
 #endif
 
+
 void KeyListenerTask::run()
 {
     if (!isActive())
@@ -89,50 +299,59 @@ void KeyListenerTask::run()
         return;
     }
 
+    const Clock::time_point woken = Clock::now();
+
 #if defined(IS_WINDOWS)
-    SHORT keyState = GetAsyncKeyState(static_cast<unsigned int>(keyCode));
-    
-    // GetAsyncKeyState() returns a SHORT (16-bit int) with two relevant bits:
-    // Bit 15 (0x8000) — high-order bit — is 1 if the key is currently down.
-    // Bit 0 (0x0001) — low-order bit — is 1 if the key was pressed since the last call.
-    bool pressed = (keyState & 0x8000) != 0;
-
-    // Detect rising edge: key pressed now, was not pressed previously
-    if (pressed && !lastPressed) 
+    const unsigned int held = heldModifiers();
+    for (std::size_t i = 0; i < hotkeys.size(); ++i)
     {
-        toggleCondition();
-        //std::cout << "Key toggled state: " << isConditionMet() << std::endl;
+        const Hotkey& hotkey = hotkeys[i];
+
+        // GetAsyncKeyState() returns a SHORT (16-bit int) with two relevant bits:
+        // Bit 15 (0x8000) — high-order bit — is 1 if the key is currently down.
+        // Bit 0 (0x0001) — low-order bit — is 1 if the key was pressed since the last call.
+        bool pressed = (GetAsyncKeyState(static_cast<int>(hotkey.platformCode)) & 0x8000) != 0;
+        bool modifiersMatch = (hotkey.modifiers & ANY) || held == hotkey.modifiers;
+        if (pressed != hotkey.down && (!pressed || modifiersMatch))
+            onKeyEdge(i, pressed, woken);
     }
-    lastPressed = pressed;
-    
+
 #elif defined(__linux__)
     if (!display) return;
 
-    while (XPending(display)) 
+    const unsigned int relevantMask = ShiftMask | ControlMask | Mod1Mask | Mod4Mask;
+    while (XPending(display))
     {
         XEvent event;
         XNextEvent(display, &event);
-        if (event.type == KeyPress)
+        if (event.type != KeyPress && event.type != KeyRelease)
+            continue;
+
+        auto* keyEvent = reinterpret_cast<XKeyEvent*>(&event);
+        bool pressed = event.type == KeyPress;
+        const Clock::time_point detected = fromServerTime(keyEvent->time, woken);
+        if (pressed && context != nullptr && context->verboseMode)
         {
-            auto* keyEvent = reinterpret_cast<XKeyEvent*>(&event);
             KeySym sym = XLookupKeysym(keyEvent, 0);
-            char* keyString = XKeysymToString(sym);            
-
-            if (context->verboseMode)
-            {
-                std::cout << "Listening for keycode: " << linuxKeyCode << std::endl;
-
-                std::cout << "Detected key press: keycode=" << keyEvent->keycode
-                          << ", keysym=" << sym
-                          << ", string=" << (keyString ? keyString : "unknown")
-                          << std::endl;
-            }
-			
-            if (keyEvent->keycode == linuxKeyCode) 
-                toggleCondition();
+            char* keyString = XKeysymToString(sym);
+            std::cout << "Detected key press: keycode=" << keyEvent->keycode
+                      << ", keysym=" << sym
+                      << ", string=" << (keyString ? keyString : "unknown")
+                      << std::endl;
+        }
+
+        for (std::size_t i = 0; i < hotkeys.size(); ++i)
+        {
+            const Hotkey& hotkey = hotkeys[i];
+            if (hotkey.platformCode != keyEvent->keycode)
+                continue;
+
+            // A release always ends the press, even if the modifiers were released first.
+            bool modifiersMatch = (hotkey.modifiers & ANY) ||
+                                  (keyEvent->state & relevantMask) == toX11Mask(hotkey.modifiers);
+            if (!pressed || modifiersMatch)
+                onKeyEdge(i, pressed, detected);
         }
     }
-    timing::sleepMilliseconds(5);
 #endif
 }
-
@@ -3,10 +3,18 @@
  * @author Antonius Torode
  * @date 06/25/2025
  * Description:
- *     TODO
+ *     Defines the KeyListenerTask class, a background task which listens for global hotkeys
+ *     and dispatches a callback on the rising edge of each key press. On Linux, the task
+ *     blocks on the X connection with epoll so it uses no CPU while idle.
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include "BackgroundTask.hpp"
 
 /// Used for preprocessor definitions.
@@ -17,20 +25,63 @@
 #endif
 
 /**
- * This class provides a threaded task which will listen for a key-press in order
- * to monitor a conditional state, which is toggled by the key-press.
+ * This class provides a threaded task which listens for global hotkeys. Each hotkey is a key
+ * plus a set of modifiers mapped to a callback, which is invoked on the listener thread once
+ * per key press (held keys and auto-repeat do not retrigger it). Presses arriving within the
+ * debounce interval of the previous accepted press of the same hotkey are ignored.
+ *
+ * The single key set with setKeyCode() (or the constructor) is a hotkey which toggles the
+ * conditional state of the task (see BackgroundTask::toggleCondition()) regardless of modifiers.
  */
 class KeyListenerTask : public threading::BackgroundTask
 {
 public:
 
+    /**
+     * @brief Modifier flags which may be combined when registering a hotkey.
+     */
+    enum Modifier : unsigned int
+    {
+        NONE = 0,           ///< No modifiers may be held.
+        SHIFT = 1 << 0,     ///< Either shift key.
+        CONTROL = 1 << 1,   ///< Either control key.
+        ALT = 1 << 2,       ///< Either alt key.
+        SUPER = 1 << 3,     ///< The super (Windows) key.
+        ANY = 1 << 7        ///< Matches regardless of which modifiers are held.
+    };
+
+    /// The clock used for debounce and latency measurements.
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Summary of the time from a key press being detected to its callback being invoked.
+     *
+     * On Linux, a press is timed from the X server's timestamp of the key event (millisecond
+     * resolution), so the time taken to wake the listener is included. On Windows, it is
+     * detected by polling, so the (up to one poll interval) sampling delay is not included.
+     */
+    struct LatencyStats
+    {
+        std::uint64_t count{0};             ///< The number of measured presses.
+        std::chrono::nanoseconds min{0};    ///< The shortest latency.
+        std::chrono::nanoseconds max{0};    ///< The longest latency.
+        std::chrono::nanoseconds total{0};  ///< The sum of all latencies.
+
+        /**
+         * @brief Returns the mean latency.
+         * @return [std::chrono::nanoseconds] - The mean latency, or zero if nothing was measured.
+         */
+        std::chrono::nanoseconds mean() const
+        { return count == 0 ? std::chrono::nanoseconds(0) : total / static_cast<std::int64_t>(count); }
+    };
+
     /**
      * @brief Default constructor for KeyListenerTask.
      *
      * Constructs an inactive listener with no key bound. Useful when the object is
-     * conditionally configured later. The task will be inert unless a keyCode is set
-     * and initialize is completed. If this constructor is used, the user must call
-     * setKeyCode() then initialize().
+     * conditionally configured later. The task will be inert unless a keyCode or hotkey is
+     * set and initialize is completed. If this constructor is used, the user must call
+     * setKeyCode() or addHotkey() then initialize().
      */
     KeyListenerTask();
 
@@ -43,16 +94,16 @@ public:
      * @param keyCode[char] - The key code to listen for (platform-specific).
      */
     KeyListenerTask(char keyCode);
-    
+
     /**
      * @brief Destructor for KeyListenerTask.
      *
      * Cleans up any platform-specific resources used by the listener. On Linux,
-     * this includes ungrabbing the key from the X server (if previously grabbed)
+     * this includes ungrabbing the keys from the X server (if previously grabbed)
      * and closing the X display connection.
      */
     ~KeyListenerTask();
-    
+
     /**
      * @brief Sets the key code to be monitored by the key listener.
      *
@@ -64,72 +115,159 @@ public:
      */
     void setKeyCode(char code)
     { keyCode = code; }
-    
+
+    /**
+     * @brief Registers a hotkey. Must be called before start(), followed by initialize().
+     * @param key[char] - The key (a single printable ASCII character).
+     * @param modifiers[unsigned int] - A combination of Modifier flags which must be held.
+     * @param callback[std::function<void()>] - Invoked on the listener thread for each press.
+     */
+    void addHotkey(char key, unsigned int modifiers, std::function<void()> callback);
+
+    /**
+     * @brief Sets the minimum time between two accepted presses of the same hotkey.
+     * @param interval[std::chrono::milliseconds] - The debounce interval (zero disables it).
+     */
+    void setDebounce(std::chrono::milliseconds interval)
+    { debounce = interval; }
+
     /**
      * @brief Indicates whether the listener is active and bound to a valid key.
      *
-     * @return true if a valid keyCode has been set (non-default); otherwise false.
+     * @return true if a valid keyCode or a hotkey has been set; otherwise false.
      */
     bool isActive()
-    { return keyCode != '\0'; }
-    
+    { return keyCode != '\0' || !hotkeys.empty(); }
+
+    /**
+     * @brief Returns the press-to-callback latency measured so far.
+     * @return [LatencyStats] - A snapshot of the latency statistics.
+     */
+    LatencyStats getLatencyStats() const;
+
     /**
-     * @brief Initializes the key listener by registering the key grab with the system.
+     * @brief Initializes the key listener by registering the key grabs with the system.
+     *
+     * This method sets up platform-specific key listening behavior. On Linux, it grabs each
+     * hotkey globally using XGrabKey, selects for key events on the root window and makes
+     * the task wait on the X connection. On Windows, the task polls the keys at a fixed rate.
+     * If no display is available, the task idles until stopped. The method may be called
+     * again after adding hotkeys, but must be called before start().
      *
-     * This method sets up platform-specific key listening behavior. On Linux, it grabs the
-     * specified key globally using XGrabKey and selects for key press events on the root window.
-     * The method requires the listener to be in an active (constructed) state.
-     * 
      * @note If the listener is not active (i.e., no key has been set), the method exits early.
      *       Intended exception handling for this case is marked as a TODO.
      */
     void initialize();
-    
+
 protected:
     /**
-     * @brief Monitors the configured key for press events and toggles a condition when detected.
+     * @brief Processes pending key events and dispatches the matching hotkeys.
      *
-     * This method is repeatedly invoked by the BackgroundTask base class. It checks whether the 
-     * specified key has been pressed, and if so, toggles the internal condition flag. On Windows,
-     * it uses GetAsyncKeyState to detect key state changes with edge detection. On Linux, it processes
-     * X11 KeyPress events from the event queue if the key has been grabbed using XGrabKey.
+     * This method is invoked by the BackgroundTask base class whenever input may be
+     * available. On Windows, it samples each hotkey with GetAsyncKeyState. On Linux, it
+     * drains the X11 event queue of the KeyPress and KeyRelease events for the grabbed keys.
      *
      * If the listener is not active (i.e. keyCode not set), the method returns early.
      *
-     * @note This method assumes `initialize()` has been called on Linux to grab the key.
+     * @note This method assumes `initialize()` has been called to grab the keys.
      */
     void run() override;
-    
+
+    /**
+     * @brief Reports the latency summary when verbose output is enabled.
+     */
+    void doWhenStopped() override;
+
+    /**
+     * @brief Applies edge detection and debounce to a key state change of a hotkey.
+     *
+     * A press of a hotkey which is already down (e.g. auto-repeat) is ignored, as is a press
+     * within the debounce interval of the last accepted one. Accepted presses record their
+     * latency and invoke the hotkey callback.
+     *
+     * @param index[std::size_t] - The index of the hotkey in registration order.
+     * @param pressed[bool] - True for a key press; false for a release.
+     * @param detected[Clock::time_point] - When the state change happened (no later than now).
+     * @return [bool] - True if the callback was invoked.
+     */
+    bool onKeyEdge(std::size_t index, bool pressed, Clock::time_point detected);
+
 private:
 
+    /**
+     * @brief A registered hotkey and its edge detection state.
+     */
+    struct Hotkey
+    {
+        char key{'\0'};                     ///< The key character.
+        unsigned int modifiers{NONE};       ///< The Modifier flags which must be held.
+        std::function<void()> callback;     ///< Invoked for each accepted press.
+        unsigned int platformCode{0};       ///< The platform key code (0 if unmapped).
+        bool grabbed{false};                ///< True once registered with the system.
+        bool down{false};                   ///< True while the key is held.
+        Clock::time_point lastAccepted{};   ///< The time of the last accepted press.
+    };
+
     /// Storage for the key-code used by this listener.
     char keyCode{'\0'};
-    
+
+    /// True once the toggle hotkey for keyCode has been registered.
+    bool toggleRegistered{false};
+
+    /// The registered hotkeys.
+    std::vector<Hotkey> hotkeys;
+
+    /// The minimum time between accepted presses of the same hotkey.
+    std::chrono::milliseconds debounce{20};
+
+    /// Guards latencyStats, which is written by the listener thread.
+    mutable std::mutex statsMutex;
+
+    /// The press-to-callback latency measured so far.
+    LatencyStats latencyStats;
+
 #if defined(IS_WINDOWS)
 
-    bool lastPressed{false};
-    
-#elif defined(__linux__)   
-    /// Storage for the int key-code used by this listener.
-	unsigned int linuxKeyCode{0};
-	
+    /**
+     * @brief Returns the Modifier flags currently held down.
+     * @return [unsigned int] - The held modifiers.
+     */
+    unsigned int heldModifiers() const;
+
+#elif defined(__linux__)
+
     /**
      * @brief Converts a single ASCII character to its corresponding X11 keycode.
      * @param c[char] - The character to convert (must be a single printable ASCII character).
      * @return [unsigned int] - The X11 keycode as an unsigned int, or 0 if the character has no corresponding keycode.
      */
     unsigned int charToKeyCode(char c);
-    
+
+    /**
+     * @brief Converts Modifier flags to an X11 modifier mask.
+     * @param flags[unsigned int] - The Modifier flags (excluding ANY).
+     * @return [unsigned int] - The X11 modifier mask.
+     */
+    static unsigned int toX11Mask(unsigned int flags);
+
+    /**
+     * @brief Grabs or ungrabs a hotkey, including the Caps Lock and Num Lock variants.
+     * @param hotkey[const Hotkey&] - The hotkey.
+     * @param grab[bool] - True to grab; false to ungrab.
+     */
+    void setGrab(const Hotkey& hotkey, bool grab);
+
     /**
      * @brief Pointer to the X11 display connection used for listening to input events.
      *
      * Initialized with XOpenDisplay(nullptr) to connect to the default display.
-     * Used internally for issuing fake mouse events via the XTest extension.
+     * Its connection file descriptor is watched by the task.
      */
     Display *display;
-      
-    static constexpr unsigned int modifiers = AnyModifier;    
+
     Window root;
-    bool grabbed{false}; // To track if key was grabbed
+
+    /// True once the X connection is being watched.
+    bool watching{false};
 #endif
 }; // class KeyListenerTask
@@ -12,6 +12,8 @@
 #include <fstream>
 #include <algorithm>
 #include <cstdlib>
+#include <limits>
+#include <memory>
 
 // The associated header file.
 #include "MIASequencer.hpp"
@@ -25,64 +27,12 @@
 #include "Timing.hpp"
 // Used for config type.
 #include "Constants.hpp"
+// Used for capturing input to record.
+#include "InputRecorderTask.hpp"
 
-// Used for finding random values for some features.
-#include "MathUtils.hpp"
 
-using StringUtils::stringContainsChar;
-using StringUtils::getBeforeChar;
-using StringUtils::getAfterChar;
-using StringUtils::contains;
-using StringUtils::trim;
-using StringUtils::delimiterString;
 using virtual_keys::VirtualKeyStrokes;
 
-/*
- * This namespace defines methods and wrappers intended to be used only by this file. This
- * typically defines custom features and sequences of calls which utilize other utilities in
- * combination, which may not have a good place within those utilities or any other existing libs.
- */
-namespace
-{
-    /**
-     * @brief Simulates pressing a random number key between two values (0–9) using virtual key codes.
-     *
-     * This method will choose a random value between the input min and max, and then simulate a key
-     * press of the chosen value. After chooseing the random value, this simply calls pressNumber(..)
-     * to perform the actual key press.
-     * 
-     * @note The min_num must be less than or equal to the max_num.
-     * @note This method is designed specifically for the PRESSRANDNUM function.
-     *
-     * @param vkeys[VirtualKeyStrokes& keys] - The object for simulating actions.
-     * @param min_num[int] - The min value to use (must be in range 0–9) - inclusive.
-     * @param max_num[int] - The max value to use (must be in range 0–9) - inclusive.
-     * @param holdTime[int] - Duration in milliseconds to hold the key before releasing.
-     * @param verboseMode[bool] - If true, prints the pressed number to standard output.
-     */
-    void pressRandomNumber(VirtualKeyStrokes& vkeys, 
-                           int min_num, 
-                           int max_num, 
-                           int holdTime = 0, 
-                           bool verboseMode = false)
-    {
-        // If they are equal, the 'random value' will just be the number itself.
-        if ( min_num == max_num)
-            vkeys.pressNumber(min_num, holdTime, verboseMode);
-            
-        // Check for valid ranges on the input numbers. 
-        if ( min_num < 0 || max_num > 9 || max_num < min_num )
-        {
-            std::string invalidInputErr = "ERROR: Invalid range for PRESSRANDNUM: " 
-                                        + std::to_string(min_num) + ";" + std::to_string(max_num);
-            MIA_THROW(error::ErrorCode::Invalid_Parameter, invalidInputErr);
-        }
-        
-        int randomVal = math::randomInt(min_num, max_num);
-        vkeys.pressNumber(randomVal, holdTime, verboseMode);
-    }
-}
-
 MIASequencer::MIASequencer() : 
     config(defaultSequencesFile, constants::ConfigType::RAW_LINES),
     sequencesFileOpt("-c", "--config", "Specify a config file to use (default = " +
@@ -90,34 +40,55 @@ MIASequencer::MIASequencer() :
                                 CommandOption::commandOptionType::STRING_OPTION),
     testOpt("-t", "--test", "Enables test mode. This mode will only output the sequence to terminal.",
                                 CommandOption::commandOptionType::BOOL_OPTION),
-    sequenceNameOpt("-s", "--sequence", "Run a sequence, then exit.",
+    sequenceNameOpt("-s", "--sequence", "Run a sequence (or several comma separated sequences "
+                                "concurrently), then exit.",
                                 CommandOption::commandOptionType::STRING_OPTION),
     loopModeOpt("-L", "--loop", "Loop over the activated sequence indefinitely.",
                                 CommandOption::commandOptionType::BOOL_OPTION),
     printSequencesOpt("-P", "--list", "Print a list of all valid sequences when ran.",
-                                CommandOption::commandOptionType::BOOL_OPTION)
-{ };
+                                CommandOption::commandOptionType::BOOL_OPTION),
+    compileOpt("-C", "--compile", "Validate all sequences, report every error and write the compiled "
+                                "sequence cache, then exit.",
+                                CommandOption::commandOptionType::BOOL_OPTION),
+    inputBackendOpt("-I", "--input", "Inject input in batches with the given backend "
+                                "(auto, xtest, uinput or null).",
+                                CommandOption::commandOptionType::STRING_OPTION),
+    recordOpt("-R", "--record", "Record keyboard and mouse input as a new sequence with the given "
+                                "name until Ctrl+Alt+R is pressed, then save it to the sequences file.",
+                                CommandOption::commandOptionType::STRING_OPTION)
+{
+    addHelpSection("MIASequencer specific options:");
+    addOption(sequencesFileOpt, sequencesFile);
+    addOption(sequenceNameOpt, sequenceName);
+    addOption(testOpt, testMode);
+    addOption(loopModeOpt, loopMode);
+    addOption(printSequencesOpt, printSequences);
+    addOption(compileOpt, compileOnly);
+    addOption(inputBackendOpt, inputBackend);
+    addOption(recordOpt, recordName);
+};
 
 
 void MIASequencer::initialize(int argc, char* argv[])
 {
     try
     {    
+        // Parses the command line arguments into the option values.
         MIAApplication::initialize(argc, argv);
-
-        // Set the values from the command line arguments.
-        testOpt.getOptionVal<bool>(argc, argv, testMode);
-        sequenceNameOpt.getOptionVal<std::string>(argc, argv, sequenceName);
-        loopModeOpt.getOptionVal<bool>(argc, argv, loopMode);
-        printSequencesOpt.getOptionVal<bool>(argc, argv, printSequences);
         
         // Set and load the config file.
-        std::string sequencesFile = defaultSequencesFile;
-        sequencesFileOpt.getOptionVal<std::string>(argc, argv, sequencesFile);
+        config.setCacheEnabled(isConfigCacheEnabled());
         config.setConfigFileName(sequencesFile, constants::ConfigType::RAW_LINES); // handles config.initialize().
     
         // By this point, verbose, debug, etc are all set.
         listener.setContext(getContext());
+        
+        if (!inputBackend.empty())
+        {
+            keys.setBackend(virtual_keys::InputBackend::create(virtual_keys::InputBackend::stringToType(inputBackend)));
+            if (getVerboseMode())
+                std::cout << "Using input backend: " << keys.getBackend()->getName() << std::endl;
+        }
     }
     catch (const error::MIAException& ex)
     {
@@ -130,395 +101,123 @@ void MIASequencer::initialize(int argc, char* argv[])
 
 void MIASequencer::loadConfig()
 {    
-    CompleteSequence sequence;
+    sequences.clear();
+    compileErrorCount = 0;
     
-    // The config stores all non-comment and non-empty lines from the config file.
-    std::vector<std::string> lines = config.getRawLines();
-    for (auto& line : lines)
-    {
-        std::string key, value;
-        // See if the line is a key/value pair or contains the end of sequence marker.
-        if (stringContainsChar(line, '='))
-        {
-            // Get the key value on the line.
-            key = getBeforeChar(line, '=');
-                
-            // Get the value of the key.
-            value = getAfterChar(line, '=');  
-        }
-        else
-        {
-            key = trim(line);
-        }
-        
-        // Check if this is the start of end of a sequence.
-        if (key == "SEQUENCENAME")
-        {
-            sequence.name = value;
-        }
-        else if (key == "DELAY")
-        {
-            sequence.delayTime = std::stoi(value);
-        }
-        else if (key == "LISTEN")
-        {
-            sequence.listenerKeyCode = value[0];
-        }
-        else if (key == "ENDOFSEQUENCE") // Complete the sequence.
-        {
-            if (sequence.isValid())
-            {
-                std::string seqName = trim(sequence.name);
-                if (getVerboseMode())
-                {
-                    std::cout << "Adding sequence to sequences map: " << seqName << std::endl;
-                    sequence.dump();
-                }
-                // TODO - check for duplicate sequences.
-                sequences[seqName] = sequence;
-                sequence.clear();
-            }
-            else // Invalid sequence so restart and ignore this one.
-            {
-                std::string invalidSequenceErr = "ERROR: Invalid configuration for the sequence " 
-                                               + sequence.name
-                                               + " Config file in question is: "
-                                               + config.getConfigFileFullPath();
-                MIA_THROW(error::ErrorCode::Invalid_Sequence_Option, invalidSequenceErr);
-                sequence.clear();
-            }
-        }
-        else // Everything else is an action or invalid.
-        {
-            SequenceAction action = createAction(key, value);
-            if (action.isValid())
-                sequence.actions.push_back(action);
-        }
-    }
-}
-
-
-MIASequencer::SequenceAction MIASequencer::createAction(std::string key, std::string value)
-{
-    SequenceAction action;
-    if (key == "TYPE")
-    {
-        action.actionType = SequenceActionType::TYPE;
-        action.strToType = value;
-    }
-    else if (key == "SLEEP")
-    {
-        action.actionType = SequenceActionType::SLEEP;
-        action.timeValue = std::stoi(value);
-    }
-    else if (key == "DELAY")
-    {
-        action.actionType = SequenceActionType::DELAY;
-        action.timeValue = std::stoi(value);
-    }
-    else if (key == "MOVEMOUSE")
-    {
-        action.actionType = SequenceActionType::MOVEMOUSE;
-        math::Coordinate coords(0,0);
-        if (stringContainsChar(value, ','))
-        {
-            coords.x = std::stoi(getBeforeChar(value, ','));
-            coords.y = std::stoi(getAfterChar(value, ','));
-        }
-        action.coords = coords;
-    }
-    else if (key == "CLICK")
-    {
-        action.actionType = SequenceActionType::CLICK;
-        std::string trimmedClickString = trim(value);
-        action.click = VirtualKeyStrokes::stringToClickType(trimmedClickString);
-    }
-    else if (key == "PRESS")
-    {
-        action.actionType = SequenceActionType::PRESS;
-        std::string trimmedPressString = trim(value);
-        action.press = VirtualKeyStrokes::stringToSpecialButton(trimmedPressString);
-    }
-    else if (key == "TYPEHOLD")
-    {
-        action.actionType = SequenceActionType::TYPEHOLD;
-        std::string trimmedTypeHoldString = trim(value);
-        std::vector<std::string> typeHoldVec = delimiterString(trimmedTypeHoldString, ";");
-        action.strToType = typeHoldVec[0];
-        action.timeValue = std::stoi(typeHoldVec[1]);
-    }
-    else if (key == "PRESSHOLD")
-    {
-        action.actionType = SequenceActionType::PRESSHOLD;
-        std::string trimmedPressHoldString = trim(value);
-        std::vector<std::string> pressHoldVec = delimiterString(trimmedPressHoldString, ";");
-        action.press = VirtualKeyStrokes::stringToSpecialButton(pressHoldVec[0]);
-        action.timeValue = std::stoi(pressHoldVec[1]);
-    }
-    else if (key == "CLICKHOLD")
+    const std::string& sourcePath = config.getConfigFileFullPath();
+    const std::string cachePath = sequencer::sequence_cache::getCachePath(sourcePath);
+    
+    // Sequences whose text is unchanged since the last compilation are reused from the cache.
+    std::vector<sequencer::CompiledSequence> cached;
+    sequencer::sequence_cache::readCache(cachePath, cached);
+    
+    sequencer::CompileResult result;
+    try
     {
-        action.actionType = SequenceActionType::CLICKHOLD;
-        std::string trimmedClickHoldString = trim(value);
-        std::vector<std::string> clickHoldVec = delimiterString(trimmedClickHoldString, ";");
-        action.click = VirtualKeyStrokes::stringToClickType(clickHoldVec[0]);
-        action.timeValue = std::stoi(clickHoldVec[1]);
+        // The config stores all non-comment and non-empty lines (with line numbers) from the file.
+        result = sequencer::compileSequences(config.getLines(), cached);
     }
-    else if (key == "PRESSRANDNUM")
+    catch (const error::MIAException& ex)
     {
-        action.actionType = SequenceActionType::PRESSRANDNUM;
-        math::Coordinate coords(0,0);
-        if (stringContainsChar(value, ';'))
-        {
-            coords.x = std::stoi(getBeforeChar(value, ';'));
-            coords.y = std::stoi(getAfterChar(value, ';'));
-        }
-        action.coords = coords;
-    }
-    else
-    {    
-        action.actionType = SequenceActionType::UNKNOWN;
+        std::cerr << "Unable to load sequences: " << ex.what() << std::endl;
+        ++compileErrorCount;
+        return;
     }
     
+    compileErrorCount = result.errors.size();
+    for (const sequencer::CompileError& compileError : result.errors)
+        std::cerr << sourcePath << ":" << compileError.lineNumber << ": " << compileError.message << std::endl;
+    
     if (getVerboseMode())
-    {
-        std::cout << "Action created: ";
-        action.dump();
-        std::cout << std::endl;
-    }
+        std::cout << "Sequences compiled: " << result.compiledCount 
+                  << ", reused from cache: " << result.reusedCount << std::endl;
     
-    return action;
-}
-
-
-void MIASequencer::printHelp() const
-{
-    MIAApplication::printHelp();
+    // Only rewrite the cache when its contents would change.
+    if (result.compiledCount > 0 || result.sequences.size() != cached.size())
+        sequencer::sequence_cache::writeCache(cachePath, result.sequences);
     
-    // This is a dump of the help messages used by the various command options.
-    std::cout << "MIASequencer specific options:" << std::endl
-              << sequencesFileOpt.getHelp() << std::endl
-              << sequenceNameOpt.getHelp() << std::endl
-              << testOpt.getHelp() << std::endl
-              << loopModeOpt.getHelp() << std::endl
-              << printSequencesOpt.getHelp() << std::endl
-              << std::endl;
-}
-
-
-bool MIASequencer::SequenceAction::isValid()
-{
-    switch (actionType) 
+    for (sequencer::CompiledSequence& compiled : result.sequences)
     {
-        case SequenceActionType::TYPE:
-            return !strToType.empty();
-
-        case SequenceActionType::SLEEP:
-        case SequenceActionType::DELAY:
-            return timeValue >= 0;
-
-        case SequenceActionType::MOVEMOUSE:
-            return true;  // No restriction on coords
-
-        case SequenceActionType::CLICK:
-            return click != VirtualKeyStrokes::ClickType::UNKNOWN;
-
-        case SequenceActionType::PRESS:
-            return press != VirtualKeyStrokes::SpecialButton::UNKNOWN;
-
-        case SequenceActionType::TYPEHOLD:
-            return !strToType.empty() && timeValue > 0;
-
-        case SequenceActionType::PRESSHOLD:
-            return press != VirtualKeyStrokes::SpecialButton::UNKNOWN  && timeValue > 0;
-
-        case SequenceActionType::CLICKHOLD:
-            return click != VirtualKeyStrokes::ClickType::UNKNOWN  && timeValue > 0;
-            
-        case SequenceActionType::PRESSRANDNUM:
-            return (coords.x >= 0 && coords.y >= 0) && (coords.x <= 9 && coords.y <= 9);
-
-        default:
-            return false;
+        CompleteSequence sequence;
+        sequence.name = std::move(compiled.name);
+        sequence.listenerKeyCode = compiled.listenerKeyCode;
+        sequence.priority = compiled.priority;
+        sequence.program = std::move(compiled.program);
+        if (getVerboseMode())
+        {
+            std::cout << "Adding sequence to sequences map: " << sequence.name << std::endl;
+            sequence.dump();
+        }
+        std::string seqName = sequence.name;
+        sequences[seqName] = std::move(sequence);
     }
 }
 
 
-bool MIASequencer::CompleteSequence::isValid()
+bool MIASequencer::CompleteSequence::isValid() const
 {
-    return !name.empty() && !actions.empty();
+    return !name.empty() && !program.empty();
 }
 
 
 void MIASequencer::CompleteSequence::clear()
 {
     name.clear();
-    delayTime = 1000; // The default value.
     listenerKeyCode = '\0';
-    actions.clear();
+    priority = 0;
+    program.clear(); // Also restores the default delay.
     return;
 }
 
 
-std::optional<int> MIASequencer::SequenceAction::performAction(VirtualKeyStrokes& keys,
-                                                               bool verboseMode,
-                                                               bool testMode)
-{
-    if (testMode)
-    {
-        dump();
-    }
-    else
-    {
-        switch(actionType)
-        {
-            case SequenceActionType::TYPE:
-                keys.type(strToType, 0, verboseMode);
-                break;
-            case SequenceActionType::SLEEP:
-                timing::sleepMilliseconds(timeValue);
-                break;
-            case SequenceActionType::MOVEMOUSE:
-                keys.moveMouseTo(coords.x, coords.y);
-                break;
-            case SequenceActionType::CLICK:
-                if (isValid())
-                    keys.mouseClick(click, 0, verboseMode);
-                break;
-            case SequenceActionType::PRESS:
-                if (isValid())
-                    keys.pressSpecialButton(press, timeValue, verboseMode);
-                break;
-            case SequenceActionType::TYPEHOLD:
-                if (isValid())
-                    keys.type(strToType, timeValue, verboseMode);
-                break;
-            case SequenceActionType::PRESSHOLD:
-                if (isValid())
-                    keys.pressSpecialButton(press, timeValue, verboseMode);
-                break;
-            case SequenceActionType::CLICKHOLD:
-                if (isValid())
-                    keys.mouseClick(click, timeValue, verboseMode);
-                break;
-            case SequenceActionType::PRESSRANDNUM:
-                if (isValid())
-                    ::pressRandomNumber(keys, coords.x, coords.y, timeValue, verboseMode);
-                break;
-            case SequenceActionType::DELAY:
-                return timeValue;
-            default:
-                // Do nothing...
-                break;
-        }
-    }
-    
-    if (testMode)
-        std::cout << std::endl;
-        
-    return std::nullopt;
-}
-
-
 void MIASequencer::CompleteSequence::performActions(VirtualKeyStrokes& keys, 
+                                                    timing::Timeline& timeline,
                                                     bool verboseMode,
-                                                    bool testMode)
+                                                    bool testMode) const
 {
-    for (auto& action : actions)
+    if (testMode)
     {
-        if (testMode)
-        {
-            action.dump();
-            std::cout << " ";
-        }
-        else
-        {
-            // Update the delayTime if performActions returns an int.
-            if (auto newDelay = action.performAction(keys, verboseMode))
-                delayTime = *newDelay;
-            
-            timing::sleepMilliseconds(delayTime);
-        }
+        program.dump(std::cout);
+        std::cout << std::endl;
+        return;
     }
     
-    if (testMode)
-        std::cout << std::endl;
-}
-
-
-void MIASequencer::SequenceAction::dump() const 
-{
-    switch (actionType) 
+    program.execute(keys, timeline, verboseMode);
+    
+    if (verboseMode)
     {
-        case SequenceActionType::TYPE:
-            std::cout << "TYPE:" << strToType;
-            break;
-            
-        case SequenceActionType::SLEEP:
-            std::cout << "SLEEP:" << timeValue << "ms";
-            break;
-            
-        case SequenceActionType::MOVEMOUSE:
-            std::cout << "MOVEMOUSE:" << coords.x << "," << coords.y;
-            break;
-            
-        case SequenceActionType::CLICK:
-            std::cout << "CLICK:" << VirtualKeyStrokes::clickTypeToString(click);
-            break;
-            
-        case SequenceActionType::PRESS:
-            std::cout << "PRESS:" << VirtualKeyStrokes::specialButtonToString(press);
-            break;
-            
-        case SequenceActionType::TYPEHOLD:
-            std::cout << "TYPE:" << strToType
-                      << ";HOLD:" << timeValue << "ms";
-            break;
-            
-        case SequenceActionType::PRESSHOLD:
-            std::cout << "PRESS:" << VirtualKeyStrokes::specialButtonToString(press)
-                      << ";HOLD:" << timeValue << "ms";
-            
-        case SequenceActionType::CLICKHOLD:
-            std::cout << "CLICK:" << VirtualKeyStrokes::clickTypeToString(click)
-                      << ";HOLD:" << timeValue << "ms";
-            break;
-            
-        case SequenceActionType::DELAY:
-            std::cout << "DELAY:" << timeValue << "ms";
-            break;
-            
-        case SequenceActionType::PRESSRANDNUM:
-            std::cout << "PRESSRANDNUM:" << coords.x << ";" << coords.y;
-            break;
-                        
-        default:
-            std::cout << "UNKNOWN";
-            break;
+        const timing::JitterStats& stats = timeline.getStats();
+        std::cout << "Timing jitter over " << stats.getCount() << " waits: mean " 
+                  << stats.getMean().count() / 1000.0 << " us, stddev "
+                  << stats.getStdDev().count() / 1000.0 << " us, max "
+                  << stats.getMax().count() / 1000.0 << " us" << std::endl;
     }
-    std::cout << std::flush;
 }
 
 
 void MIASequencer::CompleteSequence::dump() const 
 {
     std::cout << " -- { " << name << ", DELAY=";
-    std::cout << delayTime << "ms";
+    std::cout << program.getDelay() << "ms";
     
     if (listenerKeyCode != '\0')
         std::cout << ", LISTEN=" << listenerKeyCode;
+    
+    if (priority != 0)
+        std::cout << ", PRIORITY=" << priority;
 
-    for (const auto& action : actions) 
+    if (!program.empty())
     {
         std::cout << ", ";
-        action.dump();
+        program.dump(std::cout);
     }
     std::cout << " }" << std::endl;
 }
 
 
-void MIASequencer::runSequence(CompleteSequence& sequence)
+void MIASequencer::runSequence(const CompleteSequence& sequence)
 {
-    sequence.performActions(keys, getVerboseMode(), testMode);
+    sequence.performActions(keys, timeline, getVerboseMode(), testMode);
 }
 
 
@@ -532,6 +231,152 @@ void MIASequencer::runSequence(const std::string& sequenceName)
 }
 
 
+void MIASequencer::runSequences(const std::vector<std::string>& sequenceNames)
+{
+    using Runner = sequencer::SequenceRunner<VirtualKeyStrokes>;
+    std::vector<std::unique_ptr<Runner>> runners;
+    for (const std::string& name : sequenceNames)
+    {
+        auto it = sequences.find(name);
+        if (it == sequences.end())
+        {
+            std::cout << "Sequence not found/loaded: " << name << std::endl;
+            continue;
+        }
+        
+        const CompleteSequence& sequence = it->second;
+        auto runner = std::make_unique<Runner>(sequence.name, sequence.program, keys, arbiter, sequence.priority);
+        runner->setContext(getContext());
+        runner->setLoop(loopMode);
+        runner->setDryRun(testMode);
+        
+        // If this is false, then a LISTEN value is not set for this sequence.
+        if (sequence.listenerKeyCode != '\0')
+        {
+            std::cout << "Press the '" << sequence.listenerKeyCode 
+                      << "' key to start/stop the sequence: " << sequence.name << std::endl;
+            Runner* target = runner.get();
+            listener.addHotkey(sequence.listenerKeyCode, KeyListenerTask::ANY, 
+                               [target]() { target->toggleCondition(); });
+        }
+        else
+        {
+            runner->setConditionMet(true);
+        }
+        runners.push_back(std::move(runner));
+    }
+    
+    if (listener.isActive())
+    {
+        listener.initialize();
+        listener.start();
+    }
+    for (auto& runner : runners)
+        runner->start();
+    
+    // Without loop mode, each sequence runs once. In loop mode this blocks until the app is closed.
+    for (auto& runner : runners)
+        runner->waitForRuns(loopMode ? std::numeric_limits<std::uint64_t>::max() : 1);
+    
+    // The hotkey callbacks refer to the runners, so stop the listener first.
+    listener.stop();
+    for (auto& runner : runners)
+        runner->stop();
+    
+    if (getVerboseMode() && runners.size() > 1)
+        std::cout << "Input requests which waited for another sequence: " 
+                  << arbiter.getContendedCount() << std::endl;
+}
+
+
+int MIASequencer::recordSequence(const std::string& name)
+{
+    if (sequences.count(name) != 0)
+    {
+        std::cerr << "A sequence named " << name << " already exists." << std::endl;
+        return constants::FAILURE;
+    }
+    
+    InputRecorderTask recorder;
+    try
+    {
+        recorder.initialize();
+    }
+    catch (const error::MIAException& ex)
+    {
+        std::cerr << "Unable to record input: " << ex.what() << std::endl;
+        return constants::FAILURE;
+    }
+    recorder.setContext(getContext());
+    
+    // The recorder's condition is used to signal the end of the recording.
+    listener.addHotkey('r', KeyListenerTask::CONTROL | KeyListenerTask::ALT, 
+                       [&recorder]() { recorder.setConditionMet(true); });
+    listener.initialize();
+    listener.start();
+    recorder.start();
+    std::cout << "Recording... press Ctrl+Alt+R to stop." << std::endl;
+    recorder.waitForCondition(true);
+    listener.stop();
+    recorder.stop();
+    
+    sequencer::MacroRecorder macro;
+    for (const sequencer::RecordedEvent& event : recorder.takeEvents())
+        macro.record(event);
+    macro.trimTrailingKey('r'); // The key that stopped the recording.
+    sequencer::RecordedSequence recorded = macro.build();
+    if (recorded.actions.empty())
+    {
+        std::cerr << "Nothing was recorded." << std::endl;
+        return constants::FAILURE;
+    }
+    if (getVerboseMode() && recorded.skippedEvents > 0)
+        std::cout << "Skipped " << recorded.skippedEvents << " input(s) with no sequence action." << std::endl;
+    
+    const std::string text = sequencer::MacroRecorder::toSequenceText(recorded, name);
+    std::cout << text;
+    
+    // Compile the new sequence now so that the next load reuses it from the cache.
+    std::vector<config::ConfigLine> lines;
+    config::config_parser::parseLines(text, lines);
+    sequencer::CompileResult result = sequencer::compileSequences(lines);
+    if (!result.errors.empty() || result.sequences.empty())
+    {
+        for (const sequencer::CompileError& compileError : result.errors)
+            std::cerr << "recording:" << compileError.lineNumber << ": " << compileError.message << std::endl;
+        return constants::FAILURE;
+    }
+    
+    const std::string& sourcePath = config.getConfigFileFullPath();
+    std::ofstream file(sourcePath, std::ios::app);
+    if (!file)
+    {
+        std::cerr << "Unable to write to " << sourcePath << std::endl;
+        return constants::FAILURE;
+    }
+    file << "\n# Recorded sequence.\n" << text;
+    file.close();
+    
+    const std::string cachePath = sequencer::sequence_cache::getCachePath(sourcePath);
+    std::vector<sequencer::CompiledSequence> cached;
+    sequencer::sequence_cache::readCache(cachePath, cached);
+    cached.push_back(result.sequences.front());
+    sequencer::sequence_cache::writeCache(cachePath, cached);
+    std::cout << "Saved sequence " << name << " to " << sourcePath << std::endl;
+    
+    if (testMode)
+    {
+        std::vector<std::chrono::nanoseconds> replayed = 
+            sequencer::MacroRecorder::measureReplay(result.sequences.front().program);
+        sequencer::ReplayReport report = sequencer::MacroRecorder::compareTiming(recorded.times, replayed);
+        std::cout << "Replay timing over " << report.count << " actions: mean error " 
+                  << report.meanError.count() / 1000000.0 << " ms, max error "
+                  << report.maxError.count() / 1000000.0 << " ms" << std::endl;
+    }
+    return constants::SUCCESS;
+}
+
+
 void MIASequencer::printSequenceList(std::ostream& out)
 {
     out << "All valid sequences listed below:" << std::endl;
@@ -562,6 +407,17 @@ void MIASequencer::defaultFrontEnd()
 
 int MIASequencer::run()
 {
+    if (compileOnly)
+    {
+        // Errors were already reported while loading.
+        std::cout << "Compiled " << sequences.size() << " sequence(s) with " 
+                  << compileErrorCount << " error(s)." << std::endl;
+        return compileErrorCount == 0 ? constants::SUCCESS : constants::FAILURE;
+    }
+    
+    if (!recordName.empty())
+        return recordSequence(recordName);
+    
     if (printSequences)
         printSequenceList();
     
@@ -573,44 +429,12 @@ int MIASequencer::run()
     else
     {
         std::cout << "Activating sequence: " << sequenceName << std::endl;
-        auto it = sequences.find(sequenceName);
-        if (it != sequences.end())
-        {
-            CompleteSequence& sequence = it->second;
-            
-            // If this is false, then a LISTEN value is not set for this sequence.
-            if (sequence.listenerKeyCode != '\0')
-            {
-                std::cout << "Press the '" << sequence.listenerKeyCode 
-                          << "' key to start/stop the sequence." << std::endl;
-                          
-                listener.setKeyCode(sequence.listenerKeyCode);
-                listener.initialize();
-                listener.start();
-                
-                do // Perform the sequence (and loop if needed). 
-                {
-                    // Start with the sequence off until the condition is met.
-                    while (listener.isConditionMet())
-                    {
-                        runSequence(sequence);
-                        if (!loopMode) break;
-                    }
-                } while (loopMode);
-            }
-            else
-            {
-                do // Perform the sequence (and loop if needed). 
-                {
-                    runSequence(sequence);
-                } while (loopMode);
-            }
-
-        }
-        else
-        {
-            std::cout << "Sequence not found/loaded: " << sequenceName << std::endl;
-        }
+        std::string names = sequenceName;
+        std::vector<std::string> sequenceNames;
+        for (const std::string& name : StringUtils::delimiterString(names, ","))
+            if (!StringUtils::trim(name).empty())
+                sequenceNames.push_back(StringUtils::trim(name));
+        runSequences(sequenceNames);
     }
     return constants::SUCCESS;
 }
@@ -11,7 +11,6 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <optional>
 #include <iostream>
 #include <limits>
 
@@ -21,11 +20,19 @@
 #include "MIAApplication.hpp"
 // Used for command options.
 #include "CommandOption.hpp"
-// Used for Coordinate type.
-#include "MathTypes.hpp"
 //Used for virtual key strokes.
 #include "VirtualKeyStrokes.hpp"
+// Used for drift-free scheduling of sequence waits.
+#include "Timing.hpp"
+// Used for the compiled sequence actions.
+#include "SequenceProgram.hpp"
+// Used for compiling and caching the sequences file.
+#include "SequenceCompiler.hpp"
+// Used for running sequences concurrently.
+#include "SequenceRunner.hpp"
 #include "KeyListenerTask.hpp"
+// Used for recording new sequences.
+#include "MacroRecorder.hpp"
 
 /**
  * @class MIASequencer
@@ -40,91 +47,28 @@ class MIASequencer : public MIAApplication
 {
 public:
 
-    /**
-     * These are the various actions which the sequencer supports.
-     */
-    enum SequenceActionType
-    {
-        UNKNOWN,     ///< Unknown action - do nothing.
-        TYPE,        ///< This will type a sequence of characters.
-        SLEEP,       ///< This will wait/pause some time.
-        DELAY,       ///< This is the time to wait between each action.
-        MOVEMOUSE,   ///< This will move the mouse to a specific cordinate.
-        CLICK,       ///< This will perform a click with the mouse.
-        PRESS,       ///< This will perform a special button press.
-        PRESSRANDNUM,///< This will press a random numered key between two values.
-        TYPEHOLD,    ///< This will press a character and hold it for a specified time.
-        PRESSHOLD,   ///< This will perform a special button press and hold it for a specified time.
-        CLICKHOLD,   ///< This will perform a click with the mouse and hold it for a specified time.
-        LISTEN,      ///< This will listen for a key press and stop or restart the sequence.
-    };
-    
-    /**
-     * This struct represents storage for a valid sequencer action. This action
-     * defines a type, which specifies what the action will do, and then containers
-     * for each type of data needed for the various actions. The intention is to only
-     * fill the data type associated with the type needed for the action.
-     */
-    struct SequenceAction
-    {
-        SequenceActionType actionType{};  ///< An action type (what to perform).
-        int timeValue{};                  ///< Timing information (for pause or delay).
-        std::string strToType{};          ///< A string (for typing).
-        virtual_keys::VirtualKeyStrokes::ClickType click{}; ///< A click type (for mouse input).
-        virtual_keys::VirtualKeyStrokes::SpecialButton press{}; ///< A special button for pressing. 
-        unsigned int keyCode{};           ///< A generic key code.
-        
-        /// Coordinates (for moving mouse). Also stores the range for the PRESSRANDNUM option.
-        math::Coordinate coords{};
-        
-        /// Returns true if this is a valid action.
-        bool isValid();
-        
-        /**
-         * @brief Outputs a human-readable representation of the acvtion to the standard output.
-         * Useful for debugging or verifying the sequence contents before execution.
-         */
-        void dump() const;
-        
-        /**
-         * @brief Executes the stored action based on its type and associated data.
-         * This function performs the action defined by the `action` field using
-         * the relevant data members (i.e., coordinates, time, string, click type).
-         * Only the data appropriate to the action type is used.
-         * @param keys[VirtualKeyStrokes& keys] - The object for simulating actions.
-         * @param verboseMode[bool] If true, enables verbose output.
-         * @param testMode[bool] - Enables test mode (default = false).
-         * @return [optional<int>] - Returns optional new delay time (ms) to use for 
-         *     subsequent actions if it needs updated via an action.
-         */
-        std::optional<int> performAction(virtual_keys::VirtualKeyStrokes& keys,
-                                         bool verboseMode = false,
-                                         bool testMode = false);
-    };
-    
-    /// A list of sequencer actions forming a complete sequence.
-    using SequenceActions = std::vector<SequenceAction>;
-    
     /**
      * @brief Represents a fully defined input sequence with a name, timing, and actions.
      *
      * A CompleteSequence contains:
      * - A unique name identifying the sequence,
-     * - A delay time in milliseconds between each action,
-     * - An ordered list of SequenceAction items to execute.
-     * - An optional listenerKeyCode for stop/restarts.
+     * - The compiled actions and the delay time in milliseconds between each action,
+     * - An optional listenerKeyCode for stop/restarts,
+     * - A priority for input arbitration when running alongside other sequences.
      */
     struct CompleteSequence
     {
-        std::string name{};        ///< The name of this sequence.
-        int delayTime{1000};       ///< The time between each action (ms).
-        SequenceActions actions{}; ///< All actions in this sequence.
+        std::string name{};                  ///< The name of this sequence.
+        sequencer::SequenceProgram program{}; ///< The compiled actions and delay.
         
         /// This stores a key code to listen for in order to stop or restart the sequence.
         char listenerKeyCode{'\0'}; 
         
+        /// The priority of this sequence's input when sequences run concurrently (higher goes first).
+        int priority{0};
+        
         /// Returns true if this is a valid sequence.
-        bool isValid();
+        bool isValid() const;
         /// Clear this object.
         void clear();
         
@@ -138,16 +82,18 @@ public:
         
         /**
          * @brief Executes all actions in the sequence in order, applying the defined delay between each.
-         * Iterates through the `actions` list and calls `performAction()` on each entry,
-         * pausing for `delayTime` milliseconds between actions.
+         * Runs the compiled program, pausing for the delay between actions. Waits are
+         * scheduled on the timeline, so the time taken by the actions themselves does not add drift.
          * @param keys[VirtualKeyStrokes& keys] - The object for simulating actions.
+         * @param timeline[timing::Timeline&] - The drift-free timeline to schedule waits on.
          * @param verboseMode[bool] If true, enables verbose output.
-         * @param testMode[bool] - Enables test mode (default = false).
-         * @param [bool] - Enables test mode.
+         * @param testMode[bool] - Enables test mode (default = false), which prints the actions
+         *     instead of performing them.
          */
         void performActions(virtual_keys::VirtualKeyStrokes& keys, 
+                            timing::Timeline& timeline,
                             bool verboseMode = false,
-                            bool testMode = false);
+                            bool testMode = false) const;
     };
     
     /// Maps sequence names to their corresponding list of actions.
@@ -179,23 +125,8 @@ public:
     /// Runs the MIASequencer application.
     int run() override;
 
-protected:
-
-    /**
-     * Prints help info for optional config file.
-     */
-    virtual void printHelp() const;
-
 private:
     
-    /**
-     * This will create a SequenceAction from a key-value pair.
-     * @param key[std::String] - The key defining the action type.
-     * @param value[std::String] - The value defining the data needed to perform the action.
-     * @return [SequenceAction] - Returns the constructed SequenceAction.  
-     */
-    SequenceAction createAction(std::string key, std::string value);
-    
     /**
      * Runs a sequence based on the name (key) of the sequence.
      * @param sequenceName[const std::String&] - The name of the sequence to run.
@@ -206,7 +137,26 @@ private:
      * Runs a sequence.
      * @param sequence[const CompleteSequence&] - The sequence to run.
      */
-    void runSequence(CompleteSequence& sequence);
+    void runSequence(const CompleteSequence& sequence);
+    
+    /**
+     * Runs sequences concurrently, each on its own thread and timeline. Sequences with a LISTEN
+     * key start and stop when their key is pressed, and the others start immediately. Key and
+     * mouse input from the sequences is serialized by priority through the arbiter. Returns once
+     * each sequence has run (never in loop mode).
+     * @param sequenceNames[const std::vector<std::string>&] - The names of the sequences to run.
+     */
+    void runSequences(const std::vector<std::string>& sequenceNames);
+    
+    /**
+     * Records the user's keyboard and mouse input until Ctrl+Alt+R is pressed, then converts it
+     * into a sequence (see sequencer::MacroRecorder), appends it to the sequences file and adds
+     * its compiled form to the sequence cache. In test mode, the recorded timing is also
+     * compared with a dry replay of the compiled sequence.
+     * @param name[const std::string&] - The name of the new sequence.
+     * @return [int] - constants::SUCCESS, or constants::FAILURE if nothing could be recorded.
+     */
+    int recordSequence(const std::string& name);
      
     /**
      * This will load a default front-end. This will continually loop, while asking the
@@ -217,15 +167,30 @@ private:
     
     /// An instance of VirtualKeyStrokes for calling the virtual key strokes.
     virtual_keys::VirtualKeyStrokes keys;
+    
+    /**
+     * The timeline that all sequence waits are scheduled on. Each run resynchronizes it to the
+     * current time before its first wait (see SequenceProgram::execute()).
+     */
+    timing::Timeline timeline;
+    
+    /// Serializes the input of concurrently running sequences on keys.
+    sequencer::InputArbiter arbiter;
 
     /**
-     * This will load in the configuration file and load the sequences.
+     * This will compile the sequences from the configuration file and load them. Every error
+     * is reported with its line number, and the invalid sequences are skipped. Unchanged
+     * sequences are reused from the compiled cache ("<file>.seq.cache"), which is updated
+     * when anything changed.
      */
     void loadConfig();
     
     /// The name of the defauilt config file that this class uses.
     std::string defaultSequencesFile{"MIASequences.MIA"};
     
+    /// The sequences file to load (set by sequencesFileOpt).
+    std::string sequencesFile{defaultSequencesFile};
+    
     /**
      * The configuration loader for this app. The configuration for this app uses the
      * constants::ConfigType::RAW_LINES format since it also loads the sequencer fields
@@ -239,6 +204,9 @@ private:
     CommandOption sequenceNameOpt;   ///< Used for running a particular sequence.
     CommandOption loopModeOpt;       ///< Used for setting the sequence loop mode option.
     CommandOption printSequencesOpt; ///< Used for printing all valid sequences.
+    CommandOption compileOpt;        ///< Used for validating and compiling the sequences only.
+    CommandOption inputBackendOpt;   ///< Used for selecting the input backend.
+    CommandOption recordOpt;         ///< Used for recording a new sequence.
     
     /// Determines whether to loop sequences or terminate after they finish.
     bool loopMode{false};
@@ -246,7 +214,19 @@ private:
     /// Determines whether to print the sequences on application start.
     bool printSequences{false};
     
-    /// Name of the option-entered sequence to run. Empty if no sequence option used.
+    /// Determines whether to only compile the sequences (reporting errors) and exit.
+    bool compileOnly{false};
+    
+    /// The input backend to use (see InputBackend::stringToType()). Empty to use the default.
+    std::string inputBackend{};
+    
+    /// The name of the sequence to record. Empty if the record option is not used.
+    std::string recordName{};
+    
+    /// The number of errors found when the sequences were last loaded.
+    std::size_t compileErrorCount{0};
+    
+    /// Names (comma separated) of the option-entered sequences to run. Empty if no sequence option used.
     std::string sequenceName{};
     /// Stores true for testMode functionality.
     bool testMode{false};
@@ -255,10 +235,8 @@ private:
     sequenceList sequences;
           
     /**
-     * This is a listener, which will (if initialized and set), monitor for a specific
-     * user-defined key-press throughout the sequence to stop and/or restart the sequence looping.
-     * Since this is a threaded class, this will be constructed outside of the sequences when it
-     * is needed and used.
+     * This is a listener, which will (if initialized and set), monitor for the user-defined
+     * LISTEN keys of the running sequences to stop and/or restart each sequence.
      */
     KeyListenerTask listener{};
     
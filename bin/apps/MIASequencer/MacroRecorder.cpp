@@ -0,0 +1,384 @@
+/**
+ * @file MacroRecorder.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements converting recorded input events into MIASequences sequences.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+// The associated header file.
+#include "MacroRecorder.hpp"
+// Used for the characters which can be typed.
+#include "VirtualKeyStrokes.hpp"
+
+using virtual_keys::InputEvent;
+using virtual_keys::VirtualKeyStrokes;
+
+namespace
+{
+    /**
+     * @brief A key or button press paired with its release.
+     */
+    struct Press
+    {
+        std::string key;                    ///< The action without a hold ("TYPE", "PRESS" or "CLICK").
+        std::string value;                  ///< The character, button name or click name.
+        std::chrono::nanoseconds start{0};  ///< When it was pressed.
+        std::chrono::nanoseconds end{0};    ///< When it was released.
+        bool holdable{true};                ///< False for presses which have no hold form (scrolling).
+        bool hasPosition{false};            ///< True if the mouse position is known (clicks).
+        int x{0};                           ///< The mouse x position for clicks.
+        int y{0};                           ///< The mouse y position for clicks.
+    };
+
+    /**
+     * @brief One action before timing is added, possibly merged from several presses.
+     */
+    struct Unit
+    {
+        std::string key;                    ///< The action name.
+        std::string value;                  ///< The action value without the hold time.
+        int hold{0};                        ///< The quantized hold time per key (ms), or 0.
+        std::chrono::nanoseconds start{0};  ///< When the first press started.
+        std::chrono::nanoseconds end{0};    ///< When the last press ended.
+
+        /// Returns the total hold time of the action on replay (ms).
+        int totalHold() const
+        { return key == "TYPEHOLD" ? hold * static_cast<int>(value.size()) : hold; }
+    };
+
+    /// Returns the PRESS name of a named key, or an empty string if it has none.
+    std::string namedKey(std::uint32_t code)
+    {
+        switch (code)
+        {
+            case virtual_keys::keysym::RETURN: return "ENTER";
+            case virtual_keys::keysym::TAB: return "TAB";
+            case virtual_keys::keysym::NUM_LOCK: return "NUM_LOCK";
+            default: return "";
+        }
+    }
+
+    /// Returns the CLICK name of a mouse button, or an empty string if it has none.
+    std::string clickName(std::uint32_t number)
+    {
+        switch (number)
+        {
+            case virtual_keys::button::LEFT: return "LEFTCLICK";
+            case virtual_keys::button::RIGHT: return "RIGHTCLICK";
+            case virtual_keys::button::MIDDLE: return "MIDDLECLICK";
+            default: return "";
+        }
+    }
+
+    /**
+     * @brief Records when each input call is made instead of simulating input.
+     */
+    struct TimingProbe
+    {
+        std::vector<timing::Clock::time_point> times;
+
+        void type(const std::string&, int, bool)
+        { times.push_back(timing::Clock::now()); }
+
+        void moveMouseTo(int, int)
+        { times.push_back(timing::Clock::now()); }
+
+        void mouseClick(VirtualKeyStrokes::ClickType, int, bool)
+        { times.push_back(timing::Clock::now()); }
+
+        void pressSpecialButton(VirtualKeyStrokes::SpecialButton, int, bool)
+        { times.push_back(timing::Clock::now()); }
+
+        void pressNumber(int, int, bool)
+        { times.push_back(timing::Clock::now()); }
+    };
+
+    /// Returns a map key identifying an event's key or button.
+    std::uint64_t pressId(const InputEvent& event)
+    {
+        return (static_cast<std::uint64_t>(event.type) << 32) | event.code;
+    }
+} // anonymous namespace
+
+
+namespace sequencer
+{
+    void MacroRecorder::trimTrailingKey(std::uint32_t code)
+    {
+        while (!events.empty() && events.back().event.type == InputEvent::Type::KEY &&
+               events.back().event.code == code)
+            events.pop_back();
+    }
+
+
+    int MacroRecorder::quantize(std::chrono::nanoseconds duration) const
+    {
+        double quantum = static_cast<double>(std::max<std::int64_t>(options.quantum.count(), 1));
+        double milliseconds = std::chrono::duration<double, std::milli>(duration).count();
+        return std::max(0, static_cast<int>(std::lround(milliseconds / quantum) * options.quantum.count()));
+    }
+
+
+    RecordedSequence MacroRecorder::build() const
+    {
+        RecordedSequence sequence;
+
+        // Pair each press with its release.
+        std::vector<Press> presses;
+        std::unordered_map<std::uint64_t, std::size_t> open;
+        bool shift = false, havePosition = false;
+        int mouseX = 0, mouseY = 0;
+        for (const RecordedEvent& recorded : events)
+        {
+            const InputEvent& event = recorded.event;
+            if (event.type == InputEvent::Type::MOVE_TO)
+            {
+                mouseX = event.x;
+                mouseY = event.y;
+                havePosition = true;
+                continue;
+            }
+            if (event.type == InputEvent::Type::KEY && event.code == virtual_keys::keysym::SHIFT_L)
+            {
+                shift = event.pressed;
+                continue;
+            }
+            if (!event.pressed)
+            {
+                auto it = open.find(pressId(event));
+                if (it != open.end())
+                {
+                    presses[it->second].end = recorded.time;
+                    open.erase(it);
+                }
+                continue;
+            }
+            if (open.count(pressId(event)) != 0)
+                continue; // Auto-repeat of a key which is already down.
+
+            Press press;
+            press.start = press.end = recorded.time;
+            if (event.type == InputEvent::Type::KEY)
+            {
+                char character = static_cast<char>(event.code);
+                if (event.code < 0x80 && VirtualKeyStrokes::canPress(character))
+                {
+                    press.key = "TYPE";
+                    bool capital = shift && std::isalpha(static_cast<unsigned char>(character));
+                    press.value = std::string(1, capital ? static_cast<char>(std::toupper(character)) : character);
+                }
+                else if (!(press.value = namedKey(event.code)).empty())
+                {
+                    press.key = "PRESS";
+                }
+            }
+            else if (event.code == virtual_keys::button::SCROLL_UP || event.code == virtual_keys::button::SCROLL_DOWN)
+            {
+                press.key = "PRESS";
+                press.value = event.code == virtual_keys::button::SCROLL_UP ? "SCROLL_UP" : "SCROLL_DOWN";
+                press.holdable = false;
+            }
+            else if (!(press.value = clickName(event.code)).empty())
+            {
+                press.key = "CLICK";
+                press.hasPosition = havePosition;
+                press.x = mouseX;
+                press.y = mouseY;
+            }
+
+            if (press.key.empty())
+            {
+                ++sequence.skippedEvents;
+                continue;
+            }
+            if (press.holdable)
+                open[pressId(event)] = presses.size();
+            presses.push_back(press);
+        }
+
+        // Turn the presses into actions, merging bursts of typing.
+        std::vector<Unit> units;
+        bool moved = false;
+        int movedX = 0, movedY = 0;
+        for (const Press& press : presses)
+        {
+            Unit unit{press.key, press.value, 0, press.start, press.end};
+            if (press.holdable && press.end - press.start >= options.holdThreshold)
+            {
+                unit.key += "HOLD";
+                unit.hold = quantize(press.end - press.start);
+            }
+
+            if (press.hasPosition && (!moved || press.x != movedX || press.y != movedY))
+            {
+                units.push_back({"MOVEMOUSE", std::to_string(press.x) + "," + std::to_string(press.y), 0,
+                                 press.start, press.start});
+                moved = true;
+                movedX = press.x;
+                movedY = press.y;
+            }
+
+            if (!units.empty() && (unit.key == "TYPE" || unit.key == "TYPEHOLD"))
+            {
+                Unit& previous = units.back();
+                if (previous.key == unit.key && previous.hold == unit.hold &&
+                    unit.start - previous.end < options.burstGap)
+                {
+                    previous.value += unit.value;
+                    previous.end = std::max(previous.end, unit.end);
+                    continue;
+                }
+            }
+            units.push_back(unit);
+        }
+        if (units.empty())
+            return sequence;
+
+        // Every action is followed by the DELAY, and a SLEEP by another one, so a gap replays as
+        // either one DELAY or SLEEP plus two DELAYs. A MOVEMOUSE always replays one DELAY before
+        // its click, which is taken out of the gap leading up to the move.
+        const int quantum = static_cast<int>(std::max<std::int64_t>(options.quantum.count(), 1));
+        std::vector<int> gaps(units.size() - 1);
+        for (std::size_t i = 0; i + 1 < units.size(); ++i)
+            gaps[i] = std::max(0, quantize(units[i + 1].start - units[i].start) - units[i].totalHold());
+
+        auto targetGap = [&units, &gaps](std::size_t i, int delay)
+        { return gaps[i] - (units[i + 1].key == "MOVEMOUSE" ? delay : 0); };
+
+        // Returns the SLEEP which best represents a gap, or -1 if the DELAY alone is closest.
+        auto sleepFor = [quantum](int gap, int delay)
+        {
+            if (std::abs(gap - delay) <= quantum)
+                return -1;
+            if (gap >= 2 * delay)
+                return gap - 2 * delay;
+            return gap - delay < 2 * delay - gap ? -1 : 0;
+        };
+        auto replayedGap = [&sleepFor](int gap, int delay)
+        {
+            int sleep = sleepFor(gap, delay);
+            return sleep < 0 ? delay : sleep + 2 * delay;
+        };
+
+        sequence.delay = std::max(options.delay, 0);
+        if (options.delay < 0 && !gaps.empty())
+        {
+            // Gaps shorter than the DELAY, or between one and two DELAYs, can't be represented,
+            // so only consider DELAYs which replay every gap to within a quantum (a DELAY of 0
+            // always can, with a SLEEP per gap). Of those, prefer the fewest SLEEPs, then the
+            // smallest total error, then the longest DELAY.
+            int shortest = std::numeric_limits<int>::max();
+            for (std::size_t i = 0; i < gaps.size(); ++i)
+                if (units[i].key != "MOVEMOUSE")
+                    shortest = std::min(shortest, gaps[i]);
+            if (shortest == std::numeric_limits<int>::max())
+                shortest = 0;
+
+            std::tuple<std::size_t, long long, int> best{std::numeric_limits<std::size_t>::max(), 0, 0};
+            for (int delay = 0; delay <= shortest + quantum; delay += quantum)
+            {
+                std::size_t sleeps = 0;
+                long long totalError = 0;
+                bool fits = true;
+                for (std::size_t i = 0; i < gaps.size() && fits; ++i)
+                {
+                    if (units[i].key == "MOVEMOUSE")
+                        continue;
+                    int gap = targetGap(i, delay);
+                    int error = std::abs(replayedGap(gap, delay) - gap);
+                    fits = error <= quantum;
+                    totalError += error;
+                    sleeps += sleepFor(gap, delay) >= 0 ? 1 : 0;
+                }
+                std::tuple<std::size_t, long long, int> cost{sleeps, totalError, -delay};
+                if (fits && cost < best)
+                    best = cost;
+            }
+            sequence.delay = -std::get<2>(best);
+        }
+
+        for (std::size_t i = 0; i < units.size(); ++i)
+        {
+            const Unit& unit = units[i];
+            std::string value = unit.value;
+            if (unit.hold > 0)
+                value += ";" + std::to_string(unit.hold);
+            sequence.actions.push_back({unit.key, value});
+            sequence.times.push_back(unit.start - units.front().start);
+
+            if (i < gaps.size() && unit.key != "MOVEMOUSE")
+            {
+                int sleep = sleepFor(targetGap(i, sequence.delay), sequence.delay);
+                if (sleep >= 0)
+                    sequence.actions.push_back({"SLEEP", std::to_string(sleep)});
+            }
+        }
+        return sequence;
+    }
+
+
+    std::string MacroRecorder::toSequenceText(const RecordedSequence& sequence, const std::string& name,
+                                              char listenerKeyCode)
+    {
+        std::ostringstream out;
+        out << "SEQUENCENAME=" << name << "\n";
+        out << "DELAY=" << sequence.delay << "\n";
+        if (listenerKeyCode != '\0')
+            out << "LISTEN=" << listenerKeyCode << "\n";
+        for (const RecordedAction& action : sequence.actions)
+            out << action.key << "=" << action.value << "\n";
+        out << "ENDOFSEQUENCE\n";
+        return out.str();
+    }
+
+
+    SequenceProgram MacroRecorder::toProgram(const RecordedSequence& sequence)
+    {
+        SequenceProgram program;
+        program.setDelay(sequence.delay);
+        for (const RecordedAction& action : sequence.actions)
+            program.addAction(action.key, action.value);
+        return program;
+    }
+
+
+    std::vector<std::chrono::nanoseconds> MacroRecorder::measureReplay(const SequenceProgram& program)
+    {
+        TimingProbe probe;
+        timing::Timeline timeline;
+        program.execute(probe, timeline);
+
+        std::vector<std::chrono::nanoseconds> times;
+        for (const timing::Clock::time_point& time : probe.times)
+            times.push_back(time - probe.times.front());
+        return times;
+    }
+
+
+    ReplayReport MacroRecorder::compareTiming(const std::vector<std::chrono::nanoseconds>& recorded,
+                                              const std::vector<std::chrono::nanoseconds>& replayed)
+    {
+        ReplayReport report;
+        report.count = std::min(recorded.size(), replayed.size());
+        std::chrono::nanoseconds total(0);
+        for (std::size_t i = 0; i < report.count; ++i)
+        {
+            std::chrono::nanoseconds error = recorded[i] > replayed[i] ? recorded[i] - replayed[i]
+                                                                       : replayed[i] - recorded[i];
+            total += error;
+            report.maxError = std::max(report.maxError, error);
+        }
+        if (report.count > 0)
+            report.meanError = total / static_cast<std::int64_t>(report.count);
+        return report;
+    }
+} // namespace sequencer
@@ -0,0 +1,177 @@
+/**
+ * @file MacroRecorder.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Declares the MacroRecorder, which turns timestamped keyboard and mouse events into a
+ *     MIASequences sequence. Bursts of key presses are coalesced into TYPE actions, long
+ *     presses into TYPEHOLD/PRESSHOLD/CLICKHOLD actions, and the time between actions is
+ *     quantized and expressed with the sequence DELAY plus SLEEP actions where needed. The
+ *     result can be written as sequence text or compiled directly into a SequenceProgram,
+ *     and a replay report compares the recorded timing with the timing of a replay.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Used for the recorded event type.
+#include "InputBackend.hpp"
+// Used for the compiled form of a recording.
+#include "SequenceProgram.hpp"
+
+namespace sequencer
+{
+    /**
+     * @brief A keyboard or mouse event with the time it occurred.
+     */
+    struct RecordedEvent
+    {
+        std::chrono::nanoseconds time{0};   ///< The time of the event (any fixed origin).
+        virtual_keys::InputEvent event{};   ///< The event (its delay is ignored).
+    };
+
+    /**
+     * @brief Options which control how events are coalesced and timed.
+     */
+    struct RecordingOptions
+    {
+        /// Times are rounded to the nearest multiple of this.
+        std::chrono::milliseconds quantum{10};
+        /// Presses held at least this long become TYPEHOLD, PRESSHOLD or CLICKHOLD actions.
+        std::chrono::milliseconds holdThreshold{150};
+        /// Key presses starting closer together than this are merged into one action.
+        std::chrono::milliseconds burstGap{300};
+        /// The DELAY for the sequence in ms, or negative to choose one which replays every gap
+        /// between actions to within a quantum using the fewest SLEEP actions.
+        int delay{-1};
+    };
+
+    /**
+     * @brief A single action of a recorded sequence, as it appears in a sequences file.
+     */
+    struct RecordedAction
+    {
+        std::string key;                    ///< The action name (e.g., "TYPE").
+        std::string value;                  ///< The action value (e.g., "abc").
+    };
+
+    /**
+     * @brief The sequence built from a recording.
+     */
+    struct RecordedSequence
+    {
+        int delay{0};                                    ///< The DELAY between actions (ms).
+        std::vector<RecordedAction> actions;             ///< The actions, including SLEEPs.
+        std::vector<std::chrono::nanoseconds> times;     ///< When each non-SLEEP action was recorded, relative to the first.
+        std::size_t skippedEvents{0};                    ///< Events which have no sequence action (e.g., unknown keys).
+    };
+
+    /**
+     * @brief Compares recorded action times with the times of a replay.
+     */
+    struct ReplayReport
+    {
+        std::size_t count{0};                       ///< The number of actions compared.
+        std::chrono::nanoseconds meanError{0};      ///< The mean absolute difference.
+        std::chrono::nanoseconds maxError{0};       ///< The largest absolute difference.
+    };
+
+    /**
+     * @class MacroRecorder
+     * @brief Collects timestamped input events and converts them into a sequence.
+     *
+     * Events are expected in time order. Shift is tracked to record capital letters rather
+     * than being recorded itself. A press of a key which is already down (auto-repeat) is
+     * ignored. Mouse moves only set the position used by the next click.
+     */
+    class MacroRecorder
+    {
+    public:
+        /**
+         * @brief Constructs an empty recorder.
+         * @param options[const RecordingOptions&] - How to coalesce and time the events.
+         */
+        explicit MacroRecorder(const RecordingOptions& options = {}) : options(options) { }
+
+        /**
+         * @brief Adds an event to the recording.
+         * @param event[const RecordedEvent&] - The event.
+         */
+        void record(const RecordedEvent& event)
+        { events.push_back(event); }
+
+        /**
+         * @brief Returns the recorded events.
+         * @return [const std::vector<RecordedEvent>&] - The events in order.
+         */
+        const std::vector<RecordedEvent>& getEvents() const
+        { return events; }
+
+        /**
+         * @brief Removes the trailing events of a key, e.g., the hotkey used to stop recording.
+         * @param code[std::uint32_t] - The key identifier to remove from the end.
+         */
+        void trimTrailingKey(std::uint32_t code);
+
+        /**
+         * @brief Removes all recorded events.
+         */
+        void clear()
+        { events.clear(); }
+
+        /**
+         * @brief Coalesces and times the recorded events.
+         * @return [RecordedSequence] - The recorded sequence.
+         */
+        RecordedSequence build() const;
+
+        /**
+         * @brief Formats a recorded sequence in the MIASequences file format.
+         * @param sequence[const RecordedSequence&] - The sequence.
+         * @param name[const std::string&] - The SEQUENCENAME.
+         * @param listenerKeyCode[char] - The LISTEN key, or '\0' for none.
+         * @return [std::string] - The sequence text, ending with ENDOFSEQUENCE.
+         */
+        static std::string toSequenceText(const RecordedSequence& sequence, const std::string& name,
+                                          char listenerKeyCode = '\0');
+
+        /**
+         * @brief Compiles a recorded sequence.
+         * @param sequence[const RecordedSequence&] - The sequence.
+         * @return [SequenceProgram] - The compiled program.
+         * @throws MIAException(Invalid_Sequence_Option) - If an action cannot be compiled.
+         */
+        static SequenceProgram toProgram(const RecordedSequence& sequence);
+
+        /**
+         * @brief Replays a program against a clock without performing any input.
+         *
+         * The program runs on a fresh timeline, so waits and holds take their real time.
+         * @param program[const SequenceProgram&] - The program to replay.
+         * @return [std::vector<std::chrono::nanoseconds>] - When each non-SLEEP instruction ran, relative to the first.
+         */
+        static std::vector<std::chrono::nanoseconds> measureReplay(const SequenceProgram& program);
+
+        /**
+         * @brief Compares recorded and replayed action times, pairing them in order.
+         * @param recorded[const std::vector<std::chrono::nanoseconds>&] - The recorded times.
+         * @param replayed[const std::vector<std::chrono::nanoseconds>&] - The replayed times.
+         * @return [ReplayReport] - The timing differences.
+         */
+        static ReplayReport compareTiming(const std::vector<std::chrono::nanoseconds>& recorded,
+                                          const std::vector<std::chrono::nanoseconds>& replayed);
+
+    private:
+        /// Rounds a duration to the nearest multiple of the quantum, in ms.
+        int quantize(std::chrono::nanoseconds duration) const;
+
+        /// How to coalesce and time the events.
+        RecordingOptions options;
+
+        /// The recorded events in order.
+        std::vector<RecordedEvent> events;
+    }; // class MacroRecorder
+} // namespace sequencer
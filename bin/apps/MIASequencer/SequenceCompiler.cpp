@@ -0,0 +1,334 @@
+/**
+ * @file SequenceCompiler.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the MIASequences compiler and the binary sequence cache.
+ */
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+// The associated header file.
+#include "SequenceCompiler.hpp"
+// Used for hashing the sequence text.
+#include "ConfigCache.hpp"
+// Used for the compile errors thrown by SequenceProgram.
+#include "MIAException.hpp"
+// Used to write the cache file atomically.
+#include "BasicUtilities.hpp"
+
+using config::config_parser::stripView;
+
+namespace
+{
+    /// The magic bytes at the start of every sequence cache file.
+    constexpr char MAGIC[8] = {'M', 'I', 'A', 'S', 'E', 'Q', '\0', '\0'};
+
+    /**
+     * @brief Compiles the lines of one sequence (ending with ENDOFSEQUENCE).
+     * @param block[const std::vector<const config::ConfigLine*>&] - The lines of the sequence.
+     * @param sequence[sequencer::CompiledSequence&] - Receives the compiled sequence.
+     * @param errors[std::vector<sequencer::CompileError>&] - Any errors are appended here.
+     * @return [bool] - True if the sequence compiled without errors.
+     */
+    bool compileBlock(const std::vector<const config::ConfigLine*>& block,
+                      sequencer::CompiledSequence& sequence,
+                      std::vector<sequencer::CompileError>& errors)
+    {
+        std::size_t errorCount = errors.size();
+        for (const config::ConfigLine* line : block)
+        {
+            std::size_t equalSign = line->text.find('=');
+            std::string_view key = stripView(line->text.substr(0, equalSign));
+            std::string_view value = equalSign == std::string_view::npos ? std::string_view()
+                                                                          : line->text.substr(equalSign + 1);
+
+            if (key == "SEQUENCENAME")
+            {
+                sequence.name = std::string(stripView(value));
+            }
+            else if (key == "DELAY")
+            {
+                std::string_view number = stripView(value);
+                int delay = 0;
+                auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), delay);
+                if (number.empty() || ec != std::errc() || ptr != number.data() + number.size() || delay < 0)
+                    errors.push_back({line->lineNumber, "Invalid DELAY '" + std::string(value) + "': expected a non-negative time in ms"});
+                else
+                    sequence.program.setDelay(delay);
+            }
+            else if (key == "PRIORITY")
+            {
+                std::string_view number = stripView(value);
+                int priority = 0;
+                auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), priority);
+                if (number.empty() || ec != std::errc() || ptr != number.data() + number.size())
+                    errors.push_back({line->lineNumber, "Invalid PRIORITY '" + std::string(value) + "': expected an integer"});
+                else
+                    sequence.priority = priority;
+            }
+            else if (key == "LISTEN")
+            {
+                std::string_view listenKey = stripView(value);
+                if (listenKey.size() != 1)
+                    errors.push_back({line->lineNumber, "Invalid LISTEN '" + std::string(value) + "': expected a single key"});
+                else
+                    sequence.listenerKeyCode = listenKey[0];
+            }
+            else if (key == "ENDOFSEQUENCE")
+            {
+                if (sequence.name.empty())
+                    errors.push_back({line->lineNumber, "Sequence has no SEQUENCENAME"});
+                else if (sequence.program.empty() && errors.size() == errorCount)
+                    errors.push_back({line->lineNumber, "Sequence '" + sequence.name + "' has no actions"});
+            }
+            else
+            {
+                try
+                {
+                    sequence.program.addAction(key, value);
+                }
+                catch (const error::MIAException& ex)
+                {
+                    errors.push_back({line->lineNumber, ex.getDetails()});
+                }
+            }
+        }
+        return errors.size() == errorCount;
+    }
+
+    /**
+     * @brief Appends the raw bytes of a value to a buffer.
+     * @param out[std::string&] - The buffer.
+     * @param value[const T&] - The trivially copyable value.
+     */
+    template<typename T>
+    void appendBytes(std::string& out, const T& value)
+    { out.append(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+    /**
+     * @brief Reads values from a byte range, failing (rather than overrunning) at its end.
+     */
+    class ByteReader
+    {
+    public:
+        explicit ByteReader(std::string_view bytes) : bytes(bytes) { }
+
+        /// Copies the next sizeof(T) bytes into value; returns false if there are too few bytes.
+        template<typename T>
+        bool read(T& value)
+        {
+            if (bytes.size() < sizeof(T))
+                return false;
+            std::memcpy(&value, bytes.data(), sizeof(T));
+            bytes.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        /// Returns a view of the next length bytes; returns false if there are too few bytes.
+        bool readView(std::size_t length, std::string_view& view)
+        {
+            if (bytes.size() < length)
+                return false;
+            view = bytes.substr(0, length);
+            bytes.remove_prefix(length);
+            return true;
+        }
+
+        /// Returns the number of bytes not yet read.
+        std::size_t remaining() const
+        { return bytes.size(); }
+
+    private:
+        std::string_view bytes;
+    };
+
+    /// The fixed-size part of each cached sequence record.
+    struct SequenceRecord
+    {
+        std::uint64_t sourceHash;
+        std::int32_t delay;
+        std::uint32_t listenerKeyCode;
+        std::uint32_t nameLength;
+        std::uint32_t instructionCount;
+        std::uint32_t stringCount;
+        std::int32_t priority;
+    };
+
+    /**
+     * @brief Reads the compiled sequences from the contents of a cache file.
+     * @param bytes[std::string_view] - The cache file contents.
+     * @param sequences[std::vector<sequencer::CompiledSequence>&] - The cached sequences are appended here.
+     * @return [bool] - True if the contents are a complete, valid cache.
+     */
+    bool parseCache(std::string_view bytes, std::vector<sequencer::CompiledSequence>& sequences)
+    {
+        using sequencer::Instruction;
+
+        ByteReader reader(bytes);
+        char magic[sizeof(MAGIC)];
+        std::uint32_t version = 0;
+        std::uint32_t count = 0;
+        if (!reader.read(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            !reader.read(version) || version != sequencer::sequence_cache::FORMAT_VERSION || 
+            !reader.read(count))
+            return false;
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            SequenceRecord record;
+            std::string_view name;
+            if (!reader.read(record) || !reader.readView(record.nameLength, name) ||
+                std::uint64_t(record.instructionCount) * sizeof(Instruction) > reader.remaining())
+                return false;
+
+            sequencer::CompiledSequence sequence;
+            sequence.name = std::string(name);
+            sequence.listenerKeyCode = static_cast<char>(record.listenerKeyCode);
+            sequence.sourceHash = record.sourceHash;
+            sequence.priority = record.priority;
+            sequence.program.setDelay(record.delay);
+
+            std::vector<Instruction> code(record.instructionCount);
+            for (Instruction& instruction : code)
+                reader.read(instruction);
+
+            for (std::uint32_t s = 0; s < record.stringCount; ++s)
+            {
+                std::uint32_t length = 0;
+                std::string_view text;
+                if (!reader.read(length) || !reader.readView(length, text))
+                    return false;
+                sequence.program.internString(text);
+            }
+
+            // Reject anything the interpreter could not run safely.
+            for (const Instruction& instruction : code)
+            {
+                if (!sequence.program.isValidInstruction(instruction))
+                    return false;
+                sequence.program.addInstruction(instruction);
+            }
+            sequences.push_back(std::move(sequence));
+        }
+        return reader.remaining() == 0;
+    }
+} // anonymous namespace
+
+
+namespace sequencer
+{
+    CompileResult compileSequences(const std::vector<config::ConfigLine>& lines,
+                                   const std::vector<CompiledSequence>& previous)
+    {
+        CompileResult result;
+
+        std::unordered_map<std::uint64_t, const CompiledSequence*> previousByHash;
+        for (const CompiledSequence& sequence : previous)
+            previousByHash.emplace(sequence.sourceHash, &sequence);
+
+        std::unordered_set<std::string> names;
+        std::vector<const config::ConfigLine*> block;
+        std::string blockText;
+        for (const config::ConfigLine& line : lines)
+        {
+            block.push_back(&line);
+            blockText.append(line.text).push_back('\n');
+
+            std::string_view key = stripView(line.text.substr(0, line.text.find('=')));
+            if (key != "ENDOFSEQUENCE")
+                continue;
+
+            CompiledSequence sequence;
+            sequence.sourceHash = config::config_cache::hashBytes(blockText);
+            auto cached = previousByHash.find(sequence.sourceHash);
+            bool valid = true;
+            if (cached != previousByHash.end())
+            {
+                sequence = *cached->second;
+                ++result.reusedCount;
+            }
+            else
+            {
+                valid = compileBlock(block, sequence, result.errors);
+                ++result.compiledCount;
+            }
+
+            if (valid && !names.insert(sequence.name).second)
+            {
+                result.errors.push_back({line.lineNumber, "Duplicate sequence name '" + sequence.name + "'"});
+                valid = false;
+            }
+            if (valid)
+                result.sequences.push_back(std::move(sequence));
+
+            block.clear();
+            blockText.clear();
+        }
+
+        if (!block.empty())
+            result.errors.push_back({block.front()->lineNumber, "Sequence is missing ENDOFSEQUENCE"});
+
+        return result;
+    }
+
+
+    namespace sequence_cache
+    {
+        std::string getCachePath(const std::string& sequencesFilePath)
+        {
+            return sequencesFilePath + ".seq.cache";
+        }
+
+
+        bool readCache(const std::string& cachePath, std::vector<CompiledSequence>& sequences)
+        {
+            sequences.clear();
+            config::ConfigFileBuffer buffer;
+            if (!buffer.map(cachePath) || !parseCache(buffer.view(), sequences))
+            {
+                sequences.clear();
+                return false;
+            }
+            return true;
+        }
+
+
+        bool writeCache(const std::string& cachePath, const std::vector<CompiledSequence>& sequences)
+        {
+            std::string bytes;
+            bytes.append(MAGIC, sizeof(MAGIC));
+            appendBytes(bytes, FORMAT_VERSION);
+            appendBytes(bytes, static_cast<std::uint32_t>(sequences.size()));
+            for (const CompiledSequence& sequence : sequences)
+            {
+                const std::vector<Instruction>& code = sequence.program.getCode();
+                const std::vector<std::string>& strings = sequence.program.getStrings();
+                SequenceRecord record{};
+                record.sourceHash = sequence.sourceHash;
+                record.delay = sequence.program.getDelay();
+                record.listenerKeyCode = static_cast<unsigned char>(sequence.listenerKeyCode);
+                record.nameLength = static_cast<std::uint32_t>(sequence.name.size());
+                record.instructionCount = static_cast<std::uint32_t>(code.size());
+                record.stringCount = static_cast<std::uint32_t>(strings.size());
+                record.priority = sequence.priority;
+                appendBytes(bytes, record);
+                bytes.append(sequence.name);
+                bytes.append(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(Instruction));
+                for (const std::string& text : strings)
+                {
+                    appendBytes(bytes, static_cast<std::uint32_t>(text.size()));
+                    bytes.append(text);
+                }
+            }
+
+            return BasicUtilities::replaceFile(cachePath, [&bytes](std::ofstream& out)
+            {
+                out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            });
+        }
+    } // namespace sequence_cache
+} // namespace sequencer
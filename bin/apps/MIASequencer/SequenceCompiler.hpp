@@ -0,0 +1,103 @@
+/**
+ * @file SequenceCompiler.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Declares the ahead-of-time compiler for MIASequences files and the binary sequence
+ *     cache. The compiler validates every sequence in a file, reporting all errors with
+ *     their line numbers, and only recompiles the sequences whose text changed since the
+ *     cached compilation.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Used for the compiled actions.
+#include "SequenceProgram.hpp"
+// Used for the configuration file lines.
+#include "ConfigParser.hpp"
+
+namespace sequencer
+{
+    /**
+     * @brief A successfully compiled sequence.
+     */
+    struct CompiledSequence
+    {
+        std::string name{};          ///< The name of the sequence.
+        char listenerKeyCode{'\0'};  ///< The LISTEN key, or '\0' if none.
+        int priority{0};             ///< The PRIORITY for input arbitration (higher goes first).
+        SequenceProgram program{};   ///< The compiled actions and delay.
+        std::uint64_t sourceHash{0}; ///< A hash of the sequence text, used to detect changes.
+    };
+
+    /**
+     * @brief An error found while compiling a sequences file.
+     */
+    struct CompileError
+    {
+        std::size_t lineNumber{0};   ///< The 1-based line number of the error.
+        std::string message{};       ///< A description of the error.
+    };
+
+    /**
+     * @brief The outcome of compiling a sequences file.
+     */
+    struct CompileResult
+    {
+        std::vector<CompiledSequence> sequences; ///< The valid sequences in file order.
+        std::vector<CompileError> errors;        ///< Every error found, in file order.
+        std::size_t compiledCount{0};            ///< The number of sequences compiled from text.
+        std::size_t reusedCount{0};              ///< The number of sequences reused unchanged.
+    };
+
+    /**
+     * @brief Compiles every sequence in a sequences file.
+     *
+     * A sequence is the block of lines ending with ENDOFSEQUENCE. Sequences with any error
+     * are left out of the result, and compilation continues with the next sequence so that
+     * all errors are reported. A sequence whose text exactly matches one in previous is
+     * reused without being compiled again.
+     *
+     * @param lines[const std::vector<config::ConfigLine>&] - The content lines of the file (see MIAConfig::getLines()).
+     * @param previous[const std::vector<CompiledSequence>&] - Previously compiled sequences (e.g., from the cache).
+     * @return [CompileResult] - The valid sequences and all errors.
+     */
+    CompileResult compileSequences(const std::vector<config::ConfigLine>& lines,
+                                   const std::vector<CompiledSequence>& previous = {});
+
+    /**
+     * @namespace sequence_cache
+     * @brief Reads and writes compiled sequences in a versioned binary file.
+     */
+    namespace sequence_cache
+    {
+        /// The version of the binary format. Increment whenever the layout or Instruction changes.
+        constexpr std::uint32_t FORMAT_VERSION = 2;
+
+        /**
+         * @brief Returns the cache file path for a sequences file ("<file>.seq.cache").
+         * @param sequencesFilePath[const std::string&] - The sequences file path.
+         * @return [std::string] - The cache file path.
+         */
+        std::string getCachePath(const std::string& sequencesFilePath);
+
+        /**
+         * @brief Maps a cache file and reads the compiled sequences from it.
+         * @param cachePath[const std::string&] - The cache file path.
+         * @param sequences[std::vector<CompiledSequence>&] - Cleared and filled with the cached sequences.
+         * @return [bool] - True if the cache existed and was valid; false otherwise (sequences is left empty).
+         */
+        bool readCache(const std::string& cachePath, std::vector<CompiledSequence>& sequences);
+
+        /**
+         * @brief Writes compiled sequences to a cache file, replacing it atomically.
+         * @param cachePath[const std::string&] - The cache file path.
+         * @param sequences[const std::vector<CompiledSequence>&] - The sequences to write.
+         * @return [bool] - True if the cache was written.
+         */
+        bool writeCache(const std::string& cachePath, const std::vector<CompiledSequence>& sequences);
+    } // namespace sequence_cache
+} // namespace sequencer
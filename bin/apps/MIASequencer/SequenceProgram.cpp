@@ -0,0 +1,248 @@
+/**
+ * @file SequenceProgram.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements compiling sequence actions into a SequenceProgram.
+ */
+
+#include <charconv>
+
+// The associated header file.
+#include "SequenceProgram.hpp"
+// Used for exception throws.
+#include "MIAException.hpp"
+// Used for trimming action names and values.
+#include "ConfigParser.hpp"
+
+using virtual_keys::VirtualKeyStrokes;
+using config::config_parser::stripView;
+
+namespace
+{
+    /**
+     * @brief Throws the standard invalid action error.
+     * @param key[std::string_view] - The action name.
+     * @param value[std::string_view] - The action value.
+     * @param reason[const char*] - Why the action is invalid.
+     */
+    [[noreturn]] void throwInvalidAction(std::string_view key, std::string_view value, const char* reason)
+    {
+        std::string err = "Invalid sequence action '" + std::string(key) + "=" + std::string(value)
+                        + "': " + reason;
+        throw error::MIAException(error::ErrorCode::Invalid_Sequence_Option, err);
+    }
+
+    /**
+     * @brief Parses a whole (trimmed) field as an integer.
+     * @param text[std::string_view] - The text to parse.
+     * @param out[std::int32_t&] - Receives the value on success.
+     * @return [bool] - True if the field was a valid integer.
+     */
+    bool parseInt(std::string_view text, std::int32_t& out)
+    {
+        text = stripView(text);
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return !text.empty() && ec == std::errc() && ptr == text.data() + text.size();
+    }
+
+    /**
+     * @brief Splits "first<delimiter>second" into its trimmed halves.
+     * @param text[std::string_view] - The text to split.
+     * @param delimiter[char] - The delimiter.
+     * @param first[std::string_view&] - Receives the text before the delimiter.
+     * @param second[std::string_view&] - Receives the text after the delimiter.
+     * @return [bool] - True if the delimiter was present.
+     */
+    bool splitPair(std::string_view text, char delimiter, std::string_view& first, std::string_view& second)
+    {
+        std::size_t pos = text.find(delimiter);
+        if (pos == std::string_view::npos)
+            return false;
+        first = stripView(text.substr(0, pos));
+        second = stripView(text.substr(pos + 1));
+        return true;
+    }
+} // anonymous namespace
+
+
+namespace sequencer
+{
+    std::int32_t SequenceProgram::internString(std::string_view text)
+    {
+        auto [it, inserted] = stringIndex.try_emplace(std::string(text), static_cast<std::int32_t>(strings.size()));
+        if (inserted)
+            strings.emplace_back(text);
+        return it->second;
+    }
+
+
+    void SequenceProgram::addAction(std::string_view key, std::string_view value)
+    {
+        Instruction instruction;
+        key = stripView(key);
+        std::string_view first, second;
+
+        if (key == "TYPE" || key == "TYPEHOLD")
+        {
+            std::string_view text = value;
+            if (key == "TYPEHOLD")
+            {
+                if (!splitPair(value, ';', text, second) || !parseInt(second, instruction.hold) || instruction.hold <= 0)
+                    throwInvalidAction(key, value, "expected <text>;<hold ms> with a positive hold time");
+            }
+            if (text.empty())
+                throwInvalidAction(key, value, "nothing to type");
+            for (char ch : text)
+                if (!VirtualKeyStrokes::canPress(ch))
+                    throwInvalidAction(key, value, "contains a character which cannot be typed");
+            instruction.op = OpCode::TYPE;
+            instruction.a = internString(text);
+        }
+        else if (key == "SLEEP")
+        {
+            instruction.op = OpCode::SLEEP;
+            if (!parseInt(value, instruction.a) || instruction.a < 0)
+                throwInvalidAction(key, value, "expected a non-negative time in ms");
+        }
+        else if (key == "MOVEMOUSE")
+        {
+            instruction.op = OpCode::MOVE_MOUSE;
+            if (!splitPair(value, ',', first, second) || !parseInt(first, instruction.a) || !parseInt(second, instruction.b))
+                throwInvalidAction(key, value, "expected <x>,<y>");
+        }
+        else if (key == "CLICK" || key == "CLICKHOLD")
+        {
+            first = stripView(value);
+            if (key == "CLICKHOLD" &&
+                (!splitPair(value, ';', first, second) || !parseInt(second, instruction.hold) || instruction.hold <= 0))
+                throwInvalidAction(key, value, "expected <click>;<hold ms> with a positive hold time");
+            auto click = VirtualKeyStrokes::stringToClickType(std::string(first));
+            if (click == VirtualKeyStrokes::ClickType::UNKNOWN)
+                throwInvalidAction(key, value, "unknown click type");
+            instruction.op = OpCode::CLICK;
+            instruction.kind = static_cast<std::uint8_t>(click);
+        }
+        else if (key == "PRESS" || key == "PRESSHOLD")
+        {
+            first = stripView(value);
+            if (key == "PRESSHOLD" &&
+                (!splitPair(value, ';', first, second) || !parseInt(second, instruction.hold) || instruction.hold <= 0))
+                throwInvalidAction(key, value, "expected <button>;<hold ms> with a positive hold time");
+            auto button = VirtualKeyStrokes::stringToSpecialButton(std::string(first));
+            if (button == VirtualKeyStrokes::SpecialButton::UNKNOWN)
+                throwInvalidAction(key, value, "unknown special button");
+            instruction.op = OpCode::PRESS_BUTTON;
+            instruction.kind = static_cast<std::uint8_t>(button);
+        }
+        else if (key == "PRESSRANDNUM")
+        {
+            instruction.op = OpCode::PRESS_RANDOM_NUMBER;
+            if (!splitPair(value, ';', first, second) || !parseInt(first, instruction.a) || !parseInt(second, instruction.b) ||
+                instruction.a < 0 || instruction.b > 9 || instruction.a > instruction.b)
+                throwInvalidAction(key, value, "expected <min>;<max> with 0 <= min <= max <= 9");
+        }
+        else
+        {
+            throwInvalidAction(key, value, "unknown action");
+        }
+
+        code.push_back(instruction);
+    }
+
+
+    bool SequenceProgram::isValidInstruction(const Instruction& instruction) const
+    {
+        if (instruction.hold < 0)
+            return false;
+
+        switch (instruction.op)
+        {
+            case OpCode::TYPE:
+            {
+                if (instruction.a < 0 || static_cast<std::size_t>(instruction.a) >= strings.size())
+                    return false;
+                const std::string& text = strings[instruction.a];
+                if (text.empty())
+                    return false;
+                for (char ch : text)
+                    if (!VirtualKeyStrokes::canPress(ch))
+                        return false;
+                return true;
+            }
+            case OpCode::SLEEP:
+                return instruction.a >= 0;
+            case OpCode::MOVE_MOUSE:
+                return true;
+            case OpCode::CLICK:
+            {
+                // Round trip through the name so out of range values are rejected as UNKNOWN.
+                auto click = static_cast<VirtualKeyStrokes::ClickType>(instruction.kind);
+                return click != VirtualKeyStrokes::ClickType::UNKNOWN &&
+                       VirtualKeyStrokes::stringToClickType(VirtualKeyStrokes::clickTypeToString(click)) == click;
+            }
+            case OpCode::PRESS_BUTTON:
+            {
+                auto button = static_cast<VirtualKeyStrokes::SpecialButton>(instruction.kind);
+                return button != VirtualKeyStrokes::SpecialButton::UNKNOWN &&
+                       VirtualKeyStrokes::stringToSpecialButton(VirtualKeyStrokes::specialButtonToString(button)) == button;
+            }
+            case OpCode::PRESS_RANDOM_NUMBER:
+                // Also guards std::uniform_int_distribution in execute(), which requires a <= b.
+                return instruction.a >= 0 && instruction.a <= instruction.b && instruction.b <= 9;
+        }
+        return false;
+    }
+
+
+    void SequenceProgram::clear()
+    {
+        code.clear();
+        strings.clear();
+        stringIndex.clear();
+        delayTime = 1000;
+    }
+
+
+    void SequenceProgram::dump(std::ostream& out, const Instruction& instruction) const
+    {
+        switch (instruction.op)
+        {
+            case OpCode::TYPE:
+                out << "TYPE:" << strings[instruction.a];
+                break;
+            case OpCode::SLEEP:
+                out << "SLEEP:" << instruction.a << "ms";
+                break;
+            case OpCode::MOVE_MOUSE:
+                out << "MOVEMOUSE:" << instruction.a << "," << instruction.b;
+                break;
+            case OpCode::CLICK:
+                out << "CLICK:" << VirtualKeyStrokes::clickTypeToString(
+                    static_cast<VirtualKeyStrokes::ClickType>(instruction.kind));
+                break;
+            case OpCode::PRESS_BUTTON:
+                out << "PRESS:" << VirtualKeyStrokes::specialButtonToString(
+                    static_cast<VirtualKeyStrokes::SpecialButton>(instruction.kind));
+                break;
+            case OpCode::PRESS_RANDOM_NUMBER:
+                out << "PRESSRANDNUM:" << instruction.a << ";" << instruction.b;
+                break;
+            default:
+                out << "UNKNOWN";
+                break;
+        }
+        if (instruction.hold > 0)
+            out << ";HOLD:" << instruction.hold << "ms";
+    }
+
+
+    void SequenceProgram::dump(std::ostream& out) const
+    {
+        for (std::size_t i = 0; i < code.size(); ++i)
+        {
+            if (i > 0)
+                out << ", ";
+            dump(out, code[i]);
+        }
+    }
+} // namespace sequencer
@@ -0,0 +1,239 @@
+/**
+ * @file SequenceProgram.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Defines the SequenceProgram class, the compiled form of a MIASequencer sequence. Each
+ *     action line is parsed and validated once at load time into a fixed-size instruction,
+ *     with strings interned into a pool and button names resolved to their enum values, so
+ *     running a sequence involves no parsing, string building or allocation.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <random>
+#include <chrono>
+
+// Used for the click and special button types.
+#include "VirtualKeyStrokes.hpp"
+// Used for drift-free scheduling of waits.
+#include "Timing.hpp"
+
+namespace sequencer
+{
+    /**
+     * @brief The operations a compiled sequence instruction can perform.
+     */
+    enum class OpCode : std::uint8_t
+    {
+        TYPE,                ///< Type the pooled string a, holding each key for hold ms.
+        SLEEP,               ///< Wait for a ms.
+        MOVE_MOUSE,          ///< Move the mouse to (a, b).
+        CLICK,               ///< Click the ClickType in kind, holding it for hold ms.
+        PRESS_BUTTON,        ///< Press the SpecialButton in kind, holding it for hold ms.
+        PRESS_RANDOM_NUMBER  ///< Press a random number key in [a, b], holding it for hold ms.
+    };
+
+    /**
+     * @brief A single compiled action. The meaning of the operands depends on the op code.
+     */
+    struct Instruction
+    {
+        OpCode op{OpCode::SLEEP};    ///< The operation to perform.
+        std::uint8_t kind{0};        ///< The ClickType or SpecialButton value.
+        std::uint16_t reserved{0};   ///< Unused; keeps the operands aligned.
+        std::int32_t a{0};           ///< First operand (string index, time, x or range minimum).
+        std::int32_t b{0};           ///< Second operand (y or range maximum).
+        std::int32_t hold{0};        ///< The time (ms) to hold a key, button or click.
+    };
+    static_assert(sizeof(Instruction) == 16, "Instructions are expected to be 16 bytes.");
+
+    /**
+     * @class SequenceProgram
+     * @brief A compiled sequence: a flat instruction list, a string pool and the action delay.
+     *
+     * Programs are built with addAction(), one config line at a time, and run with execute().
+     */
+    class SequenceProgram
+    {
+    public:
+        /**
+         * @brief Constructs an empty program with the default delay.
+         */
+        SequenceProgram() = default;
+
+        /**
+         * @brief Compiles a sequence action (e.g., "TYPEHOLD", "w;1000") and appends it.
+         * @param key[std::string_view] - The action name.
+         * @param value[std::string_view] - The action value.
+         * @throws MIAException(Invalid_Sequence_Option) - If the action is unknown or its value is invalid.
+         */
+        void addAction(std::string_view key, std::string_view value);
+
+        /**
+         * @brief Appends an already compiled instruction.
+         * @param instruction[const Instruction&] - The instruction to append.
+         */
+        void addInstruction(const Instruction& instruction)
+        { code.push_back(instruction); }
+
+        /**
+         * @brief Checks that an instruction's operands are ones addAction() could have produced
+         *     for this program. Used to validate instructions from the sequence cache, which is
+         *     read from disk, before they can reach execute().
+         * @param instruction[const Instruction&] - The instruction to check.
+         * @return [bool] - True if the instruction can be run safely.
+         */
+        bool isValidInstruction(const Instruction& instruction) const;
+
+        /**
+         * @brief Adds a string to the pool unless an equal string is already pooled.
+         * @param text[std::string_view] - The string to intern.
+         * @return [std::int32_t] - The index of the string in the pool.
+         */
+        std::int32_t internString(std::string_view text);
+
+        /**
+         * @brief Sets the time to wait after each action.
+         * @param delay[int] - The delay in ms.
+         */
+        void setDelay(int delay)
+        { delayTime = delay; }
+
+        /**
+         * @brief Returns the time to wait after each action.
+         * @return [int] - The delay in ms.
+         */
+        int getDelay() const
+        { return delayTime; }
+
+        /**
+         * @brief Returns the compiled instructions.
+         * @return [const std::vector<Instruction>&] - The instructions in execution order.
+         */
+        const std::vector<Instruction>& getCode() const
+        { return code; }
+
+        /**
+         * @brief Returns the string pool.
+         * @return [const std::vector<std::string>&] - The pooled strings.
+         */
+        const std::vector<std::string>& getStrings() const
+        { return strings; }
+
+        /**
+         * @brief Returns whether the program has no instructions.
+         * @return [bool] - True if there are no instructions.
+         */
+        bool empty() const
+        { return code.empty(); }
+
+        /**
+         * @brief Removes all instructions and strings and restores the default delay.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the time an instruction itself spends holding keys, buttons or clicks.
+         * @param instruction[const Instruction&] - The instruction.
+         * @return [int] - The total hold time in ms.
+         */
+        int getHoldTime(const Instruction& instruction) const
+        {
+            if (instruction.op == OpCode::TYPE)
+                return instruction.hold * static_cast<int>(strings[instruction.a].size());
+            return instruction.hold;
+        }
+
+        /**
+         * @brief Writes a human-readable form of an instruction (e.g., "SLEEP:500ms").
+         * @param out[std::ostream&] - The output stream.
+         * @param instruction[const Instruction&] - The instruction.
+         */
+        void dump(std::ostream& out, const Instruction& instruction) const;
+
+        /**
+         * @brief Writes all instructions, separated by ", ".
+         * @param out[std::ostream&] - The output stream.
+         */
+        void dump(std::ostream& out) const;
+
+        /**
+         * @brief Runs the program once.
+         *
+         * Each instruction is performed on the key stroke target, then the program waits for
+         * the delay. Waits and hold times are scheduled on the timeline, so the time taken by
+         * the actions themselves does not add drift. The timeline is resynchronized to the
+         * current time first, so an idle timeline does not skip the leading waits.
+         *
+         * @param keys[Keys&] - The target which simulates input (normally VirtualKeyStrokes).
+         * @param timeline[timing::Timeline&] - The timeline to schedule waits on.
+         * @param verboseMode[bool] - If true, enables verbose output.
+         */
+        template<typename Keys>
+        void execute(Keys& keys, timing::Timeline& timeline, bool verboseMode = false) const;
+
+    private:
+        /// The instructions in execution order.
+        std::vector<Instruction> code;
+
+        /// The pooled strings referenced by TYPE instructions.
+        std::vector<std::string> strings;
+
+        /// Maps pooled strings to their index, used to deduplicate while compiling.
+        std::unordered_map<std::string, std::int32_t> stringIndex;
+
+        /// The time between each action (ms).
+        int delayTime{1000};
+    }; // class SequenceProgram
+
+
+    template<typename Keys>
+    void SequenceProgram::execute(Keys& keys, timing::Timeline& timeline, bool verboseMode) const
+    {
+        using virtual_keys::VirtualKeyStrokes;
+        static thread_local std::minstd_rand randomEngine{std::random_device{}()};
+
+        const std::chrono::milliseconds delay(delayTime);
+        timeline.resync();
+        for (const Instruction& instruction : code)
+        {
+            switch (instruction.op)
+            {
+                case OpCode::TYPE:
+                    keys.type(strings[instruction.a], instruction.hold, verboseMode);
+                    break;
+                case OpCode::SLEEP:
+                    timeline.waitFor(std::chrono::milliseconds(instruction.a));
+                    break;
+                case OpCode::MOVE_MOUSE:
+                    keys.moveMouseTo(instruction.a, instruction.b);
+                    break;
+                case OpCode::CLICK:
+                    keys.mouseClick(static_cast<VirtualKeyStrokes::ClickType>(instruction.kind),
+                                    instruction.hold, verboseMode);
+                    break;
+                case OpCode::PRESS_BUTTON:
+                    keys.pressSpecialButton(static_cast<VirtualKeyStrokes::SpecialButton>(instruction.kind),
+                                            instruction.hold, verboseMode);
+                    break;
+                case OpCode::PRESS_RANDOM_NUMBER:
+                {
+                    std::uniform_int_distribution<int> range(instruction.a, instruction.b);
+                    keys.pressNumber(range(randomEngine), instruction.hold, verboseMode);
+                    break;
+                }
+            }
+
+            // Holds already slept for their hold time, so account for it on the timeline
+            // rather than adding it again to the following delay.
+            timeline.advance(std::chrono::milliseconds(getHoldTime(instruction)));
+            timeline.waitFor(delay);
+        }
+    }
+} // namespace sequencer
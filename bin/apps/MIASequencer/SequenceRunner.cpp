@@ -0,0 +1,40 @@
+/**
+ * @file SequenceRunner.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the InputArbiter used by concurrently running sequences.
+ */
+
+// The associated header file.
+#include "SequenceRunner.hpp"
+
+namespace sequencer
+{
+    InputArbiter::Lease InputArbiter::acquire(int priority)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!busy && waiting.empty())
+        {
+            busy = true;
+            return Lease(*this);
+        }
+
+        ++contendedCount;
+        const std::pair<int, std::uint64_t> request(-priority, nextTicket++);
+        waiting.insert(request);
+        released.wait(lock, [this, &request] { return !busy && *waiting.begin() == request; });
+        waiting.erase(waiting.begin());
+        busy = true;
+        return Lease(*this);
+    }
+
+
+    void InputArbiter::release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+        }
+        released.notify_all();
+    }
+} // namespace sequencer
@@ -0,0 +1,303 @@
+/**
+ * @file SequenceRunner.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Defines the classes used to run several sequences concurrently. Each SequenceRunner
+ *     runs one compiled sequence on its own thread and its own drift-free timeline, while an
+ *     InputArbiter serializes the actual key and mouse emissions between them by priority.
+ *     Sequences only hold the input device while emitting, never while waiting, so one
+ *     sequence's delays do not hold up another's input.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// Used for running each sequence on its own thread.
+#include "BackgroundTask.hpp"
+// Used for the compiled sequence actions.
+#include "SequenceProgram.hpp"
+// Used for drift-free scheduling of sequence waits.
+#include "Timing.hpp"
+
+namespace sequencer
+{
+    /**
+     * @class InputArbiter
+     * @brief Serializes access to the input device between concurrently running sequences.
+     *
+     * Only one lease may be held at a time. When the device is released, the waiting request
+     * with the highest priority is granted next, and requests of equal priority are granted
+     * in the order they were made.
+     */
+    class InputArbiter
+    {
+    public:
+        /**
+         * @brief Grants the input device for the lifetime of the lease.
+         */
+        class Lease
+        {
+        public:
+            /// Releases the input device.
+            ~Lease()
+            { arbiter.release(); }
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+        private:
+            friend class InputArbiter;
+            explicit Lease(InputArbiter& owner) : arbiter(owner) { }
+            InputArbiter& arbiter;
+        };
+
+        /**
+         * @brief Blocks until the input device is granted to the caller.
+         * @param priority[int] - The priority of the request (higher is granted first).
+         * @return [Lease] - Holds the device until destroyed.
+         */
+        [[nodiscard]] Lease acquire(int priority);
+
+        /**
+         * @brief Returns the number of requests which had to wait for another sequence.
+         * @return [std::uint64_t] - The number of contended requests.
+         */
+        std::uint64_t getContendedCount() const
+        { return contendedCount.load(); }
+
+    private:
+        /// Releases the device and wakes the waiting requests.
+        void release();
+
+        /// Guards busy and waiting.
+        std::mutex mutex;
+        /// Signals waiting requests when the device is released.
+        std::condition_variable released;
+        /// True while a lease is held.
+        bool busy{false};
+        /// The waiting requests, ordered by (negated priority, ticket) so begin() is granted next.
+        std::set<std::pair<int, std::uint64_t>> waiting;
+        /// The ticket given to the next request.
+        std::uint64_t nextTicket{0};
+        /// The number of requests which had to wait.
+        std::atomic<std::uint64_t> contendedCount{0};
+    }; // class InputArbiter
+
+
+    /**
+     * @class ArbitratedKeys
+     * @brief Forwards the input calls of a running sequence to a shared target under a lease.
+     *
+     * Holds (e.g., TYPEHOLD) are performed within the lease since they occupy the device.
+     */
+    template<typename Keys>
+    class ArbitratedKeys
+    {
+    public:
+        /**
+         * @brief Constructs the forwarding target.
+         * @param keys[Keys&] - The shared target which simulates input.
+         * @param arbiter[InputArbiter&] - The arbiter guarding the target.
+         * @param priority[int] - The priority of the owning sequence.
+         */
+        ArbitratedKeys(Keys& keys, InputArbiter& arbiter, int priority) :
+            keys(keys), arbiter(arbiter), priority(priority)
+        { }
+
+        /// Each of these forwards to the method of the same name on the target while holding a lease.
+        template<typename... Args>
+        void type(Args&&... args)
+        {
+            auto lease = arbiter.acquire(priority);
+            keys.type(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void moveMouseTo(Args&&... args)
+        {
+            auto lease = arbiter.acquire(priority);
+            keys.moveMouseTo(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void mouseClick(Args&&... args)
+        {
+            auto lease = arbiter.acquire(priority);
+            keys.mouseClick(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void pressSpecialButton(Args&&... args)
+        {
+            auto lease = arbiter.acquire(priority);
+            keys.pressSpecialButton(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void pressNumber(Args&&... args)
+        {
+            auto lease = arbiter.acquire(priority);
+            keys.pressNumber(std::forward<Args>(args)...);
+        }
+
+    private:
+        Keys& keys;
+        InputArbiter& arbiter;
+        int priority;
+    }; // class ArbitratedKeys
+
+
+    /**
+     * @class SequenceRunner
+     * @brief Runs one compiled sequence on a background thread with its own timeline.
+     *
+     * The sequence runs while the task condition is met (see BackgroundTask::setConditionMet()
+     * and toggleCondition(), normally bound to the sequence's LISTEN hotkey). Without loop
+     * mode, each activation runs the sequence once and then clears the condition. Turning the
+     * condition off lets the current pass finish before pausing.
+     */
+    template<typename Keys>
+    class SequenceRunner : public threading::BackgroundTask
+    {
+    public:
+        /**
+         * @brief Constructs an idle runner. The program must outlive the runner.
+         * @param name[const std::string&] - The name of the sequence.
+         * @param program[const SequenceProgram&] - The compiled sequence to run.
+         * @param keys[Keys&] - The shared target which simulates input.
+         * @param arbiter[InputArbiter&] - The arbiter shared by all runners using keys.
+         * @param priority[int] - The priority of this sequence's input.
+         */
+        SequenceRunner(const std::string& name, const SequenceProgram& program, Keys& keys,
+                       InputArbiter& arbiter, int priority = 0) :
+            name(name), program(program), keys(keys, arbiter, priority)
+        { }
+
+        /// Stops the runner before its members are destroyed.
+        ~SequenceRunner() override
+        { stop(); }
+
+        /**
+         * @brief Sets whether the sequence repeats while the condition is met.
+         * @param value[bool] - True to loop.
+         */
+        void setLoop(bool value)
+        { loop = value; }
+
+        /**
+         * @brief Sets whether to print the actions rather than performing them.
+         * @param value[bool] - True to print only.
+         */
+        void setDryRun(bool value)
+        { dryRun = value; }
+
+        /**
+         * @brief Returns the name of the sequence.
+         * @return [const std::string&] - The sequence name.
+         */
+        const std::string& getName() const
+        { return name; }
+
+        /**
+         * @brief Returns the number of completed passes of the sequence.
+         * @return [std::uint64_t] - The number of passes.
+         */
+        std::uint64_t getRunCount() const
+        {
+            std::lock_guard<std::mutex> lock(runMutex);
+            return runCount;
+        }
+
+        /**
+         * @brief Blocks until the sequence has completed a number of passes.
+         * @param count[std::uint64_t] - The number of passes to wait for.
+         * @return [bool] - True if the passes completed; false if the runner stopped first.
+         */
+        bool waitForRuns(std::uint64_t count)
+        {
+            std::unique_lock<std::mutex> lock(runMutex);
+            runFinished.wait(lock, [this, count] { return runCount >= count || !isRunning(); });
+            return runCount >= count;
+        }
+
+        /**
+         * @brief Stops the runner, waking any threads blocked in waitForRuns().
+         */
+        void stop() override
+        {
+            threading::BackgroundTask::stop();
+            std::lock_guard<std::mutex> lock(runMutex);
+            runFinished.notify_all();
+        }
+
+        /**
+         * @brief Returns the timeline the sequence is scheduled on. Only read it once stopped.
+         * @return [const timing::Timeline&] - The timeline.
+         */
+        const timing::Timeline& getTimeline() const
+        { return timeline; }
+
+    protected:
+        /**
+         * @brief Waits for the condition, then runs one pass of the sequence.
+         */
+        void run() override
+        {
+            if (!waitForCondition(true))
+                return;
+
+            // The thread may have idled on the condition, so schedule from the wakeup.
+            timeline.resync();
+
+            bool verboseMode = context != nullptr && context->verboseMode;
+            if (dryRun)
+            {
+                std::ostringstream out;
+                out << "[" << name << "] ";
+                program.dump(out);
+                std::cout << out.str() + "\n" << std::flush;
+            }
+            else
+            {
+                program.execute(keys, timeline, verboseMode);
+            }
+
+            if (!loop)
+                setConditionMet(false);
+
+            std::lock_guard<std::mutex> lock(runMutex);
+            ++runCount;
+            runFinished.notify_all();
+        }
+
+    private:
+        /// The name of the sequence.
+        std::string name;
+        /// The compiled sequence.
+        const SequenceProgram& program;
+        /// Forwards the sequence's input to the shared target under the arbiter.
+        ArbitratedKeys<Keys> keys;
+        /// This sequence's own timeline, so its cadence is independent of other sequences.
+        timing::Timeline timeline;
+        /// Whether to repeat while the condition is met.
+        std::atomic<bool> loop{false};
+        /// Whether to print rather than perform the actions.
+        std::atomic<bool> dryRun{false};
+
+        /// Guards runCount.
+        mutable std::mutex runMutex;
+        /// Signalled after each pass and when stopped.
+        std::condition_variable runFinished;
+        /// The number of completed passes.
+        std::uint64_t runCount{0};
+    }; // class SequenceRunner
+} // namespace sequencer
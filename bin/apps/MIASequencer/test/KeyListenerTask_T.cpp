@@ -80,8 +80,12 @@ TEST_F(KeyListenerTaskTest, ConditionToggleOnRun)
     task.initialize();
     task.start();
 
+    // The listener only runs when woken (by input or notify()), so wake it until it stops.
     while (task.isRunning())
+    {
+        task.notify();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
 
     EXPECT_TRUE(task.isConditionMet());
         
@@ -89,3 +93,80 @@ TEST_F(KeyListenerTaskTest, ConditionToggleOnRun)
 }
 
 
+
+/**
+ * @brief Exposes the edge handling of KeyListenerTask so hotkeys can be driven without a display.
+ */
+class EdgeTestListener : public KeyListenerTask
+{
+public:
+    using KeyListenerTask::onKeyEdge;
+};
+
+TEST(KeyListenerTaskHotkeys, RisingEdgeInvokesCallbackOnce)
+{
+    EdgeTestListener listener;
+    int firstCount = 0;
+    int secondCount = 0;
+    listener.addHotkey('a', KeyListenerTask::CONTROL, [&firstCount] { ++firstCount; });
+    listener.addHotkey('b', KeyListenerTask::SHIFT | KeyListenerTask::ALT, [&secondCount] { ++secondCount; });
+    listener.setDebounce(std::chrono::milliseconds(0));
+    EXPECT_TRUE(listener.isActive());
+
+    // Events are stamped before they are handled, as they are when read from the X server.
+    auto start = KeyListenerTask::Clock::now() - std::chrono::milliseconds(100);
+    EXPECT_TRUE(listener.onKeyEdge(0, true, start));
+    
+    // Held keys (auto-repeat) do not retrigger until released.
+    EXPECT_FALSE(listener.onKeyEdge(0, true, start + std::chrono::milliseconds(30)));
+    EXPECT_FALSE(listener.onKeyEdge(0, false, start + std::chrono::milliseconds(40)));
+    EXPECT_TRUE(listener.onKeyEdge(0, true, start + std::chrono::milliseconds(50)));
+    EXPECT_TRUE(listener.onKeyEdge(1, true, start + std::chrono::milliseconds(60)));
+
+    EXPECT_EQ(firstCount, 2);
+    EXPECT_EQ(secondCount, 1);
+
+    // Each latency spans from the event to its callback, so it covers at least the event's age.
+    KeyListenerTask::LatencyStats stats = listener.getLatencyStats();
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_GE(stats.min, std::chrono::milliseconds(40));
+    EXPECT_GE(stats.max, std::chrono::milliseconds(100));
+    EXPECT_LE(stats.min, stats.mean());
+    EXPECT_LE(stats.mean(), stats.max);
+
+    // A detection time ahead of the listener's clock is not recorded as a negative latency.
+    listener.onKeyEdge(0, false, KeyListenerTask::Clock::now());
+    EXPECT_TRUE(listener.onKeyEdge(0, true, KeyListenerTask::Clock::now() + std::chrono::seconds(1)));
+    EXPECT_GE(listener.getLatencyStats().min, std::chrono::nanoseconds(0));
+}
+
+TEST(KeyListenerTaskHotkeys, DebounceIgnoresChatter)
+{
+    EdgeTestListener listener;
+    int count = 0;
+    listener.addHotkey('x', KeyListenerTask::NONE, [&count] { ++count; });
+    listener.setDebounce(std::chrono::milliseconds(20));
+
+    auto start = KeyListenerTask::Clock::now() - std::chrono::milliseconds(50);
+    EXPECT_TRUE(listener.onKeyEdge(0, true, start));
+    listener.onKeyEdge(0, false, start + std::chrono::milliseconds(2));
+    
+    // A bounce within the debounce interval is ignored.
+    EXPECT_FALSE(listener.onKeyEdge(0, true, start + std::chrono::milliseconds(5)));
+    listener.onKeyEdge(0, false, start + std::chrono::milliseconds(6));
+    EXPECT_TRUE(listener.onKeyEdge(0, true, start + std::chrono::milliseconds(25)));
+    EXPECT_EQ(count, 2);
+    EXPECT_GE(listener.getLatencyStats().min, std::chrono::nanoseconds(0));
+}
+
+TEST(KeyListenerTaskHotkeys, StopWakesIdleListenerPromptly)
+{
+    KeyListenerTask listener('q');
+    listener.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto stopStart = std::chrono::steady_clock::now();
+    listener.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::milliseconds(100));
+    EXPECT_FALSE(listener.waitForCondition(true));
+}
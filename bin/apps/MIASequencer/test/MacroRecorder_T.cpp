@@ -0,0 +1,237 @@
+/**
+ * @file MacroRecorder_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for converting recorded input events into sequences.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MacroRecorder.hpp"
+#include "SequenceCompiler.hpp"
+
+using namespace sequencer;
+using virtual_keys::InputEvent;
+using std::chrono::milliseconds;
+
+namespace
+{
+    /// Returns a key press or release at a time in ms.
+    RecordedEvent key(int time, std::uint32_t code, bool pressed)
+    {
+        RecordedEvent recorded;
+        recorded.time = milliseconds(time);
+        recorded.event.type = InputEvent::Type::KEY;
+        recorded.event.code = code;
+        recorded.event.pressed = pressed;
+        return recorded;
+    }
+
+    /// Returns a mouse button press or release at a time in ms.
+    RecordedEvent button(int time, std::uint32_t number, bool pressed)
+    {
+        RecordedEvent recorded = key(time, number, pressed);
+        recorded.event.type = InputEvent::Type::BUTTON;
+        return recorded;
+    }
+
+    /// Returns a mouse move at a time in ms.
+    RecordedEvent move(int time, int x, int y)
+    {
+        RecordedEvent recorded;
+        recorded.time = milliseconds(time);
+        recorded.event.type = InputEvent::Type::MOVE_TO;
+        recorded.event.x = x;
+        recorded.event.y = y;
+        return recorded;
+    }
+
+    /// Returns each non-SLEEP action with when it starts on replay, following SequenceProgram::execute().
+    std::vector<std::pair<std::string, milliseconds>> replayTimes(const RecordedSequence& sequence)
+    {
+        std::vector<std::pair<std::string, milliseconds>> times;
+        milliseconds now(0);
+        for (const RecordedAction& action : sequence.actions)
+        {
+            if (action.key == "SLEEP")
+            {
+                now += milliseconds(std::stoi(action.value));
+            }
+            else
+            {
+                times.emplace_back(action.key, now);
+                std::size_t hold = action.value.find(';');
+                if (hold != std::string::npos)
+                    now += milliseconds(std::stoi(action.value.substr(hold + 1)));
+            }
+            now += milliseconds(sequence.delay);
+        }
+        return times;
+    }
+
+    /// Returns the actions as "KEY=value" strings.
+    std::vector<std::string> actionStrings(const RecordedSequence& sequence)
+    {
+        std::vector<std::string> strings;
+        for (const RecordedAction& action : sequence.actions)
+            strings.push_back(action.key + "=" + action.value);
+        return strings;
+    }
+} // anonymous namespace
+
+TEST(MacroRecorderTest, CoalescesBurstsIntoType)
+{
+    RecordingOptions options;
+    options.delay = 100;
+    MacroRecorder recorder(options);
+    recorder.record(key(0, virtual_keys::keysym::SHIFT_L, true));
+    recorder.record(key(0, 'h', true));
+    recorder.record(key(50, 'h', false));
+    recorder.record(key(60, virtual_keys::keysym::SHIFT_L, false));
+    recorder.record(key(100, 'i', true));
+    recorder.record(key(120, 'i', true)); // Auto-repeat.
+    recorder.record(key(150, 'i', false));
+    recorder.record(key(1150, 'x', true));
+    recorder.record(key(1200, 'x', false));
+
+    RecordedSequence sequence = recorder.build();
+    EXPECT_EQ(sequence.delay, 100);
+    EXPECT_EQ(actionStrings(sequence), (std::vector<std::string>{"TYPE=Hi", "SLEEP=950", "TYPE=x"}));
+    ASSERT_EQ(sequence.times.size(), 2u);
+    EXPECT_EQ(sequence.times[1], milliseconds(1150));
+}
+
+TEST(MacroRecorderTest, RecordsLongPressesAsHolds)
+{
+    MacroRecorder recorder;
+    recorder.record(key(0, 'a', true));
+    recorder.record(key(497, 'a', false));
+    recorder.record(key(600, virtual_keys::keysym::RETURN, true));
+    recorder.record(key(902, virtual_keys::keysym::RETURN, false));
+
+    RecordedSequence sequence = recorder.build();
+    // The DELAY is the time between the actions less the hold of the first.
+    EXPECT_EQ(sequence.delay, 100);
+    EXPECT_EQ(actionStrings(sequence), (std::vector<std::string>{"TYPEHOLD=a;500", "PRESSHOLD=ENTER;300"}));
+}
+
+TEST(MacroRecorderTest, RecordsClicksWithPositions)
+{
+    MacroRecorder recorder;
+    recorder.record(move(0, 100, 200));
+    recorder.record(button(0, virtual_keys::button::LEFT, true));
+    recorder.record(button(20, virtual_keys::button::LEFT, false));
+    recorder.record(move(500, 100, 200));
+    recorder.record(button(500, virtual_keys::button::RIGHT, true));
+    recorder.record(button(800, virtual_keys::button::RIGHT, false));
+    recorder.record(button(900, virtual_keys::button::SCROLL_DOWN, true));
+    recorder.record(button(900, virtual_keys::button::SCROLL_DOWN, false));
+    recorder.record(button(950, 8, true)); // A button with no sequence action.
+
+    RecordedSequence sequence = recorder.build();
+    EXPECT_EQ(actionStrings(sequence), (std::vector<std::string>{
+        "MOVEMOUSE=100,200", "CLICK=LEFTCLICK", "SLEEP=300", "CLICKHOLD=RIGHTCLICK;300", "PRESS=SCROLL_DOWN"}));
+    EXPECT_EQ(sequence.delay, 100);
+    EXPECT_EQ(sequence.skippedEvents, 1u);
+}
+
+TEST(MacroRecorderTest, RecordingCompiles)
+{
+    MacroRecorder recorder;
+    recorder.record(key(0, 'a', true));
+    recorder.record(key(20, 'a', false));
+    recorder.record(key(1000, virtual_keys::keysym::TAB, true));
+    recorder.record(key(1020, virtual_keys::keysym::TAB, false));
+    recorder.record(key(1100, 'b', true));
+    recorder.record(key(1120, 'b', false));
+    RecordedSequence sequence = recorder.build();
+
+    const std::string text = MacroRecorder::toSequenceText(sequence, "recorded", 'k');
+    std::vector<config::ConfigLine> lines;
+    config::config_parser::parseLines(text, lines);
+    CompileResult result = compileSequences(lines);
+    ASSERT_TRUE(result.errors.empty());
+    ASSERT_EQ(result.sequences.size(), 1u);
+    EXPECT_EQ(result.sequences[0].name, "recorded");
+    EXPECT_EQ(result.sequences[0].listenerKeyCode, 'k');
+
+    SequenceProgram program = MacroRecorder::toProgram(sequence);
+    EXPECT_EQ(program.getDelay(), sequence.delay);
+    EXPECT_EQ(program.getCode().size(), sequence.actions.size());
+    EXPECT_EQ(result.sequences[0].program.getCode().size(), program.getCode().size());
+}
+
+TEST(MacroRecorderTest, TrimsTrailingKey)
+{
+    MacroRecorder recorder;
+    recorder.record(key(0, 'a', true));
+    recorder.record(key(20, 'a', false));
+    recorder.record(key(100, 'r', true));
+    recorder.record(key(120, 'r', false));
+    recorder.trimTrailingKey('r');
+
+    ASSERT_EQ(recorder.getEvents().size(), 2u);
+    EXPECT_EQ(actionStrings(recorder.build()), (std::vector<std::string>{"TYPE=a"}));
+}
+
+TEST(MacroRecorderTest, ComparesTiming)
+{
+    std::vector<std::chrono::nanoseconds> recorded{milliseconds(0), milliseconds(100), milliseconds(200)};
+    std::vector<std::chrono::nanoseconds> replayed{milliseconds(0), milliseconds(110), milliseconds(180), milliseconds(300)};
+    ReplayReport report = MacroRecorder::compareTiming(recorded, replayed);
+    EXPECT_EQ(report.count, 3u);
+    EXPECT_EQ(report.meanError, milliseconds(10));
+    EXPECT_EQ(report.maxError, milliseconds(20));
+
+    SequenceProgram program;
+    program.setDelay(20);
+    program.addAction("TYPE", "a");
+    program.addAction("TYPE", "b");
+    std::vector<std::chrono::nanoseconds> times = MacroRecorder::measureReplay(program);
+    ASSERT_EQ(times.size(), 2u);
+    // Waits are scheduled from the timeline start, so allow for the time taken by the first action.
+    EXPECT_GE(times[1], milliseconds(15));
+}
+
+TEST(MacroRecorderTest, ReplaysEveryGapWithinAQuantum)
+{
+    // Gaps of 100, 100, 150 and 100 ms: with a DELAY of 100 the 150 ms gap can't be represented,
+    // since a SLEEP adds a second DELAY.
+    MacroRecorder recorder;
+    for (int time : {0, 100, 200, 350, 450})
+    {
+        recorder.record(key(time, virtual_keys::keysym::TAB, true));
+        recorder.record(key(time + 20, virtual_keys::keysym::TAB, false));
+    }
+    // Clicks replay one DELAY after their MOVEMOUSE.
+    recorder.record(move(1000, 5, 5));
+    recorder.record(button(1000, virtual_keys::button::LEFT, true));
+    recorder.record(button(1020, virtual_keys::button::LEFT, false));
+    recorder.record(key(1230, virtual_keys::keysym::RETURN, true));
+    recorder.record(key(1250, virtual_keys::keysym::RETURN, false));
+
+    RecordedSequence sequence = recorder.build();
+    auto replayed = replayTimes(sequence);
+    ASSERT_EQ(replayed.size(), sequence.times.size());
+    for (std::size_t i = 0; i < replayed.size(); ++i)
+    {
+        if (replayed[i].first == "MOVEMOUSE")
+            continue;
+        auto recorded = std::chrono::duration_cast<milliseconds>(sequence.times[i]);
+        EXPECT_LE(std::abs((replayed[i].second - recorded).count()), 10) << "Action " << i;
+    }
+
+    // A fixed DELAY is kept even if some gaps can't be represented exactly.
+    RecordingOptions options;
+    options.delay = 100;
+    MacroRecorder fixed(options);
+    for (const RecordedEvent& event : recorder.getEvents())
+        fixed.record(event);
+    EXPECT_EQ(fixed.build().delay, 100);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file SequenceCompiler_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for compiling sequences files and for the compiled sequence cache.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "SequenceCompiler.hpp"
+
+using namespace sequencer;
+
+namespace
+{
+    const std::string VALID_SEQUENCES =
+        "# A comment.\n"
+        "SEQUENCENAME=first\n"
+        "DELAY=10\n"
+        "TYPE=abc\n"
+        "SLEEP=5\n"
+        "ENDOFSEQUENCE\n"
+        "\n"
+        "SEQUENCENAME=second\n"
+        "LISTEN=k\n"
+        "PRIORITY=3\n"
+        "PRESS=SPACE\n"
+        "ENDOFSEQUENCE\n";
+
+    /// Compiles text the same way MIASequencer compiles a loaded file.
+    CompileResult compileText(const std::string& text, const std::vector<CompiledSequence>& previous = {})
+    {
+        std::vector<config::ConfigLine> lines;
+        config::config_parser::parseLines(text, lines);
+        return compileSequences(lines, previous);
+    }
+} // anonymous namespace
+
+TEST(SequenceCompilerTest, CompilesValidSequences)
+{
+    CompileResult result = compileText(VALID_SEQUENCES);
+
+    EXPECT_TRUE(result.errors.empty());
+    ASSERT_EQ(result.sequences.size(), 2u);
+    EXPECT_EQ(result.compiledCount, 2u);
+    EXPECT_EQ(result.sequences[0].name, "first");
+    EXPECT_EQ(result.sequences[0].program.getDelay(), 10);
+    EXPECT_EQ(result.sequences[0].program.getCode().size(), 2u);
+    EXPECT_EQ(result.sequences[1].listenerKeyCode, 'k');
+    EXPECT_EQ(result.sequences[1].priority, 3);
+}
+
+TEST(SequenceCompilerTest, ReportsEveryErrorWithLineNumbers)
+{
+    const std::string text =
+        "SEQUENCENAME=bad\n"       // 1
+        "DELAY=soon\n"             // 2
+        "TYPE=ok\n"                // 3
+        "CLICK=upclick\n"          // 4
+        "ENDOFSEQUENCE\n"          // 5
+        "SEQUENCENAME=good\n"      // 6
+        "TYPE=x\n"                 // 7
+        "ENDOFSEQUENCE\n"          // 8
+        "SEQUENCENAME=good\n"      // 9
+        "TYPE=y\n"                 // 10
+        "ENDOFSEQUENCE\n"          // 11
+        "SEQUENCENAME=empty\n"     // 12
+        "ENDOFSEQUENCE\n"          // 13
+        "SEQUENCENAME=unfinished\n"// 14
+        "TYPE=z\n";                // 15
+    CompileResult result = compileText(text);
+
+    ASSERT_EQ(result.sequences.size(), 1u);
+    EXPECT_EQ(result.sequences[0].name, "good");
+
+    std::vector<std::size_t> errorLines;
+    for (const CompileError& compileError : result.errors)
+        errorLines.push_back(compileError.lineNumber);
+    EXPECT_EQ(errorLines, (std::vector<std::size_t>{2, 4, 11, 13, 14}));
+    EXPECT_NE(result.errors[1].message.find("upclick"), std::string::npos);
+}
+
+TEST(SequenceCompilerTest, ReusesUnchangedSequences)
+{
+    CompileResult first = compileText(VALID_SEQUENCES);
+
+    std::string edited = VALID_SEQUENCES;
+    edited.replace(edited.find("SPACE"), 5, "ENTER");
+    CompileResult second = compileText(edited, first.sequences);
+
+    EXPECT_EQ(second.reusedCount, 1u);
+    EXPECT_EQ(second.compiledCount, 1u);
+    ASSERT_EQ(second.sequences.size(), 2u);
+    EXPECT_EQ(second.sequences[0].sourceHash, first.sequences[0].sourceHash);
+    EXPECT_NE(second.sequences[1].sourceHash, first.sequences[1].sourceHash);
+}
+
+TEST(SequenceCompilerTest, CacheRoundTrip)
+{
+    std::string cachePath = (std::filesystem::temp_directory_path() / "SequenceCompiler_T.seq.cache").string();
+    CompileResult result = compileText(VALID_SEQUENCES);
+    ASSERT_TRUE(sequence_cache::writeCache(cachePath, result.sequences));
+
+    std::vector<CompiledSequence> cached;
+    ASSERT_TRUE(sequence_cache::readCache(cachePath, cached));
+    ASSERT_EQ(cached.size(), result.sequences.size());
+    for (std::size_t i = 0; i < cached.size(); ++i)
+    {
+        EXPECT_EQ(cached[i].name, result.sequences[i].name);
+        EXPECT_EQ(cached[i].listenerKeyCode, result.sequences[i].listenerKeyCode);
+        EXPECT_EQ(cached[i].priority, result.sequences[i].priority);
+        EXPECT_EQ(cached[i].sourceHash, result.sequences[i].sourceHash);
+        EXPECT_EQ(cached[i].program.getDelay(), result.sequences[i].program.getDelay());
+        EXPECT_EQ(cached[i].program.getStrings(), result.sequences[i].program.getStrings());
+        ASSERT_EQ(cached[i].program.getCode().size(), result.sequences[i].program.getCode().size());
+    }
+
+    // Every sequence is reused when recompiling the same text against the cache.
+    EXPECT_EQ(compileText(VALID_SEQUENCES, cached).reusedCount, 2u);
+    std::filesystem::remove(cachePath);
+}
+
+TEST(SequenceCompilerTest, RejectsCorruptCache)
+{
+    std::string cachePath = (std::filesystem::temp_directory_path() / "SequenceCompiler_T_corrupt.seq.cache").string();
+    ASSERT_TRUE(sequence_cache::writeCache(cachePath, compileText(VALID_SEQUENCES).sequences));
+
+    // Truncating the file anywhere must be detected rather than read past the end.
+    auto size = std::filesystem::file_size(cachePath);
+    std::filesystem::resize_file(cachePath, size - 3);
+
+    std::vector<CompiledSequence> cached;
+    EXPECT_FALSE(sequence_cache::readCache(cachePath, cached));
+    EXPECT_TRUE(cached.empty());
+
+    {
+        std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+        out << "not a sequence cache";
+    }
+    EXPECT_FALSE(sequence_cache::readCache(cachePath, cached));
+    EXPECT_FALSE(sequence_cache::readCache(cachePath + ".missing", cached));
+
+    // Well formed records with operands addAction() would reject are not loaded either.
+    CompiledSequence tampered;
+    tampered.name = "tampered";
+    Instruction instruction;
+    instruction.op = OpCode::PRESS_RANDOM_NUMBER;
+    instruction.a = 7;
+    instruction.b = 3;
+    tampered.program.addInstruction(instruction);
+    ASSERT_TRUE(sequence_cache::writeCache(cachePath, {tampered}));
+    EXPECT_FALSE(sequence_cache::readCache(cachePath, cached));
+    EXPECT_TRUE(cached.empty());
+    std::filesystem::remove(cachePath);
+}
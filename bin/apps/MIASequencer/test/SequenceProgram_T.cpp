@@ -0,0 +1,198 @@
+/**
+ * @file SequenceProgram_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for compiling and executing SequenceProgram instances.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "SequenceProgram.hpp"
+#include "MIAException.hpp"
+
+using namespace sequencer;
+using virtual_keys::VirtualKeyStrokes;
+
+/**
+ * @brief Records the calls the interpreter makes instead of simulating input.
+ */
+struct RecordingKeys
+{
+    std::vector<std::string> calls;
+    std::vector<timing::Clock::time_point> typeTimes;
+
+    void type(const std::string& word, int holdTime, bool)
+    {
+        calls.push_back("type " + word + " " + std::to_string(holdTime));
+        typeTimes.push_back(timing::Clock::now());
+    }
+
+    void moveMouseTo(int x, int y)
+    { calls.push_back("move " + std::to_string(x) + " " + std::to_string(y)); }
+
+    void mouseClick(VirtualKeyStrokes::ClickType click, int holdTime, bool)
+    { calls.push_back("click " + VirtualKeyStrokes::clickTypeToString(click) + " " + std::to_string(holdTime)); }
+
+    void pressSpecialButton(VirtualKeyStrokes::SpecialButton button, int holdTime, bool)
+    { calls.push_back("button " + VirtualKeyStrokes::specialButtonToString(button) + " " + std::to_string(holdTime)); }
+
+    void pressNumber(int num, int holdTime, bool)
+    { calls.push_back("number " + std::to_string(num) + " " + std::to_string(holdTime)); }
+};
+
+TEST(SequenceProgramTest, CompilesActionsAndInternsStrings)
+{
+    SequenceProgram program;
+    program.addAction("TYPE", "abc");
+    program.addAction("SLEEP", " 500 ");
+    program.addAction("TYPEHOLD", "abc;20");
+    program.addAction("MOVEMOUSE", "145, 887");
+    program.addAction("CLICKHOLD", "leftclick;30");
+    program.addAction("PRESS", "SPACE");
+    program.addAction("PRESSRANDNUM", "2;5");
+
+    const std::vector<Instruction>& code = program.getCode();
+    ASSERT_EQ(code.size(), 7u);
+    ASSERT_EQ(program.getStrings().size(), 1u);
+    EXPECT_EQ(program.getStrings()[0], "abc");
+
+    EXPECT_EQ(code[0].op, OpCode::TYPE);
+    EXPECT_EQ(code[1].op, OpCode::SLEEP);
+    EXPECT_EQ(code[1].a, 500);
+    EXPECT_EQ(code[2].a, code[0].a);
+    EXPECT_EQ(code[2].hold, 20);
+    EXPECT_EQ(program.getHoldTime(code[2]), 60);
+    EXPECT_EQ(code[3].op, OpCode::MOVE_MOUSE);
+    EXPECT_EQ(code[3].b, 887);
+    EXPECT_EQ(code[4].kind, static_cast<std::uint8_t>(VirtualKeyStrokes::ClickType::LEFT_CLICK));
+    EXPECT_EQ(code[5].kind, static_cast<std::uint8_t>(VirtualKeyStrokes::SpecialButton::SPACE));
+    EXPECT_EQ(code[6].op, OpCode::PRESS_RANDOM_NUMBER);
+
+    std::ostringstream out;
+    program.dump(out);
+    EXPECT_EQ(out.str(), "TYPE:abc, SLEEP:500ms, TYPE:abc;HOLD:20ms, MOVEMOUSE:145,887, "
+                         "CLICK:LEFT_CLICK;HOLD:30ms, PRESS:SPACE, PRESSRANDNUM:2;5");
+}
+
+TEST(SequenceProgramTest, RejectsInvalidActions)
+{
+    const std::vector<std::pair<std::string, std::string>> invalid = {
+        {"TYPE", ""}, {"TYPE", "a.b"}, {"SLEEP", "-1"}, {"SLEEP", "5ms"}, {"MOVEMOUSE", "12"},
+        {"CLICK", "upclick"}, {"PRESS", "ESCAPE"}, {"TYPEHOLD", "w;0"}, {"PRESSHOLD", "SPACE"},
+        {"PRESSRANDNUM", "5;2"}, {"PRESSRANDNUM", "0;10"}, {"JUMP", "1"}
+    };
+
+    SequenceProgram program;
+    for (const auto& [key, value] : invalid)
+    {
+        try
+        {
+            program.addAction(key, value);
+            ADD_FAILURE() << "Expected " << key << "=" << value << " to be rejected.";
+        }
+        catch (const error::MIAException& ex)
+        {
+            EXPECT_EQ(ex.getCode(), error::ErrorCode::Invalid_Sequence_Option);
+        }
+    }
+    EXPECT_TRUE(program.empty());
+}
+
+TEST(SequenceProgramTest, ValidatesRawInstructions)
+{
+    SequenceProgram program;
+    for (const char* action : {"TYPE=abc", "SLEEP=5", "MOVEMOUSE=-4,7", "CLICKHOLD=leftclick;20", 
+                               "PRESS=TAB", "PRESSRANDNUM=2;2"})
+    {
+        std::string line = action;
+        program.addAction(line.substr(0, line.find('=')), line.substr(line.find('=') + 1));
+    }
+    for (const Instruction& instruction : program.getCode())
+        EXPECT_TRUE(program.isValidInstruction(instruction));
+
+    auto make = [](OpCode op, std::uint8_t kind, std::int32_t a, std::int32_t b, std::int32_t hold = 0)
+    {
+        Instruction instruction;
+        instruction.op = op;
+        instruction.kind = kind;
+        instruction.a = a;
+        instruction.b = b;
+        instruction.hold = hold;
+        return instruction;
+    };
+    EXPECT_FALSE(program.isValidInstruction(make(static_cast<OpCode>(6), 0, 0, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::TYPE, 0, 1, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::TYPE, 0, -1, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::SLEEP, 0, -5, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::CLICK, 0, 0, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::CLICK, 200, 0, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::PRESS_BUTTON, 0, 0, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::PRESS_BUTTON, 99, 0, 0)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::PRESS_RANDOM_NUMBER, 0, 5, 2)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::PRESS_RANDOM_NUMBER, 0, -1, 2)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::PRESS_RANDOM_NUMBER, 0, 0, 10)));
+    EXPECT_FALSE(program.isValidInstruction(make(OpCode::MOVE_MOUSE, 0, 0, 0, -1)));
+}
+
+TEST(SequenceProgramTest, ExecutesInstructionsInOrder)
+{
+    SequenceProgram program;
+    program.setDelay(1);
+    program.addAction("TYPEHOLD", "hi;2");
+    program.addAction("MOVEMOUSE", "1,2");
+    program.addAction("CLICK", "RIGHTCLICK");
+    program.addAction("PRESSHOLD", "ENTER;3");
+    program.addAction("PRESSRANDNUM", "7;7");
+    program.addAction("SLEEP", "5");
+
+    RecordingKeys keys;
+    timing::Timeline timeline;
+    auto start = timing::Clock::now();
+    program.execute(keys, timeline);
+
+    const std::vector<std::string> expected = {
+        "type hi 2", "move 1 2", "click RIGHT_CLICK 0", "button ENTER 3", "number 7 0"
+    };
+    EXPECT_EQ(keys.calls, expected);
+
+    // Six 1 ms delays, a 5 ms sleep and 7 ms of (recorded but not performed) holds, scheduled
+    // from when execute() resynchronized the timeline.
+    EXPECT_GE(timeline.getDeadline() - start, std::chrono::milliseconds(18));
+    EXPECT_LT(timeline.getDeadline() - start, std::chrono::milliseconds(100));
+}
+
+TEST(SequenceProgramTest, HonoursFirstDelayOnIdleTimeline)
+{
+    SequenceProgram program;
+    program.setDelay(60);
+    program.addAction("TYPE", "a");
+    program.addAction("TYPE", "b");
+
+    // The timeline lags by more than the delay but less than its maximum lag once execute() is
+    // called, so without a resync the first delay would return immediately.
+    timing::Timeline timeline;
+    timing::sleepFor(std::chrono::milliseconds(110));
+
+    RecordingKeys keys;
+    program.execute(keys, timeline);
+
+    ASSERT_EQ(keys.typeTimes.size(), 2u);
+    EXPECT_GE(keys.typeTimes[1] - keys.typeTimes[0], std::chrono::milliseconds(55));
+}
+
+TEST(SequenceProgramTest, ClearRestoresDefaults)
+{
+    SequenceProgram program;
+    program.setDelay(5);
+    program.addAction("TYPE", "x");
+    program.clear();
+
+    EXPECT_TRUE(program.empty());
+    EXPECT_TRUE(program.getStrings().empty());
+    EXPECT_EQ(program.getDelay(), 1000);
+    EXPECT_EQ(program.internString("x"), 0);
+}
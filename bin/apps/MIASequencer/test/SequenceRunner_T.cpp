@@ -0,0 +1,152 @@
+/**
+ * @file SequenceRunner_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for running sequences concurrently through the InputArbiter.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SequenceRunner.hpp"
+
+using namespace sequencer;
+using virtual_keys::VirtualKeyStrokes;
+
+/**
+ * @brief Records the calls made by the runners instead of simulating input. The arbiter
+ * serializes all calls, so no locking is needed here.
+ */
+struct RecordingKeys
+{
+    std::vector<std::string> calls;
+    std::vector<timing::Clock::time_point> times;
+
+    void type(const std::string& word, int, bool)
+    {
+        calls.push_back(word);
+        times.push_back(timing::Clock::now());
+    }
+
+    void moveMouseTo(int, int) { }
+    void mouseClick(VirtualKeyStrokes::ClickType, int, bool) { }
+    void pressSpecialButton(VirtualKeyStrokes::SpecialButton, int, bool) { }
+    void pressNumber(int, int, bool) { }
+};
+
+namespace
+{
+    /// Builds a program typing each word, with a short delay between the words.
+    SequenceProgram makeProgram(const std::vector<std::string>& words)
+    {
+        SequenceProgram program;
+        program.setDelay(1);
+        for (const std::string& word : words)
+            program.addAction("TYPE", word);
+        return program;
+    }
+} // anonymous namespace
+
+TEST(InputArbiterTest, GrantsHighestPriorityFirst)
+{
+    InputArbiter arbiter;
+    std::vector<int> granted;
+    std::vector<std::thread> threads;
+    {
+        auto lease = arbiter.acquire(0);
+        for (int priority : {1, 5, 3})
+        {
+            threads.emplace_back([&arbiter, &granted, priority]()
+            {
+                auto inner = arbiter.acquire(priority);
+                granted.push_back(priority);
+            });
+            // Queue the requests one at a time so that they are all waiting on the held lease.
+            while (arbiter.getContendedCount() < threads.size())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(granted, (std::vector<int>{5, 3, 1}));
+}
+
+TEST(SequenceRunnerTest, RunsSequencesConcurrently)
+{
+    RecordingKeys keys;
+    InputArbiter arbiter;
+    SequenceProgram first = makeProgram({"a", "b", "c"});
+    SequenceProgram second = makeProgram({"x", "y"});
+
+    std::vector<std::unique_ptr<SequenceRunner<RecordingKeys>>> runners;
+    runners.push_back(std::make_unique<SequenceRunner<RecordingKeys>>("first", first, keys, arbiter));
+    runners.push_back(std::make_unique<SequenceRunner<RecordingKeys>>("second", second, keys, arbiter, 1));
+    for (auto& runner : runners)
+    {
+        runner->setConditionMet(true);
+        runner->start();
+    }
+    for (auto& runner : runners)
+    {
+        EXPECT_TRUE(runner->waitForRuns(1));
+        runner->stop();
+        EXPECT_EQ(runner->getRunCount(), 1u);
+        EXPECT_FALSE(runner->isConditionMet());
+    }
+
+    // Every action ran exactly once, and each sequence kept its own order.
+    ASSERT_EQ(keys.calls.size(), 5u);
+    auto position = [&keys](const std::string& word)
+        { return std::find(keys.calls.begin(), keys.calls.end(), word) - keys.calls.begin(); };
+    EXPECT_LT(position("a"), position("b"));
+    EXPECT_LT(position("b"), position("c"));
+    EXPECT_LT(position("x"), position("y"));
+}
+
+TEST(SequenceRunnerTest, LoopsUntilToggledOff)
+{
+    RecordingKeys keys;
+    InputArbiter arbiter;
+    SequenceProgram program = makeProgram({"a"});
+    SequenceRunner<RecordingKeys> runner("loop", program, keys, arbiter);
+    runner.setLoop(true);
+    runner.start();
+
+    // Nothing runs until the condition (normally the LISTEN key) is toggled on.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(runner.getRunCount(), 0u);
+
+    runner.toggleCondition();
+    EXPECT_TRUE(runner.waitForRuns(3));
+    runner.toggleCondition();
+    runner.stop();
+    EXPECT_GE(runner.getRunCount(), 3u);
+    EXPECT_FALSE(runner.waitForRuns(1000));
+}
+
+TEST(SequenceRunnerTest, HonoursDelayAfterIdling)
+{
+    RecordingKeys keys;
+    InputArbiter arbiter;
+    SequenceProgram program = makeProgram({"a", "b"});
+    program.setDelay(60);
+    SequenceRunner<RecordingKeys> runner("idle", program, keys, arbiter);
+    runner.start();
+
+    // Idle on the condition for longer than the delay but less than the timeline's maximum lag
+    // past it, so a stale timeline would skip the first delay.
+    std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    runner.setConditionMet(true);
+    EXPECT_TRUE(runner.waitForRuns(1));
+    runner.stop();
+
+    ASSERT_EQ(keys.times.size(), 2u);
+    EXPECT_GE(keys.times[1] - keys.times[0], std::chrono::milliseconds(55));
+}
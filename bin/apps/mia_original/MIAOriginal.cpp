@@ -46,17 +46,18 @@ using std::to_string;
 MIAOriginal::MIAOriginal() :
     defaultCommandOpt("-c", "--command", "Run a default command when the app is ran.",
                                          CommandOption::commandOptionType::STRING_OPTION)
-{ };
+{
+    addHelpSection("MIAOriginal specific options:");
+    addOption(defaultCommandOpt, defaultCommand);
+};
 
 
 void MIAOriginal::initialize(int argc, char* argv[])
 {
     try
     {    
+        // Parses the command line arguments into defaultCommand.
         MIAApplication::initialize(argc, argv);
-
-        // Set the values from the command line arguments.
-        defaultCommandOpt.getOptionVal<string>(argc, argv, defaultCommand);
     }
     catch (const error::MIAException& ex)
     {
@@ -65,17 +66,6 @@ void MIAOriginal::initialize(int argc, char* argv[])
 }
 
 
-void MIAOriginal::printHelp() const
-{
-    MIAApplication::printHelp();
-    
-    // This is a dump of the help messages used by the various command options.
-    cout << "MIAOriginal specific options:" << endl
-              << defaultCommandOpt.getHelp() << endl
-              << endl;
-}
-
-
 int MIAOriginal::run()
 {
     printSplash();
@@ -41,13 +41,6 @@ public:
     /// Runs the MIAOriginal application.
     int run() override;
 
-protected:
-
-    /**
-     * Prints help info for optional config file.
-     */
-    void printHelp() const override;
-
 private:
     
     // Command options for this app.
@@ -8,6 +8,8 @@
  */
 
 #include <string>
+#include <memory>
+#include <optional>
 
 // Include the associated header file.
 #include "WoWFishbot.hpp"
@@ -15,6 +17,10 @@
 #include "VirtualKeyStrokes.hpp"
 // Include Timing for timing values.
 #include "Timing.hpp"
+// Used for capturing and searching the screen.
+#include "ScreenCapture.hpp"
+// Used for detecting the splash of a bite.
+#include "MotionDetector.hpp"
 // Used for error handling.
 #include "Error.hpp"
 // Used for config path.
@@ -28,25 +34,32 @@ using std::string;
 using std::cout;
 using std::endl;
 
+namespace
+{
+    /// The distance (in pixels) from the bobber which is watched for the splash of a bite.
+    constexpr int SPLASH_RADIUS = 48;
+}
+
 
 WoWFishbot::WoWFishbot() : 
     config(defaultConfigFile, constants::ConfigType::KEY_VALUE),
     configFileOpt("-c", "--config", "Specify a config file to use (default = " +
                                     paths::getDefaultConfigDirToUse() + "/WoWConfig.MIA)",
                                     CommandOption::commandOptionType::STRING_OPTION)
-                                    
-{ };
+{
+    addHelpSection("Fishbot specific options:");
+    addOption(configFileOpt, configFile);
+};
 
 
 void WoWFishbot::initialize(int argc, char* argv[])
 {
     try
     {    
+        // Parses the command line arguments into configFile.
         MIAApplication::initialize(argc, argv);
         
-        // Set the values from the command line arguments.
-        std::string configFile = defaultConfigFile;
-        configFileOpt.getOptionVal<std::string>(argc, argv, configFile);
+        config.setCacheEnabled(isConfigCacheEnabled());
         config.setConfigFileName(configFile, constants::ConfigType::KEY_VALUE); // handles config.initialize().
     }
     catch (const error::MIAException& ex)
@@ -110,29 +123,28 @@ void WoWFishbot::WoWFishBot(string fishButton, string lureButton)
 	virtual_keys::VirtualKeyStrokes keys;
 
     //Begin useful variable initialization.
-    HDC dc = GetDC(NULL);
-    COLORREF color;
     int counter = 0;
-    int red=1,green=1,blue=1;
-    int increment = WoWFishBotIncrement;
-    
-    if(getVerboseMode())
-        cout << "increment: " << increment << endl;
-        
-    int startX = WoWFishBotStartX + increment/2, startY = WoWFishBotStartY;
     
-    if(getVerboseMode())
-    {
-        cout << "startX: " << startX << endl;
-        cout << "startY: " << startY << endl;
-    }
+    // The search area is captured as one frame and searched in a single pass, rather than
+    // reading one pixel at a time from the screen.
+    screen::Region searchArea{WoWFishBotStartX, WoWFishBotStartY, 
+                              WoWFishBotEndX - WoWFishBotStartX, WoWFishBotEndY - WoWFishBotStartY};
+    std::unique_ptr<screen::ScreenSource> source = screen::ScreenSource::create(searchArea);
+    searchArea = source->getRegion();
     
-    int endX = WoWFishBotEndX, endY = WoWFishBotEndY;
+    // The bobber bobs gently, so a bite needs a larger change over more than one tile.
+    screen::MotionOptions splashOptions;
+    splashOptions.scale = 2;
+    splashOptions.tileThreshold = 24;
+    splashOptions.minTiles = 2;
+    screen::MotionDetector splashDetector(splashOptions);
     
     if(getVerboseMode())
     {
-        cout << "endX: " << endX << endl;
-        cout << "endY: " << endY << endl;
+        cout << "startX: " << searchArea.x << endl;
+        cout << "startY: " << searchArea.y << endl;
+        cout << "endX: " << searchArea.x + searchArea.width << endl;
+        cout << "endY: " << searchArea.y + searchArea.height << endl;
     }
     
     bool bobberFound = false;
@@ -169,38 +181,24 @@ void WoWFishbot::WoWFishBot(string fishButton, string lureButton)
         timing::sleepMilliseconds(1500);
         cout << "...Scanning." << endl;
 
-        //Finds bobber.
-        for (int j=startY;j<endY;j+=increment)
+        //Finds bobber: the first pixel where red exceeds green or blue by more than 35.
+        const screen::Frame& frame = source->capture();
+        std::optional<screen::Point> bobber = screen::findDominant(frame, screen::Channel::RED, 35);
+        if (bobber)
         {
-            for (int i=startX;i<endX;i+=increment)
+            int x = searchArea.x + bobber->x, y = searchArea.y + bobber->y;
+            
+            //Troubleshooting printouts for color of the pixel detected.
+            if (getVerboseMode())
             {
-                SetCursorPos(i,j);
-                timing::sleepMilliseconds(2);
-                color = GetPixel(dc, i, j);
-                //color = GetPixel(dc, cursor.x, cursor.y);
-
-                keys.getRGB(color, red, green, blue);
-
-                //Troubleshooting printouts for color of pixels detected.
-                if (getVerboseMode())
-				{
-                    cout << "(x,y): " << "(" << i << "," << j << ")" << endl;
-                    cout << "Red: " << red << "  --  " << "Green: " << green << "  --  " << "Blue: " << blue << endl;
-                    cout << "RGB: (" << red << "," << green << "," << blue << ")" << endl;
-                }
-
-                //Check if the mouse is over the bobber.
-                if(red > green + 35 || red > blue + 35)
-				{
-                    cout << "...The bobber has been found!! ...I think." << endl;
-                    bobberFound=true;
-                    break;
-                }
-            }
-            if(bobberFound)
-            {
-                break;
+                screen::Color color = frame.getPixel(bobber->x, bobber->y);
+                cout << "(x,y): " << "(" << x << "," << y << ")" << endl;
+                cout << "RGB: (" << +color.red << "," << +color.green << "," << +color.blue << ")" << endl;
             }
+            
+            cout << "...The bobber has been found!! ...I think." << endl;
+            keys.moveMouseTo(x, y);
+            bobberFound = true;
         }
         if(!bobberFound)
         {
@@ -209,10 +207,17 @@ void WoWFishbot::WoWFishBot(string fishButton, string lureButton)
             cout << "...To make it look like we're not cheating of course." << endl;
         }
 
-        //Waits a delay time and then clocks the bobber if it was found.
+        //Watches the bobber for the splash of a bite (for up to the delay time) and then clicks it.
         if(bobberFound)
 		{
-            timing::sleepMilliseconds(WoWFishBotDelay);
+            screen::Region bobberArea{bobber->x - SPLASH_RADIUS, bobber->y - SPLASH_RADIUS, 
+                                      2 * SPLASH_RADIUS, 2 * SPLASH_RADIUS};
+            std::optional<screen::MotionEvent> splash = screen::waitForMotion(*source, splashDetector, bobberArea, 
+                                                                              std::chrono::milliseconds(WoWFishBotDelay));
+            if (splash)
+                cout << "...Splash detected!" << endl;
+            else
+                cout << "...No splash detected, clicking anyway." << endl;
             keys.leftclick();
         }
         timing::sleepMilliseconds(1000);
@@ -226,8 +231,6 @@ void WoWFishbot::WoWFishBot(string fishButton, string lureButton)
         cout << "...Number of casts: " << counter << endl;
         elapsed_time = 0;
     }
-
-    ReleaseDC(NULL, dc);
 #elif __LINUX__
     cout << "This feature is not programmed for linux!" << endl;
     return;
@@ -288,11 +291,3 @@ void WoWFishbot::loadConfig()
         config.dumpConfigMap();
 }
 
-void WoWFishbot::printHelp() const
-{
-    MIAApplication::printHelp();
-    
-    cout << "Fishbot specific options:" << endl
-         << configFileOpt.getHelp() << endl
-         << endl;
-}
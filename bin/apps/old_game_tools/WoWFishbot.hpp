@@ -50,13 +50,6 @@ public:
      */
     int run() override;
 
-protected:
-
-    /**
-     * Prints help info for optional config file.
-     */
-    virtual void printHelp() const;
-
 private:
     /**
      * A fishbot for World of Warcraft.
@@ -72,6 +65,9 @@ private:
     /// The name of the defauilt config file that this class uses.
     std::string defaultConfigFile{"WoWConfig.MIA"};
     
+    /// The config file to load (set by configFileOpt).
+    std::string configFile{defaultConfigFile};
+    
     /// The configuration loader for this app.
     config::MIAConfig config;
     
@@ -88,7 +84,7 @@ private:
     int WoWFishBotStartY{360};
     int WoWFishBotEndX{1230};
     int WoWFishBotEndY{495};
-    int WoWFishBotIncrement{40};
+    int WoWFishBotIncrement{40}; ///< Unused since the whole search area is scanned; kept for existing configs.
     int WoWFishBotNumOfCasts{10000};
-    int WoWFishBotDelay{1000};
+    int WoWFishBotDelay{1000}; ///< The longest time (ms) to watch the bobber for a splash before clicking.
 }; // class WoWFishbot
@@ -27,17 +27,19 @@ RPGFiddler::RPGFiddler() :
     saveFileOpt("-s", "--save", "The file to save the player state to (default = " +
                 paths::getDefaultConfigDirToUse() + "/" + defaultSaveFile,
                 CommandOption::commandOptionType::STRING_OPTION)                   
-{ };
+{
+    addHelpSection("RPGFiddler specific options:");
+    addOption(saveFileOpt, fullSaveFilePath);
+};
 
 
 void RPGFiddler::initialize(int argc, char* argv[])
 {
     try
     {    
+        // Parses the command line arguments into fullSaveFilePath.
         MIAApplication::initialize(argc, argv);        
         
-        // Set the values from the command line arguments.
-        saveFileOpt.getOptionVal<std::string>(argc, argv, fullSaveFilePath);        
         if (fullSaveFilePath.empty())
             fullSaveFilePath = paths::getDefaultConfigDirToUse() + "/" + defaultSaveFile;
         else if (fullSaveFilePath[0] != '/')
@@ -63,17 +65,6 @@ void RPGFiddler::initialize(int argc, char* argv[])
 }
 
 
-void RPGFiddler::printHelp() const
-{
-    MIAApplication::printHelp();
-    
-    // This is a dump of the help messages used by the various command options.
-    std::cout << "RPGFiddler specific options:" << std::endl
-              << saveFileOpt.getHelp() << std::endl
-              << std::endl;
-}
-
-
 int RPGFiddler::run()
 {
     LOG_METHOD_CALL(); // Used for testing log file calls.
@@ -42,13 +42,6 @@ public:
     /// Runs the RPGFiddler application.
     int run() override;
 
-protected:
-
-    /**
-     * Prints help info for optional config file.
-     */
-    void printHelp() const override;
-
 private:
 
     std::string defaultSaveFile{"playerSave.MIA"};
@@ -15,6 +15,7 @@
 #include "Wallet.hpp"
 #include "Attributes.hpp"
 #include "ModifierApplicator.hpp"
+#include "NamedHandle.hpp"
 
 namespace rpg_sim
 {
@@ -33,35 +34,36 @@ namespace rpg_sim
         }
     } // namespace helper_methods
     
-    const std::string healthName = "Health";
-    const std::string manaName = "Mana";
-    const std::string copper = "Copper Coin";
-    const std::string silver = "Silver Coin";
-    const std::string constitutionName = "Constitution";
-    const std::string intelligenceName = "Intelligence";
+    // Handles to the well-known objects, resolved once rather than by name on every access.
+    const rpg::NamedHandle<stats::VitalRegistry> health{"Health"};
+    const rpg::NamedHandle<stats::VitalRegistry> mana{"Mana"};
+    const rpg::NamedHandle<currency::CurrencyRegistry> copperCoin{"Copper Coin"};
+    const rpg::NamedHandle<currency::CurrencyRegistry> silverCoin{"Silver Coin"};
+    const rpg::NamedHandle<stats::AttributeRegistry> constitution{"Constitution"};
+    const rpg::NamedHandle<stats::AttributeRegistry> intelligence{"Intelligence"};
 
     void setupSimulator(rpg::Player& player)
     {
-        int initialHealth = vitalRegistry.getByName(healthName)->getBaseMax();
-        int minHealth = vitalRegistry.getByName(healthName)->getBaseMin();
+        int initialHealth = vitalRegistry.get(health.get()).getBaseMax();
+        int minHealth = vitalRegistry.get(health.get()).getBaseMin();
         int maxHealth = initialHealth;
-        int initialMana = vitalRegistry.getByName(manaName)->getBaseMax();
-        int minMana = vitalRegistry.getByName(manaName)->getBaseMin();
+        int initialMana = vitalRegistry.get(mana.get()).getBaseMax();
+        int minMana = vitalRegistry.get(mana.get()).getBaseMin();
         int maxMana = initialMana;
 
         // Initialize vitals.
-        player.getVitals().add(healthName, initialHealth, minHealth, maxHealth);
-        player.getVitals().add(manaName, initialMana, minMana, maxMana);
+        player.getVitals().add(health.get(), initialHealth, minHealth, maxHealth);
+        player.getVitals().add(mana.get(), initialMana, minMana, maxMana);
         std::cout << "Vitals initialized: " << initialHealth << " Health, " << initialMana << " Mana.\n";
 
         // Initialize wallet.
-        player.getWallet().add(copper, 100);
-        player.getWallet().add(silver, 10);
+        player.getWallet().add(copperCoin.get(), 100);
+        player.getWallet().add(silverCoin.get(), 10);
         std::cout << "Wallet initialized: 100 Copper Coins, 10 Silver Coins.\n";
         
         // Initialize attributes.
-        player.getAttributes().add(constitutionName, 2);
-        player.getAttributes().add(intelligenceName, 2);
+        player.getAttributes().add(constitution.get(), 2);
+        player.getAttributes().add(intelligence.get(), 2);
         std::cout << "Attributes initialized: 2 constitution, 2 intelligence.\n";
         
         // Apply stat cross-modifiers.
@@ -74,14 +76,14 @@ namespace rpg_sim
         {
             // Display player status
             std::cout << "\nPlayer Status:" << std::endl
-                      << "\t Health: " << player.getVitals().get(healthName).getCurrent() << "/"
-                                       << player.getVitals().get(healthName).getCurrentMax() << std::endl
-                      << "\t Mana: " << player.getVitals().get(manaName).getCurrent() << "/"
-                                       << player.getVitals().get(manaName).getCurrentMax()<< std::endl
-                      << "\t Silver: " << player.getWallet().get(silver).getQuantity() << std::endl
-                      << "\t Copper: " << player.getWallet().get(copper).getQuantity() << std::endl
-                      << "\t Constitution: " << player.getAttributes().get(constitutionName).getCurrent() << std::endl
-                      << "\t Intelligence: " << player.getAttributes().get(intelligenceName).getCurrent() << std::endl;
+                      << "\t Health: " << player.getVitals().get(health.get()).getCurrent() << "/"
+                                       << player.getVitals().get(health.get()).getCurrentMax() << std::endl
+                      << "\t Mana: " << player.getVitals().get(mana.get()).getCurrent() << "/"
+                                       << player.getVitals().get(mana.get()).getCurrentMax()<< std::endl
+                      << "\t Silver: " << player.getWallet().get(silverCoin.get()).getQuantity() << std::endl
+                      << "\t Copper: " << player.getWallet().get(copperCoin.get()).getQuantity() << std::endl
+                      << "\t Constitution: " << player.getAttributes().get(constitution.get()).getCurrent() << std::endl
+                      << "\t Intelligence: " << player.getAttributes().get(intelligence.get()).getCurrent() << std::endl;
 
 
             // Display menu
@@ -140,8 +142,8 @@ namespace rpg_sim
             seeded = true;
         }
 
-        int currentHealth = player.getVitals().get(healthName).getCurrent();
-        int currentMana = player.getVitals().get(manaName).getCurrent();
+        int currentHealth = player.getVitals().get(health.get()).getCurrent();
+        int currentMana = player.getVitals().get(mana.get()).getCurrent();
 
         std::cout << "Player encounters a hostile mob...\n";
 
@@ -154,15 +156,15 @@ namespace rpg_sim
             int mobDamage = 5 + (std::rand() % 16); // 5–20
             std::cout << "Mob attacks! Player takes " << mobDamage << " damage.\n";
 
-            if (player.getVitals().has(healthName, mobDamage)) 
+            if (player.getVitals().has(health.get(), mobDamage)) 
             {
                 currentHealth -= mobDamage;
-                player.getVitals().update(healthName, stats::VitalDataTarget::CURRENT, currentHealth);
+                player.getVitals().update(health.get(), stats::VitalDataTarget::CURRENT, currentHealth);
                 std::cout << "Player survives with " << currentHealth << " health.\n";
             } 
             else 
             {
-                player.getVitals().update(healthName, stats::VitalDataTarget::CURRENT, 0);
+                player.getVitals().update(health.get(), stats::VitalDataTarget::CURRENT, 0);
                 std::cout << "Player takes lethal damage and dies.\n";
                 return;
             }
@@ -173,10 +175,10 @@ namespace rpg_sim
                 int spellCost = 10 + (std::rand() % 16); // 10–25
                 std::cout << "Player attempts to cast a spell (cost " << spellCost << " mana).\n";
 
-                if (player.getVitals().has(manaName, spellCost)) 
+                if (player.getVitals().has(mana.get(), spellCost)) 
                 {
                     currentMana -= spellCost;
-                    player.getVitals().update(manaName, stats::VitalDataTarget::CURRENT, currentMana);
+                    player.getVitals().update(mana.get(), stats::VitalDataTarget::CURRENT, currentMana);
                     std::cout << "Spell cast successfully. Remaining mana: " << currentMana << ".\n";
 
                     std::cout << "The spell hits! Mob is damaged severely.\n";
@@ -219,8 +221,8 @@ namespace rpg_sim
         int copperAmount = 10 + std::rand() % 91; // 10–100
         int silverAmount = 1 + std::rand() % 10;  // 1–10
 
-        player.getWallet().add(copper, copperAmount);
-        player.getWallet().add(silver, silverAmount);
+        player.getWallet().add(copperCoin.get(), copperAmount);
+        player.getWallet().add(silverCoin.get(), silverAmount);
 
         std::cout << "Player gains " << copperAmount << " Copper Coin" << (copperAmount > 1 ? "s" : "") << " and "
                   << silverAmount << " Silver Coin" << (silverAmount > 1 ? "s" : "") << ".\n";
@@ -230,10 +232,10 @@ namespace rpg_sim
     {
         std::cout << "Player rests to recover vitals...\n";
 
-        int currentHealth = player.getVitals().get(healthName).getCurrent();
-        int currentMana   = player.getVitals().get(manaName).getCurrent();
-        int maxHealth     = player.getVitals().get(healthName).getCurrentMax();
-        int maxMana       = player.getVitals().get(manaName).getCurrentMax();
+        int currentHealth = player.getVitals().get(health.get()).getCurrent();
+        int currentMana   = player.getVitals().get(mana.get()).getCurrent();
+        int maxHealth     = player.getVitals().get(health.get()).getCurrentMax();
+        int maxMana       = player.getVitals().get(mana.get()).getCurrentMax();
 
         int healthDelta = maxHealth - currentHealth;
         int manaDelta = maxMana - currentMana;
@@ -247,8 +249,8 @@ namespace rpg_sim
         if (currentHealth > maxHealth) currentHealth = maxHealth;
         if (currentMana > maxMana) currentMana = maxMana;
 
-        player.getVitals().update(healthName, stats::VitalDataTarget::CURRENT, currentHealth);
-        player.getVitals().update(manaName, stats::VitalDataTarget::CURRENT, currentMana);
+        player.getVitals().update(health.get(), stats::VitalDataTarget::CURRENT, currentHealth);
+        player.getVitals().update(mana.get(), stats::VitalDataTarget::CURRENT, currentMana);
 
         std::cout << "Recovered " << healthRestore << " health (now at " << currentHealth << ").\n";
         std::cout << "Recovered " << manaRestore << " mana (now at " << currentMana << ").\n";
@@ -258,8 +260,8 @@ namespace rpg_sim
     {
         std::cout << "Player spends currency at a vendor...\n";
 
-        uint32_t copperOwned = player.getWallet().get(copper).getQuantity();
-        uint32_t silverOwned = player.getWallet().get(silver).getQuantity();
+        uint32_t copperOwned = player.getWallet().get(copperCoin.get()).getQuantity();
+        uint32_t silverOwned = player.getWallet().get(silverCoin.get()).getQuantity();
 
         // Random spend amounts: Copper (5–50), Silver (1–5)
         uint32_t copperSpend = 5 + (std::rand() % 46);
@@ -269,26 +271,26 @@ namespace rpg_sim
 
         if (copperOwned >= copperSpend)
         {
-            player.getWallet().update(copper, copperOwned - copperSpend);
+            player.getWallet().update(copperCoin.get(), copperOwned - copperSpend);
             std::cout << "Spent " << copperSpend << " Copper Coin" << (copperSpend > 1 ? "s" : "") << ".\n";
             spentAnything = true;
         }
         else if (copperOwned > 0)
         {
-            player.getWallet().update(copper, copperOwned - copperOwned);
+            player.getWallet().update(copperCoin.get(), copperOwned - copperOwned);
             std::cout << "Only had " << copperOwned << " Copper Coin" << (copperOwned > 1 ? "s" : "") << ", all spent.\n";
             spentAnything = true;
         }
 
         if (silverOwned >= silverSpend)
         {
-            player.getWallet().update(silver, silverOwned - silverSpend);
+            player.getWallet().update(silverCoin.get(), silverOwned - silverSpend);
             std::cout << "Spent " << silverSpend << " Silver Coin" << (silverSpend > 1 ? "s" : "") << ".\n";
             spentAnything = true;
         }
         else if (silverOwned > 0)
         {
-            player.getWallet().update(silver, silverOwned - silverOwned);
+            player.getWallet().update(silverCoin.get(), silverOwned - silverOwned);
             std::cout << "Only had " << silverOwned << " Silver Coin" << (silverOwned > 1 ? "s" : "") << ", all spent.\n";
             spentAnything = true;
         }
@@ -304,11 +306,11 @@ namespace rpg_sim
         int intIncrease = 1 + (std::rand() % 3);         // +1-3
         int conIncrease = 1 + (std::rand() % 3);         // +1-3
 
-        int currentInt = player.getAttributes().get(intelligenceName).getCurrent();
-        int currentCon = player.getAttributes().get(constitutionName).getCurrent();
+        int currentInt = player.getAttributes().get(intelligence.get()).getCurrent();
+        int currentCon = player.getAttributes().get(constitution.get()).getCurrent();
 
-        player.getAttributes().update(intelligenceName, currentInt + intIncrease);
-        player.getAttributes().update(constitutionName, currentCon + conIncrease);
+        player.getAttributes().update(intelligence.get(), currentInt + intIncrease);
+        player.getAttributes().update(constitution.get(), currentCon + conIncrease);
 
         std::cout << "Leveled up! Intelligence increased by " << intIncrease
                   << ", Constitution increased by " << conIncrease << ".\n";
@@ -25,20 +25,21 @@ MIATemplate::MIATemplate() :
                                 CommandOption::commandOptionType::STRING_OPTION),
     testOpt("-t", "--test", "A test command option.",
                                 CommandOption::commandOptionType::BOOL_OPTION)                         
-{ };
+{
+    addHelpSection("MIATemplate specific options:");
+    addOption(configFileOpt, configFile);
+    addOption(testOpt, testMode);
+};
 
 
 void MIATemplate::initialize(int argc, char* argv[])
 {
     try
     {    
+        // Parses the command line arguments into testMode and configFile.
         MIAApplication::initialize(argc, argv);
 
-        // Set the values from the command line arguments.
-        testOpt.getOptionVal<bool>(argc, argv, testMode);
-        
-        std::string configFile = defaultConfigFile;
-        configFileOpt.getOptionVal<std::string>(argc, argv, configFile);
+        config.setCacheEnabled(isConfigCacheEnabled());
         config.setConfigFileName(configFile, constants::ConfigType::KEY_VALUE); // handles config.initialize().
     }
     catch (const error::MIAException& ex)
@@ -74,17 +75,6 @@ void MIATemplate::loadConfig()
         config.dumpConfigMap();
 }
 
-void MIATemplate::printHelp() const
-{
-    MIAApplication::printHelp();
-    
-    // This is a dump of the help messages used by the various command options.
-    std::cout << "MIATemplate specific options:" << std::endl
-              << configFileOpt.getHelp() << std::endl
-              << testOpt.getHelp() << std::endl
-              << std::endl;
-}
-
 void MIATemplate::TemplateConfig::printConfigValues() const 
 {
     std::cout << "----------------------------------------------------" << std::endl;
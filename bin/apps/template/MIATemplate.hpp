@@ -48,13 +48,6 @@ public:
     /// Runs the MIATemplate application.
     int run() override;
 
-protected:
-
-    /**
-     * Prints help info for optional config file.
-     */
-    void printHelp() const override;
-
 private:
 
     /**
@@ -77,6 +70,9 @@ private:
     /// The name of the defauilt config file that this class uses.
     std::string defaultConfigFile{"MIATemplate.MIA"};
     
+    /// The config file to load (set by configFileOpt).
+    std::string configFile{defaultConfigFile};
+    
     /// The configuration loader for this app.
     config::MIAConfig config;
 
@@ -37,27 +37,27 @@ MIAWorkout::MIAWorkout() :
     outputFileOpt("-o", "--output", "Specify the output file path for workouts (defaults"
                                     " to config file value).",
                                 CommandOption::commandOptionType::STRING_OPTION),
-    difficultyOpt("-d", "--difficulty", "Specify a difficulty to use (default = 1.0).",
+    difficultyOpt("", "--difficulty", "Specify a difficulty to use (default = 1.0).",
                                 CommandOption::commandOptionType::DOUBLE_OPTION),
     weeklyOpt("-w", "--weekly", "Generate workouts for an entire week.",
                                 CommandOption::commandOptionType::BOOL_OPTION)
-                                    
-{ };
+{
+    addHelpSection("MIAWorkout specific options:");
+    addOption(configFileOpt, configFile);
+    addOption(outputFileOpt, workoutOutputFilePath);
+    addOption(difficultyOpt, difficulty);
+    addOption(weeklyOpt, weekly);
+};
 
 
 void MIAWorkout::initialize(int argc, char* argv[])
 {
     try
     {  
+        // Parses the command line arguments into the option values.
         MIAApplication::initialize(argc, argv);
-
-        // Set the values from the command line arguments.
-        difficultyOpt.getOptionVal<double>(argc, argv, difficulty);
-        weeklyOpt.getOptionVal<bool>(argc, argv, weekly);
-        outputFileOpt.getOptionVal<std::string>(argc, argv, workoutOutputFilePath);
         
-        std::string configFile = defaultConfigFile;
-        configFileOpt.getOptionVal<std::string>(argc, argv, configFile);
+        config.setCacheEnabled(isConfigCacheEnabled());
         config.setConfigFileName(configFile, constants::ConfigType::KEY_VALUE); // handles config.initialize().
     }
     catch (const error::MIAException& ex)
@@ -98,12 +98,6 @@ void MIAWorkout::printHelp() const
 {
     MIAApplication::printHelp();
     
-    cout << "MIAWorkout specific options:" << endl
-         << configFileOpt.getHelp() << endl
-         << outputFileOpt.getHelp() << endl
-         << difficultyOpt.getHelp() << endl
-         << weeklyOpt.getHelp() << endl
-         << endl << endl;
     cout << "Assuming default values, difficulties range from 0-100." << endl;
     cout << "   1-10 (VERY EASY), 11-24 (EASY), 25-39 (NORMAL)" << endl;
     cout << "   39-54 (HARD), 54-74 (VERY HARD), 75+ (INSANE)" << endl;
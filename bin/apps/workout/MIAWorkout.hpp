@@ -43,7 +43,7 @@ public:
 protected:
 
     /**
-     * Prints help info for optional config file.
+     * Prints help info followed by the difficulty ranges.
      */
     virtual void printHelp() const;
 
@@ -57,6 +57,9 @@ private:
     /// The name of the defauilt config file that this class uses.
     std::string defaultConfigFile{"MIAWorkout.MIA"};
     
+    /// The config file to load (set by configFileOpt).
+    std::string configFile{defaultConfigFile};
+    
     /// The configuration loader for this app.
     config::MIAConfig config;
 
@@ -7,23 +7,58 @@
  *     for running background tasks in a separate thread. It manages thread lifecycle, 
  *     stop signaling via an atomic flag, and requires derived classes to implement the
  *     task logic in the run() method. The class ensures proper cleanup and supports 
- *     controlled stopping of long-running or repeating tasks.
+ *     controlled stopping of long-running or repeating tasks. Besides calling run()
+ *     continuously, a task can block until notified, run at a fixed rate, or (on Linux)
+ *     wait for file descriptors to become readable, so idle tasks use no CPU.
  */
 #pragma once
 
 #include <thread>
 #include <atomic>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
 
 #include "RuntimeContext.hpp"
+// Used for preprocessor definitions.
+#include "Constants.hpp"
+// Used for exception throws.
+#include "MIAException.hpp"
+
+#if defined(IS_LINUX)
+    #include <cerrno>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif
 
 namespace threading
 {
+    /**
+     * @brief Determines when the worker thread of a BackgroundTask calls run().
+     */
+    enum class TaskMode
+    {
+        CONTINUOUS,     ///< run() is called back to back until stopped (the default).
+        EVENT_DRIVEN,   ///< run() is called once per wakeup from notify().
+        PERIODIC,       ///< run() is called at a fixed rate, and additionally on notify().
+        FD_READY        ///< run() is called when a watched file descriptor is readable, or on notify().
+    };
+
     /**
      * @brief Abstract base class for running background tasks in a separate thread.
      *
      * Derived classes should override the run() method to implement specific task behavior.
      * The task starts on a separate thread via start(), and can be stopped via stop().
+     *
+     * By default run() is called continuously. A derived class may instead select a blocking
+     * mode (see setEventDriven(), setPeriodic() and addWatchedFd()) before start() is called,
+     * in which case the worker sleeps in the kernel between calls to run() and stop() wakes it
+     * immediately rather than waiting for run() to poll stopRequested.
      */
     class BackgroundTask 
     {
@@ -37,7 +72,15 @@ namespace threading
          * @brief Destructor ensures the thread is properly stopped and joined.
          */
         virtual ~BackgroundTask() 
-        { stop(); }
+        { 
+            stop(); 
+#if defined(IS_LINUX)
+            if (epollFd >= 0)
+                close(epollFd);
+            if (wakeFd >= 0)
+                close(wakeFd);
+#endif
+        }
         
         /**
          * @brief Deleted copy and move constructors and assignment operators.
@@ -62,15 +105,50 @@ namespace threading
         /**
          * @brief Requests the background task to stop.
          *
-         * This sets the stopRequested flag. The threadLoop() method checks this flag.
+         * This sets the stopRequested flag and wakes the worker if it is blocked waiting for
+         * work, then joins it. The threadLoop() method checks this flag.
          */
         virtual void stop() 
         {     
             stopRequested = true; // Set the flag unconditionally
-                if (worker.joinable()) 
-                    worker.join(); // Always join if the thread is joinable
+            wake();
+            if (worker.joinable()) 
+                worker.join(); // Always join if the thread is joinable
         }
 
+        /**
+         * @brief Wakes the worker so that it calls run() as soon as possible.
+         *
+         * Notifications which arrive while run() is executing are coalesced into a single
+         * further call. This has no effect in TaskMode::CONTINUOUS, where run() is always
+         * called again immediately. Safe to call from any thread.
+         */
+        void notify()
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                notified = true;
+            }
+            wake();
+        }
+
+        /**
+         * @brief Returns the mode which determines when run() is called.
+         * @return [TaskMode] - The current task mode.
+         */
+        TaskMode getMode() const
+        { return mode; }
+
+        /**
+         * @brief Returns the number of periods skipped because run() overran its deadline.
+         *
+         * In TaskMode::PERIODIC, a late call is made immediately, but if more than a whole
+         * period was lost the missed periods are skipped instead of being run back to back.
+         * @return [std::uint64_t] - The number of skipped periods.
+         */
+        std::uint64_t getMissedPeriods() const
+        { return missedPeriods.load(); }
+
         /**
          * @brief Checks whether the task is still running.
          * @return [bool] - true if the task has not been requested to stop.
@@ -84,7 +162,26 @@ namespace threading
          * @param value[bool] - The new value to set for conditionMet.
          */
         void setConditionMet(bool value) 
-        {  conditionMet.store(value); }
+        {  
+            conditionMet.store(value); 
+            wake();
+        }
+
+        /**
+         * @brief Blocks the calling thread until the condition flag has the given value.
+         *
+         * Intended for threads which pause until a task toggles the condition, without polling.
+         * Returns early if the task is stopped.
+         * @param value[bool] - The value to wait for.
+         * @return [bool] - true if the condition has the value; false if the task was stopped first.
+         */
+        bool waitForCondition(bool value)
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait(lock, [this, value] 
+                { return conditionMet.load() == value || stopRequested.load(); });
+            return conditionMet.load() == value;
+        }
 
         /**
          * @brief Checks whether the condition has been met.
@@ -133,6 +230,83 @@ namespace threading
          */
         virtual void doWhenStopped() {}
 
+        /**
+         * @brief Makes the worker block until notify() or stop() is called, then call run() once.
+         * @throws MIAException(Invalid_Configuration_Call) - If the task is already started.
+         */
+        void setEventDriven()
+        { 
+            requireNotStarted();
+            mode = TaskMode::EVENT_DRIVEN; 
+        }
+
+        /**
+         * @brief Makes the worker call run() at a fixed rate.
+         *
+         * Deadlines are absolute (start + n * period), so time spent in run() and wakeup latency
+         * do not accumulate as drift. The first call happens immediately on start().
+         * @param interval[std::chrono::nanoseconds] - The time between calls; must be positive.
+         * @throws MIAException(Invalid_Argument) - If the interval is not positive.
+         * @throws MIAException(Invalid_Configuration_Call) - If the task is already started.
+         */
+        void setPeriodic(std::chrono::nanoseconds interval)
+        {
+            requireNotStarted();
+            if (interval.count() <= 0)
+                throw error::MIAException(error::ErrorCode::Invalid_Argument, 
+                                          "BackgroundTask period must be positive.");
+            period = interval;
+            mode = TaskMode::PERIODIC;
+        }
+
+        /**
+         * @brief Makes the worker call run() whenever one of the watched descriptors is readable.
+         *
+         * Descriptors are watched level-triggered with epoll, so run() must consume the
+         * available data or it will be called again immediately. The descriptors are not
+         * owned and must stay open until the task is stopped. Use getReadyFds() in run() to
+         * see which descriptors woke the worker.
+         * @param fd[int] - The file descriptor to watch for readability.
+         * @throws MIAException(Linux_Only_Feature) - If not built for Linux.
+         * @throws MIAException(Invalid_Argument) - If the descriptor cannot be watched.
+         * @throws MIAException(Invalid_Configuration_Call) - If the task is already started.
+         */
+        void addWatchedFd(int fd)
+        {
+            requireNotStarted();
+#if defined(IS_LINUX)
+            if (epollFd < 0)
+            {
+                epollFd = epoll_create1(EPOLL_CLOEXEC);
+                wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                epoll_event wakeEvent{};
+                wakeEvent.events = EPOLLIN;
+                wakeEvent.data.fd = wakeFd;
+                if (epollFd < 0 || wakeFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) != 0)
+                    throw error::MIAException(error::ErrorCode::Invalid_Argument, 
+                                              "Unable to create the BackgroundTask wait set.");
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            if (fd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+                throw error::MIAException(error::ErrorCode::Invalid_Argument, 
+                                          "Unable to watch file descriptor: " + std::to_string(fd));
+            mode = TaskMode::FD_READY;
+#else
+            (void)fd;
+            throw error::MIAException(error::ErrorCode::Linux_Only_Feature, 
+                                      "BackgroundTask file descriptor waits require Linux.");
+#endif
+        }
+
+        /**
+         * @brief Returns the watched descriptors that were readable when run() was last woken.
+         * @return [const std::vector<int>&] - The ready descriptors; empty if woken by notify().
+         */
+        const std::vector<int>& getReadyFds() const
+        { return readyFds; }
+
         /// Flag indicating if a stop has been requested.
         std::atomic<bool> stopRequested{false};
         
@@ -143,17 +317,182 @@ namespace threading
         std::atomic<bool> conditionMet{false};
 
     private:
+        /// The clock used for periodic deadlines.
+        using Clock = std::chrono::steady_clock;
+
         /**
-         * @brief Internal method that repeatedly invokes run() until stopped.
+         * @brief Internal method that invokes run() according to the task mode until stopped.
          */
         void threadLoop() 
         { 
-            while (!stopRequested.load()) 
-                run();
+            switch (mode)
+            {
+                case TaskMode::CONTINUOUS:
+                    while (!stopRequested.load()) 
+                        run();
+                    break;
+                case TaskMode::EVENT_DRIVEN:
+                    while (waitForNotify(nullptr)) 
+                        run();
+                    break;
+                case TaskMode::PERIODIC:
+                    periodicLoop();
+                    break;
+                case TaskMode::FD_READY:
+                    while (waitForFds()) 
+                        run();
+                    break;
+            }
             doWhenStopped();
         }
 
+        /**
+         * @brief Calls run() on absolute deadlines, skipping whole periods that were missed.
+         */
+        void periodicLoop()
+        {
+            Clock::time_point deadline = Clock::now();
+            while (!stopRequested.load())
+            {
+                run();
+                Clock::time_point next = deadline + period;
+                while (true)
+                {
+                    bool woken = waitForNotify(&next);
+                    if (stopRequested.load())
+                        return;
+                    if (woken)
+                        run(); // An extra call on notify() that leaves the schedule unchanged.
+                    else
+                        break;
+                }
+                
+                // If we woke more than a period late, skip the missed periods rather than
+                // running them back to back.
+                deadline = next;
+                Clock::time_point now = Clock::now();
+                if (now - deadline >= period)
+                {
+                    auto behind = (now - deadline) / period;
+                    missedPeriods += static_cast<std::uint64_t>(behind);
+                    deadline += behind * period;
+                }
+            }
+        }
+
+        /**
+         * @brief Blocks until notified, stopped or (if given) the deadline passes.
+         * @param deadline[const Clock::time_point*] - The wait deadline, or nullptr to wait indefinitely.
+         * @return [bool] - True if woken by notify() and not stopped; false on stop or timeout.
+         */
+        bool waitForNotify(const Clock::time_point* deadline)
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            auto ready = [this] { return notified || stopRequested.load(); };
+            if (deadline == nullptr)
+                wakeCondition.wait(lock, ready);
+            else if (!wakeCondition.wait_until(lock, *deadline, ready))
+                return false;
+            if (stopRequested.load())
+                return false;
+            notified = false;
+            return true;
+        }
+
+        /**
+         * @brief Blocks until a watched descriptor is readable, or notify() or stop() is called.
+         * @return [bool] - True if run() should be called; false if stopped.
+         */
+        bool waitForFds()
+        {
+            readyFds.clear();
+#if defined(IS_LINUX)
+            epoll_event events[16];
+            while (readyFds.empty() && !stopRequested.load())
+            {
+                int count = epoll_wait(epollFd, events, 16, -1);
+                if (count < 0 && errno != EINTR)
+                    return false;
+                
+                bool woken = false;
+                for (int i = 0; i < count; ++i)
+                {
+                    if (events[i].data.fd != wakeFd)
+                    {
+                        readyFds.push_back(events[i].data.fd);
+                        continue;
+                    }
+                    std::uint64_t value;
+                    while (read(wakeFd, &value, sizeof(value)) > 0) 
+                    { }
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                    woken = notified;
+                    notified = false;
+                }
+                if (woken)
+                    break;
+            }
+#endif
+            return !stopRequested.load();
+        }
+
+        /**
+         * @brief Wakes the worker from whichever wait it is blocked in, along with any
+         *        threads blocked in waitForCondition().
+         */
+        void wake()
+        {
+            {
+                // Taking the lock orders the wakeup after a waiter's predicate check.
+                std::lock_guard<std::mutex> lock(wakeMutex);
+            }
+            wakeCondition.notify_all();
+#if defined(IS_LINUX)
+            if (wakeFd >= 0)
+            {
+                std::uint64_t one = 1;
+                [[maybe_unused]] ssize_t written = write(wakeFd, &one, sizeof(one));
+            }
+#endif
+        }
+
+        /**
+         * @brief Throws if the worker thread has already been started.
+         * @throws MIAException(Invalid_Configuration_Call) - If the task is already started.
+         */
+        void requireNotStarted() const
+        {
+            if (worker.joinable())
+                throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
+                                          "BackgroundTask mode must be set before start().");
+        }
+
         /// The worker thread that executes the task.
         std::thread worker;
+
+        /// Determines when run() is called.
+        TaskMode mode{TaskMode::CONTINUOUS};
+
+        /// The time between calls to run() in TaskMode::PERIODIC.
+        std::chrono::nanoseconds period{0};
+
+        /// The number of periods skipped due to overruns in TaskMode::PERIODIC.
+        std::atomic<std::uint64_t> missedPeriods{0};
+
+        /// Guards notified and orders wakeups with the waiting threads.
+        std::mutex wakeMutex;
+
+        /// Signalled by notify(), stop() and setConditionMet() to wake waiting threads.
+        std::condition_variable wakeCondition;
+
+        /// Set by notify() and cleared when the worker wakes for it.
+        bool notified{false};
+
+        /// The watched descriptors that were readable on the last wakeup.
+        std::vector<int> readyFds;
+
+        /// The epoll instance and the eventfd used to interrupt it (TaskMode::FD_READY only).
+        int epollFd{-1};
+        int wakeFd{-1};
     }; // class BackgroundTask 
 } // namespace threading
@@ -0,0 +1,78 @@
+/**
+ * @file CancellationToken.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Defines the CancellationToken class, a cheap, copyable handle to a shared cancellation
+ *     flag. It is used for cooperative cancellation of scheduled tasks (see TaskScheduler.hpp)
+ *     and is carried by the RuntimeContext so an application can cancel all of its work at once.
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace threading
+{
+    /**
+     * @brief A copyable handle to a shared cancellation flag.
+     *
+     * All copies of a token share one flag, so cancelling any copy cancels them all. Work which
+     * supports cancellation should check isCancelled() at convenient points and stop early.
+     */
+    class CancellationToken
+    {
+    public:
+        /**
+         * @brief Constructs a new token with its own, not yet cancelled, flag.
+         */
+        CancellationToken() :
+            flag(std::make_shared<std::atomic<bool>>(false))
+        { }
+
+        /**
+         * @brief Returns a shared token which can never be cancelled (used as a default argument).
+         * @return [const CancellationToken&] - The never-cancelled token.
+         */
+        static const CancellationToken& none()
+        {
+            static const CancellationToken noneToken{nullptr};
+            return noneToken;
+        }
+
+        /**
+         * @brief Requests cancellation of all work using this token. Has no effect on none().
+         */
+        void cancel() const
+        {
+            if (flag)
+                flag->store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Clears a previous cancellation so the token can be reused.
+         */
+        void reset() const
+        {
+            if (flag)
+                flag->store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief Checks whether cancellation has been requested.
+         * @return [bool] - True if cancel() was called on this token or a copy of it.
+         */
+        bool isCancelled() const
+        { return flag && flag->load(std::memory_order_acquire); }
+
+    private:
+        /**
+         * @brief Constructs a token without a flag (see none()).
+         */
+        explicit CancellationToken(std::nullptr_t)
+        { }
+
+        /// The shared flag; null for the none() token.
+        std::shared_ptr<std::atomic<bool>> flag;
+    }; // class CancellationToken
+} // namespace threading
@@ -0,0 +1,295 @@
+/**
+ * @file CommandLine.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the table-driven, single-pass CommandLine parser.
+ */
+
+#include <algorithm>
+#include <charconv>
+
+// The associated header file.
+#include "CommandLine.hpp"
+// Used for exception throws.
+#include "MIAException.hpp"
+
+namespace
+{
+    /**
+     * Returns a readable name for an option type, used in the missing required option error.
+     * @param type[CommandOption::commandOptionType] - The option type.
+     * @return const char* - The type name.
+     */
+    const char* optionTypeName(CommandOption::commandOptionType type)
+    {
+        switch (type)
+        {
+            case CommandOption::BOOL_OPTION: return "Bool";
+            case CommandOption::INT_OPTION: return "Integer";
+            case CommandOption::UNSIGNED_INT_OPTION: return "Unsigned Integer";
+            case CommandOption::DOUBLE_OPTION: return "Double";
+            case CommandOption::STRING_OPTION: return "String";
+            default: return "Unknown";
+        }
+    }
+
+    /**
+     * Parses the entire text as a number with std::from_chars.
+     * @param text[std::string_view] - The text to parse.
+     * @param out[Number&] - Set to the parsed value on success.
+     * @return bool - True if the whole text was a valid, in-range number.
+     */
+    template<typename Number>
+    bool parseNumber(std::string_view text, Number& out)
+    {
+        if (!text.empty() && text.front() == '+')
+            text.remove_prefix(1);
+        if (text.empty())
+            return false;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return ec == std::errc() && ptr == text.data() + text.size();
+    }
+
+    /**
+     * Throws the standard invalid value error.
+     * @param typeName[const char*] - The expected value type (e.g., "integer").
+     * @param name[std::string_view] - The option as written on the command line.
+     */
+    [[noreturn]] void throwInvalidValue(const char* typeName, std::string_view name)
+    {
+        std::string err = std::string("Invalid ") + typeName + " value for " + std::string(name);
+        throw error::MIAException(error::ErrorCode::Invalid_Argument, err);
+    }
+} // anonymous namespace
+
+
+void CommandLine::addOption(const CommandOption& option, bool& sink)
+{ addEntry(option, &sink, CommandOption::BOOL_OPTION, "bool"); }
+
+void CommandLine::addOption(const CommandOption& option, int& sink)
+{ addEntry(option, &sink, CommandOption::INT_OPTION, "int"); }
+
+void CommandLine::addOption(const CommandOption& option, unsigned int& sink)
+{ addEntry(option, &sink, CommandOption::UNSIGNED_INT_OPTION, "unsigned int"); }
+
+void CommandLine::addOption(const CommandOption& option, double& sink)
+{ addEntry(option, &sink, CommandOption::DOUBLE_OPTION, "double"); }
+
+void CommandLine::addOption(const CommandOption& option, std::string& sink)
+{ addEntry(option, &sink, CommandOption::STRING_OPTION, "string"); }
+
+
+void CommandLine::addHelpSection(const std::string& heading)
+{
+    helpItems.push_back({heading, 0});
+}
+
+
+void CommandLine::addEntry(const CommandOption& option,
+                           Sink sink,
+                           CommandOption::commandOptionType expected,
+                           const char* typeName)
+{
+    const std::string& shortArg = option.getShortArg();
+    const std::string& longArg = option.getLongArg();
+
+    if (option.getType() != expected)
+    {
+        std::string err = std::string("Expected ") + typeName + " for option: " + longArg;
+        throw error::MIAException(error::ErrorCode::Invalid_Type_Requested, err);
+    }
+
+    // Short options are a single character so they can be bundled and looked up directly.
+    bool validShort = shortArg.empty() ||
+        (shortArg.size() == 2 && shortArg[0] == '-' && shortArg[1] != '-' &&
+         static_cast<unsigned char>(shortArg[1]) < shortTable.size());
+    if (longArg.size() < 3 || longArg.compare(0, 2, "--") != 0 ||
+        longArg.find('=') != std::string::npos || !validShort)
+    {
+        std::string err = "Malformed command option: '" + shortArg + "', '" + longArg + "'";
+        throw error::MIAException(error::ErrorCode::Invalid_Argument, err);
+    }
+
+    auto longPos = std::lower_bound(longTable.begin(), longTable.end(), longArg,
+        [](const auto& item, const std::string& name) { return item.first < name; });
+    bool duplicateLong = longPos != longTable.end() && longPos->first == longArg;
+    bool duplicateShort = !shortArg.empty() && shortTable[static_cast<unsigned char>(shortArg[1])] != 0;
+    if (duplicateLong || duplicateShort)
+    {
+        std::string err = "Command option registered twice: " + (duplicateLong ? longArg : shortArg);
+        throw error::MIAException(error::ErrorCode::Invalid_Argument, err);
+    }
+
+    std::uint32_t index = static_cast<std::uint32_t>(entries.size());
+    entries.push_back({option, sink, false});
+    longTable.insert(longPos, {longArg, index});
+    if (!shortArg.empty())
+        shortTable[static_cast<unsigned char>(shortArg[1])] = index + 1;
+    helpItems.push_back({"", index});
+}
+
+
+int CommandLine::findLong(std::string_view name) const
+{
+    auto pos = std::lower_bound(longTable.begin(), longTable.end(), name,
+        [](const auto& item, std::string_view key) { return item.first < key; });
+    if (pos == longTable.end() || pos->first != name)
+        return -1;
+    return static_cast<int>(pos->second);
+}
+
+
+void CommandLine::assign(Entry& entry, std::string_view name, std::string_view value)
+{
+    entry.seen = true;
+    if (bool** sink = std::get_if<bool*>(&entry.sink))
+    {
+        if (value == "true" || value == "1")
+            **sink = true;
+        else if (value == "false" || value == "0")
+            **sink = false;
+        else
+            throwInvalidValue("bool", name);
+    }
+    else if (int** sink = std::get_if<int*>(&entry.sink))
+    {
+        if (!parseNumber(value, **sink))
+            throwInvalidValue("integer", name);
+    }
+    else if (unsigned int** sink = std::get_if<unsigned int*>(&entry.sink))
+    {
+        if (!parseNumber(value, **sink))
+            throwInvalidValue("unsigned integer", name);
+    }
+    else if (double** sink = std::get_if<double*>(&entry.sink))
+    {
+        if (!parseNumber(value, **sink))
+            throwInvalidValue("double", name);
+    }
+    else if (std::string** sink = std::get_if<std::string*>(&entry.sink))
+    {
+        (*sink)->assign(value);
+    }
+}
+
+
+void CommandLine::parse(int argc, char* argv[])
+{
+    positionalArgs.clear();
+    unknownArgs.clear();
+    for (Entry& entry : entries)
+        entry.seen = false;
+
+    bool optionsEnded = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+
+        if (optionsEnded || arg.size() < 2 || arg[0] != '-')
+        {
+            positionalArgs.emplace_back(arg);
+            continue;
+        }
+
+        if (arg == "--")
+        {
+            optionsEnded = true;
+            continue;
+        }
+
+        // Long option: "--name" or "--name=value".
+        if (arg[1] == '-')
+        {
+            std::size_t equalSign = arg.find('=');
+            std::string_view name = arg.substr(0, equalSign);
+            int index = findLong(name);
+            if (index < 0)
+            {
+                unknownArgs.emplace_back(arg);
+                continue;
+            }
+
+            Entry& entry = entries[index];
+            if (equalSign != std::string_view::npos)
+                assign(entry, name, arg.substr(equalSign + 1));
+            else if (std::holds_alternative<bool*>(entry.sink))
+                assign(entry, name, "true");
+            else if (i + 1 < argc)
+                assign(entry, name, argv[++i]);
+            else
+            {
+                std::string err = "Missing value for option " + std::string(name);
+                throw error::MIAException(error::ErrorCode::Invalid_Argument, err);
+            }
+            continue;
+        }
+
+        // Short options: "-s", "-svalue", "-s value" or bundled flags such as "-vt".
+        for (std::size_t pos = 1; pos < arg.size(); ++pos)
+        {
+            unsigned char flag = static_cast<unsigned char>(arg[pos]);
+            std::uint32_t slot = flag < shortTable.size() ? shortTable[flag] : 0;
+            if (slot == 0)
+            {
+                unknownArgs.emplace_back(arg);
+                break;
+            }
+
+            Entry& entry = entries[slot - 1];
+            std::string_view name = entry.option.getShortArg();
+            if (std::holds_alternative<bool*>(entry.sink))
+            {
+                assign(entry, name, "true");
+                continue;
+            }
+
+            // A value option consumes the rest of the token, or else the next argument.
+            if (pos + 1 < arg.size())
+                assign(entry, name, arg.substr(pos + 1));
+            else if (i + 1 < argc)
+                assign(entry, name, argv[++i]);
+            else
+            {
+                std::string err = "Missing value for option " + std::string(name);
+                throw error::MIAException(error::ErrorCode::Invalid_Argument, err);
+            }
+            break;
+        }
+    }
+
+    for (const Entry& entry : entries)
+    {
+        if (entry.option.isRequired() && !entry.seen)
+        {
+            std::string err = std::string(optionTypeName(entry.option.getType())) + " option "
+                            + entry.option.getLongArg() + " not found";
+            throw error::MIAException(error::ErrorCode::Missing_Argument, err);
+        }
+    }
+}
+
+
+bool CommandLine::isSet(std::string_view longArg) const
+{
+    int index = findLong(longArg);
+    return index >= 0 && entries[index].seen;
+}
+
+
+std::string CommandLine::getHelp() const
+{
+    std::string help;
+    for (const HelpItem& item : helpItems)
+    {
+        if (!item.heading.empty())
+        {
+            // Separate sections with a blank line.
+            if (!help.empty())
+                help += "\n";
+            help += item.heading + "\n";
+        }
+        else
+            help += entries[item.entry].option.getHelp() + "\n";
+    }
+    return help;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file CommandLine.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * @brief Defines the CommandLine class, a table-driven, single-pass command-line parser.
+ *
+ * Options are registered once together with a typed sink (the variable which receives the
+ * value). Registration builds a lookup table (a direct table for short options and a sorted
+ * table for long options), and parse() then walks argv exactly once, dispatching each value
+ * straight to its sink. This replaces calling CommandOption::getOptionVal() per option, which
+ * rescans the full argv for every option.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <variant>
+#include <cstdint>
+
+// Used for the registered options.
+#include "CommandOption.hpp"
+
+/**
+ * @class CommandLine
+ * @brief Parses argv in a single pass into the sinks of registered CommandOptions.
+ *
+ * Supported syntax:
+ *   - "--long value" and "--long=value".
+ *   - "-s value" and "-svalue".
+ *   - Bundled short flags (e.g. "-vt" is "-v -t"). A value option may end a bundle, in which
+ *     case the rest of the token or the next argument is its value (e.g. "-vd2" or "-vd 2").
+ *   - "--" ends option parsing; everything after it is positional.
+ *
+ * Boolean options are set to true when present and may be given an explicit value with
+ * "--flag=true" or "--flag=false". Options not present on the command line leave their sink
+ * untouched, so sinks should hold their default values before parse() is called. Unknown
+ * options are collected (see getUnknownArgs()) rather than treated as errors.
+ */
+class CommandLine
+{
+public:
+    /**
+     * @brief Constructs an empty command line with no registered options.
+     */
+    CommandLine() = default;
+
+    /**
+     * Registers an option and the variable that receives its value.
+     * @param option[const CommandOption&] - The option to register (copied).
+     * @param sink[Type&] - The variable set when the option is parsed. It must outlive parse().
+     * @throws MIAException(Invalid_Type_Requested) - If the sink type does not match the option type.
+     * @throws MIAException(Invalid_Argument) - If the option names are malformed or already registered.
+     */
+    void addOption(const CommandOption& option, bool& sink);
+    void addOption(const CommandOption& option, int& sink);
+    void addOption(const CommandOption& option, unsigned int& sink);
+    void addOption(const CommandOption& option, double& sink);
+    void addOption(const CommandOption& option, std::string& sink);
+
+    /**
+     * Starts a new section in the generated help. Options added afterwards are listed under it.
+     * @param heading[const std::string&] - The section heading (e.g., "MIATemplate specific options:").
+     */
+    void addHelpSection(const std::string& heading);
+
+    /**
+     * Walks argv once, writing the value of every registered option that is present to its sink.
+     * @param argc[int] - Argument count.
+     * @param argv[char**] - Argument values. argv[0] is skipped.
+     * @throws MIAException(Invalid_Argument) - If a value cannot be converted to its option's type
+     *     or a value option is missing its value.
+     * @throws MIAException(Missing_Argument) - If a required option is not present.
+     */
+    void parse(int argc, char* argv[]);
+
+    /**
+     * Returns whether an option was present in the last parse().
+     * @param longArg[std::string_view] - The long form of the option (e.g., "--config").
+     * @return bool - True if the option was present; false if absent or not registered.
+     */
+    bool isSet(std::string_view longArg) const;
+
+    /**
+     * Returns the arguments which were neither options nor option values.
+     * @return const std::vector<std::string>& - The positional arguments in order.
+     */
+    const std::vector<std::string>& getPositionalArgs() const
+    { return positionalArgs; }
+
+    /**
+     * Returns the option-like arguments which did not match any registered option.
+     * @return const std::vector<std::string>& - The unknown arguments in order.
+     */
+    const std::vector<std::string>& getUnknownArgs() const
+    { return unknownArgs; }
+
+    /**
+     * Generates the help text for every registered option, grouped by help section.
+     * Each option is formatted by CommandOption::getHelp() and followed by a newline.
+     * @return std::string - The help text.
+     */
+    std::string getHelp() const;
+
+private:
+    /// A pointer to the variable which receives a parsed option value.
+    using Sink = std::variant<bool*, int*, unsigned int*, double*, std::string*>;
+
+    /**
+     * @brief A registered option, its sink and its state from the last parse().
+     */
+    struct Entry
+    {
+        CommandOption option;   ///< The registered option.
+        Sink sink;              ///< Receives the parsed value.
+        bool seen{false};       ///< True if the option was present in the last parse().
+    };
+
+    /**
+     * @brief A line of the generated help: either a section heading or an option.
+     */
+    struct HelpItem
+    {
+        std::string heading;    ///< The section heading (empty for options).
+        std::size_t entry{0};   ///< The option index (only used if heading is empty).
+    };
+
+    /**
+     * Validates and registers an option with its sink.
+     * @param option[const CommandOption&] - The option to register.
+     * @param sink[Sink] - The sink for the option value.
+     * @param expected[CommandOption::commandOptionType] - The option type matching the sink.
+     * @param typeName[const char*] - The sink type name used in errors.
+     */
+    void addEntry(const CommandOption& option,
+                  Sink sink,
+                  CommandOption::commandOptionType expected,
+                  const char* typeName);
+
+    /**
+     * Returns the index of the option with the given long name, or -1 if there is none.
+     * @param name[std::string_view] - The long name including the leading "--".
+     * @return int - The entry index, or -1.
+     */
+    int findLong(std::string_view name) const;
+
+    /**
+     * Converts a value and writes it to the sink of an entry.
+     * @param entry[Entry&] - The option being set.
+     * @param name[std::string_view] - The option as written on the command line (used in errors).
+     * @param value[std::string_view] - The value text.
+     * @throws MIAException(Invalid_Argument) - If the value cannot be converted.
+     */
+    static void assign(Entry& entry, std::string_view name, std::string_view value);
+
+    /// The registered options in registration order.
+    std::vector<Entry> entries;
+
+    /// The long option names sorted by name, with their entry index.
+    std::vector<std::pair<std::string, std::uint32_t>> longTable;
+
+    /// The entry index (+1) of each single-character short option, indexed by character; 0 if none.
+    std::array<std::uint32_t, 128> shortTable{};
+
+    /// The generated help layout.
+    std::vector<HelpItem> helpItems;
+
+    /// Arguments which were not options, from the last parse().
+    std::vector<std::string> positionalArgs;
+
+    /// Unrecognized option arguments, from the last parse().
+    std::vector<std::string> unknownArgs;
+}; // class CommandLine
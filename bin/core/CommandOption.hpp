@@ -64,7 +64,8 @@ public:
     std::string getHelp() const
     {
         const size_t paddingWidth = 24; // total space reserved for shortArg + longArg + spaces
-        size_t currentLength = shortArg.size() + 2 /*", "*/ + longArg.size();
+        // A missing short option is padded as if it were two characters so descriptions align.
+        size_t currentLength = (shortArg.empty() ? 2 : shortArg.size()) + 2 /*", "*/ + longArg.size();
 
         // Calculate spaces needed, at least 2 spaces for readability
         size_t spaces = std::max<size_t>(2, paddingWidth > currentLength ? paddingWidth - currentLength : 2);
@@ -75,6 +76,34 @@ public:
             return "  " + shortArg + ", " + longArg + std::string(spaces, ' ') + description;
     }
     
+    /**
+     * Returns the short form of the option (e.g., "-c"), or an empty string if there is none.
+     * @return const std::string& - The short option.
+     */
+    const std::string& getShortArg() const
+    { return shortArg; }
+
+    /**
+     * Returns the long form of the option (e.g., "--config").
+     * @return const std::string& - The long option.
+     */
+    const std::string& getLongArg() const
+    { return longArg; }
+
+    /**
+     * Returns the type of value this option expects.
+     * @return commandOptionType - The option type.
+     */
+    commandOptionType getType() const
+    { return type; }
+
+    /**
+     * Returns whether this option is required.
+     * @return bool - True if the option must be specified.
+     */
+    bool isRequired() const
+    { return requiredOption; }
+
     /**
      * Templated method to retrieve the parsed command-line option value.
      * Dispatches to the correct command_parser method based on the template type.
@@ -0,0 +1,212 @@
+/**
+ * @file ConfigCache.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements reading and writing of compiled configuration snapshots.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <system_error>
+
+// Include the associated header file.
+#include "ConfigCache.hpp"
+// Used to write the cache files atomically.
+#include "BasicUtilities.hpp"
+
+namespace config
+{
+    namespace config_cache
+    {
+        namespace
+        {
+            /// The magic bytes at the start of every cache file.
+            constexpr char MAGIC[8] = {'M', 'I', 'A', 'C', 'F', 'G', '\0', '\0'};
+
+            /**
+             * @brief Rounds a byte count up to the next multiple of 8.
+             * @param size[std::uint64_t] - The byte count.
+             * @return [std::uint64_t] - The aligned byte count.
+             */
+            constexpr std::uint64_t align8(std::uint64_t size)
+            { return (size + 7) & ~static_cast<std::uint64_t>(7); }
+
+            /**
+             * @brief Reads the size and modification time of a file.
+             * @param filePath[const std::string&] - The file to inspect.
+             * @param size[std::uint64_t&] - Receives the file size.
+             * @param mtime[std::int64_t&] - Receives the modification time in file clock ticks.
+             * @return [bool] - True if the file exists and could be inspected.
+             */
+            bool getSourceStamp(const std::string& filePath, std::uint64_t& size, std::int64_t& mtime)
+            {
+                std::error_code errCode;
+                size = std::filesystem::file_size(filePath, errCode);
+                if (errCode)
+                    return false;
+                auto writeTime = std::filesystem::last_write_time(filePath, errCode);
+                if (errCode)
+                    return false;
+                mtime = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+                return true;
+            }
+
+            /**
+             * @brief Returns true if a file clock time is within RACY_WINDOW_SECONDS of now.
+             * @param mtime[std::int64_t] - The modification time in file clock ticks.
+             * @return [bool] - True if the time is too recent to trust for change detection.
+             */
+            bool isRacy(std::int64_t mtime)
+            {
+                using FileClock = std::filesystem::file_time_type::clock;
+                auto modified = std::filesystem::file_time_type(FileClock::duration(mtime));
+                return FileClock::now() - modified < std::chrono::seconds(RACY_WINDOW_SECONDS);
+            }
+        } // anonymous namespace
+
+
+        std::string getCachePath(const std::string& filePath, constants::ConfigType configType)
+        {
+            const char* tag = configType == constants::ConfigType::KEY_VALUE ? KEY_VALUE_TAG : RAW_LINES_TAG;
+            return filePath + tag + CACHE_EXTENSION;
+        }
+
+
+        std::uint64_t hashBytes(std::string_view bytes)
+        {
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (char ch : bytes)
+            {
+                hash ^= static_cast<unsigned char>(ch);
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+
+        bool openCache(const std::string& filePath,
+                       constants::ConfigType configType,
+                       ConfigFileBuffer& buffer,
+                       CacheView& view)
+        {
+            std::uint64_t sourceSize;
+            std::int64_t sourceMtime;
+            if (!getSourceStamp(filePath, sourceSize, sourceMtime))
+                return false;
+
+            ConfigFileBuffer mapped;
+            if (!mapped.map(getCachePath(filePath, configType)))
+                return false;
+
+            std::string_view bytes = mapped.view();
+            if (bytes.size() < sizeof(Header))
+                return false;
+
+            Header header;
+            std::memcpy(&header, bytes.data(), sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+                header.version != FORMAT_VERSION ||
+                header.configType != static_cast<std::uint32_t>(configType) ||
+                header.sourceSize != sourceSize ||
+                header.sourceMtime != sourceMtime)
+                return false;
+
+            // Validate that every section lies within the file before handing out pointers.
+            if (header.intPoolCount > bytes.size() || header.stringPoolSize > bytes.size())
+                return false;
+            std::uint64_t recordsOffset = sizeof(Header);
+            std::uint64_t slotsOffset = recordsOffset + align8(std::uint64_t(header.recordCount) * header.recordSize);
+            std::uint64_t intPoolOffset = slotsOffset + align8(std::uint64_t(header.slotCount) * sizeof(std::uint32_t));
+            std::uint64_t poolOffset = intPoolOffset + align8(header.intPoolCount * sizeof(std::int32_t));
+            if (poolOffset != header.stringPoolOffset ||
+                header.stringPoolSize != header.sourceSize ||
+                header.stringPoolOffset + header.stringPoolSize > bytes.size())
+                return false;
+
+            std::string_view pool = bytes.substr(header.stringPoolOffset, header.stringPoolSize);
+
+            // The modification time can't distinguish edits made within the same clock tick as the
+            // cache write, so verify those sources by content.
+            if (header.racy != 0)
+            {
+                ConfigFileBuffer source;
+                try
+                {
+                    source.load(filePath);
+                }
+                catch (...)
+                {
+                    return false;
+                }
+                if (hashBytes(source.view()) != header.sourceHash)
+                    return false;
+
+                // Once the source is outside the racy window its modification time can be trusted
+                // again, so rewrite the cache without the flag to skip the hash on later loads. The
+                // content is unchanged, and failing to rewrite only means the hash is checked again.
+                if (!isRacy(sourceMtime))
+                {
+                    header.racy = 0;
+                    BasicUtilities::replaceFile(getCachePath(filePath, configType), [&bytes, &header](std::ofstream& out)
+                    {
+                        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+                        out.write(bytes.data() + sizeof(Header), static_cast<std::streamsize>(bytes.size() - sizeof(Header)));
+                    });
+                }
+            }
+
+            view.header = header;
+            view.records = bytes.data() + recordsOffset;
+            view.slots = bytes.data() + slotsOffset;
+            view.intPool = bytes.data() + intPoolOffset;
+            view.stringPool = pool;
+            buffer = std::move(mapped);
+            return true;
+        }
+
+
+        bool writeCache(const std::string& filePath, const CacheContents& contents)
+        {
+            std::uint64_t sourceSize;
+            std::int64_t sourceMtime;
+            if (!getSourceStamp(filePath, sourceSize, sourceMtime) || sourceSize != contents.source.size())
+                return false;
+
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = FORMAT_VERSION;
+            header.configType = static_cast<std::uint32_t>(contents.configType);
+            header.sourceSize = sourceSize;
+            header.sourceMtime = sourceMtime;
+            header.sourceHash = hashBytes(contents.source);
+            header.racy = isRacy(sourceMtime) ? 1 : 0;
+            header.recordCount = contents.recordCount;
+            header.recordSize = contents.recordSize;
+            header.slotCount = static_cast<std::uint32_t>(contents.slots.size());
+            header.intPoolCount = contents.intPool.size();
+            header.stringPoolOffset = sizeof(Header)
+                                    + align8(contents.records.size())
+                                    + align8(contents.slots.size() * sizeof(std::uint32_t))
+                                    + align8(contents.intPool.size() * sizeof(std::int32_t));
+            header.stringPoolSize = contents.source.size();
+
+            return BasicUtilities::replaceFile(getCachePath(filePath, contents.configType), [&header, &contents](std::ofstream& out)
+            {
+                const char padding[8] = {};
+                auto writeSection = [&out, &padding](const void* data, std::uint64_t size)
+                {
+                    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                    out.write(padding, static_cast<std::streamsize>(align8(size) - size));
+                };
+
+                writeSection(&header, sizeof(Header));
+                writeSection(contents.records.data(), contents.records.size());
+                writeSection(contents.slots.data(), contents.slots.size() * sizeof(std::uint32_t));
+                writeSection(contents.intPool.data(), contents.intPool.size() * sizeof(std::int32_t));
+                out.write(contents.source.data(), static_cast<std::streamsize>(contents.source.size()));
+            });
+        }
+    } // namespace config_cache
+} // namespace config
@@ -0,0 +1,193 @@
+/**
+ * @file ConfigCache.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Declares the binary compiled configuration cache used by MIAConfig. After a text
+ *     configuration file is parsed, a snapshot of the parsed data is written next to it. Later
+ *     loads map the snapshot directly instead of tokenizing and parsing the text again, and fall
+ *     back to the text file whenever the snapshot does not match it.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Used for the ConfigType.
+#include "Constants.hpp"
+// Used for the ConfigFileBuffer.
+#include "ConfigParser.hpp"
+
+namespace config
+{
+    /**
+     * @namespace config_cache
+     * @brief Reading and writing of compiled configuration snapshots.
+     *
+     * A cache file consists of a Header, followed by fixed-size record arrays and a string pool.
+     * The string pool is a verbatim copy of the source file text, so every key, value and line
+     * is stored as an offset and length into it. All sections are 8-byte aligned so the file can
+     * be memory mapped and read in place.
+     *
+     * A cache is only used if its recorded source size and modification time match the source
+     * file. If the source was modified within RACY_WINDOW_SECONDS of the cache being written,
+     * the modification time alone cannot be trusted, so the source content hash is compared too.
+     * A racy cache which still matches by content is rewritten without the flag by openCache()
+     * once the source is outside the window, so only the loads right after a write pay for it.
+     */
+    namespace config_cache
+    {
+        /// The cache file format version. Increment whenever the layout below changes.
+        constexpr std::uint32_t FORMAT_VERSION = 1;
+
+        /// The extension appended to a configuration file path to form its cache path.
+        constexpr const char* CACHE_EXTENSION = ".cache";
+
+        /// Inserted before CACHE_EXTENSION for each ConfigType, so one file read as several types
+        /// keeps one cache per type instead of the types overwriting each other's cache.
+        constexpr const char* KEY_VALUE_TAG = ".kv";
+        constexpr const char* RAW_LINES_TAG = ".raw";
+
+        /// Source files modified this recently relative to the cache are verified by content hash.
+        constexpr std::int64_t RACY_WINDOW_SECONDS = 2;
+
+        /**
+         * @brief The fixed header at the start of every cache file.
+         */
+        struct Header
+        {
+            char magic[8];                  ///< Always "MIACFG" followed by two zero bytes.
+            std::uint32_t version;          ///< FORMAT_VERSION at the time of writing.
+            std::uint32_t configType;       ///< The constants::ConfigType of the cached data.
+            std::uint64_t sourceSize;       ///< Size of the source file in bytes.
+            std::int64_t sourceMtime;       ///< Modification time of the source (file clock ticks).
+            std::uint64_t sourceHash;       ///< FNV-1a hash of the source file contents.
+            std::uint32_t racy;             ///< Non-zero if sourceHash must be verified on load.
+            std::uint32_t recordCount;      ///< Number of records in the record section.
+            std::uint32_t recordSize;       ///< Size of each record in bytes.
+            std::uint32_t slotCount;        ///< Number of uint32 key slots following the records.
+            std::uint64_t intPoolCount;     ///< Number of int32 values following the key slots.
+            std::uint64_t stringPoolOffset; ///< Byte offset of the string pool from the file start.
+            std::uint64_t stringPoolSize;   ///< Size of the string pool in bytes.
+        };
+
+        /**
+         * @brief Cached form of a KEY_VALUE ConfigEntry.
+         */
+        struct EntryRecord
+        {
+            std::uint64_t keyHash;     ///< ConfigEntry::keyHash.
+            std::uint32_t keyOffset;   ///< Offset of the key in the string pool.
+            std::uint32_t keyLength;   ///< Length of the key.
+            std::uint32_t rawOffset;   ///< Offset of the raw value in the string pool.
+            std::uint32_t rawLength;   ///< Length of the raw value.
+            std::uint32_t valueType;   ///< ConfigValue::index() of the parsed value.
+            std::int32_t intValue;     ///< The int value, or the bool value as 0/1.
+            double doubleValue;        ///< The double value.
+            std::uint32_t listOffset;  ///< Offset of an int list in the int pool.
+            std::uint32_t listCount;   ///< Number of values in the int list.
+        };
+
+        /**
+         * @brief Cached form of a RAW_LINES ConfigLine.
+         */
+        struct LineRecord
+        {
+            std::uint64_t lineNumber;  ///< ConfigLine::lineNumber.
+            std::uint32_t offset;      ///< Offset of the line text in the string pool.
+            std::uint32_t length;      ///< Length of the line text.
+        };
+
+        /**
+         * @brief A read-only view of the sections of a validated, mapped cache file.
+         */
+        struct CacheView
+        {
+            /// The validated header.
+            Header header;
+
+            /// The start of the record section.
+            const char* records{nullptr};
+
+            /// The start of the key slot section.
+            const char* slots{nullptr};
+
+            /// The start of the int pool section.
+            const char* intPool{nullptr};
+
+            /// The string pool (the cached copy of the source text).
+            std::string_view stringPool;
+        };
+
+        /**
+         * @brief The sections of a cache file to be written.
+         */
+        struct CacheContents
+        {
+            /// The configuration type being cached.
+            constants::ConfigType configType;
+
+            /// The source text the records refer to (becomes the string pool).
+            std::string_view source;
+
+            /// The serialized records.
+            std::vector<char> records;
+
+            /// The number of records in records.
+            std::uint32_t recordCount{0};
+
+            /// The size of each record.
+            std::uint32_t recordSize{0};
+
+            /// The key slot table (may be empty).
+            std::vector<std::uint32_t> slots;
+
+            /// The int pool (may be empty).
+            std::vector<std::int32_t> intPool;
+        };
+
+        /**
+         * @brief Returns the cache file path used for a configuration file read as a given type.
+         * @param filePath[const std::string&] - The configuration file path.
+         * @param configType[constants::ConfigType] - The configuration type being cached.
+         * @return [std::string] - The cache file path (e.g. "file.MIA.kv.cache").
+         */
+        std::string getCachePath(const std::string& filePath, constants::ConfigType configType);
+
+        /**
+         * @brief Computes the 64-bit FNV-1a hash of a block of bytes.
+         * @param bytes[std::string_view] - The bytes to hash.
+         * @return [std::uint64_t] - The hash.
+         */
+        std::uint64_t hashBytes(std::string_view bytes);
+
+        /**
+         * @brief Maps and validates the cache for a configuration file.
+         * @param filePath[const std::string&] - The configuration (source) file path.
+         * @param configType[constants::ConfigType] - The configuration type expected in the cache.
+         * @param buffer[ConfigFileBuffer&] - Receives the mapped cache file on success.
+         * @param view[CacheView&] - Receives the cache sections on success.
+         * @return [bool] - True if a valid, up to date cache was mapped; false otherwise.
+         * @note A racy cache whose source is now outside RACY_WINDOW_SECONDS is rewritten in place
+         *     (through a temporary file) with the racy flag cleared.
+         */
+        bool openCache(const std::string& filePath,
+                       constants::ConfigType configType,
+                       ConfigFileBuffer& buffer,
+                       CacheView& view);
+
+        /**
+         * @brief Writes the cache for a configuration file.
+         *
+         * The cache is written to a temporary file and renamed into place, so readers never see a
+         * partially written cache. Failures (e.g. a read-only configuration directory) are not
+         * errors; the configuration is simply parsed from text next time.
+         * @param filePath[const std::string&] - The configuration (source) file path.
+         * @param contents[const CacheContents&] - The sections to write.
+         * @return [bool] - True if the cache was written.
+         */
+        bool writeCache(const std::string& filePath, const CacheContents& contents);
+    } // namespace config_cache
+} // namespace config
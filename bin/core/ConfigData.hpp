@@ -13,6 +13,10 @@
 
 // Used for the ConfigType
 #include "Constants.hpp"
+// Used for the pre-parsed ConfigEntry type.
+#include "ConfigValue.hpp"
+// Used for the ConfigLine and ConfigParseIssue types.
+#include "ConfigParser.hpp"
 
 namespace config
 {
@@ -83,6 +87,22 @@ namespace config
          */
         virtual std::vector<int> getIntVector(const std::string& key, char delimiter) const = 0;
 
+        /**
+         * @brief Retrieves the index of the pre-parsed entry for a key.
+         * @param key[const std::string&] - The key to look up.
+         * @return [std::size_t] - The index of the entry, usable with getEntry().
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual std::size_t getKeyIndex(const std::string& key) const = 0;
+
+        /**
+         * @brief Retrieves a pre-parsed entry by index.
+         * @param index[std::size_t] - The index of the entry (see getKeyIndex()).
+         * @return [const ConfigEntry*] - The entry, or nullptr if the index is out of range.
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual const ConfigEntry* getEntry(std::size_t index) const = 0;
+
         /**
          * @brief Retrieves all key-value pairs stored in the configuration.
          * @return [std::vector<constants::KeyValuePair>] - A vector of all key-value pairs.
@@ -97,6 +117,20 @@ namespace config
          */
         virtual std::vector<std::string> getRawLines() const = 0;
 
+        /**
+         * @brief Retrieves all content lines with their line numbers.
+         * @return [const std::vector<ConfigLine>&] - The content lines, viewing the loaded file buffer.
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual const std::vector<ConfigLine>& getLines() const = 0;
+
+        /**
+         * @brief Retrieves the issues found while parsing the last loaded file.
+         * @return [const std::vector<ConfigParseIssue>&] - The issues with line and column information.
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual const std::vector<ConfigParseIssue>& getParseIssues() const = 0;
+
         /**
          * @brief Outputs the configuration data to the specified stream.
          * @param os[std::ostream&] - The output stream to write to.
@@ -112,6 +146,23 @@ namespace config
          */
         virtual void load(const std::string& filePath, bool verboseMode) = 0;
 
+        /**
+         * @brief Loads configuration data from the compiled cache of a file, if it is up to date.
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during loading.
+         * @return [bool] - True if the cache was valid and loaded; false if load() must be used.
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual bool loadCache(const std::string& filePath, bool verboseMode) = 0;
+
+        /**
+         * @brief Writes the compiled cache for the data most recently loaded by load().
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during writing.
+         * @note Pure virtual; must be implemented by derived classes.
+         */
+        virtual void writeCache(const std::string& filePath, bool verboseMode) const = 0;
+
         /**
          * @brief Retrieves the type of configuration data stored.
          * @return [constants::ConfigType] - The configuration type (e.g., KEY_VALUE, RAW_LINES).
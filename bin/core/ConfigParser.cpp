@@ -0,0 +1,208 @@
+/**
+ * @file ConfigParser.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the single-pass configuration file buffer and tokenizers.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+
+// Include the associated header file.
+#include "ConfigParser.hpp"
+// Used for exception calls and handling.
+#include "MIAException.hpp"
+// Used for the IS_LINUX platform check.
+#include "Constants.hpp"
+
+#ifdef IS_LINUX
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace config
+{
+    void ConfigFileBuffer::load(const std::string& filePath)
+    {
+        std::FILE* file = std::fopen(filePath.c_str(), "rb");
+        if (file == nullptr)
+        {
+            std::string err = "Failed to open config file: " + filePath;
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, err);
+        }
+
+        // Size the buffer once and read the whole file with a single call.
+        std::fseek(file, 0, SEEK_END);
+        long fileSize = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (fileSize < 0)
+        {
+            std::fclose(file);
+            std::string err = "Failed to read config file: " + filePath;
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, err);
+        }
+
+        data = std::unique_ptr<char[], ConfigBufferRelease>(new char[static_cast<std::size_t>(fileSize) + 1]);
+        size = std::fread(data.get(), 1, static_cast<std::size_t>(fileSize), file);
+        data[size] = '\0';
+        std::fclose(file);
+    }
+
+
+    bool ConfigFileBuffer::map(const std::string& filePath)
+    {
+    #ifdef IS_LINUX
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat fileInfo;
+        if (::fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        std::size_t length = static_cast<std::size_t>(fileInfo.st_size);
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping stays valid after the descriptor is closed.
+        if (mapping == MAP_FAILED)
+            return false;
+
+        data = std::unique_ptr<char[], ConfigBufferRelease>(static_cast<char*>(mapping), ConfigBufferRelease{length, true});
+        size = length;
+        return true;
+    #else
+        try
+        {
+            load(filePath);
+            return true;
+        }
+        catch (const error::MIAException&)
+        {
+            return false;
+        }
+    #endif
+    }
+
+
+    void ConfigFileBuffer::assign(std::string_view text)
+    {
+        data = std::unique_ptr<char[], ConfigBufferRelease>(new char[text.size() + 1]);
+        std::memcpy(data.get(), text.data(), text.size());
+        data[text.size()] = '\0';
+        size = text.size();
+    }
+
+
+    void ConfigBufferRelease::operator()(char* ptr) const
+    {
+    #ifdef IS_LINUX
+        if (mapped)
+        {
+            ::munmap(ptr, length);
+            return;
+        }
+    #endif
+        delete[] ptr;
+    }
+
+
+    namespace config_parser
+    {
+        namespace
+        {
+            /**
+             * @brief Walks a buffer line by line, calling visit for each content line.
+             *
+             * Line endings ("\n" or "\r\n") are removed and the MIAConfig skip rules applied.
+             * @param buffer[std::string_view] - The text to walk.
+             * @param visit[Visitor] - Called as visit(std::string_view line, std::size_t lineNumber).
+             */
+            template<typename Visitor>
+            void forEachContentLine(std::string_view buffer, Visitor&& visit)
+            {
+                const char* cursor = buffer.data();
+                const char* end = cursor + buffer.size();
+                std::size_t lineNumber = 0;
+
+                while (cursor < end)
+                {
+                    ++lineNumber;
+                    const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+                    const char* lineEnd = newline ? newline : end;
+
+                    std::string_view line(cursor, lineEnd - cursor);
+                    if (!line.empty() && line.back() == '\r')
+                        line.remove_suffix(1);
+
+                    if (line.size() > 2 && line.front() != '#')
+                        visit(line, lineNumber);
+
+                    cursor = newline ? newline + 1 : end;
+                }
+            }
+        } // anonymous namespace
+
+
+        std::string_view stripView(std::string_view text)
+        {
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+                text.remove_prefix(1);
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+                text.remove_suffix(1);
+            return text;
+        }
+
+
+        void parseLines(std::string_view buffer, std::vector<ConfigLine>& lines)
+        {
+            lines.clear();
+            forEachContentLine(buffer, [&lines](std::string_view line, std::size_t lineNumber)
+            {
+                lines.push_back({line, lineNumber});
+            });
+        }
+
+
+        void parseKeyValues(std::string_view buffer,
+                            std::vector<KeyValueToken>& tokens,
+                            std::vector<ConfigParseIssue>& issues)
+        {
+            tokens.clear();
+            issues.clear();
+            forEachContentLine(buffer, [&](std::string_view line, std::size_t lineNumber)
+            {
+                std::size_t equalSign = line.find('=');
+                if (equalSign == std::string_view::npos)
+                {
+                    // Lines of only whitespace are not worth reporting.
+                    if (!stripView(line).empty())
+                        issues.push_back({lineNumber, 1, "Expected 'key=value' but no '=' was found."});
+                    return;
+                }
+
+                std::string_view key = stripView(line.substr(0, equalSign));
+                if (key.empty())
+                {
+                    issues.push_back({lineNumber, equalSign + 1, "Missing key before '='."});
+                    return;
+                }
+
+                std::string_view rest = line.substr(equalSign + 1);
+                std::string_view value = stripView(rest);
+                if (value.empty())
+                {
+                    issues.push_back({lineNumber, equalSign + 2, "Missing value after '='."});
+                    return;
+                }
+
+                std::size_t valueColumn = static_cast<std::size_t>(value.data() - line.data()) + 1;
+                tokens.push_back({key, value, lineNumber, valueColumn});
+            });
+        }
+    } // namespace config_parser
+} // namespace config
@@ -0,0 +1,183 @@
+/**
+ * @file ConfigParser.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Single-pass configuration file tokenizing used by the ConfigData implementations.
+ *     A configuration file is read into one retained buffer and tokenized in a single pass into
+ *     string_views which point into that buffer, so no per-line strings are allocated.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace config
+{
+    /**
+     * @brief A single content line of a configuration file.
+     *
+     * The text points into the ConfigFileBuffer it was parsed from and excludes any line ending.
+     */
+    struct ConfigLine
+    {
+        /// The line text (without '\n' or a trailing '\r').
+        std::string_view text;
+
+        /// The 1-based line number within the file.
+        std::size_t lineNumber{0};
+    };
+
+    /**
+     * @brief A key-value pair tokenized from a configuration line.
+     *
+     * The key and value are stripped of surrounding whitespace and point into the buffer.
+     */
+    struct KeyValueToken
+    {
+        /// The key text (left of the first '=').
+        std::string_view key;
+
+        /// The value text (right of the first '=').
+        std::string_view value;
+
+        /// The 1-based line number of the pair.
+        std::size_t lineNumber{0};
+
+        /// The 1-based column at which the value begins.
+        std::size_t valueColumn{0};
+    };
+
+    /**
+     * @brief A problem found while tokenizing a configuration file.
+     */
+    struct ConfigParseIssue
+    {
+        /// The 1-based line number of the issue.
+        std::size_t lineNumber{0};
+
+        /// The 1-based column of the issue.
+        std::size_t column{0};
+
+        /// A description of the issue.
+        std::string message;
+    };
+
+    /**
+     * @brief Releases ConfigFileBuffer storage by either unmapping or deleting it.
+     */
+    struct ConfigBufferRelease
+    {
+        /// The length of the mapping (only used when mapped is true).
+        std::size_t length{0};
+
+        /// True if the storage is a memory mapping rather than a heap allocation.
+        bool mapped{false};
+
+        /**
+         * @brief Unmaps or deletes the storage.
+         * @param ptr[char*] - The storage to release.
+         */
+        void operator()(char* ptr) const;
+    };
+
+    /**
+     * @class ConfigFileBuffer
+     * @brief Owns the full contents of a configuration file read with a single read call.
+     *
+     * Views produced by the config_parser functions point into this buffer, so it must outlive
+     * them. The storage is either heap allocated or a read-only memory mapping and is never
+     * reallocated, which keeps views valid if the buffer object itself is moved.
+     */
+    class ConfigFileBuffer
+    {
+    public:
+        /**
+         * @brief Constructs an empty buffer.
+         */
+        ConfigFileBuffer() = default;
+
+        /**
+         * @brief Deleted copy operations (copies would not carry views with them).
+         */
+        ConfigFileBuffer(const ConfigFileBuffer&) = delete;
+        ConfigFileBuffer& operator=(const ConfigFileBuffer&) = delete;
+        ConfigFileBuffer(ConfigFileBuffer&&) = default;
+        ConfigFileBuffer& operator=(ConfigFileBuffer&&) = default;
+
+        /**
+         * @brief Reads an entire file into the buffer, replacing any previous contents.
+         * @param filePath[const std::string&] - The path of the file to read.
+         * @throws MIAException(Failed_To_Open_File) If the file cannot be opened or read.
+         */
+        void load(const std::string& filePath);
+
+        /**
+         * @brief Maps an entire file read-only into the buffer, replacing any previous contents.
+         *
+         * On platforms without mmap support this falls back to load().
+         * @param filePath[const std::string&] - The path of the file to map.
+         * @return [bool] - True if the file was mapped (or read); false if it could not be opened.
+         */
+        bool map(const std::string& filePath);
+
+        /**
+         * @brief Replaces the buffer contents with a copy of the given text.
+         * @param text[std::string_view] - The text to store.
+         */
+        void assign(std::string_view text);
+
+        /**
+         * @brief Returns a view of the entire buffer.
+         * @return [std::string_view] - The buffer contents.
+         */
+        std::string_view view() const
+        { return std::string_view(data.get(), size); }
+
+    private:
+        /// The file contents.
+        std::unique_ptr<char[], ConfigBufferRelease> data;
+
+        /// The number of bytes in data.
+        std::size_t size{0};
+    };
+
+    /**
+     * @namespace config_parser
+     * @brief Single-pass tokenizers for configuration file buffers.
+     *
+     * Both tokenizers apply the same line filtering that MIAConfig has always used: blank lines,
+     * lines starting with '#' and lines shorter than three characters are skipped.
+     */
+    namespace config_parser
+    {
+        /**
+         * @brief Splits a buffer into content lines.
+         * @param buffer[std::string_view] - The configuration file text.
+         * @param lines[std::vector<ConfigLine>&] - Cleared and filled with the content lines.
+         */
+        void parseLines(std::string_view buffer, std::vector<ConfigLine>& lines);
+
+        /**
+         * @brief Tokenizes a buffer into key-value pairs separated by '='.
+         *
+         * Content lines without a key, without an '=' or with an empty value are skipped and
+         * reported as an issue with the exact line and column.
+         * @param buffer[std::string_view] - The configuration file text.
+         * @param tokens[std::vector<KeyValueToken>&] - Cleared and filled with the pairs found.
+         * @param issues[std::vector<ConfigParseIssue>&] - Cleared and filled with any issues found.
+         */
+        void parseKeyValues(std::string_view buffer,
+                            std::vector<KeyValueToken>& tokens,
+                            std::vector<ConfigParseIssue>& issues);
+
+        /**
+         * @brief Removes leading and trailing whitespace from a view without copying.
+         * @param text[std::string_view] - The text to strip.
+         * @return [std::string_view] - The stripped view.
+         */
+        std::string_view stripView(std::string_view text);
+    } // namespace config_parser
+} // namespace config
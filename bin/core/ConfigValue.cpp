@@ -0,0 +1,307 @@
+/**
+ * @file ConfigValue.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements parsing and typed conversion of pre-parsed configuration values.
+ */
+
+#include <charconv>
+#include <cctype>
+#include <cmath>
+
+// Include the associated header file.
+#include "ConfigValue.hpp"
+// Used for exception calls and handling.
+#include "MIAException.hpp"
+
+namespace config
+{
+    namespace
+    {
+        /**
+         * @brief Attempts to parse the entire string view as an int.
+         * @param text[std::string_view] - The text to parse.
+         * @param out[int&] - Set to the parsed value on success.
+         * @return [bool] - True if the whole text was a valid, in-range integer.
+         */
+        bool parseFullInt(std::string_view text, int& out)
+        {
+            if (!text.empty() && text.front() == '+')
+                text.remove_prefix(1);
+            if (text.empty())
+                return false;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+            return ec == std::errc() && ptr == text.data() + text.size();
+        }
+
+        /**
+         * @brief Attempts to parse the entire string view as a double (including inf/infinity).
+         * @param text[std::string_view] - The text to parse.
+         * @param out[double&] - Set to the parsed value on success.
+         * @return [bool] - True if the whole text was a valid floating point value.
+         */
+        bool parseFullDouble(std::string_view text, double& out)
+        {
+            if (text == "inf" || text == "infinity")
+            {
+                out = std::numeric_limits<double>::infinity();
+                return true;
+            }
+            if (!text.empty() && text.front() == '+')
+                text.remove_prefix(1);
+            if (text.empty())
+                return false;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+            return ec == std::errc() && ptr == text.data() + text.size();
+        }
+
+        /**
+         * @brief Attempts to parse a boolean keyword (true/false/yes/no/on/off, any case).
+         * @param text[std::string_view] - The text to parse.
+         * @param out[bool&] - Set to the parsed value on success.
+         * @return [bool] - True if the text was a recognized boolean keyword.
+         */
+        bool parseBoolKeyword(std::string_view text, bool& out)
+        {
+            if (text.size() < 2 || text.size() > 5)
+                return false;
+            char lowerBuffer[5];
+            for (std::size_t i = 0; i < text.size(); ++i)
+                lowerBuffer[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+            std::string_view lower(lowerBuffer, text.size());
+            if (lower == "true" || lower == "yes" || lower == "on")
+                out = true;
+            else if (lower == "false" || lower == "no" || lower == "off")
+                out = false;
+            else
+                return false;
+            return true;
+        }
+
+        /**
+         * @brief Splits text on a delimiter and parses each non-empty item as an int.
+         * @param text[std::string_view] - The text to split and parse.
+         * @param delimiter[char] - The item delimiter.
+         * @param out[std::vector<int>&] - Receives the parsed values.
+         * @return [bool] - True if every non-empty item was a valid integer.
+         */
+        bool parseIntList(std::string_view text, char delimiter, std::vector<int>& out)
+        {
+            out.clear();
+            while (true)
+            {
+                std::size_t pos = text.find(delimiter);
+                std::string_view item = text.substr(0, pos);
+                while (!item.empty() && std::isspace(static_cast<unsigned char>(item.front())))
+                    item.remove_prefix(1);
+                while (!item.empty() && std::isspace(static_cast<unsigned char>(item.back())))
+                    item.remove_suffix(1);
+                if (!item.empty())
+                {
+                    int value;
+                    if (!parseFullInt(item, value))
+                        return false;
+                    out.push_back(value);
+                }
+                if (pos == std::string_view::npos)
+                    break;
+                text.remove_prefix(pos + 1);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Checks whether text is an optionally signed run of decimal digits.
+         * @param text[std::string_view] - The text to check.
+         * @return [bool] - True if the text is an integer literal (regardless of its range).
+         */
+        bool isIntegerLiteral(std::string_view text)
+        {
+            if (!text.empty() && (text.front() == '+' || text.front() == '-'))
+                text.remove_prefix(1);
+            if (text.empty())
+                return false;
+            for (char ch : text)
+            {
+                if (!std::isdigit(static_cast<unsigned char>(ch)))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Checks whether text begins like a number (an optional sign, then a digit or '.').
+         * @param text[std::string_view] - The text to check.
+         * @return [bool] - True if the text starts with a numeric prefix.
+         */
+        bool looksNumeric(std::string_view text)
+        {
+            if (!text.empty() && (text.front() == '+' || text.front() == '-'))
+                text.remove_prefix(1);
+            return !text.empty() && (std::isdigit(static_cast<unsigned char>(text.front())) || text.front() == '.');
+        }
+
+        /**
+         * @brief Throws the standard type-mismatch error for a configuration entry.
+         * @param entry[const ConfigEntry&] - The entry that failed conversion.
+         * @param requested[const char*] - The name of the requested type.
+         */
+        [[noreturn]] void throwTypeMismatch(const ConfigEntry& entry, const char* requested)
+        {
+            std::string err = "Configuration value for key '" + std::string(entry.key) + "' ("
+                            + std::string(entry.raw) + ") is of type " + configValueTypeName(entry.value)
+                            + " and cannot be read as " + requested + ".";
+            throw error::MIAException(error::ErrorCode::Invalid_Type_Requested, err);
+        }
+    } // anonymous namespace
+
+
+    ConfigValue parseConfigValue(std::string_view raw)
+    {
+        bool boolValue;
+        if (parseBoolKeyword(raw, boolValue))
+            return boolValue;
+
+        int intValue;
+        if (parseFullInt(raw, intValue))
+            return intValue;
+
+        double doubleValue;
+        if (parseFullDouble(raw, doubleValue))
+            return doubleValue;
+
+        std::vector<int> intList;
+        if (raw.find(',') != std::string_view::npos && parseIntList(raw, ',', intList))
+            return intList;
+
+        return raw;
+    }
+
+
+    std::string findMalformedValue(std::string_view raw, const ConfigValue& value, std::size_t& offset)
+    {
+        offset = 0;
+        if (std::holds_alternative<double>(value) && isIntegerLiteral(raw))
+            return "Integer value '" + std::string(raw) + "' is out of the int range and can only be read as a double.";
+
+        if (!std::holds_alternative<std::string_view>(value) || raw.find(',') == std::string_view::npos)
+            return {};
+
+        // A list is only malformed if every item looks numeric, otherwise it is a list of strings.
+        std::string_view badItem;
+        std::size_t badOffset = 0;
+        std::size_t start = 0;
+        while (start <= raw.size())
+        {
+            std::size_t end = raw.find(',', start);
+            if (end == std::string_view::npos)
+                end = raw.size();
+            std::string_view item = raw.substr(start, end - start);
+            std::size_t itemOffset = start;
+            while (!item.empty() && std::isspace(static_cast<unsigned char>(item.front())))
+            {
+                item.remove_prefix(1);
+                ++itemOffset;
+            }
+            while (!item.empty() && std::isspace(static_cast<unsigned char>(item.back())))
+                item.remove_suffix(1);
+
+            if (!item.empty())
+            {
+                if (!looksNumeric(item))
+                    return {};
+                int intValue;
+                double doubleValue;
+                bool valid = isIntegerLiteral(item) ? parseFullInt(item, intValue) : parseFullDouble(item, doubleValue);
+                if (!valid && badItem.empty())
+                {
+                    badItem = item;
+                    badOffset = itemOffset;
+                }
+            }
+            start = end + 1;
+        }
+
+        if (badItem.empty())
+            return {};
+        offset = badOffset;
+        return "List item '" + std::string(badItem) + "' is not a valid number, so the list can only be read as strings.";
+    }
+
+
+    std::string configValueTypeName(const ConfigValue& value)
+    {
+        switch (value.index())
+        {
+            case 0: return "string";
+            case 1: return "bool";
+            case 2: return "int";
+            case 3: return "double";
+            case 4: return "int list";
+            default: return "unknown";
+        }
+    }
+
+
+    int toInt(const ConfigEntry& entry)
+    {
+        if (const int* value = std::get_if<int>(&entry.value))
+            return *value;
+
+        // Integral doubles (e.g. 3.0) are accepted since no information is lost.
+        if (const double* value = std::get_if<double>(&entry.value))
+        {
+            if (std::isfinite(*value) && std::trunc(*value) == *value &&
+                *value >= std::numeric_limits<int>::min() && *value <= std::numeric_limits<int>::max())
+                return static_cast<int>(*value);
+        }
+        throwTypeMismatch(entry, "int");
+    }
+
+
+    double toDouble(const ConfigEntry& entry)
+    {
+        if (const double* value = std::get_if<double>(&entry.value))
+            return *value;
+        if (const int* value = std::get_if<int>(&entry.value))
+            return static_cast<double>(*value);
+        throwTypeMismatch(entry, "double");
+    }
+
+
+    bool toBool(const ConfigEntry& entry)
+    {
+        if (const bool* value = std::get_if<bool>(&entry.value))
+            return *value;
+        if (const int* value = std::get_if<int>(&entry.value))
+        {
+            if (*value == 0 || *value == 1)
+                return *value == 1;
+        }
+        throwTypeMismatch(entry, "bool");
+    }
+
+
+    std::string toString(const ConfigEntry& entry)
+    {
+        return std::string(entry.raw);
+    }
+
+
+    std::vector<int> toIntVector(const ConfigEntry& entry, char delimiter)
+    {
+        if (delimiter == ',')
+        {
+            if (const std::vector<int>* value = std::get_if<std::vector<int>>(&entry.value))
+                return *value;
+        }
+        if (const int* value = std::get_if<int>(&entry.value))
+            return {*value};
+
+        // Other delimiters were not pre-parsed at load, so fall back to parsing the raw text.
+        std::vector<int> result;
+        if (!parseIntList(entry.raw, delimiter, result))
+            throwTypeMismatch(entry, "int list");
+        return result;
+    }
+} // namespace config
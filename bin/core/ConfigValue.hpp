@@ -0,0 +1,173 @@
+/**
+ * @file ConfigValue.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Defines the typed, pre-parsed configuration value types used by MIAConfig.
+ *     Values are parsed and type-checked once when a configuration file is loaded and
+ *     stored in a variant. Typed ConfigKey handles allow repeated lookups of the same
+ *     key to skip both string hashing and value parsing.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace config
+{
+    /**
+     * @brief The pre-parsed value of a single configuration entry.
+     *
+     * The alternative held is the most specific type the raw text parsed as at load time.
+     * The order of detection is bool, int, double, std::vector<int> (comma separated) then
+     * std::string_view as the fallback for anything else. String views point into the buffer
+     * owned by the ConfigData object which loaded the entry.
+     */
+    using ConfigValue = std::variant<std::string_view, bool, int, double, std::vector<int>>;
+
+    /**
+     * @brief A single configuration entry as stored by the KEY_VALUE configuration type.
+     *
+     * The key and raw views point into the buffer owned by the ConfigData object which loaded
+     * the entry and are only valid while that object is loaded.
+     */
+    struct ConfigEntry
+    {
+        /// The key name of this entry.
+        std::string_view key;
+
+        /// The precomputed hash of the key name (see hashConfigKey()).
+        std::uint64_t keyHash{0};
+
+        /// The raw (stripped) value text as it appeared in the configuration file.
+        std::string_view raw;
+
+        /// The typed value parsed from raw at load time.
+        ConfigValue value;
+    };
+
+    /**
+     * @brief Computes a 64-bit FNV-1a hash of a configuration key name.
+     *
+     * This is constexpr so that hashes of well-known key names can be computed at compile time.
+     * @param key[std::string_view] - The key name to hash.
+     * @return [std::uint64_t] - The hash of the key name.
+     */
+    constexpr std::uint64_t hashConfigKey(std::string_view key)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (char ch : key)
+        {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief A typed handle to a configuration entry.
+     *
+     * A ConfigKey is resolved once via MIAConfig::getKey<T>(), which validates that the stored
+     * value converts to T. Subsequent MIAConfig::get() calls use the stored index directly and
+     * only fall back to a name lookup if the configuration was reloaded with a different layout.
+     * @tparam T - One of int, double, bool, std::string, std::string_view or std::vector<int>.
+     */
+    template<typename T>
+    struct ConfigKey
+    {
+        /// Value used for an index that has not been resolved yet.
+        static constexpr std::size_t UNRESOLVED = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * @brief Constructs an unresolved key for the given name.
+         * @param keyName[std::string_view] - The key name in the configuration file.
+         */
+        explicit ConfigKey(std::string_view keyName)
+            : name(keyName), hash(hashConfigKey(keyName)) {}
+
+        /// The key name in the configuration file.
+        std::string name;
+
+        /// The precomputed hash of name.
+        std::uint64_t hash;
+
+        /// The index of the entry within the loaded configuration (UNRESOLVED if not resolved).
+        mutable std::size_t index{UNRESOLVED};
+    };
+
+    /**
+     * @brief Parses raw configuration text into its most specific typed value.
+     * @param raw[std::string_view] - The stripped value text.
+     * @return [ConfigValue] - The parsed value.
+     */
+    ConfigValue parseConfigValue(std::string_view raw);
+
+    /**
+     * @brief Checks whether raw text holds a malformed typed value.
+     *
+     * Text which looks numeric but cannot be read as the intended type is reported here so that
+     * the problem surfaces when the file is loaded rather than when the value is first read. This
+     * covers integers outside the int range (which parse as double) and comma separated lists
+     * whose items are all numeric but not all valid integers (such as "1,2,3x"). Other text is a
+     * valid string value and is never reported.
+     * @param raw[std::string_view] - The stripped value text.
+     * @param value[const ConfigValue&] - The value parsed from raw by parseConfigValue().
+     * @param offset[std::size_t&] - Set to the offset within raw at which the problem begins.
+     * @return [std::string] - A description of the problem, or an empty string if there is none.
+     */
+    std::string findMalformedValue(std::string_view raw, const ConfigValue& value, std::size_t& offset);
+
+    /**
+     * @brief Returns a human readable name for the type held by a ConfigValue.
+     * @param value[const ConfigValue&] - The value to describe.
+     * @return [std::string] - The type name (e.g. "int", "string").
+     */
+    std::string configValueTypeName(const ConfigValue& value);
+
+    /**
+     * @name Typed conversions of a pre-parsed ConfigEntry.
+     * @brief Converts a pre-parsed ConfigEntry into the requested type without reparsing.
+     *
+     * Lossless widening conversions are allowed (int to double, int 0/1 to bool, a single int
+     * to a one element std::vector<int>). Any other mismatch is reported.
+     * @throws MIAException(Invalid_Type_Requested) If the entry does not hold a compatible value.
+     * @{
+     */
+    int toInt(const ConfigEntry& entry);
+    double toDouble(const ConfigEntry& entry);
+    bool toBool(const ConfigEntry& entry);
+    std::string toString(const ConfigEntry& entry);
+    std::vector<int> toIntVector(const ConfigEntry& entry, char delimiter = ',');
+    /** @} */
+
+    /**
+     * @brief Converts a pre-parsed ConfigEntry to T by dispatching to the matching toX() function.
+     * @tparam T - One of int, double, bool, std::string, std::string_view or std::vector<int>.
+     * @param entry[const ConfigEntry&] - The entry to convert.
+     * @return [T] - The converted value.
+     * @throws MIAException(Invalid_Type_Requested) If the entry does not hold a compatible value.
+     */
+    template<typename T>
+    T convertConfigValue(const ConfigEntry& entry)
+    {
+        if constexpr (std::is_same_v<T, int>)
+            return toInt(entry);
+        else if constexpr (std::is_same_v<T, double>)
+            return toDouble(entry);
+        else if constexpr (std::is_same_v<T, bool>)
+            return toBool(entry);
+        else if constexpr (std::is_same_v<T, std::string>)
+            return toString(entry);
+        else if constexpr (std::is_same_v<T, std::string_view>)
+            return entry.raw;
+        else if constexpr (std::is_same_v<T, std::vector<int>>)
+            return toIntVector(entry);
+        else
+            static_assert(!sizeof(T), "Unsupported configuration value type.");
+    }
+} // namespace config
@@ -61,6 +61,10 @@ namespace error
         Undefined_RPG_Value = 31434,          ///< A referenced value for the RPG system wasn't defined.
         Duplicate_RPG_Value = 31435,          ///< A duplicate RPG entry was added.
         Invalid_RPG_Data = 31436,             ///< An invalid combination/set of RPG data was used. 
+        Task_Cancelled = 31437,               ///< A scheduled task was cancelled before it ran.
+        Input_Backend_Unavailable = 31438,    ///< The requested input backend could not be opened.
+        Screen_Capture_Unavailable = 31439,   ///< The screen could not be captured.
+        Invalid_Model_File = 31440,           ///< A saved model file is invalid or of an unsupported version.
         Catastrophic_Failure = 9001           ///< Some unprogrammed error occured.
     };
 
@@ -43,6 +43,10 @@ namespace error
         { Undefined_RPG_Value, "A referenced value for the RPG system wasn't defined." },
         { Duplicate_RPG_Value, "A duplicate RPG entry was added." },
         { Invalid_RPG_Data, "An invalid combination/set of RPG data was used." }, 
+        { Task_Cancelled, "A scheduled task was cancelled before it ran." },
+        { Input_Backend_Unavailable, "The requested input backend could not be opened." },
+        { Screen_Capture_Unavailable, "The screen could not be captured." },
+        { Invalid_Model_File, "The model file is invalid or of an unsupported version." },
         { Catastrophic_Failure, "A catastrophic failure occurred." }
     };
 
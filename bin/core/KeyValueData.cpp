@@ -2,144 +2,279 @@
  * @file KeyValueData.cpp
  * @author Antonius Torode
  * @date 05/24/2025
- * Description: 
+ * Description: Implements the KeyValueData class which stores configuration files as
+ *              pre-parsed, typed key-value entries.
  */
 
-#include <fstream>
 #include <sstream>
+#include <cstring>
 #include <algorithm>
-#include <limits>
 
 // Include the associated header file.
 #include "KeyValueData.hpp"
 // Used for exception calls and handling.
 #include "MIAException.hpp"
-// Used for various string manipulation.
-#include "BasicUtilities.hpp"
+// Used for the single-pass file tokenizer.
+#include "ConfigParser.hpp"
+// Used for the compiled configuration cache.
+#include "ConfigCache.hpp"
 
 namespace config
 {     
     void KeyValueData::load(const std::string& filePath, bool verboseMode)
     {
-        std::ifstream file(filePath, std::ifstream::in);
-        if (!file.is_open()) 
-        {            
-            std::string err = "Failed to open config file: " + filePath;
-            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, err);
-        }
-        rawConfigValsMap.clear();
+        // Everything is loaded into locals and only swapped in on success, so a failed reload
+        // (e.g. the file was removed) leaves the previously loaded configuration intact.
+        ConfigFileBuffer loadedBuffer;
+        loadedBuffer.load(filePath);
 
-        std::string line;
-        std::vector<std::string> lines;
-        
-        while (std::getline(file, line)) 
-        {            
-            if (!line.empty() && line[0] != '#' && line.size()>2)
+        std::vector<KeyValueToken> tokens;
+        std::vector<ConfigParseIssue> issues;
+        config_parser::parseKeyValues(loadedBuffer.view(), tokens, issues);
+
+        std::vector<ConfigEntry> loaded;
+        loaded.reserve(tokens.size());
+        std::vector<std::uint32_t> loadedSlots(slotCountFor(tokens.size()), 0);
+        const std::size_t mask = loadedSlots.size() - 1;
+
+        for (const KeyValueToken& token : tokens)
+        {
+            if (verboseMode)
+                std::cout << "Config line read: " << token.key << "=" << token.value << std::endl;
+
+            ConfigEntry entry;
+            entry.key = token.key;
+            entry.keyHash = hashConfigKey(token.key);
+            entry.raw = token.value;
+            entry.value = parseConfigValue(token.value);
+
+            // Malformed typed values are kept (as read) but reported now rather than on access.
+            std::size_t issueOffset;
+            std::string issue = findMalformedValue(entry.raw, entry.value, issueOffset);
+            if (!issue.empty())
+                issues.push_back({token.lineNumber, token.valueColumn + issueOffset, std::move(issue)});
+
+            // Later duplicates replace earlier entries, matching the previous map behavior.
+            std::size_t slot = entry.keyHash & mask;
+            while (loadedSlots[slot] != 0 &&
+                   (loaded[loadedSlots[slot] - 1].keyHash != entry.keyHash || loaded[loadedSlots[slot] - 1].key != entry.key))
+                slot = (slot + 1) & mask;
+
+            if (loadedSlots[slot] == 0)
             {
-                if(verboseMode) 
-				    std::cout << "Config line read: " << line << std::endl;
-                lines.push_back(line);
+                loadedSlots[slot] = static_cast<std::uint32_t>(loaded.size() + 1);
+                loaded.push_back(std::move(entry));
+            }
+            else
+            {
+                loaded[loadedSlots[slot] - 1] = std::move(entry);
             }
         }
-        if(verboseMode) 
-		    std::cout << std::endl;
 
-        file.close();
-        
-        int size = lines.size();
-        int equalSignLocation;        
-        std::string variable, value;
-        for (int i=0; i<size;i++)
-        {
-            equalSignLocation = BasicUtilities::findCharInString(lines[i], '=');
-            if (equalSignLocation <= 0 || equalSignLocation >= static_cast<int>(lines[i].size()) - 1)
-                continue; // or log malformed line
-                
-            variable = BasicUtilities::strip(lines[i].substr(0, equalSignLocation));
-            value = lines[i].substr(equalSignLocation+1,lines[i].size()-1);
-
-            //removes end of line characters from variable name and value. Fixes a bug.
-            variable.erase(remove(variable.begin(), variable.end(), '\r'), variable.end());
-            value.erase(remove(value.begin(), value.end(), '\r'), value.end());
-
-            rawConfigValsMap[variable] = BasicUtilities::strip(value);
-        }
-        
+        std::stable_sort(issues.begin(), issues.end(),
+                         [](const ConfigParseIssue& a, const ConfigParseIssue& b) { return a.lineNumber < b.lineNumber; });
+
+        buffer = std::move(loadedBuffer);
+        entries = std::move(loaded);
+        keySlots = std::move(loadedSlots);
+        parseIssues = std::move(issues);
+
         if (verboseMode) 
         {
-            std::cout << "Finished loading raw lines from: " << filePath << std::endl;
+            for (const ConfigParseIssue& issue : parseIssues)
+                std::cout << filePath << ":" << issue.lineNumber << ":" << issue.column 
+                          << ": " << issue.message << std::endl;
+            std::cout << "Finished loading " << entries.size() << " entries from: " << filePath << std::endl;
         }
     }
 
 
-    int KeyValueData::getInt(const std::string& key) const
+    bool KeyValueData::loadCache(const std::string& filePath, bool verboseMode)
     {
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
+        ConfigFileBuffer mapped;
+        config_cache::CacheView view;
+        if (!config_cache::openCache(filePath, constants::ConfigType::KEY_VALUE, mapped, view) ||
+            view.header.recordSize != sizeof(config_cache::EntryRecord))
+            return false;
+
+        const std::size_t count = view.header.recordCount;
+        const std::size_t slotCount = view.header.slotCount;
+        if (slotCount < 16 || (slotCount & (slotCount - 1)) != 0 || slotCount < count * 2)
+            return false;
+
+        std::vector<std::uint32_t> loadedSlots(slotCount);
+        std::memcpy(loadedSlots.data(), view.slots, slotCount * sizeof(std::uint32_t));
+        for (std::uint32_t slot : loadedSlots)
         {
-            std::string err = "Can't find key in configuration map: " + key;
-            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
+            if (slot > count)
+                return false;
         }
-        try 
-        {
-            return std::stoi(it->second);
-        } 
-        catch (...) 
+
+        std::vector<ConfigEntry> loaded;
+        loaded.reserve(count);
+        const std::size_t poolSize = view.stringPool.size();
+        for (std::size_t i = 0; i < count; ++i)
         {
-            // TODO - Add MIAException here.
-            return 0;
+            config_cache::EntryRecord record;
+            std::memcpy(&record, view.records + i * sizeof(record), sizeof(record));
+            if (std::size_t(record.keyOffset) + record.keyLength > poolSize ||
+                std::size_t(record.rawOffset) + record.rawLength > poolSize ||
+                std::uint64_t(record.listOffset) + record.listCount > view.header.intPoolCount)
+                return false;
+
+            ConfigEntry entry;
+            entry.key = view.stringPool.substr(record.keyOffset, record.keyLength);
+            entry.keyHash = record.keyHash;
+            entry.raw = view.stringPool.substr(record.rawOffset, record.rawLength);
+            switch (record.valueType)
+            {
+                case 0: entry.value = entry.raw; break;
+                case 1: entry.value = record.intValue != 0; break;
+                case 2: entry.value = static_cast<int>(record.intValue); break;
+                case 3: entry.value = record.doubleValue; break;
+                case 4:
+                {
+                    std::vector<int> list(record.listCount);
+                    std::memcpy(list.data(), view.intPool + std::size_t(record.listOffset) * sizeof(std::int32_t),
+                                list.size() * sizeof(std::int32_t));
+                    entry.value = std::move(list);
+                    break;
+                }
+                default: return false;
+            }
+            loaded.push_back(std::move(entry));
         }
+
+        buffer = std::move(mapped);
+        entries = std::move(loaded);
+        keySlots = std::move(loadedSlots);
+        parseIssues.clear();
+
+        if (verboseMode)
+            std::cout << "Loaded " << entries.size() << " entries from compiled cache: " 
+                      << config_cache::getCachePath(filePath, constants::ConfigType::KEY_VALUE) << std::endl;
+        return true;
     }
 
 
-    double KeyValueData::getDouble(const std::string& key) const
+    void KeyValueData::writeCache(const std::string& filePath, bool verboseMode) const
     {
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
+        // Files with parse issues are not cached so the issues are reported on every load.
+        if (!parseIssues.empty())
+            return;
+
+        config_cache::CacheContents contents;
+        contents.configType = constants::ConfigType::KEY_VALUE;
+        contents.source = buffer.view();
+        contents.recordCount = static_cast<std::uint32_t>(entries.size());
+        contents.recordSize = sizeof(config_cache::EntryRecord);
+        contents.records.resize(entries.size() * sizeof(config_cache::EntryRecord));
+        contents.slots = keySlots;
+
+        const char* base = contents.source.data();
+        for (std::size_t i = 0; i < entries.size(); ++i)
         {
-            std::string err = "Can't find key in configuration map: " + key;
-            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
+            const ConfigEntry& entry = entries[i];
+            config_cache::EntryRecord record{};
+            record.keyHash = entry.keyHash;
+            record.keyOffset = static_cast<std::uint32_t>(entry.key.data() - base);
+            record.keyLength = static_cast<std::uint32_t>(entry.key.size());
+            record.rawOffset = static_cast<std::uint32_t>(entry.raw.data() - base);
+            record.rawLength = static_cast<std::uint32_t>(entry.raw.size());
+            record.valueType = static_cast<std::uint32_t>(entry.value.index());
+            if (const bool* value = std::get_if<bool>(&entry.value))
+                record.intValue = *value ? 1 : 0;
+            else if (const int* value = std::get_if<int>(&entry.value))
+                record.intValue = *value;
+            else if (const double* value = std::get_if<double>(&entry.value))
+                record.doubleValue = *value;
+            else if (const std::vector<int>* value = std::get_if<std::vector<int>>(&entry.value))
+            {
+                record.listOffset = static_cast<std::uint32_t>(contents.intPool.size());
+                record.listCount = static_cast<std::uint32_t>(value->size());
+                contents.intPool.insert(contents.intPool.end(), value->begin(), value->end());
+            }
+            std::memcpy(contents.records.data() + i * sizeof(record), &record, sizeof(record));
         }
-        try 
-        {
-            if (it->second == "inf" || it->second == "infinity")
-                return std::numeric_limits<double>::infinity();
-            else
-                return std::stod(it->second);
-        } 
-        catch (...) 
+
+        bool written = config_cache::writeCache(filePath, contents);
+        if (verboseMode)
+            std::cout << (written ? "Wrote compiled cache: " : "Could not write compiled cache: ")
+                      << config_cache::getCachePath(filePath, constants::ConfigType::KEY_VALUE) << std::endl;
+    }
+
+
+    std::size_t KeyValueData::slotCountFor(std::size_t entryCount)
+    {
+        std::size_t slotCount = 16;
+        while (slotCount < entryCount * 2)
+            slotCount <<= 1;
+        return slotCount;
+    }
+
+
+    std::size_t KeyValueData::findIndex(std::string_view key, std::uint64_t keyHash) const
+    {
+        if (keySlots.empty())
+            return entries.size();
+
+        const std::size_t mask = keySlots.size() - 1;
+        for (std::size_t slot = keyHash & mask; keySlots[slot] != 0; slot = (slot + 1) & mask)
         {
-            // TODO - Add MIAException here.
-            return 0.0;
+            const ConfigEntry& entry = entries[keySlots[slot] - 1];
+            if (entry.keyHash == keyHash && entry.key == key)
+                return keySlots[slot] - 1;
         }
+        return entries.size();
     }
 
 
-    std::string KeyValueData::getString(const std::string& key) const
+    std::size_t KeyValueData::getKeyIndex(const std::string& key) const
     {
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
+        std::size_t index = findIndex(key, hashConfigKey(key));
+        if (index == entries.size())
         {
             std::string err = "Can't find key in configuration map: " + key;
             throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
         }
-            
-        return it->second;
+        return index;
+    }
+
+
+    const ConfigEntry* KeyValueData::getEntry(std::size_t index) const
+    {
+        return index < entries.size() ? &entries[index] : nullptr;
+    }
+
+
+    const ConfigEntry& KeyValueData::findEntry(const std::string& key) const
+    {
+        return entries[getKeyIndex(key)];
+    }
+
+
+    int KeyValueData::getInt(const std::string& key) const
+    {
+        return toInt(findEntry(key));
+    }
+
+
+    double KeyValueData::getDouble(const std::string& key) const
+    {
+        return toDouble(findEntry(key));
+    }
+
+
+    std::string KeyValueData::getString(const std::string& key) const
+    {
+        return toString(findEntry(key));
     }
 
 
     std::vector<std::string> KeyValueData::getVector(const std::string& key, char delimiter) const
     {
         std::vector<std::string> result;
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
-        {
-            std::string err = "Can't find key in configuration map: " + key;
-            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
-        }
-
-        std::string val = it->second;
-        std::stringstream ss(val);
+        std::stringstream ss{std::string(findEntry(key).raw)};
         std::string item;
         while (std::getline(ss, item, delimiter)) 
         {
@@ -152,55 +287,35 @@ namespace config
 
     bool KeyValueData::getBool(const std::string& key) const
     {
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
-        {
-            std::string err = "Can't find key in configuration map: " + key;
-            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
-        }
-            
-        std::string val = it->second;
-        std::transform(val.begin(), val.end(), val.begin(), ::tolower);
-        
-        // Check for different forms of true.
-        return (val == "true" || val == "1" || val == "yes" || val == "on");
+        return toBool(findEntry(key));
     }
 
 
     std::vector<int> KeyValueData::getIntVector(const std::string& key, char delimiter) const
     {
-        std::vector<int> result;
-        auto it = rawConfigValsMap.find(key);
-        if (it == rawConfigValsMap.end())
-        {
-            std::string err = "Can't find key in configuration map: " + key;
-            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value, err);
-        }
-
-        std::string val = it->second;
-        std::stringstream ss(val);
-        std::string item;
-        while (std::getline(ss, item, delimiter)) 
-        {
-            try 
-            {
-                result.push_back(std::stoi(item));
-            } 
-            catch (...) 
-            {
-                // Skip invalid integers
-            }
-        }
-        return result;
+        return toIntVector(findEntry(key), delimiter);
     }
     
+    const std::vector<ConfigLine>& KeyValueData::getLines() const
+    {
+        throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
+            "getLines not supported for KEY_VALUE configuration file.");
+    }
+
+
+    const std::vector<ConfigParseIssue>& KeyValueData::getParseIssues() const
+    {
+        return parseIssues;
+    }
+
+
     std::vector<constants::KeyValuePair> KeyValueData::getAllConfigPairs() const
     {
         std::vector<constants::KeyValuePair> pairs;
-        pairs.reserve(rawConfigValsMap.size());
-        for (const auto& val : rawConfigValsMap)
+        pairs.reserve(entries.size());
+        for (const auto& entry : entries)
         {
-            pairs.emplace_back(val.first, val.second);
+            pairs.emplace_back(std::string(entry.key), std::string(entry.raw));
         }
         return pairs;
     }
@@ -209,9 +324,10 @@ namespace config
     std::vector<std::string> KeyValueData::getRawLines() const
     {
         std::vector<std::string> lines;
-        for (const auto& val : rawConfigValsMap)
+        lines.reserve(entries.size());
+        for (const auto& entry : entries)
         {
-            std::string line = val.first + "=" + val.second;
+            std::string line = std::string(entry.key) + "=" + std::string(entry.raw);
             lines.push_back(line);
         }
         return lines;
@@ -220,10 +336,10 @@ namespace config
 
     void KeyValueData::dump(std::ostream& os) const
     {
-        os << "Dumping rawConfigValsMap:" << std::endl;
-        for (const auto& val : rawConfigValsMap)
+        os << "Dumping configuration entries:" << std::endl;
+        for (const auto& entry : entries)
         {
-            os << val.first << "=" << val.second << std::endl;
+            os << entry.key << "=" << entry.raw << std::endl;
         }
         os << std::endl;
     }
@@ -11,7 +11,8 @@
 #include <vector>
 #include <string>
 #include <iostream>
-#include <unordered_map>
+#include <string_view>
+#include <cstdint>
 
 // Included for the abstract base class.
 #include "ConfigData.hpp"
@@ -30,19 +31,18 @@ namespace config
     class KeyValueData : public ConfigData
     {
     public:
-        /**
-         * @brief Type alias for the map storing raw key-value pairs.
-         *
-         * Key-value pairs in the configuration file are expected to be separated by '='.
-         * This delimiter is used when parsing the file into the map.
-         */
-        using BasicConfigMap = std::unordered_map<std::string, std::string>;
-
         /**
          * @brief Loads configuration data from a file as key-value pairs.
+         *
+         * The file is read into a retained buffer and tokenized in a single pass. Each value
+         * is parsed into its typed ConfigValue once here so that the typed getters never
+         * reparse the raw text. Malformed lines are skipped and recorded with their line and
+         * column (see getParseIssues()). Malformed typed values (see findMalformedValue()) are
+         * kept as read and recorded the same way.
          * @param filePath[const std::string&] - The path to the configuration file.
          * @param verboseMode[bool] - If true, enables verbose output during loading.
-         * @throws MIAException If the file cannot be opened or parsed.
+         * @throws MIAException If the file cannot be opened or parsed. The previously loaded
+         *     entries are kept in that case.
          * @see ConfigData::load()
          */
         void load(const std::string& filePath, bool verboseMode) override;
@@ -50,7 +50,7 @@ namespace config
         /**
          * @brief Retrieves the configuration value for a key as an integer.
          * @param key[const std::string&] - The key to look up.
-         * @return [int] - The integer value if the key exists and conversion succeeds; otherwise, 0.
+         * @return [int] - The pre-parsed integer value of the entry.
          * @throws MIAException If the key is not found or conversion fails.
          * @see ConfigData::getInt()
          */
@@ -59,7 +59,7 @@ namespace config
         /**
          * @brief Retrieves the configuration value for a key as a double.
          * @param key[const std::string&] - The key to look up.
-         * @return [double] - The double value if the key exists and conversion succeeds; otherwise, 0.0.
+         * @return [double] - The pre-parsed double value of the entry.
          * @throws MIAException If the key is not found or conversion fails.
          * @see ConfigData::getDouble()
          */
@@ -68,7 +68,7 @@ namespace config
         /**
          * @brief Retrieves the configuration value for a key as a string.
          * @param key[const std::string&] - The key to look up.
-         * @return [std::string] - The string value if the key exists; otherwise, an empty string.
+         * @return [std::string] - The raw string value of the entry.
          * @throws MIAException If the key is not found.
          * @see ConfigData::getString()
          */
@@ -87,7 +87,7 @@ namespace config
         /**
          * @brief Retrieves the configuration value for a key as a boolean.
          * @param key[const std::string&] - The key to look up.
-         * @return [bool] - The boolean value if the key exists and conversion succeeds; otherwise, false.
+         * @return [bool] - The pre-parsed boolean value of the entry.
          * @throws MIAException If the key is not found or conversion fails.
          * @see ConfigData::getBool()
          */
@@ -97,15 +97,32 @@ namespace config
          * @brief Retrieves the configuration value for a key as a vector of integers.
          * @param key[const std::string&] - The key to look up.
          * @param delimiter[char] - The character used to split the string value.
-         * @return [std::vector<int>] - A vector of integers parsed from the value; empty if key not found or conversion fails.
+         * @return [std::vector<int>] - A vector of integers parsed from the value.
          * @throws MIAException If the key is not found or conversion fails.
          * @see ConfigData::getIntVector()
          */
         std::vector<int> getIntVector(const std::string& key, char delimiter) const override;
 
+        /**
+         * @brief Retrieves the index of the pre-parsed entry for a key.
+         * @param key[const std::string&] - The key to look up.
+         * @return [std::size_t] - The index of the entry in the entry table.
+         * @throws MIAException If the key is not found.
+         * @see ConfigData::getKeyIndex()
+         */
+        std::size_t getKeyIndex(const std::string& key) const override;
+
+        /**
+         * @brief Retrieves a pre-parsed entry by index.
+         * @param index[std::size_t] - The index of the entry.
+         * @return [const ConfigEntry*] - The entry, or nullptr if the index is out of range.
+         * @see ConfigData::getEntry()
+         */
+        const ConfigEntry* getEntry(std::size_t index) const override;
+
         /**
          * @brief Retrieves all key-value pairs stored in the configuration.
-         * @return [std::vector<constants::KeyValuePair>] - A vector containing all key-value pairs.
+         * @return [std::vector<constants::KeyValuePair>] - A vector containing all key-value pairs in file order.
          * @see ConfigData::getAllConfigPairs()
          */
         std::vector<constants::KeyValuePair> getAllConfigPairs() const override;
@@ -118,6 +135,20 @@ namespace config
          */
         std::vector<std::string> getRawLines() const override;
 
+        /**
+         * @brief Unsupported for KEY_VALUE configurations, which only retain parsed pairs.
+         * @throws MIAException Always.
+         * @see ConfigData::getLines()
+         */
+        const std::vector<ConfigLine>& getLines() const override;
+
+        /**
+         * @brief Retrieves the issues found while parsing the last loaded file.
+         * @return [const std::vector<ConfigParseIssue>&] - The malformed lines that were skipped.
+         * @see ConfigData::getParseIssues()
+         */
+        const std::vector<ConfigParseIssue>& getParseIssues() const override;
+
         /**
          * @brief Outputs the configuration data to the specified stream.
          * @param os[std::ostream&] - The output stream to write to.
@@ -127,6 +158,29 @@ namespace config
          */
         void dump(std::ostream& os) const override;
 
+        /**
+         * @brief Loads the entries from the compiled cache of a file, if it is up to date.
+         *
+         * The cache is memory mapped and the keys and raw values point directly into its string
+         * pool. The fixed-size records and the key index are decoded into the same entry table that
+         * load() builds, without tokenizing or parsing any text, since getEntry() hands out
+         * ConfigEntry pointers. Int lists are copied out of the int pool.
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during loading.
+         * @return [bool] - True if the cache was valid and loaded.
+         * @see ConfigData::loadCache()
+         */
+        bool loadCache(const std::string& filePath, bool verboseMode) override;
+
+        /**
+         * @brief Writes the compiled cache for the entries most recently loaded by load(). Nothing
+         *     is written if the file had parse issues, so they are reported again on the next load.
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during writing.
+         * @see ConfigData::writeCache()
+         */
+        void writeCache(const std::string& filePath, bool verboseMode) const override;
+
         /**
          * @brief Retrieves the type of configuration data stored.
          * @return [constants::ConfigType] - Always returns constants::ConfigType::KEY_VALUE.
@@ -136,8 +190,49 @@ namespace config
 
     private:
         /**
-         * @brief Stores the key-value pairs parsed from the configuration file.
+         * @brief Finds the index of the entry with the given key and precomputed hash.
+         * @param key[std::string_view] - The key to look up.
+         * @param keyHash[std::uint64_t] - The hashConfigKey() value of key.
+         * @return [std::size_t] - The entry index, or entries.size() if the key is not present.
+         */
+        std::size_t findIndex(std::string_view key, std::uint64_t keyHash) const;
+
+        /**
+         * @brief Returns the keySlots size used to index a given number of entries.
+         * @param entryCount[std::size_t] - The number of entries which will be indexed.
+         * @return [std::size_t] - A power of two of at least 16 and at least twice entryCount.
+         */
+        static std::size_t slotCountFor(std::size_t entryCount);
+
+        /**
+         * @brief Finds the entry for a key or throws if it does not exist.
+         * @param key[const std::string&] - The key to look up.
+         * @return [const ConfigEntry&] - The pre-parsed entry for the key.
+         * @throws MIAException If the key is not found.
+         */
+        const ConfigEntry& findEntry(const std::string& key) const;
+
+        /**
+         * @brief Owns the file contents which the entry keys and values view into.
+         */
+        ConfigFileBuffer buffer;
+
+        /**
+         * @brief Stores the pre-parsed entries in the order they appear in the configuration file.
+         */
+        std::vector<ConfigEntry> entries;
+
+        /**
+         * @brief Open-addressing index over entries keyed by ConfigEntry::keyHash.
+         *
+         * Each slot holds an entry index plus one (zero marks an empty slot). The size is
+         * a power of two at least twice the number of entries, so probes stay short.
+         */
+        std::vector<std::uint32_t> keySlots;
+
+        /**
+         * @brief Stores the issues found while parsing the last loaded file.
          */
-        BasicConfigMap rawConfigValsMap;
+        std::vector<ConfigParseIssue> parseIssues;
     };
 } // namespace config
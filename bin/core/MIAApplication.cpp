@@ -15,8 +15,6 @@
 // Used for exception handling.
 #include "MIAException.hpp"
 #include "Error.hpp"
-// Used for parsing command options.
-#include "CommandParser.hpp"
 // Used for default path locations.
 #include "Paths.hpp"
 #include "Logger.hpp"
@@ -32,35 +30,30 @@ MIAApplication::MIAApplication() :
         CommandOption::commandOptionType::BOOL_OPTION),
     logFileOpt("-l", "--logfile", "Set a custom logfile. Default = " +
         paths::getDefaultLogDirToUse() + "/" + logger::DEFAULT_LOG_FILE,
-        CommandOption::commandOptionType::STRING_OPTION)
-{ }
+        CommandOption::commandOptionType::STRING_OPTION),
+    configCacheOpt("-k", "--config-cache", "Load and write a compiled cache of the configuration file.",
+        CommandOption::commandOptionType::BOOL_OPTION)
+{
+    addHelpSection("Base MIA application options:");
+    addOption(verboseOpt, context.verboseMode);
+    addOption(debugOpt, context.debugLevel);
+    addOption(helpOpt, helpRequested);
+    addOption(logFileOpt, customLogFile);
+    addOption(configCacheOpt, configCacheEnabled);
+}
 
 
 void MIAApplication::initialize(int argc, char* argv[])
 {
-    try
-    {
-        // Set the executable name.
-        executableName = argv[0];
-        
-        // Set the command option parameters for verbose and help.
-        verboseOpt.getOptionVal<bool>(argc, argv, context.verboseMode);
-        debugOpt.getOptionVal<unsigned int>(argc, argv, context.debugLevel);
-        helpOpt.getOptionVal<bool>(argc, argv, helpRequested);
-        
-        // Load (optionally if specified) the custom log file. 
-        std::string customLogFile;
-        logFileOpt.getOptionVal<std::string>(argc, argv, customLogFile);
-        if (!customLogFile.empty())
-            context.logger.setLogFile(customLogFile);
-    }
-    catch (const error::MIAException& ex)
-    {
-        // This shouldn't ever throw a MIAException since it's simple and part of the base app, 
-        // but throw an exception just in case... 
-        std::string err = "Error during MIAApplication::initialize!";
-        throw error::MIAException(error::ErrorCode::Catastrophic_Failure, err); 
-    }
+    // Set the executable name.
+    executableName = argc > 0 ? argv[0] : "";
+    
+    // Parse every registered option (base and app-specific) in a single pass over argv.
+    commandLine.parse(argc, argv);
+    
+    // Load (optionally if specified) the custom log file. 
+    if (!customLogFile.empty())
+        context.logger.setLogFile(customLogFile);
 
     if (helpRequested)
     {
@@ -73,10 +66,6 @@ void MIAApplication::initialize(int argc, char* argv[])
 void MIAApplication::printHelp() const
 {
     std::cout << "Usage: " << executableName << " [args]" << std::endl
-              << "Base MIA application options:" << std::endl
-              << verboseOpt.getHelp() << std::endl
-              << debugOpt.getHelp() << std::endl
-              << helpOpt.getHelp()  << std::endl
-              << logFileOpt.getHelp()  << std::endl
+              << commandLine.getHelp()
               << std::endl;
 }
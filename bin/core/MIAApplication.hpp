@@ -11,6 +11,7 @@
 
 // Used for base configuration values.
 #include "CommandOption.hpp"
+#include "CommandLine.hpp"
 #include "Logger.hpp"
 #include "RuntimeContext.hpp"
 
@@ -75,13 +76,40 @@ protected:
     /**
      * Virtual initialize() method. This should be overridden by the inheriting app, but a call
      * to this method should be included.
-     * Parse command line arguments, handling common flags (-v, -h).
-     * Calls parseAppArguments for app-specific argument parsing.
+     * Parses the command line arguments in a single pass into every option registered with
+     * addOption() (including the app-specific ones), then handles common flags (-v, -h, ...).
      * @param argc, argv Command line arguments
-     * @throw [MIAException] - Throws an exception if parsing the command line options for base arguments fail.
+     * @throw [MIAException] - Throws an exception if parsing the command line options fails.
      */
     virtual void initialize(int argc, char* argv[]);
 
+    /**
+     * Registers a command option and the variable which receives its value when initialize()
+     * parses the command line. Apps should call this from their constructor.
+     * @tparam Type - The sink type (bool, int, unsigned int, double, or std::string).
+     * @param option[const CommandOption&] - The option to register.
+     * @param sink[Type&] - The variable to set. It should hold the default value.
+     * @throws MIAException - If the sink type does not match the option or the option is a duplicate.
+     */
+    template<typename Type>
+    void addOption(const CommandOption& option, Type& sink)
+    { commandLine.addOption(option, sink); }
+
+    /**
+     * Starts a new section in the generated help (e.g., "MIATemplate specific options:").
+     * Options registered afterwards with addOption() are listed under it.
+     * @param heading[const std::string&] - The section heading.
+     */
+    void addHelpSection(const std::string& heading)
+    { commandLine.addHelpSection(heading); }
+
+    /**
+     * Provides read-only access to the parsed command line (e.g., for positional arguments).
+     * @return const CommandLine& - The command line parsed by initialize().
+     */
+    const CommandLine& getCommandLine() const
+    { return commandLine; }
+
     /**
      * Runs the main application logic. Must be implemented by derived classes. When implemented, 
      * this should ideally return a valid return code from constants::ReturnCode. 
@@ -91,7 +119,7 @@ protected:
     virtual int run() = 0;
     
     /**
-     * Prints common help info including verbose and help flags.
+     * Prints the usage line and the generated help for every registered command option.
      */
     virtual void printHelp() const;
     
@@ -112,6 +140,14 @@ protected:
      */
     const RuntimeContext& getContext() const 
     { return context; }
+
+    /**
+     * Returns whether the user enabled the compiled configuration cache (-k). Apps which load a
+     * configuration should pass this to MIAConfig::setCacheEnabled() before setConfigFileName().
+     * @return [bool] - True if the configuration cache should be used.
+     */
+    bool isConfigCacheEnabled() const
+    { return configCacheEnabled; }
     
 private:    
     /// The RuntimeContext for this class - stores common runtime variables.
@@ -122,10 +158,20 @@ private:
     CommandOption debugOpt;
     CommandOption helpOpt;
     CommandOption logFileOpt;
+    CommandOption configCacheOpt;
+    
+    /// The table of all registered command options, parsed once in initialize().
+    CommandLine commandLine;
     
     /// True if the user specified the help flag in command options.
     bool helpRequested{false};
     
+    /// True if the user enabled the compiled configuration cache in command options.
+    bool configCacheEnabled{false};
+    
+    /// The custom log file specified in the command options (empty for the default).
+    std::string customLogFile;
+    
     /// Store the executable name for use in the help message.
     std::string executableName;
 };
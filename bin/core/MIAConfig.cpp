@@ -80,7 +80,14 @@ namespace config
             configFileFullPath = paths::getDefaultConfigDirToUse() + "/" + configFileName;
         }
         
-        configData->load(configFileFullPath, verboseMode);
+        // Prefer the compiled cache and only parse the text file if it is missing or out of date.
+        loadedFromCache = cacheEnabled && configData->loadCache(configFileFullPath, verboseMode);
+        if (!loadedFromCache)
+        {
+            configData->load(configFileFullPath, verboseMode);
+            if (cacheEnabled)
+                configData->writeCache(configFileFullPath, verboseMode);
+        }
     }
     
     constants::ConfigType MIAConfig::getConfigType() const
@@ -128,6 +135,16 @@ namespace config
         return configData->getRawLines();
     }
 
+    const std::vector<ConfigLine>& MIAConfig::getLines() const
+    {
+        return configData->getLines();
+    }
+
+    const std::vector<ConfigParseIssue>& MIAConfig::getParseIssues() const
+    {
+        return configData->getParseIssues();
+    }
+
     void MIAConfig::dumpConfigMap(std::ostream& os) const
     {
         configData->dump(os);
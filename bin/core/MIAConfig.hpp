@@ -15,6 +15,8 @@
 
 // Included for various common-types.
 #include "ConfigData.hpp"
+// Included for the typed ConfigKey handles.
+#include "ConfigValue.hpp"
 
 namespace config
 {   
@@ -112,8 +114,9 @@ namespace config
          * Retrieves the configuration value associated with the given key as an int.
          * @note Only supported for constants::ConfigType::KEY_VALUE.
          * @param key[const std::string&] - The key name to look up in the configuration map.
-         * @return [int] - The int value if the key exists and conversion succeeds; otherwise, returns 0.
-         * @throws MIAException - Thrown if the key is not found in the configuration map.
+         * @return [int] - The int value typed at load (an integral double such as 3.0 is also accepted).
+         * @throws MIAException - Thrown if the key is not found in the configuration map, or with
+         *         Invalid_Type_Requested if the value is not an int (e.g., "3.5" or "abc").
          */
         int getInt(const std::string& key) const;
 
@@ -121,8 +124,9 @@ namespace config
          * Retrieves the configuration value associated with the given key as a double.
          * @note Only supported for constants::ConfigType::KEY_VALUE.
          * @param key[const std::string&] - The key name to look up in the configuration map.
-         * @return [double] - The double value if the key exists and conversion succeeds; otherwise, returns 0.0.
-         * @throws MIAException - Thrown if the key is not found in the configuration map.
+         * @return [double] - The double (or int) value typed at load.
+         * @throws MIAException - Thrown if the key is not found in the configuration map, or with
+         *         Invalid_Type_Requested if the value is not numeric.
          */
         double getDouble(const std::string& key) const;
 
@@ -150,8 +154,9 @@ namespace config
          * Retrieves the configuration value associated with the given key as a bool.
          * @note Only supported for constants::ConfigType::KEY_VALUE.
          * @param key[const std::string&] - The key name to look up in the configuration map.
-         * @return [bool] - The bool value if the key exists and conversion succeeds; otherwise, returns false.
-         * @throws MIAException - Thrown if the key is not found in the configuration map.
+         * @return [bool] - The bool value typed at load (true/false, yes/no or on/off in any case, or 1/0).
+         * @throws MIAException - Thrown if the key is not found in the configuration map, or with
+         *         Invalid_Type_Requested if the value is not a bool (e.g., "maybe" or "2").
          */
         bool getBool(const std::string& key) const;
 
@@ -160,11 +165,54 @@ namespace config
          * splitting the stored string by the specified delimiter.
          * @param key[const std::string&] - The key name to look up in the configuration map.
          * @param delimiter[char] - The character used to split the string into vector elements.
-         * @return [std::vector<int>] - A vector of ints parsed from the value; empty vector if key not found.
-         * @throws MIAException - Thrown if the key is not found in the configuration map.
+         * @return [std::vector<int>] - A vector of ints parsed from the value.
+         * @throws MIAException - Thrown if the key is not found in the configuration map, or with
+         *         Invalid_Type_Requested if an item is not an int.
          */
         std::vector<int> getIntVector(const std::string& key, char delimiter) const;
         
+        /**
+         * Resolves a typed handle for the given key. The stored value is type-checked here, so
+         * calling this right after loading reports malformed values at load time rather than
+         * on first use. The returned key can be passed to get() repeatedly without any string
+         * hashing or parsing.
+         * @note Only supported for constants::ConfigType::KEY_VALUE.
+         * @tparam T - One of int, double, bool, std::string, std::string_view or std::vector<int>.
+         * @param key[std::string_view] - The key name to look up in the configuration map.
+         * @return [ConfigKey<T>] - A resolved handle for the key.
+         * @throws MIAException - Thrown if the key is not found or the value cannot be read as T.
+         */
+        template<typename T>
+        ConfigKey<T> getKey(std::string_view key) const
+        {
+            ConfigKey<T> configKey(key);
+            configKey.index = configData->getKeyIndex(configKey.name);
+            convertConfigValue<T>(*configData->getEntry(configKey.index));
+            return configKey;
+        }
+
+        /**
+         * Retrieves the pre-parsed value for a typed key. If the key was resolved against a
+         * different load of the configuration (e.g. before a reload() that changed the file
+         * layout), it is transparently re-resolved by name.
+         * @note Only supported for constants::ConfigType::KEY_VALUE.
+         * @tparam T - One of int, double, bool, std::string, std::string_view or std::vector<int>.
+         * @param key[const ConfigKey<T>&] - The typed key to look up.
+         * @return [T] - The value of the entry.
+         * @throws MIAException - Thrown if the key is not found or the value cannot be read as T.
+         */
+        template<typename T>
+        T get(const ConfigKey<T>& key) const
+        {
+            const ConfigEntry* entry = configData->getEntry(key.index);
+            if (entry == nullptr || entry->keyHash != key.hash)
+            {
+                key.index = configData->getKeyIndex(key.name);
+                entry = configData->getEntry(key.index);
+            }
+            return convertConfigValue<T>(*entry);
+        }
+
         /**
          * Dumps all key-value pairs stored in rawConfigValsMap to the specified output stream.
          * Useful for debugging to inspect the current configuration values.
@@ -188,6 +236,39 @@ namespace config
          */
         std::vector<std::string> getRawLines() const;
 
+        /**
+         * Returns all content lines with their line numbers as views into the loaded file.
+         * The views remain valid until the configuration is reloaded or destroyed.
+         * @note Only supported for constants::ConfigType::RAW_LINES.
+         * @return [const std::vector<ConfigLine>&] - The content lines of the loaded file.
+         * @throws MIAException - Thrown if the config type does not retain raw lines.
+         */
+        const std::vector<ConfigLine>& getLines() const;
+
+        /**
+         * Returns the issues (with line and column) found while parsing the loaded file.
+         * @return [const std::vector<ConfigParseIssue>&] - The parse issues; empty if there were none.
+         */
+        const std::vector<ConfigParseIssue>& getParseIssues() const;
+
+        /**
+         * Enables or disables the compiled configuration cache (see ConfigCache.hpp). When enabled,
+         * initialize() loads "<file>.kv.cache" (or ".raw.cache") if it is up to date and writes it after parsing otherwise.
+         * The cache is disabled by default, since it writes files next to the configuration file,
+         * and is meant for applications that load large configurations often. Takes effect on the
+         * next initialize() or reload().
+         * @param enabled[bool] - True to use the cache.
+         */
+        void setCacheEnabled(bool enabled)
+        { cacheEnabled = enabled; }
+
+        /**
+         * Returns whether the last initialize() loaded the configuration from the compiled cache.
+         * @return [bool] - True if the cache was used; false if the text file was parsed.
+         */
+        bool isLoadedFromCache() const
+        { return loadedFromCache; }
+
     private:
     
         /// The name of the configuration file for this object.
@@ -198,5 +279,11 @@ namespace config
         
         /// Stores the configuration data (PIMPL idiom).
         std::unique_ptr<ConfigData> configData;
+
+        /// True if the compiled configuration cache should be used (see setCacheEnabled()).
+        bool cacheEnabled{false};
+
+        /// True if the last initialize() loaded the configuration from the compiled cache.
+        bool loadedFromCache{false};
     }; // class MIAConfig
 } // namespace config
@@ -63,6 +63,13 @@ namespace error
          */
         ErrorCode getCode() const noexcept
         { return errorCode; }
+
+        /**
+         * @brief Returns the details given when the exception was thrown, without the error description.
+         * @return The error details (may be empty).
+         */
+        const std::string& getDetails() const noexcept
+        { return errorDetails; }
     
     private:
         std::string generateFullErrorMsg()
@@ -2,14 +2,19 @@
  * @file RawLinesData.cpp
  * @author Antonius Torode
  * @date 05/24/2025
- * Description: 
+ * Description: Implements the RawLinesData class which stores configuration files as
+ *              raw line views into a retained file buffer.
  */
 
 #include <iostream>
-#include <fstream>
+#include <cstring>
 
 // Include the associated header.
 #include "RawLinesData.hpp"
+// Used for the single-pass file tokenizer.
+#include "ConfigParser.hpp"
+// Used for the compiled configuration cache.
+#include "ConfigCache.hpp"
 // Used for exception handling and error codes.
 #include "MIAException.hpp"
 #include "Error.hpp"
@@ -18,32 +23,78 @@ namespace config
 {
     void RawLinesData::load(const std::string& filePath, bool verboseMode)
     {
-        std::ifstream file(filePath, std::ifstream::in);
-        if (!file.is_open()) 
-        {            
-            std::string err = "Failed to open config file: " + filePath;
-            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, err);
-        }            
-        rawConfigLines.clear();
-        
-        std::string line;
-        while (std::getline(file, line)) 
-        {
-            if (!line.empty() && line[0] != '#' && line.size()>2)
-            {
-                if(verboseMode)
-				    std::cout << "Config line read: " << line << std::endl;
-                rawConfigLines.push_back(line);
-            }
-        }
+        // Loaded into locals first so a failed reload keeps the previously loaded lines.
+        ConfigFileBuffer loadedBuffer;
+        loadedBuffer.load(filePath);
+        std::vector<ConfigLine> loaded;
+        config_parser::parseLines(loadedBuffer.view(), loaded);
+        buffer = std::move(loadedBuffer);
+        rawConfigLines = std::move(loaded);
         
         if (verboseMode) 
         {
+            for (const ConfigLine& line : rawConfigLines)
+                std::cout << "Config line read: " << line.text << std::endl;
             std::cout << "Finished loading raw lines from: " << filePath << std::endl;
         }
     }
 
 
+    bool RawLinesData::loadCache(const std::string& filePath, bool verboseMode)
+    {
+        ConfigFileBuffer mapped;
+        config_cache::CacheView view;
+        if (!config_cache::openCache(filePath, constants::ConfigType::RAW_LINES, mapped, view) ||
+            view.header.recordSize != sizeof(config_cache::LineRecord))
+            return false;
+
+        std::vector<ConfigLine> loaded;
+        loaded.reserve(view.header.recordCount);
+        for (std::size_t i = 0; i < view.header.recordCount; ++i)
+        {
+            config_cache::LineRecord record;
+            std::memcpy(&record, view.records + i * sizeof(record), sizeof(record));
+            if (std::size_t(record.offset) + record.length > view.stringPool.size())
+                return false;
+            loaded.push_back({view.stringPool.substr(record.offset, record.length), 
+                              static_cast<std::size_t>(record.lineNumber)});
+        }
+
+        buffer = std::move(mapped);
+        rawConfigLines = std::move(loaded);
+
+        if (verboseMode)
+            std::cout << "Loaded " << rawConfigLines.size() << " raw lines from compiled cache: " 
+                      << config_cache::getCachePath(filePath, constants::ConfigType::RAW_LINES) << std::endl;
+        return true;
+    }
+
+
+    void RawLinesData::writeCache(const std::string& filePath, bool verboseMode) const
+    {
+        config_cache::CacheContents contents;
+        contents.configType = constants::ConfigType::RAW_LINES;
+        contents.source = buffer.view();
+        contents.recordCount = static_cast<std::uint32_t>(rawConfigLines.size());
+        contents.recordSize = sizeof(config_cache::LineRecord);
+        contents.records.resize(rawConfigLines.size() * sizeof(config_cache::LineRecord));
+
+        for (std::size_t i = 0; i < rawConfigLines.size(); ++i)
+        {
+            config_cache::LineRecord record{};
+            record.lineNumber = rawConfigLines[i].lineNumber;
+            record.offset = static_cast<std::uint32_t>(rawConfigLines[i].text.data() - contents.source.data());
+            record.length = static_cast<std::uint32_t>(rawConfigLines[i].text.size());
+            std::memcpy(contents.records.data() + i * sizeof(record), &record, sizeof(record));
+        }
+
+        bool written = config_cache::writeCache(filePath, contents);
+        if (verboseMode)
+            std::cout << (written ? "Wrote compiled cache: " : "Could not write compiled cache: ")
+                      << config_cache::getCachePath(filePath, constants::ConfigType::RAW_LINES) << std::endl;
+    }
+
+
     int RawLinesData::getInt(const std::string& key) const
     {
         throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
@@ -86,6 +137,20 @@ namespace config
     }
 
 
+    std::size_t RawLinesData::getKeyIndex(const std::string& key) const
+    {
+        throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
+            "getKeyIndex not supported for RAW_LINES configuration file.");
+    }
+
+
+    const ConfigEntry* RawLinesData::getEntry(std::size_t index) const
+    {
+        throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
+            "getEntry not supported for RAW_LINES configuration file.");
+    }
+
+
     std::vector<constants::KeyValuePair> RawLinesData::getAllConfigPairs() const
     {        
         throw error::MIAException(error::ErrorCode::Invalid_Configuration_Call, 
@@ -94,17 +159,33 @@ namespace config
 
 
     std::vector<std::string> RawLinesData::getRawLines() const
+    {
+        std::vector<std::string> lines;
+        lines.reserve(rawConfigLines.size());
+        for (const ConfigLine& line : rawConfigLines)
+            lines.emplace_back(line.text);
+        return lines;
+    }
+
+
+    const std::vector<ConfigLine>& RawLinesData::getLines() const
     {
         return rawConfigLines;
     }
 
 
+    const std::vector<ConfigParseIssue>& RawLinesData::getParseIssues() const
+    {
+        return parseIssues;
+    }
+
+
     void RawLinesData::dump(std::ostream& os) const
     {
         os << "Dumping rawConfigLines:" << std::endl;
         for (const auto& line : rawConfigLines)
         {
-            os << line << std::endl;
+            os << line.text << std::endl;
         }
         os << std::endl;
     }
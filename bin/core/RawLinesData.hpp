@@ -32,6 +32,9 @@ namespace config
     public:
         /**
          * @brief Loads configuration data from a file as raw lines.
+         *
+         * The file is read into a retained buffer with a single read and split into line
+         * views in one pass; no per-line strings are allocated.
          * @param filePath[const std::string&] - The path to the configuration file.
          * @param verboseMode[bool] - If true, enables verbose output during loading.
          * @throws MIAException If the file cannot be opened or read.
@@ -55,16 +58,32 @@ namespace config
         std::vector<std::string> getVector(const std::string& key, char delimiter) const override;
         bool getBool(const std::string& key) const override;
         std::vector<int> getIntVector(const std::string& key, char delimiter) const override;
+        std::size_t getKeyIndex(const std::string& key) const override;
+        const ConfigEntry* getEntry(std::size_t index) const override;
         std::vector<constants::KeyValuePair> getAllConfigPairs() const override;
         /** @} */
 
         /**
          * @brief Retrieves all raw lines stored in the configuration.
-         * @return [std::vector<std::string>] - A vector containing all raw lines.
+         * @return [std::vector<std::string>] - A vector containing copies of all raw lines.
          * @see ConfigData::getRawLines()
          */
         std::vector<std::string> getRawLines() const override;
 
+        /**
+         * @brief Retrieves all raw lines with their line numbers without copying them.
+         * @return [const std::vector<ConfigLine>&] - The line views into the loaded file buffer.
+         * @see ConfigData::getLines()
+         */
+        const std::vector<ConfigLine>& getLines() const override;
+
+        /**
+         * @brief Retrieves the issues found while parsing the last loaded file.
+         * @return [const std::vector<ConfigParseIssue>&] - Always empty, since any line is valid.
+         * @see ConfigData::getParseIssues()
+         */
+        const std::vector<ConfigParseIssue>& getParseIssues() const override;
+
         /**
          * @brief Outputs the configuration data to the specified stream.
          * @param os[std::ostream&] - The output stream to write to.
@@ -73,6 +92,25 @@ namespace config
          */
         void dump(std::ostream& os) const override;
 
+        /**
+         * @brief Loads the lines from the compiled cache of a file, if it is up to date.
+         *
+         * The cache is memory mapped and the lines point directly into its string pool.
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during loading.
+         * @return [bool] - True if the cache was valid and loaded.
+         * @see ConfigData::loadCache()
+         */
+        bool loadCache(const std::string& filePath, bool verboseMode) override;
+
+        /**
+         * @brief Writes the compiled cache for the lines most recently loaded by load().
+         * @param filePath[const std::string&] - The path to the configuration (source) file.
+         * @param verboseMode[bool] - If true, enables verbose output during writing.
+         * @see ConfigData::writeCache()
+         */
+        void writeCache(const std::string& filePath, bool verboseMode) const override;
+
         /**
          * @brief Retrieves the type of configuration data stored.
          * @return [constants::ConfigType] - Always returns constants::ConfigType::RAW_LINES.
@@ -82,8 +120,18 @@ namespace config
 
     private:
         /**
-         * @brief Stores the raw lines read from the configuration file.
+         * @brief Owns the file contents which the line views point into.
+         */
+        ConfigFileBuffer buffer;
+
+        /**
+         * @brief Stores views of the raw lines read from the configuration file.
+         */
+        std::vector<ConfigLine> rawConfigLines;
+
+        /**
+         * @brief Always empty; kept so getParseIssues() can return a reference.
          */
-        std::vector<std::string> rawConfigLines;
+        std::vector<ConfigParseIssue> parseIssues;
     };
 } // namespace config
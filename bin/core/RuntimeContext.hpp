@@ -8,6 +8,8 @@
 #pragma once
 
 #include "Logger.hpp"
+// Used for cooperative cancellation of application work.
+#include "CancellationToken.hpp"
 
 /**
  * @brief Holds runtime configuration and shared services for application components.
@@ -21,6 +23,7 @@
  * - logger: A shared logger instance for uniform logging across components.
  * - verboseMode: Enables verbose output when true.
  * - debugLevel: Indicates the level of debug verbosity (0 = none).
+ * - cancellation: Cancels the application's scheduled work (see TaskScheduler) when cancelled.
  */
 struct RuntimeContext
 {
@@ -32,4 +35,7 @@ struct RuntimeContext
     
     /// Stores debug level.
     unsigned int debugLevel{0};
+    
+    /// Shared cancellation flag for work submitted on behalf of this application.
+    threading::CancellationToken cancellation;
 };
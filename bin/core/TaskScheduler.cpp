@@ -0,0 +1,189 @@
+/**
+ * @file TaskScheduler.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the work-stealing TaskScheduler worker threads and queues.
+ */
+
+// Include the associated header file.
+#include "TaskScheduler.hpp"
+
+namespace threading
+{
+    namespace
+    {
+        /// The scheduler owning the calling worker thread (null on other threads).
+        thread_local TaskScheduler* currentScheduler = nullptr;
+
+        /// The index of the calling worker thread within currentScheduler.
+        thread_local std::size_t currentWorker = 0;
+    } // anonymous namespace
+
+
+    TaskScheduler::TaskScheduler(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            workers.push_back(std::make_unique<Worker>());
+
+        // Start the threads only once every worker exists, since they steal from each other.
+        for (std::size_t i = 0; i < threadCount; ++i)
+            workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping.store(true);
+        }
+        workAvailable.notify_all();
+        for (auto& worker : workers)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+    }
+
+
+    TaskScheduler& TaskScheduler::getShared()
+    {
+        static TaskScheduler shared;
+        return shared;
+    }
+
+
+    TaskScheduler* TaskScheduler::getCurrent()
+    {
+        return currentScheduler;
+    }
+
+
+    void TaskScheduler::push(JobPtr job, TaskPriority priority)
+    {
+        std::size_t target = currentScheduler == this
+                           ? currentWorker
+                           : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+        outstanding.fetch_add(1);
+        {
+            Worker& worker = *workers[target];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queues[static_cast<std::size_t>(priority)].push_back(std::move(job));
+        }
+        queued.fetch_add(1);
+
+        // A worker increments sleeping before re-checking queued, so either it sees this job or
+        // this thread sees it sleeping and wakes it.
+        if (sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            workAvailable.notify_one();
+        }
+    }
+
+
+    TaskScheduler::JobPtr TaskScheduler::take(std::size_t self)
+    {
+        if (queued.load() == 0)
+            return nullptr;
+
+        std::size_t count = workers.size();
+        for (std::size_t priority = 0; priority < TASK_PRIORITY_COUNT; ++priority)
+        {
+            // Own queue first (newest job, which is most likely still in cache).
+            if (self < count)
+            {
+                Worker& worker = *workers[self];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                auto& queue = worker.queues[priority];
+                if (!queue.empty())
+                {
+                    JobPtr job = std::move(queue.back());
+                    queue.pop_back();
+                    queued.fetch_sub(1);
+                    return job;
+                }
+            }
+
+            // Then steal the oldest job from the other workers.
+            for (std::size_t offset = 1; offset <= count; ++offset)
+            {
+                std::size_t victim = (self + offset) % count;
+                if (victim == self)
+                    continue;
+                Worker& worker = *workers[victim];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                auto& queue = worker.queues[priority];
+                if (!queue.empty())
+                {
+                    JobPtr job = std::move(queue.front());
+                    queue.pop_front();
+                    queued.fetch_sub(1);
+                    return job;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+
+    void TaskScheduler::execute(JobPtr job)
+    {
+        job->run();
+        job.reset();
+        if (outstanding.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            allIdle.notify_all();
+        }
+    }
+
+
+    bool TaskScheduler::runPendingTask()
+    {
+        JobPtr job = take(currentScheduler == this ? currentWorker : workers.size());
+        if (!job)
+            return false;
+        execute(std::move(job));
+        return true;
+    }
+
+
+    void TaskScheduler::waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        allIdle.wait(lock, [this] { return outstanding.load() == 0; });
+    }
+
+
+    void TaskScheduler::workerLoop(std::size_t index)
+    {
+        currentScheduler = this;
+        currentWorker = index;
+
+        while (true)
+        {
+            if (JobPtr job = take(index))
+            {
+                execute(std::move(job));
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping.fetch_add(1);
+            workAvailable.wait(lock, [this] { return queued.load() > 0 || stopping.load(); });
+            sleeping.fetch_sub(1);
+
+            // Queued work is always drained before a stopping worker exits.
+            if (stopping.load() && queued.load() == 0)
+                break;
+        }
+
+        currentScheduler = nullptr;
+    }
+} // namespace threading
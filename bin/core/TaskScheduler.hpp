@@ -0,0 +1,551 @@
+/**
+ * @file TaskScheduler.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Defines the TaskScheduler class, a shared thread pool for short, parallel units of work.
+ *     Each worker thread owns a set of task deques (one per TaskPriority). A worker takes its
+ *     own newest tasks first and steals the oldest tasks of other workers when it runs out,
+ *     which keeps related work on one thread while balancing load. Idle workers block and use
+ *     no CPU. Submitted tasks return a TaskFuture which supports continuations via then().
+ *
+ *     Where BackgroundTask owns one long-running thread, the TaskScheduler is for work that
+ *     should be spread over all cores (e.g. parallelFor over a data set) without each feature
+ *     spawning its own threads. Use TaskScheduler::getShared() for the process-wide pool.
+ */
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <type_traits>
+#include <variant>
+#include <optional>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+
+// Used for cooperative cancellation.
+#include "CancellationToken.hpp"
+// Used for the Task_Cancelled exception.
+#include "MIAException.hpp"
+
+namespace threading
+{
+    /**
+     * @brief The order in which queued tasks are taken. Higher priority tasks are always taken
+     * before lower priority tasks that are waiting in any worker's queue.
+     */
+    enum class TaskPriority
+    {
+        HIGH = 0,
+        NORMAL = 1,
+        LOW = 2
+    };
+
+    /// The number of TaskPriority values.
+    constexpr std::size_t TASK_PRIORITY_COUNT = 3;
+
+    class TaskScheduler;
+
+    namespace detail
+    {
+        /**
+         * @brief Type-erased, move-only unit of work held in the scheduler queues.
+         */
+        struct Job
+        {
+            virtual ~Job() = default;
+            virtual void run() = 0;
+        };
+
+        /**
+         * @brief Job which invokes a stored callable.
+         */
+        template<typename Function>
+        struct CallableJob : Job
+        {
+            explicit CallableJob(Function&& function) : function(std::move(function)) { }
+            void run() override { function(); }
+            Function function;
+        };
+
+        /**
+         * @brief Shared result state between a task and its TaskFutures.
+         * @tparam Result - The task result type (may be void).
+         */
+        template<typename Result>
+        struct FutureState
+        {
+            /// The stored value type (std::monostate for void results).
+            using Value = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+            explicit FutureState(TaskScheduler* scheduler) : scheduler(scheduler) { }
+
+            /**
+             * @brief Stores the result (or error) and runs any registered continuations.
+             * @param result[std::optional<Value>] - The value, or empty if error is set.
+             * @param exception[std::exception_ptr] - The error, or null on success.
+             */
+            void complete(std::optional<Value> result, std::exception_ptr exception)
+            {
+                std::vector<std::function<void()>> pending;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    value = std::move(result);
+                    error = exception;
+                    done = true;
+                    pending.swap(continuations);
+                }
+                ready.notify_all();
+                for (auto& continuation : pending)
+                    continuation();
+            }
+
+            /**
+             * @brief Runs a continuation once the state is complete (immediately if it already is).
+             * @param continuation[std::function<void()>] - The continuation to run.
+             */
+            void addContinuation(std::function<void()> continuation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!done)
+                    {
+                        continuations.push_back(std::move(continuation));
+                        return;
+                    }
+                }
+                continuation();
+            }
+
+            /**
+             * @brief Returns whether the result is available.
+             * @return [bool] - True once complete() has been called.
+             */
+            bool isDone()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                return done;
+            }
+
+            /// The scheduler the task runs on.
+            TaskScheduler* scheduler;
+
+            std::mutex mutex;
+            std::condition_variable ready;
+            bool done{false};
+            std::optional<Value> value;
+            std::exception_ptr error;
+            std::vector<std::function<void()>> continuations;
+        };
+    } // namespace detail
+
+    /**
+     * @brief A copyable handle to the result of a task submitted to a TaskScheduler.
+     *
+     * Like std::shared_future, all copies refer to the same result and get() may be called any
+     * number of times. If get() or wait() is called from a worker thread of the same scheduler,
+     * the caller runs other queued tasks while it waits instead of blocking the worker.
+     * @tparam Result - The task result type (may be void).
+     */
+    template<typename Result>
+    class TaskFuture
+    {
+    public:
+        /**
+         * @brief Constructs an empty future (isValid() returns false).
+         */
+        TaskFuture() = default;
+
+        /**
+         * @brief Constructs a future from a shared state (used by TaskScheduler).
+         * @param state[std::shared_ptr<detail::FutureState<Result>>] - The shared state.
+         */
+        explicit TaskFuture(std::shared_ptr<detail::FutureState<Result>> state) :
+            state(std::move(state))
+        { }
+
+        /**
+         * @brief Returns whether this future refers to a task.
+         * @return [bool] - True unless default constructed.
+         */
+        bool isValid() const
+        { return state != nullptr; }
+
+        /**
+         * @brief Returns whether the task has finished (successfully or not).
+         * @return [bool] - True if get() will not block.
+         */
+        bool isReady() const
+        { return state->isDone(); }
+
+        /**
+         * @brief Waits for the task to finish, running other queued tasks if called from a worker.
+         */
+        void wait() const;
+
+        /**
+         * @brief Waits for and returns the task result.
+         * @return [const Result&] - The result (nothing for void tasks).
+         * @throws Any exception thrown by the task, or MIAException(Task_Cancelled) if it was
+         *     cancelled before it ran.
+         */
+        decltype(auto) get() const
+        {
+            wait();
+            if (state->error)
+                std::rethrow_exception(state->error);
+            if constexpr (!std::is_void_v<Result>)
+                return static_cast<const Result&>(*state->value);
+        }
+
+        /**
+         * @brief Schedules a continuation to run with the result once this task finishes.
+         *
+         * The continuation is called with the result (as a const reference), or with no
+         * arguments for void tasks. If this task fails, the continuation is skipped and the
+         * returned future holds the same error.
+         * @param function[Function&&] - The continuation.
+         * @param priority[TaskPriority] - The priority of the continuation task.
+         * @return [TaskFuture<...>] - A future for the continuation's result.
+         */
+        template<typename Function>
+        auto then(Function&& function, TaskPriority priority = TaskPriority::NORMAL) const;
+
+    private:
+        /// The shared result state.
+        std::shared_ptr<detail::FutureState<Result>> state;
+    }; // class TaskFuture
+
+    /**
+     * @brief A work-stealing thread pool with priorities, futures and parallelFor.
+     */
+    class TaskScheduler
+    {
+    public:
+        /**
+         * @brief Starts the worker threads.
+         * @param threadCount[std::size_t] - The number of workers; 0 uses one per hardware thread.
+         */
+        explicit TaskScheduler(std::size_t threadCount = 0);
+
+        /**
+         * @brief Runs all queued tasks to completion, then stops and joins the workers.
+         */
+        ~TaskScheduler();
+
+        /**
+         * @brief Deleted copy and move operations; workers hold a pointer to their scheduler.
+         */
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+        TaskScheduler(TaskScheduler&&) = delete;
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Returns the process-wide scheduler (one worker per hardware thread), created on first use.
+         * @return [TaskScheduler&] - The shared scheduler.
+         */
+        static TaskScheduler& getShared();
+
+        /**
+         * @brief Returns the scheduler whose worker is the calling thread.
+         * @return [TaskScheduler*] - The scheduler, or nullptr if not called from a worker.
+         */
+        static TaskScheduler* getCurrent();
+
+        /**
+         * @brief Returns the number of worker threads.
+         * @return [std::size_t] - The worker count.
+         */
+        std::size_t getThreadCount() const
+        { return workers.size(); }
+
+        /**
+         * @brief Queues a task. Tasks submitted from a worker go to that worker's own queue.
+         * @param function[Function&&] - The callable to run (taking no arguments).
+         * @param priority[TaskPriority] - The priority of the task.
+         * @param token[const CancellationToken&] - If cancelled before the task starts, the task is
+         *     skipped and its future holds MIAException(Task_Cancelled). Running tasks may also check it.
+         * @return [TaskFuture<...>] - A future for the callable's result.
+         */
+        template<typename Function>
+        auto submit(Function&& function,
+                    TaskPriority priority = TaskPriority::NORMAL,
+                    const CancellationToken& token = CancellationToken::none())
+        {
+            using Callable = std::decay_t<Function>;
+            using Result = std::invoke_result_t<Callable&>;
+            auto state = std::make_shared<detail::FutureState<Result>>(this);
+            enqueue([state, token, callable = Callable(std::forward<Function>(function))]() mutable
+            {
+                if (token.isCancelled())
+                {
+                    auto cancelled = error::MIAException(error::ErrorCode::Task_Cancelled,
+                                                         "Task cancelled before it started.");
+                    state->complete(std::nullopt, std::make_exception_ptr(cancelled));
+                    return;
+                }
+                try
+                {
+                    if constexpr (std::is_void_v<Result>)
+                    {
+                        callable();
+                        state->complete(std::monostate{}, nullptr);
+                    }
+                    else
+                        state->complete(callable(), nullptr);
+                }
+                catch (...)
+                {
+                    state->complete(std::nullopt, std::current_exception());
+                }
+            }, priority);
+            return TaskFuture<Result>(state);
+        }
+
+        /**
+         * @brief Calls body(i) for every i in [begin, end) using all workers and the calling thread.
+         *
+         * The range is split into chunks of grainSize indices which idle threads claim in order,
+         * so uneven iterations balance automatically. Returns once every claimed chunk finishes.
+         * @param begin[std::size_t] - The first index.
+         * @param end[std::size_t] - One past the last index.
+         * @param body[Function&&] - Called as body(std::size_t index).
+         * @param grainSize[std::size_t] - Indices per chunk; 0 picks about four chunks per thread.
+         * @param token[const CancellationToken&] - If cancelled, no further chunks are started.
+         * @throws The first exception thrown by body (remaining chunks are skipped).
+         */
+        template<typename Function>
+        void parallelFor(std::size_t begin,
+                         std::size_t end,
+                         Function&& body,
+                         std::size_t grainSize = 0,
+                         const CancellationToken& token = CancellationToken::none());
+
+        /**
+         * @brief Runs one queued task on the calling thread, if there is one.
+         * @return [bool] - True if a task was run.
+         */
+        bool runPendingTask();
+
+        /**
+         * @brief Blocks until every submitted task has finished. Must not be called from a worker.
+         */
+        void waitIdle();
+
+    private:
+        /// An owned, type-erased task.
+        using JobPtr = std::unique_ptr<detail::Job>;
+
+        /**
+         * @brief A worker thread and its per-priority task deques.
+         */
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<JobPtr> queues[TASK_PRIORITY_COUNT];
+            std::thread thread;
+        };
+
+        /**
+         * @brief Wraps a callable in a Job and queues it.
+         * @param function[Function&&] - The callable.
+         * @param priority[TaskPriority] - The task priority.
+         */
+        template<typename Function>
+        void enqueue(Function&& function, TaskPriority priority)
+        {
+            using Callable = std::decay_t<Function>;
+            push(std::make_unique<detail::CallableJob<Callable>>(Callable(std::forward<Function>(function))),
+                 priority);
+        }
+
+        /**
+         * @brief Queues a job on the calling worker's deque, or on the next worker round-robin.
+         * @param job[JobPtr] - The job.
+         * @param priority[TaskPriority] - The job priority.
+         */
+        void push(JobPtr job, TaskPriority priority);
+
+        /**
+         * @brief Takes the highest priority job available to a thread: its own newest job, or
+         *     else the oldest job of another worker.
+         * @param self[std::size_t] - The worker index of the caller, or workers.size() for non-workers.
+         * @return [JobPtr] - The job, or null if every queue is empty.
+         */
+        JobPtr take(std::size_t self);
+
+        /**
+         * @brief Runs a job and updates the outstanding task count.
+         * @param job[JobPtr] - The job to run.
+         */
+        void execute(JobPtr job);
+
+        /**
+         * @brief The body of each worker thread.
+         * @param index[std::size_t] - The worker index.
+         */
+        void workerLoop(std::size_t index);
+
+        /// The worker threads.
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        /// Jobs queued but not yet taken.
+        std::atomic<std::size_t> queued{0};
+
+        /// Jobs queued or running.
+        std::atomic<std::size_t> outstanding{0};
+
+        /// Workers currently blocked waiting for work.
+        std::atomic<std::size_t> sleeping{0};
+
+        /// Round-robin target for jobs submitted from outside the pool.
+        std::atomic<std::size_t> nextWorker{0};
+
+        /// Set when the scheduler is being destroyed.
+        std::atomic<bool> stopping{false};
+
+        /// Guards sleeping workers and waitIdle().
+        std::mutex sleepMutex;
+
+        /// Wakes sleeping workers when work is queued.
+        std::condition_variable workAvailable;
+
+        /// Wakes waitIdle() when the outstanding count reaches zero.
+        std::condition_variable allIdle;
+    }; // class TaskScheduler
+
+
+    template<typename Result>
+    void TaskFuture<Result>::wait() const
+    {
+        TaskScheduler* scheduler = state->scheduler;
+        bool helping = TaskScheduler::getCurrent() == scheduler;
+        while (!state->isDone())
+        {
+            // Workers keep the pool making progress (e.g. nested parallelFor) instead of blocking.
+            if (helping && scheduler->runPendingTask())
+                continue;
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (helping)
+                state->ready.wait_for(lock, std::chrono::milliseconds(1), [this] { return state->done; });
+            else
+                state->ready.wait(lock, [this] { return state->done; });
+        }
+    }
+
+
+    template<typename Result>
+    template<typename Function>
+    auto TaskFuture<Result>::then(Function&& function, TaskPriority priority) const
+    {
+        using Callable = std::decay_t<Function>;
+        using Next = typename std::conditional_t<std::is_void_v<Result>,
+                                                 std::invoke_result<Callable&>,
+                                                 std::invoke_result<Callable&, const Result&>>::type;
+        auto source = state;
+        auto next = std::make_shared<detail::FutureState<Next>>(source->scheduler);
+        auto callable = std::make_shared<Callable>(std::forward<Function>(function));
+        source->addContinuation([source, next, priority, callable]()
+            {
+                source->scheduler->submit([source, next, callable]()
+                {
+                    if (source->error)
+                    {
+                        next->complete(std::nullopt, source->error);
+                        return;
+                    }
+                    try
+                    {
+                        if constexpr (std::is_void_v<Next>)
+                        {
+                            if constexpr (std::is_void_v<Result>)
+                                (*callable)();
+                            else
+                                (*callable)(static_cast<const Result&>(*source->value));
+                            next->complete(std::monostate{}, nullptr);
+                        }
+                        else if constexpr (std::is_void_v<Result>)
+                            next->complete((*callable)(), nullptr);
+                        else
+                            next->complete((*callable)(static_cast<const Result&>(*source->value)), nullptr);
+                    }
+                    catch (...)
+                    {
+                        next->complete(std::nullopt, std::current_exception());
+                    }
+                }, priority);
+            });
+        return TaskFuture<Next>(next);
+    }
+
+
+    template<typename Function>
+    void TaskScheduler::parallelFor(std::size_t begin,
+                                    std::size_t end,
+                                    Function&& body,
+                                    std::size_t grainSize,
+                                    const CancellationToken& token)
+    {
+        if (begin >= end || token.isCancelled())
+            return;
+
+        std::size_t count = end - begin;
+        std::size_t threads = workers.size() + 1;
+        if (grainSize == 0)
+            grainSize = std::max<std::size_t>(1, count / (threads * 4));
+        std::size_t chunks = (count + grainSize - 1) / grainSize;
+
+        // Shared by every runner; lives on this stack frame until all runners have finished.
+        std::atomic<std::size_t> nextChunk{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr firstError;
+        std::mutex errorMutex;
+
+        auto runChunks = [&]()
+        {
+            while (!failed.load(std::memory_order_relaxed) && !token.isCancelled())
+            {
+                std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks)
+                    return;
+                std::size_t first = begin + chunk * grainSize;
+                std::size_t last = std::min(end, first + grainSize);
+                try
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                        body(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!firstError)
+                        firstError = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::size_t helpers = std::min(workers.size(), chunks - 1);
+        std::vector<TaskFuture<void>> runners;
+        runners.reserve(helpers);
+        for (std::size_t i = 0; i < helpers; ++i)
+            runners.push_back(submit(runChunks, TaskPriority::HIGH));
+
+        runChunks();
+        for (const auto& runner : runners)
+            runner.wait();
+
+        if (firstError)
+            std::rethrow_exception(firstError);
+    }
+} // namespace threading
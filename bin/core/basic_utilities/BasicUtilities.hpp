@@ -9,6 +9,9 @@
 #pragma once
 
 #include <string>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
 
 namespace BasicUtilities
 {
@@ -72,4 +75,40 @@ namespace BasicUtilities
      * @return true if file exists or was successfully created, false otherwise.
      */
     bool ensureFileExists(const std::string& path, bool createIfMissing = true);
+
+    /**
+     * @brief Writes a file through a temporary file ("<path>.tmp") which is then renamed over it,
+     *     so readers (including processes which have the old file mapped) never see a partially
+     *     written file. The temporary file is removed if writing or renaming fails.
+     * @param path[const std::string&] - The file to write.
+     * @param write[Writer] - Called with the open binary std::ofstream to write the contents.
+     * @return [bool] - True if the file was written and renamed into place.
+     */
+    template<typename Writer>
+    bool replaceFile(const std::string& path, Writer write)
+    {
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+                return false;
+            write(out);
+            out.close();
+            if (!out)
+            {
+                std::error_code errCode;
+                std::filesystem::remove(tempPath, errCode);
+                return false;
+            }
+        }
+
+        std::error_code errCode;
+        std::filesystem::rename(tempPath, path, errCode);
+        if (errCode)
+        {
+            std::filesystem::remove(tempPath, errCode);
+            return false;
+        }
+        return true;
+    }
 }
@@ -10,6 +10,8 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
 
 namespace fs = std::filesystem;
 
@@ -105,3 +107,29 @@ TEST(BasicUtilitiesTest, EnsureFileExists)
     fs::remove(testFile);
 }
 
+
+/**
+ * @test BasicUtilitiesTest.ReplaceFile
+ * @brief Tests that replaceFile writes through a temporary file and leaves no temporary behind.
+ */
+TEST(BasicUtilitiesTest, ReplaceFile)
+{
+    std::string testFile = "test_replace_gtest.txt";
+    if (fs::exists(testFile)) fs::remove(testFile);
+
+    // Writes a new file, then replaces it.
+    EXPECT_TRUE(BasicUtilities::replaceFile(testFile, [](std::ofstream& out) { out << "first"; }));
+    EXPECT_TRUE(BasicUtilities::replaceFile(testFile, [](std::ofstream& out) { out << "second"; }));
+    std::ifstream in(testFile);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    EXPECT_EQ(contents, "second");
+    EXPECT_FALSE(fs::exists(testFile + ".tmp"));
+
+    // Fails without leaving a temporary file if the target directory does not exist.
+    EXPECT_FALSE(BasicUtilities::replaceFile("missing_dir_gtest/file.txt", [](std::ofstream& out) { out << "x"; }));
+    EXPECT_FALSE(fs::exists("missing_dir_gtest"));
+
+    // Cleanup after test
+    fs::remove(testFile);
+}
@@ -10,8 +10,14 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <mutex>
 #include "BackgroundTask.hpp"
 
+#if defined(IS_LINUX)
+    #include <unistd.h>
+#endif
+
 using namespace threading;
 
 /**
@@ -106,3 +112,165 @@ TEST(BackgroundTaskTest, ConditionToggle)
     task.toggleCondition();
     EXPECT_TRUE(task.isConditionMet());
 }
+
+/**
+ * @brief Test implementation of BackgroundTask used for the blocking task modes.
+ *
+ * The run() method records the time of each call and, if a file descriptor is being
+ * watched, drains it. The protected mode setters are exposed for the tests.
+ */
+class WaitingTask : public BackgroundTask
+{
+public:
+    using BackgroundTask::setEventDriven;
+    using BackgroundTask::setPeriodic;
+    using BackgroundTask::addWatchedFd;
+
+    std::atomic<int> runCount{0};
+    std::vector<std::chrono::steady_clock::time_point> runTimes;
+    std::vector<int> lastReadyFds;
+    std::mutex runMutex;
+    std::chrono::milliseconds workTime{0};
+
+    void run() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(runMutex);
+            runTimes.push_back(std::chrono::steady_clock::now());
+            lastReadyFds = getReadyFds();
+#if defined(IS_LINUX)
+            for (int fd : getReadyFds())
+            {
+                char byte;
+                [[maybe_unused]] ssize_t bytesRead = read(fd, &byte, 1);
+            }
+#endif
+        }
+        if (workTime.count() > 0)
+            std::this_thread::sleep_for(workTime);
+        ++runCount;
+    }
+};
+
+/**
+ * @brief Waits until the predicate holds or the timeout expires.
+ * @return [bool] - The final value of the predicate.
+ */
+template<typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+{
+    auto end = std::chrono::steady_clock::now() + timeout;
+    while (!predicate() && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return predicate();
+}
+
+/**
+ * @test BackgroundTaskTest.EventDrivenRunsOnlyWhenNotified
+ * @brief Verifies that an event-driven task stays idle until notify() is called, runs once
+ *        per notification, and that stop() wakes it without a notification.
+ */
+TEST(BackgroundTaskTest, EventDrivenRunsOnlyWhenNotified)
+{
+    WaitingTask task;
+    task.setEventDriven();
+    EXPECT_EQ(task.getMode(), TaskMode::EVENT_DRIVEN);
+    task.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(task.runCount.load(), 0);
+
+    task.notify();
+    EXPECT_TRUE(waitFor([&task] { return task.runCount.load() == 1; }));
+    task.notify();
+    EXPECT_TRUE(waitFor([&task] { return task.runCount.load() == 2; }));
+
+    auto stopStart = std::chrono::steady_clock::now();
+    task.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::milliseconds(100));
+    EXPECT_EQ(task.runCount.load(), 2);
+    EXPECT_FALSE(task.isRunning());
+}
+
+/**
+ * @test BackgroundTaskTest.PeriodicCompensatesForDrift
+ * @brief Verifies that a periodic task runs on absolute deadlines, so the time spent inside
+ *        run() does not accumulate into the schedule, and that stop() interrupts the wait.
+ */
+TEST(BackgroundTaskTest, PeriodicCompensatesForDrift)
+{
+    WaitingTask task;
+    task.setPeriodic(std::chrono::milliseconds(10));
+    task.workTime = std::chrono::milliseconds(4);
+    task.start();
+
+    EXPECT_TRUE(waitFor([&task] { return task.runCount.load() >= 11; }));
+    task.stop();
+
+    std::lock_guard<std::mutex> lock(task.runMutex);
+    ASSERT_GE(task.runTimes.size(), 11u);
+    auto elapsed = task.runTimes[10] - task.runTimes[0];
+    
+    // Ten periods of 10ms; without drift compensation this would be at least 140ms.
+    EXPECT_GE(elapsed, std::chrono::milliseconds(100) - std::chrono::milliseconds(1));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(100) + std::chrono::milliseconds(30) * (task.getMissedPeriods() + 1));
+}
+
+/**
+ * @test BackgroundTaskTest.ModeMustBeSetBeforeStart
+ * @brief Verifies that invalid periods and mode changes on a started task are rejected.
+ */
+TEST(BackgroundTaskTest, ModeMustBeSetBeforeStart)
+{
+    WaitingTask task;
+    EXPECT_THROW(task.setPeriodic(std::chrono::nanoseconds(0)), error::MIAException);
+
+    task.setEventDriven();
+    task.start();
+    EXPECT_THROW(task.setPeriodic(std::chrono::milliseconds(1)), error::MIAException);
+    task.stop();
+}
+
+#if defined(IS_LINUX)
+/**
+ * @test BackgroundTaskTest.FdReadyRunsWhenReadable
+ * @brief Verifies that a task watching a pipe runs when data is written to it, reports the
+ *        ready descriptor, and can also be woken by notify() and stop().
+ */
+TEST(BackgroundTaskTest, FdReadyRunsWhenReadable)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    {
+        WaitingTask task;
+        task.addWatchedFd(fds[0]);
+        EXPECT_EQ(task.getMode(), TaskMode::FD_READY);
+        task.start();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(task.runCount.load(), 0);
+
+        ASSERT_EQ(write(fds[1], "x", 1), 1);
+        EXPECT_TRUE(waitFor([&task] { return task.runCount.load() == 1; }));
+        {
+            std::lock_guard<std::mutex> lock(task.runMutex);
+            ASSERT_EQ(task.lastReadyFds.size(), 1u);
+            EXPECT_EQ(task.lastReadyFds[0], fds[0]);
+        }
+
+        task.notify();
+        EXPECT_TRUE(waitFor([&task] { return task.runCount.load() == 2; }));
+        {
+            std::lock_guard<std::mutex> lock(task.runMutex);
+            EXPECT_TRUE(task.lastReadyFds.empty());
+        }
+
+        task.stop();
+        EXPECT_EQ(task.runCount.load(), 2);
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file CommandLine_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Unit tests for the table-driven CommandLine parser using Google Test.
+ */
+
+#include <gtest/gtest.h>
+#include "CommandLine.hpp"
+#include "MIAException.hpp"
+
+using error::MIAException;
+using error::ErrorCode;
+
+
+/**
+ * @brief Fixture which registers one option of every supported type.
+ */
+class CommandLineTest : public ::testing::Test
+{
+protected:
+    CommandOption verboseOpt{"-v", "--verbose", "Enable verbose output.", CommandOption::BOOL_OPTION};
+    CommandOption testOpt{"-t", "--test", "Enable test mode.", CommandOption::BOOL_OPTION};
+    CommandOption countOpt{"-n", "--count", "A count.", CommandOption::INT_OPTION};
+    CommandOption levelOpt{"-d", "--debug", "A debug level.", CommandOption::UNSIGNED_INT_OPTION};
+    CommandOption ratioOpt{"", "--ratio", "A ratio.", CommandOption::DOUBLE_OPTION};
+    CommandOption fileOpt{"-c", "--config", "A config file.", CommandOption::STRING_OPTION};
+
+    bool verbose{false};
+    bool test{false};
+    int count{0};
+    unsigned int level{0};
+    double ratio{1.0};
+    std::string file{"default.MIA"};
+
+    CommandLine commandLine;
+
+    void SetUp() override
+    {
+        commandLine.addHelpSection("Options:");
+        commandLine.addOption(verboseOpt, verbose);
+        commandLine.addOption(testOpt, test);
+        commandLine.addOption(countOpt, count);
+        commandLine.addOption(levelOpt, level);
+        commandLine.addOption(ratioOpt, ratio);
+        commandLine.addOption(fileOpt, file);
+    }
+
+    /// Parses the given arguments (argv[0] is added automatically).
+    void parse(std::vector<std::string> args)
+    {
+        args.insert(args.begin(), "prog");
+        std::vector<char*> argv;
+        for (std::string& arg : args)
+            argv.push_back(arg.data());
+        commandLine.parse(static_cast<int>(argv.size()), argv.data());
+    }
+};
+
+/**
+ * @test CommandLineTest.ParsesEveryFormInOnePass
+ * @brief Verifies separate values, "--opt=value", attached short values, positional and
+ *        unknown arguments, and that absent options keep their defaults.
+ */
+TEST_F(CommandLineTest, ParsesEveryFormInOnePass)
+{
+    parse({"--count", "-7", "--ratio=2.5", "-cmy.MIA", "input.txt", "--unknown", "-v"});
+
+    EXPECT_TRUE(verbose);
+    EXPECT_FALSE(test);
+    EXPECT_EQ(count, -7);
+    EXPECT_EQ(level, 0u);
+    EXPECT_DOUBLE_EQ(ratio, 2.5);
+    EXPECT_EQ(file, "my.MIA");
+    EXPECT_TRUE(commandLine.isSet("--config"));
+    EXPECT_FALSE(commandLine.isSet("--debug"));
+    EXPECT_EQ(commandLine.getPositionalArgs(), std::vector<std::string>({"input.txt"}));
+    EXPECT_EQ(commandLine.getUnknownArgs(), std::vector<std::string>({"--unknown"}));
+}
+
+/**
+ * @test CommandLineTest.BundledShortFlags
+ * @brief Verifies that bundled short flags are expanded and that a value option may end a
+ *        bundle, taking the rest of the token or the next argument as its value.
+ */
+TEST_F(CommandLineTest, BundledShortFlags)
+{
+    parse({"-vtd3", "-tn", "12", "--", "-v"});
+
+    EXPECT_TRUE(verbose);
+    EXPECT_TRUE(test);
+    EXPECT_EQ(level, 3u);
+    EXPECT_EQ(count, 12);
+    EXPECT_EQ(commandLine.getPositionalArgs(), std::vector<std::string>({"-v"}));
+}
+
+/**
+ * @test CommandLineTest.InvalidValuesThrow
+ * @brief Verifies that unconvertible values, negative unsigned values and missing values
+ *        throw Invalid_Argument.
+ */
+TEST_F(CommandLineTest, InvalidValuesThrow)
+{
+    auto expectInvalid = [this](std::vector<std::string> args)
+    {
+        try
+        {
+            parse(args);
+            FAIL() << "Expected MIAException";
+        }
+        catch (const MIAException& ex)
+        {
+            EXPECT_EQ(ex.getCode(), ErrorCode::Invalid_Argument);
+        }
+    };
+    expectInvalid({"--count", "12abc"});
+    expectInvalid({"-d", "-1"});
+    expectInvalid({"--ratio=fast"});
+    expectInvalid({"--verbose=maybe"});
+    expectInvalid({"--config"});
+}
+
+/**
+ * @test CommandLineTest.RegistrationAndRequiredErrors
+ * @brief Verifies that mismatched sink types and duplicate names are rejected at registration
+ *        and that a missing required option throws Missing_Argument.
+ */
+TEST_F(CommandLineTest, RegistrationAndRequiredErrors)
+{
+    std::string wrongSink;
+    EXPECT_THROW(commandLine.addOption(countOpt, wrongSink), MIAException);
+
+    bool duplicate{false};
+    CommandOption shortClash("-v", "--version", "Clashes with -v.", CommandOption::BOOL_OPTION);
+    EXPECT_THROW(commandLine.addOption(shortClash, duplicate), MIAException);
+
+    std::string output;
+    CommandOption outputOpt("-o", "--output", "An output file.", CommandOption::STRING_OPTION, true);
+    commandLine.addOption(outputOpt, output);
+    try
+    {
+        parse({"-v"});
+        FAIL() << "Expected MIAException";
+    }
+    catch (const MIAException& ex)
+    {
+        EXPECT_EQ(ex.getCode(), ErrorCode::Missing_Argument);
+    }
+
+    parse({"--output", "out.txt"});
+    EXPECT_EQ(output, "out.txt");
+}
+
+/**
+ * @test CommandLineTest.GeneratedHelp
+ * @brief Verifies that the help lists the section heading followed by each option's help.
+ */
+TEST_F(CommandLineTest, GeneratedHelp)
+{
+    std::string help = commandLine.getHelp();
+    EXPECT_EQ(help.rfind("Options:\n", 0), 0u);
+    EXPECT_NE(help.find(verboseOpt.getHelp() + "\n"), std::string::npos);
+    EXPECT_NE(help.find(ratioOpt.getHelp() + "\n"), std::string::npos);
+}
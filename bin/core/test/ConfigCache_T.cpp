@@ -0,0 +1,225 @@
+/**
+ * @file ConfigCache_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Unit tests for the compiled configuration cache using Google Test.
+ */
+
+#include <gtest/gtest.h>
+#include "MIAConfig.hpp"
+#include "ConfigCache.hpp"
+#include "Constants.hpp"
+
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+
+using namespace config;
+using namespace constants;
+
+
+class ConfigCacheTest : public ::testing::Test
+{
+protected:
+    std::string filePath;
+    std::string cachePath;
+    std::string rawCachePath;
+
+    void SetUp() override
+    {
+        filePath = std::filesystem::absolute("test_config_cache.cfg").string();
+        cachePath = config_cache::getCachePath(filePath, ConfigType::KEY_VALUE);
+        rawCachePath = config_cache::getCachePath(filePath, ConfigType::RAW_LINES);
+        std::filesystem::remove(cachePath);
+        std::filesystem::remove(rawCachePath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(filePath);
+        std::filesystem::remove(cachePath);
+        std::filesystem::remove(rawCachePath);
+    }
+
+    // Replaces the contents of the test configuration file.
+    void writeConfig(const std::string& content)
+    {
+        std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+};
+
+/**
+ * @test ConfigCacheTest.SecondLoadUsesCache
+ * @brief Verifies that the first load parses the text and writes the cache, and that a
+ *        second load reads every value type back from the cache.
+ */
+TEST_F(ConfigCacheTest, SecondLoadUsesCache)
+{
+    writeConfig("port=8080\nhost=localhost\npi=3.14\ndebug=true\nids=1,2,3\n");
+
+    MIAConfig first(filePath, ConfigType::KEY_VALUE);
+    first.setCacheEnabled(true);
+    first.initialize();
+    EXPECT_FALSE(first.isLoadedFromCache());
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+    MIAConfig second(filePath, ConfigType::KEY_VALUE);
+    second.setCacheEnabled(true);
+    second.initialize();
+    EXPECT_TRUE(second.isLoadedFromCache());
+    EXPECT_EQ(second.getInt("port"), 8080);
+    EXPECT_EQ(second.getString("host"), "localhost");
+    EXPECT_DOUBLE_EQ(second.getDouble("pi"), 3.14);
+    EXPECT_TRUE(second.getBool("debug"));
+    EXPECT_EQ(second.getIntVector("ids", ','), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(second.get(second.getKey<int>("port")), 8080);
+    EXPECT_EQ(second.getAllConfigPairs(), first.getAllConfigPairs());
+}
+
+/**
+ * @test ConfigCacheTest.ChangedSourceIsReparsed
+ * @brief Verifies that edits to the source file invalidate the cache, including an edit
+ *        which keeps the file size the same and lands within the modification time window.
+ */
+TEST_F(ConfigCacheTest, ChangedSourceIsReparsed)
+{
+    writeConfig("port=8080\n");
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(true);
+    config.initialize();
+
+    // Same size, written immediately after the cache.
+    writeConfig("port=9090\n");
+    config.reload();
+    EXPECT_FALSE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 9090);
+
+    // Different size.
+    writeConfig("port=10100\n");
+    config.reload();
+    EXPECT_FALSE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 10100);
+
+    config.reload();
+    EXPECT_TRUE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 10100);
+}
+
+/**
+ * @test ConfigCacheTest.RacyCacheIsRewrittenOnceSettled
+ * @brief Verifies that a cache flagged as racy is still used when the source matches by content,
+ *        and is rewritten without the flag once the source is outside the racy window.
+ */
+TEST_F(ConfigCacheTest, RacyCacheIsRewrittenOnceSettled)
+{
+    writeConfig("port=8080\n");
+    std::filesystem::last_write_time(filePath, std::filesystem::file_time_type::clock::now() - std::chrono::minutes(1));
+
+    auto readHeader = [this]()
+    {
+        config_cache::Header header{};
+        std::ifstream in(cachePath, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return header;
+    };
+
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(true);
+    config.initialize();
+    ASSERT_EQ(readHeader().racy, 0u);
+
+    // Mark the cache as racy, as if it had been written right after the source was edited.
+    config_cache::Header header = readHeader();
+    header.racy = 1;
+    {
+        std::fstream out(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    config.reload();
+    EXPECT_TRUE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 8080);
+    EXPECT_EQ(readHeader().racy, 0u);
+
+    config.reload();
+    EXPECT_TRUE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 8080);
+}
+
+/**
+ * @test ConfigCacheTest.CorruptCacheFallsBackToText
+ * @brief Verifies that a truncated cache file is ignored and replaced.
+ */
+TEST_F(ConfigCacheTest, CorruptCacheFallsBackToText)
+{
+    writeConfig("port=8080\n");
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(true);
+    config.initialize();
+
+    std::filesystem::resize_file(cachePath, sizeof(config_cache::Header) + 4);
+    config.reload();
+    EXPECT_FALSE(config.isLoadedFromCache());
+    EXPECT_EQ(config.getInt("port"), 8080);
+
+    config.reload();
+    EXPECT_TRUE(config.isLoadedFromCache());
+}
+
+/**
+ * @test ConfigCacheTest.RawLinesAndKeyValueCachesCoexist
+ * @brief Verifies that raw lines and their line numbers are restored from the cache and
+ *        that reading the same file as both types keeps a separate cache for each.
+ */
+TEST_F(ConfigCacheTest, RawLinesAndKeyValueCachesCoexist)
+{
+    writeConfig("# header\nfirst=line\n\nsecond=line\n");
+
+    MIAConfig first(filePath, ConfigType::RAW_LINES);
+    first.setCacheEnabled(true);
+    first.initialize();
+    MIAConfig second(filePath, ConfigType::RAW_LINES);
+    second.setCacheEnabled(true);
+    second.initialize();
+    EXPECT_TRUE(second.isLoadedFromCache());
+    ASSERT_EQ(second.getLines().size(), 2u);
+    EXPECT_EQ(second.getLines()[0].text, "first=line");
+    EXPECT_EQ(second.getLines()[1].lineNumber, 4u);
+
+    MIAConfig keyValue(filePath, ConfigType::KEY_VALUE);
+    keyValue.setCacheEnabled(true);
+    keyValue.initialize();
+    EXPECT_FALSE(keyValue.isLoadedFromCache());
+    EXPECT_EQ(keyValue.getString("second"), "line");
+
+    keyValue.reload();
+    second.reload();
+    EXPECT_TRUE(keyValue.isLoadedFromCache());
+    EXPECT_TRUE(second.isLoadedFromCache());
+}
+
+/**
+ * @test ConfigCacheTest.DisabledCacheIsNotWritten
+ * @brief Verifies that the cache is disabled by default and that a disabled cache is
+ *        neither read nor written.
+ */
+TEST_F(ConfigCacheTest, DisabledCacheIsNotWritten)
+{
+    writeConfig("port=8080\n");
+    MIAConfig defaults(filePath, ConfigType::KEY_VALUE);
+    defaults.initialize();
+    defaults.reload();
+    EXPECT_FALSE(defaults.isLoadedFromCache());
+    EXPECT_FALSE(std::filesystem::exists(cachePath));
+
+    MIAConfig enabled(filePath, ConfigType::KEY_VALUE);
+    enabled.setCacheEnabled(true);
+    enabled.initialize();
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(false);
+    config.initialize();
+    EXPECT_FALSE(config.isLoadedFromCache());
+}
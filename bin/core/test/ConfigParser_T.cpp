@@ -0,0 +1,84 @@
+/**
+ * @file ConfigParser_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Unit tests for the single-pass config_parser tokenizers using Google Test.
+ */
+
+#include <gtest/gtest.h>
+#include "ConfigParser.hpp"
+
+using namespace config;
+
+
+/**
+ * @test ConfigParserTest.ParseLinesSkipsCommentsAndShortLines
+ * @brief Verifies that parseLines() applies the MIAConfig skip rules, strips line
+ *        endings and records 1-based line numbers.
+ */
+TEST(ConfigParserTest, ParseLinesSkipsCommentsAndShortLines)
+{
+    ConfigFileBuffer buffer;
+    buffer.assign("# comment\r\n\nfirst line\r\nab\nsecond line");
+
+    std::vector<ConfigLine> lines;
+    config_parser::parseLines(buffer.view(), lines);
+
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].text, "first line");
+    EXPECT_EQ(lines[0].lineNumber, 3u);
+    EXPECT_EQ(lines[1].text, "second line");
+    EXPECT_EQ(lines[1].lineNumber, 5u);
+}
+
+/**
+ * @test ConfigParserTest.ParseKeyValuesStripsAndPointsIntoBuffer
+ * @brief Verifies that parseKeyValues() strips keys and values and that the resulting
+ *        views point into the buffer rather than into copies.
+ */
+TEST(ConfigParserTest, ParseKeyValuesStripsAndPointsIntoBuffer)
+{
+    ConfigFileBuffer buffer;
+    buffer.assign("  port = 8080 \r\nhost=localhost\n");
+
+    std::vector<KeyValueToken> tokens;
+    std::vector<ConfigParseIssue> issues;
+    config_parser::parseKeyValues(buffer.view(), tokens, issues);
+
+    ASSERT_EQ(tokens.size(), 2u);
+    EXPECT_TRUE(issues.empty());
+    EXPECT_EQ(tokens[0].key, "port");
+    EXPECT_EQ(tokens[0].value, "8080");
+    EXPECT_EQ(tokens[0].lineNumber, 1u);
+    EXPECT_EQ(tokens[0].valueColumn, 10u);
+    EXPECT_EQ(tokens[1].key, "host");
+    EXPECT_EQ(tokens[1].value, "localhost");
+
+    std::string_view whole = buffer.view();
+    EXPECT_GE(tokens[1].value.data(), whole.data());
+    EXPECT_LE(tokens[1].value.data() + tokens[1].value.size(), whole.data() + whole.size());
+}
+
+/**
+ * @test ConfigParserTest.ParseKeyValuesReportsMalformedLines
+ * @brief Verifies that malformed lines are skipped and reported with their exact
+ *        line and column.
+ */
+TEST(ConfigParserTest, ParseKeyValuesReportsMalformedLines)
+{
+    ConfigFileBuffer buffer;
+    buffer.assign("good=1\nno equals here\n=value\nkey=   \n");
+
+    std::vector<KeyValueToken> tokens;
+    std::vector<ConfigParseIssue> issues;
+    config_parser::parseKeyValues(buffer.view(), tokens, issues);
+
+    ASSERT_EQ(tokens.size(), 1u);
+    ASSERT_EQ(issues.size(), 3u);
+    EXPECT_EQ(issues[0].lineNumber, 2u);
+    EXPECT_EQ(issues[0].column, 1u);
+    EXPECT_EQ(issues[1].lineNumber, 3u);
+    EXPECT_EQ(issues[1].column, 1u);
+    EXPECT_EQ(issues[2].lineNumber, 4u);
+    EXPECT_EQ(issues[2].column, 5u);
+}
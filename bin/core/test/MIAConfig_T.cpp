@@ -35,6 +35,8 @@ std::string createTempConfigFile(const std::string& content)
 void removeTempConfigFile(const std::string& path) 
 {
     std::remove(path.c_str());
+    std::remove((path + ".kv.cache").c_str());
+    std::remove((path + ".raw.cache").c_str());
 }
 
 
@@ -164,3 +166,127 @@ TEST_F(MIAConfigTest, ExceptionThrownForMissingKey)
     EXPECT_THROW(config.getBool("undefined"), error::MIAException);
 }
 
+
+/**
+ * @test MIAConfigTest.TypedKeysResolveAndRead
+ * @brief Verifies that typed ConfigKey handles resolve against the loaded configuration
+ *        and return the pre-parsed values.
+ *
+ * The test resolves keys of each supported type, reads them repeatedly and confirms the
+ * handles remain valid (and are re-resolved) after a reload.
+ */
+TEST_F(MIAConfigTest, TypedKeysResolveAndRead) 
+{
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.initialize();
+
+    ConfigKey<int> portKey = config.getKey<int>("port");
+    ConfigKey<double> piKey = config.getKey<double>("pi");
+    ConfigKey<bool> debugKey = config.getKey<bool>("debug");
+    ConfigKey<std::string> hostKey = config.getKey<std::string>("host");
+    ConfigKey<std::vector<int>> idsKey = config.getKey<std::vector<int>>("ids");
+
+    EXPECT_EQ(config.get(portKey), 8080);
+    EXPECT_DOUBLE_EQ(config.get(piKey), 3.14);
+    EXPECT_TRUE(config.get(debugKey));
+    EXPECT_EQ(config.get(hostKey), "localhost");
+    EXPECT_EQ(config.get(idsKey), std::vector<int>({1, 2, 3}));
+
+    // An int value can be read losslessly as a double.
+    EXPECT_DOUBLE_EQ(config.get(config.getKey<double>("port")), 8080.0);
+
+    config.reload();
+    EXPECT_EQ(config.get(portKey), 8080);
+
+    // An unresolved key is resolved by name on first use.
+    ConfigKey<std::string> lazyKey("names");
+    EXPECT_EQ(config.get(lazyKey), "alpha,beta,gamma");
+}
+
+/**
+ * @test MIAConfigTest.MalformedValuesAreReported
+ * @brief Verifies that values which cannot be read as the requested type throw
+ *        MIAException instead of silently returning a default.
+ */
+TEST_F(MIAConfigTest, MalformedValuesAreReported) 
+{
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.initialize();
+
+    EXPECT_THROW(config.getInt("host"), error::MIAException);
+    EXPECT_THROW(config.getInt("pi"), error::MIAException);
+    EXPECT_THROW(config.getDouble("names"), error::MIAException);
+    EXPECT_THROW(config.getBool("port"), error::MIAException);
+    EXPECT_THROW(config.getIntVector("names", ','), error::MIAException);
+    EXPECT_THROW(config.getKey<int>("host"), error::MIAException);
+    EXPECT_THROW(config.getKey<int>("nonexistent"), error::MIAException);
+}
+
+/**
+ * @test MIAConfigTest.FailedReloadKeepsLoadedValues
+ * @brief Verifies that a reload which fails (here because the file was removed) throws and
+ *        leaves the previously loaded values readable.
+ */
+TEST_F(MIAConfigTest, FailedReloadKeepsLoadedValues) 
+{
+    MIAConfig config(filePath, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(false);
+    config.initialize();
+    removeTempConfigFile(filePath);
+
+    EXPECT_THROW(config.reload(), error::MIAException);
+    EXPECT_EQ(config.getInt("port"), 8080);
+    EXPECT_EQ(config.getString("host"), "localhost");
+    EXPECT_TRUE(config.getParseIssues().empty());
+}
+
+/**
+ * @test MIAConfigLoadTest.MalformedTypedValuesAreReportedAtLoad
+ * @brief Verifies that numeric-looking values which cannot be read as their type are
+ *        reported by getParseIssues() when the file is loaded, while string lists are not.
+ */
+TEST(MIAConfigLoadTest, MalformedTypedValuesAreReportedAtLoad) 
+{
+    std::string path = createTempConfigFile(
+        "big=99999999999\n"
+        "ids=1, 2, 3x\n"
+        "mixed=1,2,3,a,b,c\n"
+        "ratios=0.5,1.5\n"
+        "ip=10.0.0.1\n");
+    MIAConfig config(path, ConfigType::KEY_VALUE);
+    config.setCacheEnabled(false);
+    config.initialize();
+
+    const std::vector<ConfigParseIssue>& issues = config.getParseIssues();
+    ASSERT_EQ(issues.size(), 2u);
+    EXPECT_EQ(issues[0].lineNumber, 1u);
+    EXPECT_EQ(issues[0].column, 5u);
+    EXPECT_EQ(issues[1].lineNumber, 2u);
+    EXPECT_EQ(issues[1].column, 11u);
+
+    // The values are still loaded as read.
+    EXPECT_DOUBLE_EQ(config.getDouble("big"), 99999999999.0);
+    EXPECT_EQ(config.getString("ids"), "1, 2, 3x");
+    EXPECT_EQ(config.getVector("mixed", ',').size(), 6u);
+    removeTempConfigFile(path);
+}
+
+/**
+ * @test MIAConfigTest.RawLinesKeepLineNumbers
+ * @brief Verifies that a RAW_LINES configuration exposes both copied raw lines and
+ *        zero-copy line views with their original line numbers.
+ */
+TEST_F(MIAConfigTest, RawLinesKeepLineNumbers) 
+{
+    MIAConfig config(filePath, ConfigType::RAW_LINES);
+    config.initialize();
+
+    std::vector<std::string> rawLines = config.getRawLines();
+    const std::vector<ConfigLine>& lines = config.getLines();
+    ASSERT_EQ(rawLines.size(), 6u);
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(rawLines[1], "host=localhost");
+    EXPECT_EQ(lines[1].text, "host=localhost");
+    EXPECT_EQ(lines[1].lineNumber, 2u);
+    EXPECT_TRUE(config.getParseIssues().empty());
+}
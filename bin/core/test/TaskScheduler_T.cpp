@@ -0,0 +1,148 @@
+/**
+ * @file TaskScheduler_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests the TaskScheduler thread pool, futures, continuations, parallelFor,
+ *     priorities and cancellation.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include "TaskScheduler.hpp"
+#include "RuntimeContext.hpp"
+
+using namespace threading;
+
+/**
+ * @test TaskScheduler.SubmitReturnsResultsAndErrors
+ * @brief Verifies that futures deliver results, void completion and thrown exceptions.
+ */
+TEST(TaskScheduler, SubmitReturnsResultsAndErrors)
+{
+    TaskScheduler scheduler(2);
+
+    auto answer = scheduler.submit([] { return 6 * 7; });
+    std::atomic<bool> ran{false};
+    auto voidTask = scheduler.submit([&ran] { ran = true; });
+    auto failing = scheduler.submit([]() -> int { throw std::runtime_error("boom"); });
+
+    EXPECT_EQ(answer.get(), 42);
+    voidTask.get();
+    EXPECT_TRUE(ran);
+    EXPECT_THROW(failing.get(), std::runtime_error);
+    EXPECT_TRUE(failing.isReady());
+}
+
+/**
+ * @test TaskScheduler.ContinuationsChainAndPropagateErrors
+ * @brief Verifies that then() receives the previous result and that errors skip continuations.
+ */
+TEST(TaskScheduler, ContinuationsChainAndPropagateErrors)
+{
+    TaskScheduler scheduler(2);
+
+    auto chained = scheduler.submit([] { return 10; })
+                            .then([](int value) { return value * 2; })
+                            .then([](int value) { return std::to_string(value); });
+    EXPECT_EQ(chained.get(), "20");
+
+    std::atomic<bool> continued{false};
+    auto failed = scheduler.submit([]() -> int { throw std::runtime_error("boom"); })
+                           .then([&continued](int) { continued = true; });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_FALSE(continued);
+}
+
+/**
+ * @test TaskScheduler.ParallelForCoversRangeAndNests
+ * @brief Verifies that parallelFor visits every index exactly once, including when called
+ *        from inside a task (where the waiting worker must help instead of blocking).
+ */
+TEST(TaskScheduler, ParallelForCoversRangeAndNests)
+{
+    TaskScheduler scheduler(2);
+
+    std::vector<int> hits(10000, 0);
+    scheduler.parallelFor(0, hits.size(), [&hits](std::size_t i) { hits[i]++; }, 64);
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 10000);
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](int hit) { return hit == 1; }));
+
+    auto nested = scheduler.submit([&scheduler]
+    {
+        std::atomic<long> sum{0};
+        scheduler.parallelFor(1, 101, [&sum](std::size_t i) { sum += static_cast<long>(i); }, 4);
+        return sum.load();
+    });
+    EXPECT_EQ(nested.get(), 5050);
+
+    EXPECT_THROW(scheduler.parallelFor(0, 100, [](std::size_t i)
+    {
+        if (i == 50)
+            throw std::runtime_error("boom");
+    }, 1), std::runtime_error);
+}
+
+/**
+ * @test TaskScheduler.HigherPriorityRunsFirst
+ * @brief Verifies that queued high priority tasks run before queued low priority tasks.
+ */
+TEST(TaskScheduler, HigherPriorityRunsFirst)
+{
+    TaskScheduler scheduler(1);
+
+    // Occupy the only worker while the other tasks are queued.
+    std::atomic<bool> release{false};
+    auto gate = scheduler.submit([&release] { while (!release) std::this_thread::yield(); });
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto record = [&](int id) { std::lock_guard<std::mutex> lock(orderMutex); order.push_back(id); };
+    scheduler.submit([&] { record(3); }, TaskPriority::LOW);
+    scheduler.submit([&] { record(2); }, TaskPriority::NORMAL);
+    scheduler.submit([&] { record(1); }, TaskPriority::HIGH);
+
+    release = true;
+    scheduler.waitIdle();
+    EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+}
+
+/**
+ * @test TaskScheduler.CancellationThroughRuntimeContext
+ * @brief Verifies that cancelling the RuntimeContext token skips queued tasks and parallelFor
+ *        chunks, and that reset() allows new work.
+ */
+TEST(TaskScheduler, CancellationThroughRuntimeContext)
+{
+    TaskScheduler scheduler(1);
+    RuntimeContext context;
+
+    std::atomic<bool> release{false};
+    scheduler.submit([&release] { while (!release) std::this_thread::yield(); });
+
+    std::atomic<bool> ran{false};
+    auto skipped = scheduler.submit([&ran] { ran = true; }, TaskPriority::NORMAL, context.cancellation);
+    context.cancellation.cancel();
+    release = true;
+
+    try
+    {
+        skipped.get();
+        FAIL() << "Expected MIAException";
+    }
+    catch (const error::MIAException& ex)
+    {
+        EXPECT_EQ(ex.getCode(), error::ErrorCode::Task_Cancelled);
+    }
+    EXPECT_FALSE(ran);
+
+    std::atomic<int> iterations{0};
+    scheduler.parallelFor(0, 100, [&iterations](std::size_t) { ++iterations; }, 1, context.cancellation);
+    EXPECT_EQ(iterations.load(), 0);
+
+    context.cancellation.reset();
+    scheduler.parallelFor(0, 100, [&iterations](std::size_t) { ++iterations; }, 1, context.cancellation);
+    EXPECT_EQ(iterations.load(), 100);
+}
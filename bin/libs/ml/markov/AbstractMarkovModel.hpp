@@ -11,20 +11,34 @@
  *     and accessing model internals. This abstraction enables interchangeable
  *     use of different model strategies in generic pipelines.
  *
+ *     The transition storage is a template parameter: the default nested-map
+ *     ProbabilityMatrix, or the CSR-based CompactMarkovMatrix, which uses far less
+ *     memory for dense models such as characters. Compact models can be saved to a
+ *     model file, which a MappedMarkovMatrix model can then use read-only in place.
+ *
  * Dependencies:
  *   - C++17 or later (for template aliasing and override syntax)
  */
 #pragma once
 
+#include <cstdint>
+#include <random>
+#include <string>
+
 #include "MarkovModels.hpp"
+#include "CompactMarkovMatrix.hpp"
+#include "MarkovModelFile.hpp"
+// Used to generate many sequences in parallel.
+#include "TaskScheduler.hpp"
 
 namespace markov_models
 {
     /**
      * Abstract interface for a generic first-order Markov model.
      * @tparam T The type of the state (e.g., char, std::string, custom struct, etc).
+     * @tparam Matrix The transition storage (ProbabilityMatrix<T> or CompactMarkovMatrix<T>).
      */
-    template <typename T>
+    template <typename T, typename Matrix = ProbabilityMatrix<T>>
     class AbstractMarkovModel
     {
     public:
@@ -36,7 +50,44 @@ namespace markov_models
          * @param sequences[const std::vector<std::vector<T>>&] - A vector of input sequences.
          */
         inline void train(const std::vector<std::vector<T>>& sequences)
-        { probabilityMatrix = markov_models::generateProbabilityMatrix(sequences); };
+        { trainFrom(sequences); };
+
+        /**
+         * Adds the transitions of new sequences to the model without retraining from scratch.
+         * @param sequences[const std::vector<std::vector<T>>&] - A vector of input sequences.
+         */
+        inline void update(const std::vector<std::vector<T>>& sequences)
+        { updateFrom(sequences); };
+
+        /**
+         * Trains the model from any container of sequences whose elements convert to T,
+         * read in place (e.g., std::vector<std::string> for char). Counting is sharded
+         * across cores (see countTransitions()).
+         * @tparam Sequences A container of indexable sequences.
+         * @param sequences[const Sequences&] - The input sequences.
+         */
+        template <typename Sequences>
+        void trainFrom(const Sequences& sequences)
+        {
+            clear();
+            updateFrom(sequences);
+        }
+
+        /**
+         * Adds the transitions of any container of sequences to the model (see trainFrom()).
+         * @tparam Sequences A container of indexable sequences.
+         * @param sequences[const Sequences&] - The input sequences.
+         */
+        template <typename Sequences>
+        void updateFrom(const Sequences& sequences)
+        { updateFromCounts(markov_models::countTransitions<T>(sequences)); }
+
+        /**
+         * Adds transition counts gathered elsewhere (e.g., streamed from a file) to the model.
+         * @param counts[const TransitionCounts<T>&] - The counts to add.
+         */
+        inline void updateFromCounts(const TransitionCounts<T>& counts)
+        { markov_models::updateMatrix(probabilityMatrix, transitionCounts, counts); };
 
         /**
          * Checks if the given state exists in the model.
@@ -49,9 +100,10 @@ namespace markov_models
         /**
          * Retrieves the set of successor states and their probabilities for a given state.
          * @param state[const T&] - The current state.
-         * @return [const std::unordered_map<T, double>& - A const reference to the map of successor states.
+         * @return A const reference to the map of successor states (ProbabilityMatrix), or a
+         *     vector of successor and probability pairs (CompactMarkovMatrix).
          */
-        inline const std::unordered_map<T, double>& getTransition(const T& state) const
+        inline decltype(auto) getTransition(const T& state) const
         { return markov_models::getTransitions(probabilityMatrix, state); };
 
         /**
@@ -66,19 +118,43 @@ namespace markov_models
          * @param os The output stream to print to.
          */
         inline void print(std::ostream& os = std::cout) const
-        { markov_models::printProbabilityMatrix(probabilityMatrix); };
+        { markov_models::printProbabilityMatrix(probabilityMatrix, os); };
 
         /**
          * Clears the contents of the model.
          */
         inline void clear()
-        { markov_models::clearMatrix(probabilityMatrix); };
+        {
+            markov_models::clearMatrix(probabilityMatrix);
+            transitionCounts.clear();
+        };
+
+        /**
+         * Saves the trained model to a model file (CompactMarkovMatrix storage only).
+         * @param filePath[const std::string&] - The path of the file to write.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be written.
+         */
+        inline void save(const std::string& filePath) const
+        { markov_models::saveMatrix(probabilityMatrix, filePath); };
+
+        /**
+         * Replaces the model with one saved to a model file (CompactMarkovMatrix or
+         * MappedMarkovMatrix storage). A mapped model uses the file in place.
+         * @param filePath[const std::string&] - The path of the file.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         * @throws MIAException(Invalid_Model_File) - If the file is not a valid model of T.
+         */
+        inline void load(const std::string& filePath)
+        {
+            markov_models::loadMatrix(probabilityMatrix, filePath);
+            transitionCounts.clear();
+        };
 
         /**
          * Returns a reference to the internal probability matrix.
-         * @return [const ProbabilityMatrix<T>&] - The probability transition matrix.
+         * @return [const Matrix&] - The probability transition matrix.
          */
-        inline const ProbabilityMatrix<T>& getMatrix() const
+        inline const Matrix& getMatrix() const
         { return probabilityMatrix; };
 
         /**
@@ -88,9 +164,8 @@ namespace markov_models
          */
         inline void printTransition(const T& state, std::ostream& os = std::cout) const
         {
-            auto it = probabilityMatrix.find(state);
-            if (it != probabilityMatrix.end())
-                printTransition(state, it->second, os);
+            if (hasState(state))
+                markov_models::printTransition(state, getTransition(state), os);
             else
                 os << "State " << state << " not found in model." << std::endl;
         };
@@ -99,14 +174,76 @@ namespace markov_models
          * Samples the next state based on the current state.
          * @param state[const T&] - The current state.
          * @return [T] - The next state sampled from the learned distribution.
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
          */
         inline T sampleNextState(const T& state) const
         { return markov_models::sampleNextState(probabilityMatrix, state); };
+
+        /**
+         * Samples the next state based on the current state using a given random engine.
+         * @tparam RNG A uniform random bit generator (e.g., std::mt19937_64).
+         * @param state[const T&] - The current state.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [T] - The next state sampled from the learned distribution.
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+         */
+        template <typename RNG>
+        inline T sampleNextState(const T& state, RNG& rng) const
+        { return markov_models::sampleNextState(probabilityMatrix, state, rng); };
+
+        /**
+         * Generates a sequence by walking the model from a start state. The walk stops
+         * early if it reaches a state with no successors.
+         * @tparam RNG A uniform random bit generator (e.g., std::mt19937_64).
+         * @param start[const T&] - The first state of the sequence.
+         * @param length[std::size_t] - The largest number of states, including the start.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [std::vector<T>] - The generated sequence (empty if length is 0).
+         */
+        template <typename RNG>
+        std::vector<T> generateSequence(const T& start, std::size_t length, RNG& rng) const
+        {
+            std::vector<T> sequence;
+            if (length == 0)
+                return sequence;
+            sequence.reserve(length);
+            sequence.push_back(start);
+            while (sequence.size() < length && hasState(sequence.back()))
+                sequence.push_back(sampleNextState(sequence.back(), rng));
+            return sequence;
+        }
+
+        /**
+         * Generates many sequences in parallel on the shared TaskScheduler. Each sequence
+         * gets its own engine seeded from the seed and its position, so the result only
+         * depends on the seed and not on how the work is split between threads.
+         * @param start[const T&] - The first state of each sequence.
+         * @param length[std::size_t] - The largest number of states per sequence, including the start.
+         * @param count[std::size_t] - The number of sequences to generate.
+         * @param seed[std::uint64_t] - The seed (defaults to a random one).
+         * @return [std::vector<std::vector<T>>] - The generated sequences.
+         */
+        std::vector<std::vector<T>> generate(const T& start, std::size_t length, std::size_t count,
+                                             std::uint64_t seed = std::random_device{}()) const
+        {
+            std::vector<std::vector<T>> sequences(count);
+            threading::TaskScheduler::getShared().parallelFor(0, count, [&](std::size_t i)
+            {
+                std::seed_seq sequenceSeed{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                                           static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32)};
+                std::mt19937_64 rng(sequenceSeed);
+                sequences[i] = generateSequence(start, length, rng);
+            });
+            return sequences;
+        }
         
     private:
         
         /// Storage for the main probability matrix of this class.
-        ProbabilityMatrix<T> probabilityMatrix;
+        Matrix probabilityMatrix;
+
+        /// The counts behind the matrix, for storages which only hold probabilities (used by update()).
+        TransitionCounts<T> transitionCounts;
     };
 } // namespace markov_models
 
@@ -9,7 +9,6 @@
 #include <string>
 #include <vector>
 #include "CharacterMarkovModel.hpp"
-#include "StringUtils.hpp"
 
 namespace markov_models
 {
@@ -21,11 +20,39 @@ namespace markov_models
     
     void CharacterMarkovModel::trainFromStrings(const std::vector<std::string>& sequences)    
     {
-        std::vector<std::vector<char>> trainingVec;
-        for (const auto& sequence : sequences)
+        trainFrom(sequences);
+    }
+
+
+    void CharacterMarkovModel::updateFromStrings(const std::vector<std::string>& sequences)    
+    {
+        updateFrom(sequences);
+    }
+
+
+    void CharacterMarkovModel::trainFromFile(const std::string& filePath, const CorpusOptions& options)
+    {
+        CharacterTransitionCounts counts = countCorpusTransitions(filePath, options);
+        clear();
+        updateFromCounts(counts.toTransitionCounts());
+    }
+
+
+    void CharacterMarkovModel::updateFromFile(const std::string& filePath, const CorpusOptions& options)
+    {
+        updateFromCounts(countCorpusTransitions(filePath, options).toTransitionCounts());
+    }
+
+
+    std::vector<std::string> CharacterMarkovModel::generateStrings(char start, std::size_t length, 
+                                                                   std::size_t count, std::uint64_t seed) const
+    {
+        std::vector<std::string> strings;
+        strings.reserve(count);
+        for (const auto& sequence : generate(start, length, count, seed))
         {
-            trainingVec.push_back( StringUtils::stringToCharVec(sequence) );
+            strings.emplace_back(sequence.begin(), sequence.end());
         }
-        train(trainingVec);
+        return strings;
     }
 } // namespace markov_models
@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include <string>
 #include <vector>
 #include "AbstractMarkovModel.hpp"
+#include "CorpusReader.hpp"
 
 namespace markov_models
 {
@@ -18,9 +20,10 @@ namespace markov_models
      * This class implements a first order markov model which uses
      * characters as the element type. The class is setup such that
      * strings can be input as the sequence rather than a vector of
-     * characters.
+     * characters. Transitions are stored in a CompactMarkovMatrix since
+     * the alphabet is small.
      */
-    class CharacterMarkovModel : public AbstractMarkovModel<char>
+    class CharacterMarkovModel : public AbstractMarkovModel<char, CompactMarkovMatrix<char>>
     {
     public:
         /**
@@ -41,13 +44,49 @@ namespace markov_models
         ~CharacterMarkovModel() = default;
         
         /**
-         * This method will convert an input vector of sequences into a
-         * std::vector<std::vector<char>>, then call the train() method in the base
-         * class using that input vector to generate the probabilityMatrix.
+         * This method trains the model directly from the strings (without copying them
+         * into character vectors) to generate the probabilityMatrix.
          * @param sequences[const std::vector<std::string>&] - The list of sequences
          *     to use for training and generating the probabilityMatrix.
          */
         void trainFromStrings(const std::vector<std::string>& sequences);
+
+        /**
+         * This method adds the transitions of new strings to the trained model.
+         * @param sequences[const std::vector<std::string>&] - The list of new sequences.
+         */
+        void updateFromStrings(const std::vector<std::string>& sequences);
+
+        /**
+         * This method trains the model from a corpus file, streaming it through a memory
+         * mapping or a fixed-size buffer without building a string per sequence.
+         * @param filePath[const std::string&] - The path of the corpus.
+         * @param options[const CorpusOptions&] - How to read the file and split it into sequences.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         */
+        void trainFromFile(const std::string& filePath, const CorpusOptions& options = {});
+
+        /**
+         * This method adds the transitions of a corpus file to the trained model (see trainFromFile()).
+         * @param filePath[const std::string&] - The path of the corpus.
+         * @param options[const CorpusOptions&] - How to read the file and split it into sequences.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         */
+        void updateFromFile(const std::string& filePath, const CorpusOptions& options = {});
+
+        /**
+         * Generates many strings in parallel (see AbstractMarkovModel::generate()).
+         * @param start[char] - The first character of each string.
+         * @param length[std::size_t] - The largest length of each string.
+         * @param count[std::size_t] - The number of strings to generate.
+         * @param seed[std::uint64_t] - The seed (defaults to a random one).
+         * @return [std::vector<std::string>] - The generated strings.
+         */
+        std::vector<std::string> generateStrings(char start, std::size_t length, std::size_t count,
+                                                 std::uint64_t seed = std::random_device{}()) const;
         
     }; // class CharacterMarkovModel
+
+    /// A read-only character model used in place from a model file saved by CharacterMarkovModel::save().
+    using MappedCharacterMarkovModel = AbstractMarkovModel<char, MappedMarkovMatrix<char>>;
 } // namespace markov_models
@@ -0,0 +1,238 @@
+/**
+ * @file CorpusReader.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file implements streaming corpus ingestion for character Markov models.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <memory>
+
+#include "CorpusReader.hpp"
+#include "MIAException.hpp"
+#include "TaskScheduler.hpp"
+// Used for the IS_LINUX platform check.
+#include "Constants.hpp"
+
+#ifdef IS_LINUX
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * Reads a file with a fixed-size buffer and scans each buffer in turn.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+     */
+    markov_models::CharacterTransitionCounts countBuffered(const std::string& filePath,
+                                                           const markov_models::CorpusOptions& options)
+    {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(filePath.c_str(), "rb"), &std::fclose);
+        if (!file)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to open corpus file: " + filePath);
+        }
+
+        markov_models::CharacterTransitionCounts counts;
+        markov_models::CorpusScanner scanner(options);
+        std::vector<char> buffer(std::max<std::size_t>(options.bufferSize, 1));
+        std::size_t read;
+        while ((read = std::fread(buffer.data(), 1, buffer.size(), file.get())) > 0)
+        {
+            scanner.scan(std::string_view(buffer.data(), read), counts);
+        }
+        if (std::ferror(file.get()))
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to read corpus file: " + filePath);
+        }
+        return counts;
+    }
+
+#ifdef IS_LINUX
+    /**
+     * Maps a file and scans its chunks in parallel, merging the counts of each thread.
+     * @return [bool] - False if the file could not be mapped (counts is left empty).
+     */
+    bool countMapped(const std::string& filePath, const markov_models::CorpusOptions& options,
+                     markov_models::CharacterTransitionCounts& counts)
+    {
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat fileInfo;
+        if (::fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        std::size_t length = static_cast<std::size_t>(fileInfo.st_size);
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping stays valid after the descriptor is closed.
+        if (mapping == MAP_FAILED)
+            return false;
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+
+        // One shard per thread, each scanning a contiguous run of chunks, keeps memory independent
+        // of the file size.
+        std::string_view text(static_cast<const char*>(mapping), length);
+        std::size_t chunkSize = std::max<std::size_t>(options.chunkSize, 1);
+        std::size_t chunks = (length + chunkSize - 1) / chunkSize;
+        threading::TaskScheduler& scheduler = threading::TaskScheduler::getShared();
+        std::size_t shardCount = std::min(chunks, scheduler.getThreadCount() + 1);
+        std::vector<markov_models::CharacterTransitionCounts> shards(shardCount);
+        try
+        {
+            scheduler.parallelFor(0, shardCount, [&](std::size_t shard)
+            {
+                std::size_t first = shard * chunks / shardCount;
+                std::size_t last = (shard + 1) * chunks / shardCount;
+                markov_models::CorpusScanner scanner(options);
+                scanner.prime(text.substr(0, first * chunkSize));
+                for (std::size_t chunk = first; chunk < last; ++chunk)
+                    scanner.scan(text.substr(chunk * chunkSize, chunkSize), shards[shard]);
+            }, 1);
+        }
+        catch (...)
+        {
+            ::munmap(mapping, length);
+            throw;
+        }
+        ::munmap(mapping, length);
+
+        for (const auto& shard : shards)
+            counts.merge(shard);
+        return true;
+    }
+#endif
+} // anonymous namespace
+
+
+namespace markov_models
+{
+    std::uint64_t CharacterTransitionCounts::getTotal() const
+    {
+        std::uint64_t total = 0;
+        for (std::uint64_t count : counts)
+            total += count;
+        return total;
+    }
+
+
+    void CharacterTransitionCounts::merge(const CharacterTransitionCounts& other)
+    {
+        for (std::size_t i = 0; i < counts.size(); ++i)
+            counts[i] += other.counts[i];
+    }
+
+
+    TransitionCounts<char> CharacterTransitionCounts::toTransitionCounts() const
+    {
+        TransitionCounts<char> sparse;
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            if (counts[i] != 0)
+                sparse[static_cast<char>(i / 256)][static_cast<char>(i % 256)] = counts[i];
+        }
+        return sparse;
+    }
+
+
+    CorpusScanner::CorpusScanner(const CorpusOptions& options)
+    {
+        for (int b = 0; b < 256; ++b)
+        {
+            unsigned char c = static_cast<unsigned char>(b);
+            ByteClass type = CONTENT;
+            switch (options.delimiter)
+            {
+                case SequenceDelimiter::LINES:
+                    type = (c == '\n' || c == '\r') ? DELIMITER : CONTENT;
+                    break;
+                case SequenceDelimiter::SENTENCES:
+                    if (c == '.' || c == '!' || c == '?')
+                        type = DELIMITER;
+                    else if (std::isspace(c))
+                        type = SPACE;
+                    break;
+                case SequenceDelimiter::WORDS:
+                    if (c < 0x80 && !std::isalnum(c) && c != '\'' && c != '-')
+                        type = DELIMITER;
+                    break;
+                case SequenceDelimiter::CUSTOM:
+                    if (options.customDelimiters.find(static_cast<char>(c)) != std::string::npos)
+                        type = DELIMITER;
+                    break;
+            }
+            classes[c] = type;
+        }
+    }
+
+
+    void CorpusScanner::prime(std::string_view before)
+    {
+        reset();
+        std::size_t i = before.size();
+        while (i > 0 && classes[static_cast<unsigned char>(before[i - 1])] == SPACE)
+            --i;
+        if (i > 0 && classes[static_cast<unsigned char>(before[i - 1])] == CONTENT)
+        {
+            previous = static_cast<unsigned char>(before[i - 1]);
+            pendingSpace = i < before.size();
+        }
+    }
+
+
+    void CorpusScanner::scan(std::string_view text, CharacterTransitionCounts& counts)
+    {
+        for (char character : text)
+        {
+            unsigned char c = static_cast<unsigned char>(character);
+            switch (classes[c])
+            {
+                case DELIMITER:
+                    previous = NONE;
+                    pendingSpace = false;
+                    break;
+                case SPACE:
+                    pendingSpace = previous != NONE;
+                    break;
+                case CONTENT:
+                    if (pendingSpace)
+                    {
+                        counts.add(static_cast<unsigned char>(previous), ' ');
+                        previous = ' ';
+                        pendingSpace = false;
+                    }
+                    if (previous != NONE)
+                        counts.add(static_cast<unsigned char>(previous), c);
+                    previous = c;
+                    break;
+            }
+        }
+    }
+
+
+    CharacterTransitionCounts countCorpusTransitions(const std::string& filePath, const CorpusOptions& options)
+    {
+    #ifdef IS_LINUX
+        if (options.useMemoryMap)
+        {
+            CharacterTransitionCounts counts;
+            if (countMapped(filePath, options, counts))
+                return counts;
+        }
+    #endif
+        // Empty files cannot be mapped; they are read (as nothing) here too.
+        return countBuffered(filePath, options);
+    }
+} // namespace markov_models
@@ -0,0 +1,152 @@
+/**
+ * @file CorpusReader.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This header defines streaming ingestion of text corpora for character Markov
+ *     models. A file is read through a memory mapping (scanned in parallel chunks)
+ *     or a fixed-size buffer, and character transitions are counted byte by byte as
+ *     the text streams past. Sequences are split by configurable delimiters (lines,
+ *     sentences, words or a custom set) but never copied into strings, so memory use
+ *     does not grow with the size of the corpus.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MarkovModels.hpp"
+
+namespace markov_models
+{
+    /**
+     * How a corpus is split into sequences.
+     */
+    enum class SequenceDelimiter
+    {
+        LINES,      ///< Each line is a sequence.
+        SENTENCES,  ///< Sequences end at '.', '!' or '?'; line breaks and runs of whitespace become one space.
+        WORDS,      ///< Each run of letters, digits, apostrophes and hyphens (and non-ASCII bytes) is a sequence.
+        CUSTOM      ///< Sequences end at any character of CorpusOptions::customDelimiters.
+    };
+
+    /**
+     * Options for reading a corpus.
+     */
+    struct CorpusOptions
+    {
+        /// How the corpus is split into sequences.
+        SequenceDelimiter delimiter{SequenceDelimiter::LINES};
+        /// The characters which end a sequence when delimiter is CUSTOM.
+        std::string customDelimiters{};
+        /// Map the file into memory and scan it in parallel (falls back to the buffered reader if unavailable).
+        bool useMemoryMap{true};
+        /// The size of the buffer used by the buffered reader, in bytes.
+        std::size_t bufferSize{std::size_t(1) << 16};
+        /// The number of mapped bytes scanned by each parallel work unit.
+        std::size_t chunkSize{std::size_t(1) << 22};
+    };
+
+    /**
+     * Dense transition counts between byte values (a 256 x 256 table).
+     */
+    class CharacterTransitionCounts
+    {
+    public:
+        /// Constructs a table of zero counts.
+        CharacterTransitionCounts() : counts(256 * 256, 0) { }
+
+        /// Adds one to the count of a transition.
+        void add(unsigned char from, unsigned char to)
+        { ++counts[from * 256 + to]; }
+
+        /// Returns the count of a transition.
+        std::uint64_t get(char from, char to) const
+        { return counts[static_cast<unsigned char>(from) * 256 + static_cast<unsigned char>(to)]; }
+
+        /// Returns the total count of every transition.
+        std::uint64_t getTotal() const;
+
+        /**
+         * Adds another table into this one.
+         * @param other[const CharacterTransitionCounts&] - The counts to add.
+         */
+        void merge(const CharacterTransitionCounts& other);
+
+        /**
+         * Converts the non-zero counts to the sparse form used by the Markov models.
+         * @return [TransitionCounts<char>] - The counts.
+         */
+        TransitionCounts<char> toTransitionCounts() const;
+
+    private:
+        /// The count of each transition, indexed by from * 256 + to.
+        std::vector<std::uint64_t> counts;
+    }; // class CharacterTransitionCounts
+
+    /**
+     * A byte-by-byte sequence splitter and transition counter. It keeps its state between
+     * calls to scan(), so text may be fed in pieces of any size (e.g., buffer by buffer).
+     */
+    class CorpusScanner
+    {
+    public:
+        /**
+         * Constructs a scanner at the start of a corpus.
+         * @param options[const CorpusOptions&] - The delimiter settings.
+         */
+        explicit CorpusScanner(const CorpusOptions& options);
+
+        /**
+         * Sets the scanner state as if the given text had just been scanned. Used to start
+         * scanning in the middle of a corpus, given the text before that point.
+         * @param before[std::string_view] - The text before the scan position.
+         */
+        void prime(std::string_view before);
+
+        /**
+         * Counts the transitions in the next piece of text.
+         * @param text[std::string_view] - The text.
+         * @param counts[CharacterTransitionCounts&] - The counts to add to.
+         */
+        void scan(std::string_view text, CharacterTransitionCounts& counts);
+
+        /// Returns the scanner to the start of a corpus.
+        void reset()
+        {
+            previous = NONE;
+            pendingSpace = false;
+        }
+
+    private:
+        /// The class of each byte value.
+        enum ByteClass : std::uint8_t
+        {
+            CONTENT,    ///< Part of a sequence.
+            DELIMITER,  ///< Ends a sequence.
+            SPACE       ///< Collapsed into one space within a sequence (sentences only).
+        };
+
+        /// The value of previous at the start of a sequence.
+        static constexpr int NONE = -1;
+
+        /// The class of each byte value.
+        std::array<ByteClass, 256> classes{};
+        /// The last byte of the current sequence, or NONE.
+        int previous{NONE};
+        /// True if whitespace has been seen since previous.
+        bool pendingSpace{false};
+    }; // class CorpusScanner
+
+    /**
+     * Counts the character transitions in a file.
+     * @param filePath[const std::string&] - The path of the corpus.
+     * @param options[const CorpusOptions&] - How to read and split the corpus.
+     * @return [CharacterTransitionCounts] - The counts.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+     */
+    CharacterTransitionCounts countCorpusTransitions(const std::string& filePath, const CorpusOptions& options = {});
+} // namespace markov_models
@@ -0,0 +1,545 @@
+/**
+ * @file HiddenMarkovModel.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file implements the DiscreteHiddenMarkovModel.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "HiddenMarkovModel.hpp"
+#include "TaskScheduler.hpp"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+    /*
+     * The kernels below use SSE2 where available, the same way as the screen capture and
+     * motion detection kernels, since the default build does not optimize enough for the
+     * compiler to vectorize the scalar loops. Both forms add in the same order (four
+     * independent sums, combined pairwise), so they give identical results.
+     */
+
+    /// Returns the dot product of two arrays.
+    double dot(const double* a, const double* b, std::size_t n)
+    {
+        std::size_t i = 0;
+    #if defined(__SSE2__)
+        __m128d low = _mm_setzero_pd(), high = _mm_setzero_pd();
+        for (; i + 4 <= n; i += 4)
+        {
+            low = _mm_add_pd(low, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+            high = _mm_add_pd(high, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        }
+        double sums[4];
+        _mm_storeu_pd(sums, low);
+        _mm_storeu_pd(sums + 2, high);
+    #else
+        double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (; i + 4 <= n; i += 4)
+        {
+            sums[0] += a[i] * b[i];
+            sums[1] += a[i + 1] * b[i + 1];
+            sums[2] += a[i + 2] * b[i + 2];
+            sums[3] += a[i + 3] * b[i + 3];
+        }
+    #endif
+        for (; i < n; ++i)
+            sums[0] += a[i] * b[i];
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    /// Returns the sum of an array (see dot()).
+    double sum(const double* a, std::size_t n)
+    {
+        std::size_t i = 0;
+    #if defined(__SSE2__)
+        __m128d low = _mm_setzero_pd(), high = _mm_setzero_pd();
+        for (; i + 4 <= n; i += 4)
+        {
+            low = _mm_add_pd(low, _mm_loadu_pd(a + i));
+            high = _mm_add_pd(high, _mm_loadu_pd(a + i + 2));
+        }
+        double sums[4];
+        _mm_storeu_pd(sums, low);
+        _mm_storeu_pd(sums + 2, high);
+    #else
+        double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (; i + 4 <= n; i += 4)
+        {
+            sums[0] += a[i];
+            sums[1] += a[i + 1];
+            sums[2] += a[i + 2];
+            sums[3] += a[i + 3];
+        }
+    #endif
+        for (; i < n; ++i)
+            sums[0] += a[i];
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    /// Adds weight * x to y.
+    void addScaled(double* y, const double* x, double weight, std::size_t n)
+    {
+        std::size_t j = 0;
+    #if defined(__SSE2__)
+        const __m128d scale = _mm_set1_pd(weight);
+        for (; j + 2 <= n; j += 2)
+            _mm_storeu_pd(y + j, _mm_add_pd(_mm_loadu_pd(y + j), _mm_mul_pd(scale, _mm_loadu_pd(x + j))));
+    #endif
+        for (; j < n; ++j)
+            y[j] += weight * x[j];
+    }
+
+    /**
+     * Relaxes every destination of one Viterbi step from a single source state: where
+     * score + row[j] beats best[j], it replaces it and from becomes back[j].
+     */
+    void relaxRow(double* best, std::uint32_t* back, double score, const double* row, std::uint32_t from,
+                  std::size_t n)
+    {
+        std::size_t j = 0;
+    #if defined(__SSE2__)
+        const __m128d scores = _mm_set1_pd(score);
+        for (; j + 2 <= n; j += 2)
+        {
+            __m128d candidate = _mm_add_pd(scores, _mm_loadu_pd(row + j));
+            __m128d current = _mm_loadu_pd(best + j);
+            __m128d better = _mm_cmpgt_pd(candidate, current);
+            _mm_storeu_pd(best + j, _mm_or_pd(_mm_and_pd(better, candidate), _mm_andnot_pd(better, current)));
+            int mask = _mm_movemask_pd(better);
+            if (mask & 1)
+                back[j] = from;
+            if (mask & 2)
+                back[j + 1] = from;
+        }
+    #endif
+        for (; j < n; ++j)
+        {
+            double candidate = score + row[j];
+            bool better = candidate > best[j];
+            best[j] = better ? candidate : best[j];
+            back[j] = better ? from : back[j];
+        }
+    }
+
+    /**
+     * Normalizes strided groups of weights into probability distributions in place.
+     * Group g holds the entries g * groupStride + k * itemStride for k below count.
+     * @return [bool] - False if a weight is negative or not finite, or a group sums to 0.
+     */
+    bool normalizeGroups(std::vector<double>& weights, std::size_t groups, std::size_t count,
+                         std::size_t groupStride, std::size_t itemStride)
+    {
+        for (std::size_t g = 0; g < groups; ++g)
+        {
+            double total = 0.0;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                double weight = weights[g * groupStride + k * itemStride];
+                if (!(weight >= 0.0) || !std::isfinite(weight))
+                    return false;
+                total += weight;
+            }
+            if (!(total > 0.0) || !std::isfinite(total))
+                return false;
+            for (std::size_t k = 0; k < count; ++k)
+                weights[g * groupStride + k * itemStride] /= total;
+        }
+        return true;
+    }
+} // anonymous namespace
+
+
+namespace markov_models
+{
+    DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel(std::size_t stateCount, std::size_t symbolCount) :
+        stateCount(stateCount), symbolCount(symbolCount)
+    {
+        if (stateCount == 0 || symbolCount == 0)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "A hidden Markov model needs at least one state and one symbol.");
+        }
+        initial.assign(stateCount, 1.0 / static_cast<double>(stateCount));
+        transitions.assign(stateCount * stateCount, 1.0 / static_cast<double>(stateCount));
+        emissions.assign(symbolCount * stateCount, 1.0 / static_cast<double>(symbolCount));
+        updateLogProbabilities();
+    }
+
+
+    void DiscreteHiddenMarkovModel::setInitialProbabilities(const std::vector<double>& probabilities)
+    {
+        std::vector<double> normalized = probabilities;
+        if (normalized.size() != stateCount || !normalizeGroups(normalized, 1, stateCount, 0, 1))
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "Initial probabilities need one non-negative weight per state.");
+        }
+        initial = std::move(normalized);
+        updateLogProbabilities();
+    }
+
+
+    void DiscreteHiddenMarkovModel::setTransitionProbabilities(const std::vector<double>& probabilities)
+    {
+        std::vector<double> normalized = probabilities;
+        if (normalized.size() != stateCount * stateCount ||
+            !normalizeGroups(normalized, stateCount, stateCount, stateCount, 1))
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "Transition probabilities need a row of non-negative weights per state.");
+        }
+        transitions = std::move(normalized);
+        updateLogProbabilities();
+    }
+
+
+    void DiscreteHiddenMarkovModel::setEmissionProbabilities(const std::vector<double>& probabilities)
+    {
+        std::vector<double> normalized = probabilities;
+        if (normalized.size() != stateCount * symbolCount ||
+            !normalizeGroups(normalized, stateCount, symbolCount, symbolCount, 1))
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "Emission probabilities need a row of non-negative weights per state.");
+        }
+        // Stored symbol-major (symbol * stateCount + state).
+        for (std::size_t state = 0; state < stateCount; ++state)
+            for (std::size_t symbol = 0; symbol < symbolCount; ++symbol)
+                emissions[symbol * stateCount + state] = normalized[state * symbolCount + symbol];
+        updateLogProbabilities();
+    }
+
+
+    void DiscreteHiddenMarkovModel::randomize(std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> weight(0.5, 1.5);
+        for (double& p : initial)
+            p = weight(rng);
+        for (double& p : transitions)
+            p = weight(rng);
+        for (double& p : emissions)
+            p = weight(rng);
+        normalizeGroups(initial, 1, stateCount, 0, 1);
+        normalizeGroups(transitions, stateCount, stateCount, stateCount, 1);
+        normalizeGroups(emissions, stateCount, symbolCount, 1, stateCount);
+        updateLogProbabilities();
+    }
+
+
+    ViterbiPath DiscreteHiddenMarkovModel::decode(const std::vector<Index>& observations) const
+    {
+        checkObservations(observations);
+        ViterbiPath path;
+        if (observations.empty())
+            return path;
+
+        const std::size_t N = stateCount;
+        const std::size_t steps = observations.size();
+        std::vector<double> delta(N), next(N);
+        std::vector<Index> back(steps * N, 0);
+
+        const double* emission = &logEmissions[observations[0] * N];
+        for (std::size_t j = 0; j < N; ++j)
+            delta[j] = logInitial[j] + emission[j];
+
+        for (std::size_t t = 1; t < steps; ++t)
+        {
+            Index* backRow = &back[t * N];
+            std::fill(next.begin(), next.end(), -std::numeric_limits<double>::infinity());
+            // For each source state, relax every destination at once (a contiguous row).
+            for (std::size_t i = 0; i < N; ++i)
+                relaxRow(next.data(), backRow, delta[i], &logTransitions[i * N], static_cast<Index>(i), N);
+            emission = &logEmissions[observations[t] * N];
+            for (std::size_t j = 0; j < N; ++j)
+                delta[j] = next[j] + emission[j];
+        }
+
+        auto best = std::max_element(delta.begin(), delta.end());
+        path.logProbability = *best;
+        path.states.resize(steps);
+        path.states[steps - 1] = static_cast<Index>(best - delta.begin());
+        for (std::size_t t = steps - 1; t > 0; --t)
+            path.states[t - 1] = back[t * N + path.states[t]];
+        return path;
+    }
+
+
+    double DiscreteHiddenMarkovModel::logLikelihood(const std::vector<Index>& observations) const
+    {
+        checkObservations(observations);
+        if (observations.empty())
+            return 0.0;
+        Workspace workspace;
+        if (!forward(observations, workspace))
+            return -std::numeric_limits<double>::infinity();
+        double total = 0.0;
+        for (double scale : workspace.scales)
+            total += std::log(scale);
+        return total;
+    }
+
+
+    std::vector<double> DiscreteHiddenMarkovModel::posteriors(const std::vector<Index>& observations) const
+    {
+        checkObservations(observations);
+        std::vector<double> gamma(observations.size() * stateCount, 0.0);
+        Workspace workspace;
+        if (observations.empty() || !forward(observations, workspace))
+            return gamma;
+        backward(observations, workspace);
+        // With this scaling, alpha * beta is already the posterior of each step.
+        for (std::size_t k = 0; k < gamma.size(); ++k)
+            gamma[k] = workspace.alpha[k] * workspace.beta[k];
+        return gamma;
+    }
+
+
+    BaumWelchResult DiscreteHiddenMarkovModel::train(const std::vector<std::vector<Index>>& sequences,
+                                                     std::size_t maxIterations, double tolerance)
+    {
+        if (stateCount == 0)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "A hidden Markov model needs at least one state and one symbol.");
+        }
+        for (const auto& sequence : sequences)
+            checkObservations(sequence);
+
+        BaumWelchResult result;
+        if (sequences.empty())
+            return result;
+
+        threading::TaskScheduler& scheduler = threading::TaskScheduler::getShared();
+        const std::size_t shardCount = std::min(sequences.size(), scheduler.getThreadCount() + 1);
+        double previous = -std::numeric_limits<double>::infinity();
+        while (result.iterations < maxIterations)
+        {
+            // E-step: each shard counts a contiguous run of sequences into its own expectations.
+            std::vector<Expectations> shards(shardCount);
+            scheduler.parallelFor(0, shardCount, [&](std::size_t shard)
+            {
+                Expectations& expectations = shards[shard];
+                expectations.initial.assign(stateCount, 0.0);
+                expectations.transitions.assign(stateCount * stateCount, 0.0);
+                expectations.emissions.assign(symbolCount * stateCount, 0.0);
+                Workspace workspace;
+                std::size_t first = shard * sequences.size() / shardCount;
+                std::size_t last = (shard + 1) * sequences.size() / shardCount;
+                for (std::size_t s = first; s < last; ++s)
+                    accumulate(sequences[s], workspace, expectations);
+            }, 1);
+
+            Expectations& total = shards[0];
+            for (std::size_t shard = 1; shard < shardCount; ++shard)
+            {
+                for (std::size_t k = 0; k < total.initial.size(); ++k)
+                    total.initial[k] += shards[shard].initial[k];
+                for (std::size_t k = 0; k < total.transitions.size(); ++k)
+                    total.transitions[k] += shards[shard].transitions[k];
+                for (std::size_t k = 0; k < total.emissions.size(); ++k)
+                    total.emissions[k] += shards[shard].emissions[k];
+                total.logLikelihood += shards[shard].logLikelihood;
+            }
+
+            // M-step: expected counts become probabilities. Groups with no expected counts
+            // (e.g., a state never visited) keep their previous probabilities.
+            if (normalizeGroups(total.initial, 1, stateCount, 0, 1))
+                initial = total.initial;
+            for (std::size_t i = 0; i < stateCount; ++i)
+            {
+                double rowTotal = sum(&total.transitions[i * stateCount], stateCount);
+                if (rowTotal > 0.0)
+                    for (std::size_t j = 0; j < stateCount; ++j)
+                        transitions[i * stateCount + j] = total.transitions[i * stateCount + j] / rowTotal;
+            }
+            std::vector<double> stateTotals(stateCount, 0.0);
+            for (std::size_t symbol = 0; symbol < symbolCount; ++symbol)
+                for (std::size_t j = 0; j < stateCount; ++j)
+                    stateTotals[j] += total.emissions[symbol * stateCount + j];
+            for (std::size_t symbol = 0; symbol < symbolCount; ++symbol)
+            {
+                for (std::size_t j = 0; j < stateCount; ++j)
+                {
+                    if (stateTotals[j] > 0.0)
+                        emissions[symbol * stateCount + j] = total.emissions[symbol * stateCount + j] / stateTotals[j];
+                }
+            }
+            updateLogProbabilities();
+
+            ++result.iterations;
+            result.logLikelihood = total.logLikelihood;
+            if (total.logLikelihood - previous < tolerance)
+            {
+                result.converged = true;
+                break;
+            }
+            previous = total.logLikelihood;
+        }
+        return result;
+    }
+
+
+    ProbabilityMatrix<DiscreteHiddenMarkovModel::Index> DiscreteHiddenMarkovModel::getTransitionMatrix() const
+    {
+        ProbabilityMatrix<Index> matrix;
+        for (std::size_t i = 0; i < stateCount; ++i)
+        {
+            for (std::size_t j = 0; j < stateCount; ++j)
+            {
+                if (transitions[i * stateCount + j] > 0.0)
+                    matrix[static_cast<Index>(i)][static_cast<Index>(j)] = transitions[i * stateCount + j];
+            }
+        }
+        return matrix;
+    }
+
+
+    void DiscreteHiddenMarkovModel::checkObservations(const std::vector<Index>& observations) const
+    {
+        for (Index symbol : observations)
+        {
+            if (symbol >= symbolCount)
+            {
+                throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                          "Observation " + std::to_string(symbol) + " is not a symbol of the model.");
+            }
+        }
+    }
+
+
+    bool DiscreteHiddenMarkovModel::forward(const std::vector<Index>& observations, Workspace& workspace) const
+    {
+        const std::size_t N = stateCount;
+        const std::size_t steps = observations.size();
+        workspace.alpha.resize(steps * N);
+        workspace.scales.resize(steps);
+
+        double* current = workspace.alpha.data();
+        const double* emission = &emissions[observations[0] * N];
+        for (std::size_t j = 0; j < N; ++j)
+            current[j] = initial[j] * emission[j];
+
+        for (std::size_t t = 0; t < steps; ++t)
+        {
+            current = &workspace.alpha[t * N];
+            if (t > 0)
+            {
+                const double* previous = current - N;
+                std::fill(current, current + N, 0.0);
+                // current += previous[i] * (row i of the transitions), one contiguous row at a time.
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    if (previous[i] != 0.0)
+                        addScaled(current, &transitions[i * N], previous[i], N);
+                }
+                emission = &emissions[observations[t] * N];
+                for (std::size_t j = 0; j < N; ++j)
+                    current[j] *= emission[j];
+            }
+
+            // Scaling each step to sum to 1 keeps long sequences from underflowing.
+            double scale = sum(current, N);
+            if (!(scale > 0.0))
+                return false;
+            workspace.scales[t] = scale;
+            const double inverse = 1.0 / scale;
+            for (std::size_t j = 0; j < N; ++j)
+                current[j] *= inverse;
+        }
+        return true;
+    }
+
+
+    void DiscreteHiddenMarkovModel::backward(const std::vector<Index>& observations, Workspace& workspace) const
+    {
+        const std::size_t N = stateCount;
+        const std::size_t steps = observations.size();
+        workspace.beta.resize(steps * N);
+        workspace.weighted.resize(N);
+        std::fill(workspace.beta.end() - static_cast<std::ptrdiff_t>(N), workspace.beta.end(), 1.0);
+
+        for (std::size_t t = steps - 1; t > 0; --t)
+        {
+            const double* emission = &emissions[observations[t] * N];
+            const double* next = &workspace.beta[t * N];
+            for (std::size_t j = 0; j < N; ++j)
+                workspace.weighted[j] = emission[j] * next[j];
+
+            // beta[t - 1][i] is the dot product of row i of the transitions with the weighted betas.
+            const double inverse = 1.0 / workspace.scales[t];
+            double* current = &workspace.beta[(t - 1) * N];
+            for (std::size_t i = 0; i < N; ++i)
+                current[i] = dot(&transitions[i * N], workspace.weighted.data(), N) * inverse;
+        }
+    }
+
+
+    void DiscreteHiddenMarkovModel::accumulate(const std::vector<Index>& observations, Workspace& workspace,
+                                               Expectations& expectations) const
+    {
+        if (observations.empty() || !forward(observations, workspace))
+            return;
+        backward(observations, workspace);
+
+        const std::size_t N = stateCount;
+        const std::size_t steps = observations.size();
+        for (double scale : workspace.scales)
+            expectations.logLikelihood += std::log(scale);
+
+        for (std::size_t j = 0; j < N; ++j)
+            expectations.initial[j] += workspace.alpha[j] * workspace.beta[j];
+
+        for (std::size_t t = 0; t < steps; ++t)
+        {
+            // The posterior of each state emitting this step's symbol.
+            double* emitted = &expectations.emissions[observations[t] * N];
+            const double* alpha = &workspace.alpha[t * N];
+            const double* beta = &workspace.beta[t * N];
+            for (std::size_t j = 0; j < N; ++j)
+                emitted[j] += alpha[j] * beta[j];
+        }
+
+        for (std::size_t t = 0; t + 1 < steps; ++t)
+        {
+            const double* emission = &emissions[observations[t + 1] * N];
+            const double* next = &workspace.beta[(t + 1) * N];
+            for (std::size_t j = 0; j < N; ++j)
+                workspace.weighted[j] = emission[j] * next[j];
+
+            // The expected transitions from i to every j at step t (one contiguous row).
+            const double inverse = 1.0 / workspace.scales[t + 1];
+            const double* alpha = &workspace.alpha[t * N];
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const double weight = alpha[i] * inverse;
+                const double* row = &transitions[i * N];
+                double* expected = &expectations.transitions[i * N];
+                for (std::size_t j = 0; j < N; ++j)
+                    expected[j] += weight * row[j] * workspace.weighted[j];
+            }
+        }
+    }
+
+
+    void DiscreteHiddenMarkovModel::updateLogProbabilities()
+    {
+        auto toLog = [](const std::vector<double>& from, std::vector<double>& to)
+        {
+            to.resize(from.size());
+            for (std::size_t k = 0; k < from.size(); ++k)
+                to[k] = std::log(from[k]);
+        };
+        toLog(initial, logInitial);
+        toLog(transitions, logTransitions);
+        toLog(emissions, logEmissions);
+    }
+} // namespace markov_models
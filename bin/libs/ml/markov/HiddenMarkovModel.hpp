@@ -0,0 +1,359 @@
+/**
+ * @file HiddenMarkovModel.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This header defines a discrete hidden Markov model (HMM). Unlike the observable
+ *     models (see AbstractMarkovModel), the states are hidden and only the symbols they
+ *     emit are seen. The model supports Viterbi decoding (in log space), forward-backward
+ *     posteriors and Baum-Welch training over many sequences in parallel.
+ *
+ *     The initial, transition and emission probabilities are stored in contiguous
+ *     row-major arrays. Emissions are stored symbol-major, so the probabilities of one
+ *     symbol under every state are adjacent. Every inner loop then runs over contiguous
+ *     memory, and the hot ones (the forward and backward steps and the Viterbi
+ *     relaxation) use SSE2 where available.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "MarkovModels.hpp"
+#include "MIAException.hpp"
+
+namespace markov_models
+{
+    /**
+     * The most likely path of hidden states for a sequence of observations.
+     */
+    struct ViterbiPath
+    {
+        /// The hidden state at each step (empty for an empty sequence).
+        std::vector<std::uint32_t> states;
+        /// The natural log of the joint probability of the path and the observations (-infinity if impossible).
+        double logProbability{0.0};
+    };
+
+    /**
+     * The outcome of Baum-Welch training.
+     */
+    struct BaumWelchResult
+    {
+        /// The number of iterations run.
+        std::size_t iterations{0};
+        /// The total log-likelihood of the training sequences, measured before the last update.
+        double logLikelihood{0.0};
+        /// True if the log-likelihood improved by less than the tolerance before the iteration limit.
+        bool converged{false};
+    };
+
+    /**
+     * A hidden Markov model over symbol indices (0 to getSymbolCount() - 1). This holds the
+     * probabilities and the algorithms; HiddenMarkovModel<T> maps symbols of any type onto it.
+     * Probabilities start uniform; call randomize() before training, since Baum-Welch cannot
+     * separate states which start identical.
+     */
+    class DiscreteHiddenMarkovModel
+    {
+    public:
+        /// The index type of states and symbols.
+        using Index = std::uint32_t;
+
+        /// Constructs an empty model (no states or symbols).
+        DiscreteHiddenMarkovModel() = default;
+
+        /**
+         * Constructs a model with uniform probabilities.
+         * @param stateCount[std::size_t] - The number of hidden states.
+         * @param symbolCount[std::size_t] - The number of observable symbols.
+         * @throws MIAException(Invalid_Argument) - If either count is 0.
+         */
+        DiscreteHiddenMarkovModel(std::size_t stateCount, std::size_t symbolCount);
+
+        /// Returns the number of hidden states.
+        std::size_t getStateCount() const
+        { return stateCount; }
+
+        /// Returns the number of observable symbols.
+        std::size_t getSymbolCount() const
+        { return symbolCount; }
+
+        /// Returns the probability of starting in a state.
+        double getInitialProbability(Index state) const
+        { return initial[state]; }
+
+        /// Returns the probability of moving from one state to another.
+        double getTransitionProbability(Index from, Index to) const
+        { return transitions[from * stateCount + to]; }
+
+        /// Returns the probability of a state emitting a symbol.
+        double getEmissionProbability(Index state, Index symbol) const
+        { return emissions[symbol * stateCount + state]; }
+
+        /**
+         * Sets the initial probabilities.
+         * @param probabilities[const std::vector<double>&] - One non-negative weight per state (normalized here).
+         * @throws MIAException(Invalid_Argument) - If the size is wrong or the weights are invalid.
+         */
+        void setInitialProbabilities(const std::vector<double>& probabilities);
+
+        /**
+         * Sets the transition probabilities.
+         * @param probabilities[const std::vector<double>&] - Row-major weights, from * getStateCount() + to
+         *                                                    (each row is normalized here).
+         * @throws MIAException(Invalid_Argument) - If the size is wrong or a row is invalid.
+         */
+        void setTransitionProbabilities(const std::vector<double>& probabilities);
+
+        /**
+         * Sets the emission probabilities.
+         * @param probabilities[const std::vector<double>&] - Weights indexed state * getSymbolCount() + symbol
+         *                                                    (each state's weights are normalized here).
+         * @throws MIAException(Invalid_Argument) - If the size is wrong or a state's weights are invalid.
+         */
+        void setEmissionProbabilities(const std::vector<double>& probabilities);
+
+        /**
+         * Replaces every probability with a random distribution near uniform, as a starting
+         * point for Baum-Welch training.
+         * @param seed[std::uint64_t] - The seed.
+         */
+        void randomize(std::uint64_t seed);
+
+        /**
+         * Finds the most likely path of hidden states (Viterbi decoding in log space).
+         * @param observations[const std::vector<Index>&] - The symbols observed.
+         * @return [ViterbiPath] - The path and its log probability.
+         * @throws MIAException(Invalid_Argument) - If a symbol is out of range.
+         */
+        ViterbiPath decode(const std::vector<Index>& observations) const;
+
+        /**
+         * Computes the log-likelihood of observations with the (scaled) forward algorithm.
+         * @param observations[const std::vector<Index>&] - The symbols observed.
+         * @return [double] - The natural log of their probability (0 if empty, -infinity if impossible).
+         * @throws MIAException(Invalid_Argument) - If a symbol is out of range.
+         */
+        double logLikelihood(const std::vector<Index>& observations) const;
+
+        /**
+         * Computes the posterior probability of each state at each step (forward-backward).
+         * @param observations[const std::vector<Index>&] - The symbols observed.
+         * @return [std::vector<double>] - Row-major probabilities, step * getStateCount() + state
+         *                                 (all 0 if the observations are impossible).
+         * @throws MIAException(Invalid_Argument) - If a symbol is out of range.
+         */
+        std::vector<double> posteriors(const std::vector<Index>& observations) const;
+
+        /**
+         * Trains the model with Baum-Welch (expectation-maximization) from its current
+         * probabilities. Each iteration runs forward-backward over the sequences in parallel
+         * on the shared TaskScheduler, with one set of expected counts per thread, then
+         * merges them. Sequences which are impossible under the model are skipped.
+         * @param sequences[const std::vector<std::vector<Index>>&] - The training sequences.
+         * @param maxIterations[std::size_t] - The most iterations to run.
+         * @param tolerance[double] - Stop once the log-likelihood improves by less than this.
+         * @return [BaumWelchResult] - The iterations run and the final log-likelihood.
+         * @throws MIAException(Invalid_Argument) - If a symbol is out of range.
+         */
+        BaumWelchResult train(const std::vector<std::vector<Index>>& sequences,
+                              std::size_t maxIterations = 100, double tolerance = 1e-6);
+
+        /**
+         * Returns the non-zero transition probabilities in the form used by the observable models.
+         * @return [ProbabilityMatrix<Index>] - The probability of each state following each state.
+         */
+        ProbabilityMatrix<Index> getTransitionMatrix() const;
+
+    protected:
+        /**
+         * Expected counts gathered by the E-step of Baum-Welch. Each thread fills its own.
+         */
+        struct Expectations
+        {
+            std::vector<double> initial;      ///< Expected starts in each state.
+            std::vector<double> transitions;  ///< Expected transitions, from * stateCount + to.
+            std::vector<double> emissions;    ///< Expected emissions, symbol * stateCount + state.
+            double logLikelihood{0.0};        ///< The log-likelihood of the sequences counted.
+        };
+
+        /**
+         * Buffers reused by forward-backward, sized to the longest sequence seen.
+         */
+        struct Workspace
+        {
+            std::vector<double> alpha;     ///< Scaled forward probabilities, step * stateCount + state.
+            std::vector<double> beta;      ///< Scaled backward probabilities, step * stateCount + state.
+            std::vector<double> scales;    ///< The sum of each forward step before scaling.
+            std::vector<double> weighted;  ///< The emission-weighted backward probabilities of one step.
+        };
+
+        /// Throws if any observation is not a symbol of the model.
+        void checkObservations(const std::vector<Index>& observations) const;
+
+        /**
+         * Runs the scaled forward pass.
+         * @return [bool] - False if the observations are impossible (alpha is then incomplete).
+         */
+        bool forward(const std::vector<Index>& observations, Workspace& workspace) const;
+
+        /// Runs the scaled backward pass (after a successful forward pass).
+        void backward(const std::vector<Index>& observations, Workspace& workspace) const;
+
+        /// Adds the expected counts of one sequence (the E-step).
+        void accumulate(const std::vector<Index>& observations, Workspace& workspace,
+                        Expectations& expectations) const;
+
+        /// Recomputes the log-space copies used by Viterbi.
+        void updateLogProbabilities();
+
+        /// The number of hidden states.
+        std::size_t stateCount{0};
+        /// The number of observable symbols.
+        std::size_t symbolCount{0};
+        /// The probability of starting in each state.
+        std::vector<double> initial;
+        /// The transition probabilities, from * stateCount + to.
+        std::vector<double> transitions;
+        /// The emission probabilities, symbol * stateCount + state.
+        std::vector<double> emissions;
+        /// The natural logs of initial.
+        std::vector<double> logInitial;
+        /// The natural logs of transitions.
+        std::vector<double> logTransitions;
+        /// The natural logs of emissions.
+        std::vector<double> logEmissions;
+    }; // class DiscreteHiddenMarkovModel
+
+    /**
+     * A hidden Markov model whose observations are of any hashable type. Symbols are interned
+     * into indices in the order they are first seen, as the compact observable models intern
+     * their states, and the work is done by DiscreteHiddenMarkovModel.
+     * @tparam T The observation type.
+     */
+    template <typename T>
+    class HiddenMarkovModel : public DiscreteHiddenMarkovModel
+    {
+    public:
+        /// The index returned by findSymbol() for an unknown symbol.
+        static constexpr Index NO_SYMBOL = std::numeric_limits<Index>::max();
+
+        /// Constructs an empty model (no states or symbols).
+        HiddenMarkovModel() = default;
+
+        /**
+         * Constructs a model with uniform probabilities over a set of symbols.
+         * @param stateCount[std::size_t] - The number of hidden states.
+         * @param alphabet[const std::vector<T>&] - The observable symbols (duplicates are ignored).
+         * @throws MIAException(Invalid_Argument) - If there are no states or symbols.
+         */
+        HiddenMarkovModel(std::size_t stateCount, const std::vector<T>& alphabet)
+        {
+            for (const auto& symbol : alphabet)
+            {
+                if (symbolIndices.emplace(symbol, static_cast<Index>(symbols.size())).second)
+                    symbols.push_back(symbol);
+            }
+            DiscreteHiddenMarkovModel::operator=(DiscreteHiddenMarkovModel(stateCount, symbols.size()));
+        }
+
+        /**
+         * Constructs a model with uniform probabilities over the symbols of some sequences.
+         * @param stateCount[std::size_t] - The number of hidden states.
+         * @param sequences[const Sequences&] - Sequences of symbols (e.g., std::vector<std::vector<T>>).
+         * @throws MIAException(Invalid_Argument) - If there are no states or symbols.
+         */
+        template <typename Sequences>
+        static HiddenMarkovModel fromSequences(std::size_t stateCount, const Sequences& sequences)
+        {
+            std::vector<T> alphabet;
+            for (const auto& sequence : sequences)
+                alphabet.insert(alphabet.end(), sequence.begin(), sequence.end());
+            return HiddenMarkovModel(stateCount, alphabet);
+        }
+
+        /// Returns the symbols, in index order.
+        const std::vector<T>& getSymbols() const
+        { return symbols; }
+
+        /// Returns the index of a symbol, or NO_SYMBOL if it is unknown.
+        Index findSymbol(const T& symbol) const
+        {
+            auto it = symbolIndices.find(symbol);
+            return it == symbolIndices.end() ? NO_SYMBOL : it->second;
+        }
+
+        /**
+         * Converts a sequence of symbols to indices.
+         * @param sequence[const Sequence&] - The symbols (any range of T).
+         * @return [std::vector<Index>] - Their indices.
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If a symbol is unknown.
+         */
+        template <typename Sequence>
+        std::vector<Index> encode(const Sequence& sequence) const
+        {
+            std::vector<Index> indices;
+            indices.reserve(sequence.size());
+            for (const auto& symbol : sequence)
+            {
+                Index index = findSymbol(symbol);
+                if (index == NO_SYMBOL)
+                {
+                    throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value,
+                                              "The observation is not a symbol of the model.");
+                }
+                indices.push_back(index);
+            }
+            return indices;
+        }
+
+        using DiscreteHiddenMarkovModel::getEmissionProbability;
+
+        /// Returns the probability of a state emitting a symbol (0 for an unknown symbol).
+        double getEmissionProbability(Index state, const T& symbol) const
+        {
+            Index index = findSymbol(symbol);
+            return index == NO_SYMBOL ? 0.0 : DiscreteHiddenMarkovModel::getEmissionProbability(state, index);
+        }
+
+        /// Finds the most likely path of hidden states (see DiscreteHiddenMarkovModel::decode()).
+        template <typename Sequence>
+        ViterbiPath decodeSequence(const Sequence& observations) const
+        { return decode(encode(observations)); }
+
+        /// Computes the log-likelihood of observations (see DiscreteHiddenMarkovModel::logLikelihood()).
+        template <typename Sequence>
+        double sequenceLogLikelihood(const Sequence& observations) const
+        { return logLikelihood(encode(observations)); }
+
+        /// Computes the posterior state probabilities (see DiscreteHiddenMarkovModel::posteriors()).
+        template <typename Sequence>
+        std::vector<double> sequencePosteriors(const Sequence& observations) const
+        { return posteriors(encode(observations)); }
+
+        /**
+         * Trains the model with Baum-Welch (see DiscreteHiddenMarkovModel::train()).
+         * @param sequences[const Sequences&] - The training sequences (e.g., std::vector<std::string>).
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If a symbol is unknown.
+         */
+        template <typename Sequences>
+        BaumWelchResult trainFrom(const Sequences& sequences, std::size_t maxIterations = 100,
+                                  double tolerance = 1e-6)
+        {
+            std::vector<std::vector<Index>> encoded;
+            encoded.reserve(sequences.size());
+            for (const auto& sequence : sequences)
+                encoded.push_back(encode(sequence));
+            return train(encoded, maxIterations, tolerance);
+        }
+
+    private:
+        /// The symbols, in index order.
+        std::vector<T> symbols;
+        /// The index of each symbol.
+        std::unordered_map<T, Index> symbolIndices;
+    }; // class HiddenMarkovModel
+} // namespace markov_models
@@ -0,0 +1,286 @@
+/**
+ * @file NGramMarkovModel.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file implements the NGramMarkovModel.
+ */
+
+#include <algorithm>
+#include "NGramMarkovModel.hpp"
+#include "MIAException.hpp"
+#include "TaskScheduler.hpp"
+
+namespace markov_models
+{
+    NGramMarkovModel::NGramMarkovModel(std::size_t order, std::size_t maxEntries) :
+        order(order), maxEntries(maxEntries)
+    {
+        if (order == 0 || order > MAX_ORDER)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "N-gram order must be between 1 and " + std::to_string(MAX_ORDER) + ".");
+        }
+        if (maxEntries < 1024)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Argument,
+                                      "N-gram entry limit must be at least 1024.");
+        }
+        clear();
+    }
+
+
+    NGramMarkovModel::NGramMarkovModel(std::size_t order, const std::vector<std::string>& sequences,
+                                       std::size_t maxEntries) :
+        NGramMarkovModel(order, maxEntries)
+    {
+        trainFromStrings(sequences);
+    }
+
+
+    void NGramMarkovModel::trainFromStrings(const std::vector<std::string>& sequences)
+    {
+        clear();
+        for (const auto& sequence : sequences)
+        {
+            addSequence(sequence);
+        }
+    }
+
+
+    void NGramMarkovModel::addSequence(const std::string& sequence)
+    {
+        // The window starts holding the start boundary, then rolls in each character.
+        std::uint64_t window = static_cast<unsigned char>(BOUNDARY);
+        std::size_t available = 1;
+        for (std::size_t i = 0; i <= sequence.size(); ++i)
+        {
+            auto next = static_cast<std::uint8_t>(i < sequence.size() ? sequence[i] : BOUNDARY);
+            if (!inAlphabet[next])
+            {
+                inAlphabet[next] = true;
+                alphabet.push_back(static_cast<char>(next));
+            }
+            for (std::size_t j = 0; j <= available; ++j)
+            {
+                increment(window & orderMask(j), next, static_cast<std::uint8_t>(j));
+            }
+            window = (window << 8) | next;
+            available = std::min(available + 1, order);
+        }
+    }
+
+
+    std::uint32_t NGramMarkovModel::getCount(const std::string& context, char next) const
+    {
+        std::size_t length = std::min(context.size(), order);
+        std::uint64_t window = 0;
+        for (std::size_t i = context.size() - length; i < context.size(); ++i)
+        {
+            window = (window << 8) | static_cast<unsigned char>(context[i]);
+        }
+        return lookup(window, static_cast<std::uint8_t>(next), static_cast<std::uint8_t>(length));
+    }
+
+
+    double NGramMarkovModel::getProbability(const std::string& context, char next) const
+    {
+        if (!inAlphabet[static_cast<unsigned char>(next)])
+            return 0.0;
+        std::vector<double> probabilities;
+        distribution(contextWindow(context), contextLength(context), probabilities);
+        auto it = std::find(alphabet.begin(), alphabet.end(), next);
+        return probabilities.empty() ? 0.0 : probabilities[it - alphabet.begin()];
+    }
+
+
+    std::vector<std::pair<char, double>> NGramMarkovModel::getDistribution(const std::string& context) const
+    {
+        std::vector<double> probabilities;
+        distribution(contextWindow(context), contextLength(context), probabilities);
+        std::vector<std::pair<char, double>> result;
+        for (std::size_t i = 0; i < probabilities.size(); ++i)
+        {
+            result.emplace_back(alphabet[i], probabilities[i]);
+        }
+        return result;
+    }
+
+
+    std::vector<std::string> NGramMarkovModel::generateStrings(const std::string& prefix, std::size_t length,
+                                                               std::size_t count, std::uint64_t seed) const
+    {
+        std::vector<std::string> strings(count);
+        threading::TaskScheduler::getShared().parallelFor(0, count, [&](std::size_t i)
+        {
+            std::seed_seq sequenceSeed{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                                       static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32)};
+            std::mt19937_64 rng(sequenceSeed);
+            strings[i] = generate(prefix, length, rng);
+        });
+        return strings;
+    }
+
+
+    std::vector<char> NGramMarkovModel::getAlphabet() const
+    {
+        std::vector<char> characters;
+        for (char c : alphabet)
+        {
+            if (c != BOUNDARY)
+                characters.push_back(c);
+        }
+        return characters;
+    }
+
+
+    void NGramMarkovModel::clear()
+    {
+        slots.assign(1024, Slot{});
+        entryCount = 0;
+        pruneThreshold = 0;
+        alphabet.clear();
+        std::fill(std::begin(inAlphabet), std::end(inAlphabet), false);
+    }
+
+
+    std::size_t NGramMarkovModel::slotFor(std::uint64_t context, std::uint8_t next, std::uint8_t order) const
+    {
+        // splitmix64 finalizer over the context mixed with the character and order.
+        std::uint64_t x = context + 0x9e3779b97f4a7c15ull * (1 + next + (std::uint64_t(order) << 8));
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return static_cast<std::size_t>(x) & (slots.size() - 1);
+    }
+
+
+    std::uint32_t NGramMarkovModel::lookup(std::uint64_t context, std::uint8_t next, std::uint8_t order) const
+    {
+        std::size_t mask = slots.size() - 1;
+        for (std::size_t i = slotFor(context, next, order); slots[i].count != 0; i = (i + 1) & mask)
+        {
+            const Slot& slot = slots[i];
+            if (slot.context == context && slot.next == next && slot.order == order)
+                return slot.count;
+        }
+        return 0;
+    }
+
+
+    void NGramMarkovModel::increment(std::uint64_t context, std::uint8_t next, std::uint8_t order)
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t i = slotFor(context, next, order);
+        for (; slots[i].count != 0; i = (i + 1) & mask)
+        {
+            Slot& slot = slots[i];
+            if (slot.context == context && slot.next == next && slot.order == order)
+            {
+                if (slot.count != UINT32_MAX)
+                    ++slot.count;
+                return;
+            }
+        }
+
+        // A new entry: make room first, then find its slot in the (possibly rebuilt) table.
+        if (entryCount + 1 > maxEntries)
+            prune();
+        if (2 * (entryCount + 1) > slots.size())
+            rebuild(slots.size() * 2, 0);
+        mask = slots.size() - 1;
+        for (i = slotFor(context, next, order); slots[i].count != 0; i = (i + 1) & mask) { }
+        slots[i] = Slot{context, 1, next, order};
+        ++entryCount;
+    }
+
+
+    void NGramMarkovModel::rebuild(std::size_t capacity, std::uint32_t dropAtOrBelow)
+    {
+        std::vector<Slot> old(capacity, Slot{});
+        old.swap(slots);
+        entryCount = 0;
+        std::size_t mask = slots.size() - 1;
+        for (const Slot& slot : old)
+        {
+            if (slot.count == 0 || (slot.order > 0 && slot.count <= dropAtOrBelow))
+                continue;
+            std::size_t i = slotFor(slot.context, slot.next, slot.order);
+            for (; slots[i].count != 0; i = (i + 1) & mask) { }
+            slots[i] = slot;
+            ++entryCount;
+        }
+    }
+
+
+    void NGramMarkovModel::prune()
+    {
+        // Raise the threshold until a quarter of the limit is free, so pruning is rare.
+        while (entryCount > maxEntries - maxEntries / 4)
+        {
+            std::size_t before = entryCount;
+            rebuild(slots.size(), ++pruneThreshold);
+            if (entryCount == before && pruneThreshold == UINT32_MAX)
+                break;
+        }
+    }
+
+
+    std::uint64_t NGramMarkovModel::contextWindow(const std::string& context) const
+    {
+        std::uint64_t window = static_cast<unsigned char>(BOUNDARY);
+        std::size_t first = context.size() > order ? context.size() - order : 0;
+        for (std::size_t i = first; i < context.size(); ++i)
+        {
+            window = (window << 8) | static_cast<unsigned char>(context[i]);
+        }
+        return window;
+    }
+
+
+    void NGramMarkovModel::distribution(std::uint64_t window, std::size_t available,
+                                        std::vector<double>& probabilities) const
+    {
+        std::size_t size = alphabet.size();
+        probabilities.assign(size, 0.0);
+        std::vector<std::uint32_t> counts(size);
+
+        // Order 0: the relative frequency of each character.
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            counts[i] = lookup(0, static_cast<std::uint8_t>(alphabet[i]), 0);
+            total += counts[i];
+        }
+        if (total == 0)
+        {
+            probabilities.clear();
+            return;
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            probabilities[i] = static_cast<double>(counts[i]) / static_cast<double>(total);
+        }
+
+        // Witten-Bell interpolation: each longer context keeps weight total / (total + distinct)
+        // and passes the rest to the shorter one. Unseen contexts pass everything (backoff).
+        for (std::size_t j = 1; j <= available; ++j)
+        {
+            std::uint64_t context = window & orderMask(j);
+            std::uint64_t seen = 0, distinct = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                counts[i] = lookup(context, static_cast<std::uint8_t>(alphabet[i]), static_cast<std::uint8_t>(j));
+                seen += counts[i];
+                distinct += counts[i] != 0;
+            }
+            if (seen == 0)
+                continue;
+            double denominator = static_cast<double>(seen + distinct);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                probabilities[i] = (counts[i] + distinct * probabilities[i]) / denominator;
+            }
+        }
+    }
+} // namespace markov_models
@@ -0,0 +1,258 @@
+/**
+ * @file NGramMarkovModel.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This header defines a higher-order (n-gram) Markov model over characters. The
+ *     next character depends on up to the previous k characters (k <= 8), rather than
+ *     only the previous one as in CharacterMarkovModel.
+ *
+ *     Each context is packed into a 64-bit key, one byte per character, by rolling
+ *     the previous characters through a shift register. Counts for every order from
+ *     0 to k are kept in a single open-addressing hash table of fixed-size slots.
+ *     Unseen or rare contexts are handled with interpolated (Witten-Bell) smoothing,
+ *     which backs off to shorter contexts. The table has an entry limit; once it is
+ *     reached, the rarest higher-order entries are pruned so memory stays bounded.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace markov_models
+{
+    /**
+     * An order-k character Markov model with hashed contexts and interpolated smoothing.
+     * Sequences are implicitly surrounded by a boundary character ('\0'), so the model
+     * learns how sequences begin and end. Input strings must not contain '\0'.
+     */
+    class NGramMarkovModel
+    {
+    public:
+        /// The largest supported order (one byte per character in a 64-bit key).
+        static constexpr std::size_t MAX_ORDER = 8;
+
+        /// The default limit on the number of table entries (16 bytes each).
+        static constexpr std::size_t DEFAULT_MAX_ENTRIES = std::size_t(1) << 22;
+
+        /// The character which marks the start and end of each sequence.
+        static constexpr char BOUNDARY = '\0';
+
+        /**
+         * Constructs an empty model.
+         * @param order[std::size_t] - The number of previous characters to condition on (1 - 8).
+         * @param maxEntries[std::size_t] - The most entries to keep before pruning (at least 1024).
+         * @throws MIAException(Invalid_Argument) - If the order or entry limit is out of range.
+         */
+        explicit NGramMarkovModel(std::size_t order = 3, std::size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
+        /**
+         * Constructs a model and trains it from a list of strings.
+         * @param order[std::size_t] - The number of previous characters to condition on (1 - 8).
+         * @param sequences[const std::vector<std::string>&] - The strings to train with.
+         * @param maxEntries[std::size_t] - The most entries to keep before pruning (at least 1024).
+         * @throws MIAException(Invalid_Argument) - If the order or entry limit is out of range.
+         */
+        NGramMarkovModel(std::size_t order, const std::vector<std::string>& sequences,
+                         std::size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
+        /**
+         * Replaces the contents of the model with the counts from a list of strings.
+         * @param sequences[const std::vector<std::string>&] - The strings to train with.
+         */
+        void trainFromStrings(const std::vector<std::string>& sequences);
+
+        /**
+         * Adds the counts of one string to the model.
+         * @param sequence[const std::string&] - The string to add.
+         */
+        void addSequence(const std::string& sequence);
+
+        /**
+         * Returns the number of times a character followed a context.
+         * @param context[const std::string&] - The preceding characters (only the last getOrder() are used;
+         *     an empty context gives the order-0 count).
+         * @param next[char] - The following character.
+         * @return [std::uint32_t] - The count (0 if never seen or pruned).
+         */
+        std::uint32_t getCount(const std::string& context, char next) const;
+
+        /**
+         * Returns the smoothed probability of a character following a context. Contexts
+         * begin at a sequence start, so "" is the context of the first character.
+         * @param context[const std::string&] - The preceding characters of the sequence.
+         * @param next[char] - The following character (BOUNDARY for the end of a sequence).
+         * @return [double] - The probability.
+         */
+        double getProbability(const std::string& context, char next) const;
+
+        /**
+         * Returns the smoothed distribution of the character following a context.
+         * @param context[const std::string&] - The preceding characters of the sequence.
+         * @return [std::vector<std::pair<char, double>>] - Every possible character and its probability.
+         */
+        std::vector<std::pair<char, double>> getDistribution(const std::string& context) const;
+
+        /**
+         * Samples the character following a context.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param context[const std::string&] - The preceding characters of the sequence.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [char] - The sampled character (BOUNDARY for the end of a sequence).
+         */
+        template <typename RNG>
+        char sampleNext(const std::string& context, RNG& rng) const
+        {
+            std::vector<double> scratch;
+            return sampleWindow(contextWindow(context), contextLength(context), rng, scratch);
+        }
+
+        /**
+         * Generates a string by extending a prefix until the model ends the sequence.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param prefix[const std::string&] - The start of the string (may be empty).
+         * @param length[std::size_t] - The largest length of the string, including the prefix.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [std::string] - The generated string.
+         */
+        template <typename RNG>
+        std::string generate(const std::string& prefix, std::size_t length, RNG& rng) const
+        {
+            std::string text = prefix.substr(0, length);
+            std::uint64_t window = contextWindow(text);
+            std::size_t available = contextLength(text);
+            std::vector<double> scratch;
+            while (text.size() < length)
+            {
+                char next = sampleWindow(window, available, rng, scratch);
+                if (next == BOUNDARY)
+                    break;
+                text.push_back(next);
+                window = (window << 8) | static_cast<unsigned char>(next);
+                available = std::min(available + 1, order);
+            }
+            return text;
+        }
+
+        /**
+         * Generates many strings in parallel on the shared TaskScheduler. Each string
+         * gets its own engine seeded from the seed and its position.
+         * @param prefix[const std::string&] - The start of each string (may be empty).
+         * @param length[std::size_t] - The largest length of each string.
+         * @param count[std::size_t] - The number of strings to generate.
+         * @param seed[std::uint64_t] - The seed (defaults to a random one).
+         * @return [std::vector<std::string>] - The generated strings.
+         */
+        std::vector<std::string> generateStrings(const std::string& prefix, std::size_t length, std::size_t count,
+                                                 std::uint64_t seed = std::random_device{}()) const;
+
+        /// Returns the order of the model.
+        std::size_t getOrder() const
+        { return order; }
+
+        /// Returns the number of table entries (distinct context and character pairs of every order).
+        std::size_t getEntryCount() const
+        { return entryCount; }
+
+        /// Returns the entry limit.
+        std::size_t getMaxEntries() const
+        { return maxEntries; }
+
+        /// Returns the count at or below which entries have been pruned (0 if none have).
+        std::uint32_t getPruneThreshold() const
+        { return pruneThreshold; }
+
+        /// Returns the characters seen in training, excluding BOUNDARY.
+        std::vector<char> getAlphabet() const;
+
+        /// Returns the approximate number of bytes used by the model.
+        std::size_t getMemoryUsage() const
+        { return slots.capacity() * sizeof(Slot) + alphabet.capacity(); }
+
+        /// Removes every count.
+        void clear();
+
+    private:
+        /**
+         * One table slot: the count of a character following a context of some order.
+         * A count of 0 marks an empty slot.
+         */
+        struct Slot
+        {
+            std::uint64_t context{0};   ///< The context characters, the most recent in the low byte.
+            std::uint32_t count{0};     ///< The number of times next followed the context.
+            std::uint8_t next{0};       ///< The following character.
+            std::uint8_t order{0};      ///< The number of characters in the context.
+        };
+
+        /// Returns the mask which keeps the last n characters of a window.
+        static std::uint64_t orderMask(std::size_t n)
+        { return n >= 8 ? ~std::uint64_t(0) : (std::uint64_t(1) << (8 * n)) - 1; }
+
+        /// Returns the table position for a key.
+        std::size_t slotFor(std::uint64_t context, std::uint8_t next, std::uint8_t order) const;
+
+        /// Returns the count of a key (0 if absent).
+        std::uint32_t lookup(std::uint64_t context, std::uint8_t next, std::uint8_t order) const;
+
+        /// Adds one to the count of a key, inserting it if needed.
+        void increment(std::uint64_t context, std::uint8_t next, std::uint8_t order);
+
+        /// Moves every entry into a table of the given capacity, dropping order > 0 entries at or below a count.
+        void rebuild(std::size_t capacity, std::uint32_t dropAtOrBelow);
+
+        /// Prunes rare higher-order entries until the table is below its limit.
+        void prune();
+
+        /// Packs the last getOrder() characters of a sequence context (after the start boundary).
+        std::uint64_t contextWindow(const std::string& context) const;
+
+        /// Returns how many characters of a context window are usable (including the start boundary).
+        std::size_t contextLength(const std::string& context) const
+        { return std::min(context.size() + 1, order); }
+
+        /**
+         * Fills probabilities (one per alphabet entry) with the smoothed distribution after a window.
+         * @param window[std::uint64_t] - The packed context.
+         * @param available[std::size_t] - The number of characters in the window.
+         * @param probabilities[std::vector<double>&] - Filled with the distribution.
+         */
+        void distribution(std::uint64_t window, std::size_t available, std::vector<double>& probabilities) const;
+
+        /// Samples the character after a window.
+        template <typename RNG>
+        char sampleWindow(std::uint64_t window, std::size_t available, RNG& rng, std::vector<double>& scratch) const
+        {
+            distribution(window, available, scratch);
+            if (scratch.empty())
+                return BOUNDARY;
+            double target = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+            for (std::size_t i = 0; i < scratch.size(); ++i)
+            {
+                target -= scratch[i];
+                if (target < 0.0)
+                    return alphabet[i];
+            }
+            return alphabet.back();
+        }
+
+        /// The number of previous characters conditioned on.
+        std::size_t order;
+        /// The entry limit.
+        std::size_t maxEntries;
+        /// The open-addressing table (capacity is a power of two).
+        std::vector<Slot> slots;
+        /// The number of occupied slots.
+        std::size_t entryCount{0};
+        /// The count at or below which entries have been pruned.
+        std::uint32_t pruneThreshold{0};
+        /// Every character seen, including BOUNDARY, in order of first appearance.
+        std::vector<char> alphabet;
+        /// Whether each byte value is in the alphabet.
+        bool inAlphabet[256]{};
+    }; // class NGramMarkovModel
+} // namespace markov_models
@@ -0,0 +1,521 @@
+/**
+ * @file MarkovBenchmark.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     A benchmark and memory profile of the character Markov models. For synthetic
+ *     corpora of increasing size (and any real corpora given on the command line) it
+ *     measures, for each matrix representation, the training throughput (symbols/s),
+ *     the model size and size per state, the growth in resident and peak resident
+ *     memory, and the sampling rate.
+ *
+ *     Usage: MarkovBenchmark [--quick] [--sizes n1,n2,...] [--corpus path]... [--csv]
+ *
+ *     On Linux each measurement runs in its own child process, so the peak resident
+ *     memory of one representation is not hidden by that of an earlier one.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CharacterMarkovModel.hpp"
+#include "CorpusReader.hpp"
+#include "MIAException.hpp"
+#include "NGramMarkovModel.hpp"
+// Used for the IS_LINUX platform check.
+#include "Constants.hpp"
+
+#ifdef IS_LINUX
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+using namespace markov_models;
+
+namespace
+{
+    /// A corpus held both in memory (as lines) and in a file.
+    struct Corpus
+    {
+        std::string name;                ///< The name shown in the results.
+        std::string path;                ///< The path of the corpus file.
+        std::vector<std::string> lines;  ///< The lines of the corpus.
+        std::size_t symbols{0};          ///< The number of characters in every line.
+        bool temporary{false};           ///< True if the file is removed when the benchmark ends.
+    };
+
+    /// The measurements of one representation on one corpus. Plain numbers, so a child process can send it whole.
+    struct Measurement
+    {
+        bool ok{false};               ///< False if the run failed.
+        double trainSeconds{0};       ///< The time to train (or load) the model.
+        double states{0};             ///< The number of states.
+        double transitions{0};        ///< The number of distinct transitions (or n-gram entries).
+        double modelBytes{0};         ///< The bytes held by the model's own structures.
+        double residentBytes{0};      ///< The growth in resident memory while the model was built.
+        double peakBytes{0};          ///< The growth in peak resident memory while the model was built.
+        double samplesPerSecond{0};   ///< The rate of single-threaded sampling.
+    };
+
+    /// A representation to measure: trains (or loads) a model, then samples from it.
+    struct Representation
+    {
+        std::string name;  ///< The name shown in the results.
+        std::function<void(const Corpus&, Measurement&, std::size_t)> run;  ///< Fills in the measurement.
+    };
+
+    /// Seconds elapsed since a start time.
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /// The current resident memory of the process in bytes (0 if unknown).
+    double residentBytes()
+    {
+    #ifdef IS_LINUX
+        std::ifstream statm("/proc/self/statm");
+        std::size_t pages = 0, resident = 0;
+        if (statm >> pages >> resident)
+            return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE));
+    #endif
+        return 0;
+    }
+
+    /// The peak resident memory of the process in bytes (0 if unknown).
+    double peakResidentBytes()
+    {
+    #ifdef IS_LINUX
+        struct rusage usage;
+        if (::getrusage(RUSAGE_SELF, &usage) == 0)
+            return static_cast<double>(usage.ru_maxrss) * 1024.0;
+    #endif
+        return 0;
+    }
+
+    /**
+     * Builds a synthetic corpus of lines of words. The vocabulary has letter-frequency
+     * skewed words drawn with a Zipf distribution, so the text resembles natural language
+     * more closely than uniform noise.
+     */
+    Corpus makeSyntheticCorpus(std::size_t symbols, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        const std::string letters = "etaoinshrdlcumwfgypbvkjxqz";
+        std::geometric_distribution<std::size_t> letter(0.15);
+        std::uniform_int_distribution<std::size_t> wordLength(2, 10);
+        std::vector<std::string> vocabulary(5000);
+        for (auto& word : vocabulary)
+        {
+            word.resize(wordLength(rng));
+            for (char& c : word)
+                c = letters[std::min(letter(rng), letters.size() - 1)];
+        }
+
+        std::vector<double> weights(vocabulary.size());
+        for (std::size_t i = 0; i < weights.size(); ++i)
+            weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), 1.1);
+        std::discrete_distribution<std::size_t> pickWord(weights.begin(), weights.end());
+        std::uniform_int_distribution<std::size_t> lineWords(5, 15);
+
+        Corpus corpus;
+        corpus.name = "synthetic";
+        while (corpus.symbols < symbols)
+        {
+            std::string line;
+            for (std::size_t words = lineWords(rng); words > 0; --words)
+            {
+                if (!line.empty())
+                    line += ' ';
+                line += vocabulary[pickWord(rng)];
+            }
+            corpus.symbols += line.size();
+            corpus.lines.push_back(std::move(line));
+        }
+
+        corpus.path = (std::filesystem::temp_directory_path() /
+                       ("MarkovBenchmark_" + std::to_string(symbols) + ".txt")).string();
+        std::ofstream out(corpus.path, std::ios::binary);
+        for (const auto& line : corpus.lines)
+            out << line << '\n';
+        corpus.temporary = true;
+        return corpus;
+    }
+
+    /// Reads a real corpus from a file, line by line.
+    Corpus readCorpus(const std::string& path)
+    {
+        Corpus corpus;
+        corpus.name = std::filesystem::path(path).filename().string();
+        corpus.path = path;
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to open corpus file: " + path);
+        }
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            corpus.symbols += line.size();
+            corpus.lines.push_back(std::move(line));
+        }
+        return corpus;
+    }
+
+    /// The most common first character of the corpus lines, used to start every walk.
+    char startState(const Corpus& corpus)
+    {
+        std::vector<std::size_t> counts(256, 0);
+        for (const auto& line : corpus.lines)
+            if (!line.empty())
+                ++counts[static_cast<unsigned char>(line.front())];
+        return static_cast<char>(std::max_element(counts.begin(), counts.end()) - counts.begin());
+    }
+
+    /// Written once after each sampling walk, so the walk cannot be optimized away.
+    volatile char sampleSink;
+
+    /**
+     * Returns the approximate number of bytes used by a nested-map matrix: the maps, their
+     * bucket arrays and one heap node per entry (rounded up to the 16-byte allocator granularity).
+     */
+    std::size_t nestedMapMemoryUsage(const ProbabilityMatrix<char>& matrix)
+    {
+        auto node = [](std::size_t value) { return (sizeof(void*) + value + 8 + 15) & ~std::size_t(15); };
+        std::size_t bytes = sizeof(matrix) + matrix.bucket_count() * sizeof(void*);
+        for (const auto& row : matrix)
+        {
+            bytes += node(sizeof(row)) + row.second.bucket_count() * sizeof(void*);
+            bytes += row.second.size() * node(sizeof(std::pair<const char, double>));
+        }
+        return bytes;
+    }
+
+    /**
+     * Measures single-threaded sampling by walking a model, restarting at the start state
+     * whenever the walk reaches a state with no successors.
+     */
+    template <typename Model>
+    double measureSampling(const Model& model, char start, std::size_t samples)
+    {
+        if (!model.hasState(start))
+            return 0;
+        std::mt19937_64 rng(42);
+        char state = start;
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            state = model.hasState(state) ? model.sampleNextState(state, rng) : start;
+        }
+        double seconds = secondsSince(begin);
+        sampleSink = state;
+        return seconds > 0 ? static_cast<double>(samples) / seconds : 0;
+    }
+
+    /// The representations measured on every corpus.
+    std::vector<Representation> representations()
+    {
+        std::vector<Representation> list;
+
+        list.push_back({"nested-map", [](const Corpus& corpus, Measurement& result, std::size_t samples)
+        {
+            AbstractMarkovModel<char> model;
+            auto begin = std::chrono::steady_clock::now();
+            model.trainFrom(corpus.lines);
+            result.trainSeconds = secondsSince(begin);
+            result.states = static_cast<double>(model.getMatrix().size());
+            for (const auto& row : model.getMatrix())
+                result.transitions += static_cast<double>(row.second.size());
+            result.modelBytes = static_cast<double>(nestedMapMemoryUsage(model.getMatrix()));
+            result.samplesPerSecond = measureSampling(model, startState(corpus), samples);
+        }});
+
+        list.push_back({"compact", [](const Corpus& corpus, Measurement& result, std::size_t samples)
+        {
+            CharacterMarkovModel model;
+            auto begin = std::chrono::steady_clock::now();
+            model.trainFromStrings(corpus.lines);
+            result.trainSeconds = secondsSince(begin);
+            result.states = static_cast<double>(model.getMatrix().getStateCount());
+            result.transitions = static_cast<double>(model.getMatrix().getTransitionCount());
+            result.modelBytes = static_cast<double>(model.getMatrix().getMemoryUsage());
+            result.samplesPerSecond = measureSampling(model, startState(corpus), samples);
+        }});
+
+        list.push_back({"compact-file", [](const Corpus& corpus, Measurement& result, std::size_t samples)
+        {
+            CharacterMarkovModel model;
+            auto begin = std::chrono::steady_clock::now();
+            model.trainFromFile(corpus.path);
+            result.trainSeconds = secondsSince(begin);
+            result.states = static_cast<double>(model.getMatrix().getStateCount());
+            result.transitions = static_cast<double>(model.getMatrix().getTransitionCount());
+            result.modelBytes = static_cast<double>(model.getMatrix().getMemoryUsage());
+            result.samplesPerSecond = measureSampling(model, startState(corpus), samples);
+        }});
+
+        list.push_back({"mapped", [](const Corpus& corpus, Measurement& result, std::size_t samples)
+        {
+            // The model is trained and saved before measuring, so only the load is timed.
+            std::string modelPath = corpus.path + ".model";
+            {
+                CharacterMarkovModel trained;
+                trained.trainFromFile(corpus.path);
+                trained.save(modelPath);
+            }
+            double baseline = residentBytes();
+            double peakBaseline = peakResidentBytes();
+            MappedCharacterMarkovModel model;
+            auto begin = std::chrono::steady_clock::now();
+            model.load(modelPath);
+            result.trainSeconds = secondsSince(begin);
+            result.states = static_cast<double>(model.getMatrix().getStateCount());
+            result.transitions = static_cast<double>(model.getMatrix().getTransitionCount());
+            // The mapped pages are shared with every other process using the file.
+            result.modelBytes = static_cast<double>(std::filesystem::file_size(modelPath));
+            result.samplesPerSecond = measureSampling(model, startState(corpus), samples);
+            result.residentBytes = residentBytes() - baseline;
+            result.peakBytes = peakResidentBytes() - peakBaseline;
+            std::filesystem::remove(modelPath);
+        }});
+
+        list.push_back({"ngram-3", [](const Corpus& corpus, Measurement& result, std::size_t samples)
+        {
+            NGramMarkovModel model(3);
+            auto begin = std::chrono::steady_clock::now();
+            model.trainFromStrings(corpus.lines);
+            result.trainSeconds = secondsSince(begin);
+            result.states = static_cast<double>(model.getAlphabet().size());
+            result.transitions = static_cast<double>(model.getEntryCount());
+            result.modelBytes = static_cast<double>(model.getMemoryUsage());
+
+            std::mt19937_64 rng(42);
+            std::string prefix(1, startState(corpus));
+            std::size_t generated = 0;
+            begin = std::chrono::steady_clock::now();
+            while (generated < samples)
+                generated += std::max<std::size_t>(model.generate(prefix, 256, rng).size(), 1);
+            double seconds = secondsSince(begin);
+            result.samplesPerSecond = seconds > 0 ? static_cast<double>(generated) / seconds : 0;
+        }});
+
+        return list;
+    }
+
+    /**
+     * Runs one representation on one corpus, recording the memory the process holds once trained.
+     * Failures are reported and leave the measurement marked as not ok.
+     */
+    Measurement measure(const Representation& representation, const Corpus& corpus, std::size_t samples)
+    {
+        Measurement result;
+        try
+        {
+            double baseline = residentBytes();
+            double peakBaseline = peakResidentBytes();
+            representation.run(corpus, result, samples);
+            // Representations which measure their own memory (e.g., the mapped load) set it themselves.
+            if (result.residentBytes == 0)
+                result.residentBytes = std::max(residentBytes() - baseline, 0.0);
+            if (result.peakBytes == 0)
+                result.peakBytes = std::max(peakResidentBytes() - peakBaseline, 0.0);
+            result.ok = true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << representation.name << " failed on " << corpus.name << ": " << e.what() << std::endl;
+        }
+        return result;
+    }
+
+    /**
+     * Runs a measurement in a child process where possible, so its peak memory starts
+     * from the same baseline as every other measurement.
+     */
+    Measurement measureIsolated(const Representation& representation, const Corpus& corpus, std::size_t samples)
+    {
+    #ifdef IS_LINUX
+        int fds[2];
+        if (::pipe(fds) == 0)
+        {
+            std::cout.flush();
+            pid_t child = ::fork();
+            if (child == 0)
+            {
+                ::close(fds[0]);
+                Measurement result = measure(representation, corpus, samples);
+                ssize_t written = ::write(fds[1], &result, sizeof(result));
+                ::close(fds[1]);
+                ::_exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+            }
+            ::close(fds[1]);
+            if (child > 0)
+            {
+                Measurement result;
+                bool received = ::read(fds[0], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+                ::close(fds[0]);
+                int status = 0;
+                ::waitpid(child, &status, 0);
+                return received ? result : Measurement{};
+            }
+            ::close(fds[0]);
+        }
+    #endif
+        return measure(representation, corpus, samples);
+    }
+
+    /// Formats a number with an SI suffix (e.g., 1.25M).
+    std::string human(double value)
+    {
+        const char* suffixes[] = { "", "K", "M", "G", "T" };
+        std::size_t suffix = 0;
+        while (std::fabs(value) >= 1000.0 && suffix + 1 < sizeof(suffixes) / sizeof(suffixes[0]))
+        {
+            value /= 1000.0;
+            ++suffix;
+        }
+        char text[32];
+        std::snprintf(text, sizeof(text), suffix == 0 ? "%.0f%s" : "%.2f%s", value, suffixes[suffix]);
+        return text;
+    }
+
+    /// Parses a comma-separated list of sizes (e.g., "1e5,1e6").
+    std::vector<std::size_t> parseSizes(const std::string& text)
+    {
+        std::vector<std::size_t> sizes;
+        std::size_t begin = 0;
+        while (begin <= text.size())
+        {
+            std::size_t end = text.find(',', begin);
+            if (end == std::string::npos)
+                end = text.size();
+            if (end > begin)
+                sizes.push_back(static_cast<std::size_t>(std::stod(text.substr(begin, end - begin))));
+            begin = end + 1;
+        }
+        return sizes;
+    }
+
+    /// Prints the usage of the benchmark.
+    void printUsage()
+    {
+        std::cout << "Usage: MarkovBenchmark [--quick] [--sizes n1,n2,...] [--corpus path]... [--csv]" << std::endl
+                  << "  --quick          Small corpora and few samples (a smoke test)." << std::endl
+                  << "  --sizes LIST     Synthetic corpus sizes in symbols (default 1e5,1e6,1e7)." << std::endl
+                  << "  --corpus PATH    Also measure a real corpus (one sequence per line). Repeatable." << std::endl
+                  << "  --csv            Print comma-separated values instead of a table." << std::endl;
+    }
+} // anonymous namespace
+
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> sizes = { 100000, 1000000, 10000000 };
+    std::vector<std::string> corpusPaths;
+    std::size_t samples = 5000000;
+    bool csv = false;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument == "--quick")
+            {
+                sizes = { 10000, 50000 };
+                samples = 100000;
+            }
+            else if (argument == "--sizes" && i + 1 < argc)
+                sizes = parseSizes(argv[++i]);
+            else if (argument == "--corpus" && i + 1 < argc)
+                corpusPaths.push_back(argv[++i]);
+            else if (argument == "--csv")
+                csv = true;
+            else
+            {
+                printUsage();
+                return argument == "--help" ? constants::SUCCESS : constants::FAILURE;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return constants::FAILURE;
+    }
+
+    // Corpora are built before any worker threads exist, so the child processes start clean.
+    std::vector<Corpus> corpora;
+    try
+    {
+        for (std::size_t size : sizes)
+            corpora.push_back(makeSyntheticCorpus(size, size));
+        for (const auto& path : corpusPaths)
+            corpora.push_back(readCorpus(path));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        for (const auto& corpus : corpora)
+            if (corpus.temporary)
+                std::filesystem::remove(corpus.path);
+        return constants::FAILURE;
+    }
+
+    if (csv)
+        std::cout << "corpus,symbols,representation,train_s,symbols_per_s,states,transitions,"
+                     "model_bytes,bytes_per_state,resident_bytes,peak_bytes,samples_per_s" << std::endl;
+    else
+        std::printf("%-14s %9s  %-13s %9s %10s %7s %9s %9s %9s %9s %9s %10s\n", "corpus", "symbols", "matrix",
+                    "train(s)", "symbols/s", "states", "trans", "model", "B/state", "rss", "peak", "samples/s");
+
+    bool failed = false;
+    for (const auto& corpus : corpora)
+    {
+        for (const auto& representation : representations())
+        {
+            Measurement result = measureIsolated(representation, corpus, samples);
+            failed = failed || !result.ok;
+            double symbolsPerSecond = result.trainSeconds > 0 ? corpus.symbols / result.trainSeconds : 0;
+            double bytesPerState = result.states > 0 ? result.modelBytes / result.states : 0;
+            if (csv)
+            {
+                std::cout << corpus.name << ',' << corpus.symbols << ',' << representation.name << ','
+                          << result.trainSeconds << ',' << symbolsPerSecond << ',' << result.states << ','
+                          << result.transitions << ',' << result.modelBytes << ',' << bytesPerState << ','
+                          << result.residentBytes << ',' << result.peakBytes << ',' << result.samplesPerSecond << std::endl;
+            }
+            else
+            {
+                std::printf("%-14s %9s  %-13s %9.4f %10s %7.0f %9s %9s %9s %9s %9s %10s\n", corpus.name.c_str(),
+                            human(static_cast<double>(corpus.symbols)).c_str(), representation.name.c_str(),
+                            result.trainSeconds, human(symbolsPerSecond).c_str(), result.states,
+                            human(result.transitions).c_str(), human(result.modelBytes).c_str(),
+                            human(bytesPerState).c_str(), human(result.residentBytes).c_str(),
+                            human(result.peakBytes).c_str(),
+                            human(result.samplesPerSecond).c_str());
+            }
+        }
+    }
+
+    for (const auto& corpus : corpora)
+        if (corpus.temporary)
+            std::filesystem::remove(corpus.path);
+    return failed ? constants::FAILURE : constants::SUCCESS;
+}
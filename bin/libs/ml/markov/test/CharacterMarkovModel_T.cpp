@@ -7,6 +7,7 @@
  */
  
 #include <gtest/gtest.h>
+#include <filesystem>
 #include <vector>
 #include <string>
 #include "CharacterMarkovModel.hpp"
@@ -40,3 +41,72 @@ TEST(ConstructorTests, probMatrixConstructsProperly)
     for (const auto& c : allElements)
         EXPECT_TRUE(model2.hasState(c));
 }
+
+TEST(GenerateTests, sequencesFollowTheModel) 
+{
+    CharacterMarkovModel model(sequences);
+    auto generated = model.generateStrings('h', 12, 200, 1234);
+    ASSERT_EQ(generated.size(), 200u);
+    for (const auto& text : generated)
+    {
+        ASSERT_FALSE(text.empty());
+        EXPECT_EQ(text[0], 'h');
+        EXPECT_LE(text.size(), 12u);
+        for (std::size_t i = 1; i < text.size(); ++i)
+            EXPECT_GT(model.getMatrix().getProbability(text[i - 1], text[i]), 0.0);
+        // Shorter sequences must have stopped at a state with no successors.
+        if (text.size() < 12)
+        {
+            EXPECT_FALSE(model.hasState(text.back()));
+        }
+    }
+}
+
+TEST(GenerateTests, sameSeedGivesSameSequences) 
+{
+    CharacterMarkovModel model(sequences);
+    EXPECT_EQ(model.generateStrings('s', 20, 64, 99), model.generateStrings('s', 20, 64, 99));
+    EXPECT_TRUE(model.generate('s', 0, 3, 99)[0].empty());
+    EXPECT_TRUE(model.generate('s', 5, 0, 99).empty());
+}
+
+TEST(UpdateTests, updateMatchesRetraining) 
+{
+    CharacterMarkovModel full(sequences);
+    CharacterMarkovModel incremental(std::vector<std::string>(sequences.begin(), sequences.begin() + 2));
+    incremental.updateFromStrings(std::vector<std::string>(sequences.begin() + 2, sequences.end()));
+
+    EXPECT_TRUE(unorderedVectorEquals<char>(full.getAllStates(), incremental.getAllStates()));
+    for (char from : allElements)
+        for (char to : allElements)
+            EXPECT_NEAR(full.getMatrix().getProbability(from, to), incremental.getMatrix().getProbability(from, to), 1e-12);
+
+    // A model over the default ProbabilityMatrix storage updates the same way.
+    AbstractMarkovModel<int> numbers;
+    numbers.train({{1, 2, 1}});
+    numbers.update({{1, 3}});
+    EXPECT_NEAR(numbers.getTransition(1).at(2), 0.5, 1e-12);
+    EXPECT_NEAR(numbers.getTransition(1).at(3), 0.5, 1e-12);
+    EXPECT_NEAR(numbers.getTransition(2).at(1), 1.0, 1e-12);
+    numbers.clear();
+    numbers.update({{1, 3}});
+    EXPECT_EQ(numbers.getTransition(1).size(), 1u);
+}
+
+TEST(SaveTests, savedModelsLoadInPlace) 
+{
+    std::string path = (std::filesystem::temp_directory_path() / "CharacterMarkovModel_T.mkv").string();
+    CharacterMarkovModel model(sequences);
+    model.save(path);
+
+    MappedCharacterMarkovModel mapped;
+    mapped.load(path);
+    EXPECT_TRUE(unorderedVectorEquals<char>(model.getAllStates(), mapped.getAllStates()));
+    EXPECT_EQ(model.generate('h', 10, 20, 4), mapped.generate('h', 10, 20, 4));
+
+    CharacterMarkovModel reloaded;
+    reloaded.load(path);
+    reloaded.updateFromStrings({ "hello" });
+    EXPECT_GT(reloaded.getMatrix().getProbability('h', 'e'), 0.0);
+    std::filesystem::remove(path);
+}
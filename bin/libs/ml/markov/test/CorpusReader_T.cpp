@@ -0,0 +1,129 @@
+/**
+ * @file CorpusReader_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file tests streaming corpus ingestion for character Markov models.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "CharacterMarkovModel.hpp"
+#include "CorpusReader.hpp"
+#include "MIAException.hpp"
+
+using namespace markov_models;
+
+namespace
+{
+    /// Writes text to a file in the temporary directory and returns its path.
+    std::string writeCorpus(const std::string& name, const std::string& text)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+        return path;
+    }
+
+    /// Counts the transitions of in-memory sequences.
+    CharacterTransitionCounts countStrings(const std::vector<std::string>& sequences)
+    {
+        CharacterTransitionCounts counts;
+        for (const auto& sequence : sequences)
+            for (std::size_t i = 0; i + 1 < sequence.size(); ++i)
+                counts.add(static_cast<unsigned char>(sequence[i]), static_cast<unsigned char>(sequence[i + 1]));
+        return counts;
+    }
+
+    /// Returns true if two count tables are identical.
+    bool sameCounts(const CharacterTransitionCounts& a, const CharacterTransitionCounts& b)
+    {
+        return a.toTransitionCounts() == b.toTransitionCounts();
+    }
+} // anonymous namespace
+
+TEST(CorpusReaderTest, splitsByDelimiter)
+{
+    std::string text = "Hello there.  The cat\r\nsat!Ok\n\nwell-known don't";
+    std::string path = writeCorpus("CorpusReader_T_split.txt", text);
+    CorpusOptions options;
+
+    options.delimiter = SequenceDelimiter::LINES;
+    EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options),
+                           countStrings({"Hello there.  The cat", "sat!Ok", "well-known don't"})));
+
+    options.delimiter = SequenceDelimiter::WORDS;
+    EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options),
+                           countStrings({"Hello", "there", "The", "cat", "sat", "Ok", "well-known", "don't"})));
+
+    // Whitespace runs and line breaks become a single space; leading and trailing spaces are dropped.
+    options.delimiter = SequenceDelimiter::SENTENCES;
+    EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options),
+                           countStrings({"Hello there", "The cat sat", "Ok well-known don't"})));
+
+    options.delimiter = SequenceDelimiter::CUSTOM;
+    options.customDelimiters = " \n";
+    EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options),
+                           countStrings({"Hello", "there.", "The", "cat\r", "sat!Ok", "well-known", "don't"})));
+    std::filesystem::remove(path);
+}
+
+TEST(CorpusReaderTest, readersAndChunkBoundariesAgree)
+{
+    // Random text with every kind of delimiter, so chunk and buffer edges land everywhere.
+    std::mt19937_64 rng(17);
+    const std::string symbols = "abcdefgh  \n.!?\r\t'-";
+    std::uniform_int_distribution<std::size_t> pick(0, symbols.size() - 1);
+    std::string text(200000, ' ');
+    for (char& c : text)
+        c = symbols[pick(rng)];
+    std::string path = writeCorpus("CorpusReader_T_random.txt", text);
+
+    for (auto delimiter : { SequenceDelimiter::LINES, SequenceDelimiter::SENTENCES, SequenceDelimiter::WORDS })
+    {
+        CorpusOptions options;
+        options.delimiter = delimiter;
+        options.useMemoryMap = false;
+        CharacterTransitionCounts buffered = countCorpusTransitions(path, options);
+        EXPECT_GT(buffered.getTotal(), 0u);
+
+        options.bufferSize = 7;
+        EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options), buffered));
+
+        options.useMemoryMap = true;
+        EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options), buffered));
+
+        options.chunkSize = 1009;
+        EXPECT_TRUE(sameCounts(countCorpusTransitions(path, options), buffered));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(CorpusReaderTest, trainsCharacterModels)
+{
+    const std::vector<std::string> lines = { "hello", "fish", "sift", "tilt", "lot" };
+    std::string path = writeCorpus("CorpusReader_T_model.txt", "hello\nfish\nsift\r\ntilt\nlot");
+
+    CharacterMarkovModel fromStrings(lines);
+    CharacterMarkovModel fromFile;
+    fromFile.trainFromFile(path);
+    for (char from : std::string("efhilost"))
+        for (char to : std::string("efhilost"))
+            EXPECT_NEAR(fromFile.getMatrix().getProbability(from, to),
+                        fromStrings.getMatrix().getProbability(from, to), 1e-12);
+
+    // Updating from the same file doubles every count but keeps the probabilities.
+    fromFile.updateFromFile(path);
+    EXPECT_EQ(fromFile.getMatrix().getRowTotal(fromFile.getMatrix().find('l')),
+              2 * fromStrings.getMatrix().getRowTotal(fromStrings.getMatrix().find('l')));
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(fromFile.trainFromFile(path), error::MIAException);
+    std::string empty = writeCorpus("CorpusReader_T_empty.txt", "");
+    EXPECT_EQ(countCorpusTransitions(empty).getTotal(), 0u);
+    std::filesystem::remove(empty);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file HiddenMarkovModel_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file tests the hidden Markov models.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "HiddenMarkovModel.hpp"
+#include "MIAException.hpp"
+
+using namespace markov_models;
+using Index = DiscreteHiddenMarkovModel::Index;
+
+namespace
+{
+    /// The classic two-state example: healthy (0) or fever (1), observed as normal, cold or dizzy.
+    HiddenMarkovModel<std::string> makeHealthModel()
+    {
+        HiddenMarkovModel<std::string> model(2, { "normal", "cold", "dizzy" });
+        model.setInitialProbabilities({ 0.6, 0.4 });
+        model.setTransitionProbabilities({ 0.7, 0.3,
+                                           0.4, 0.6 });
+        model.setEmissionProbabilities({ 0.5, 0.4, 0.1,
+                                         0.1, 0.3, 0.6 });
+        return model;
+    }
+
+    /// The joint probability of a path of states and the observations, computed directly.
+    double pathProbability(const DiscreteHiddenMarkovModel& model, const std::vector<Index>& states,
+                           const std::vector<Index>& observations)
+    {
+        double p = model.getInitialProbability(states[0]) * model.getEmissionProbability(states[0], observations[0]);
+        for (std::size_t t = 1; t < states.size(); ++t)
+        {
+            p *= model.getTransitionProbability(states[t - 1], states[t]) *
+                 model.getEmissionProbability(states[t], observations[t]);
+        }
+        return p;
+    }
+
+    /// Calls a function with every path of states of a given length.
+    template <typename Function>
+    void forEachPath(std::size_t stateCount, std::size_t length, Function function)
+    {
+        std::vector<Index> states(length, 0);
+        while (true)
+        {
+            function(states);
+            std::size_t t = 0;
+            while (t < length && ++states[t] == stateCount)
+                states[t++] = 0;
+            if (t == length)
+                return;
+        }
+    }
+
+    /// Draws sequences of symbols from a model.
+    std::vector<std::vector<Index>> sampleSequences(const DiscreteHiddenMarkovModel& model, std::size_t count,
+                                                    std::size_t length, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        auto draw = [&rng](auto probability, std::size_t n)
+        {
+            double target = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+            for (std::size_t k = 0; k + 1 < n; ++k)
+            {
+                target -= probability(static_cast<Index>(k));
+                if (target < 0.0)
+                    return static_cast<Index>(k);
+            }
+            return static_cast<Index>(n - 1);
+        };
+
+        std::vector<std::vector<Index>> sequences(count);
+        for (auto& sequence : sequences)
+        {
+            Index state = draw([&](Index s) { return model.getInitialProbability(s); }, model.getStateCount());
+            for (std::size_t t = 0; t < length; ++t)
+            {
+                sequence.push_back(draw([&](Index o) { return model.getEmissionProbability(state, o); },
+                                        model.getSymbolCount()));
+                state = draw([&](Index s) { return model.getTransitionProbability(state, s); },
+                             model.getStateCount());
+            }
+        }
+        return sequences;
+    }
+} // anonymous namespace
+
+TEST(HiddenMarkovModelTest, decodesMostLikelyPath)
+{
+    auto model = makeHealthModel();
+    ViterbiPath path = model.decodeSequence(std::vector<std::string>{ "normal", "cold", "dizzy" });
+    EXPECT_EQ(path.states, (std::vector<Index>{ 0, 0, 1 }));
+    EXPECT_NEAR(std::exp(path.logProbability), 0.01512, 1e-12);
+
+    // The decoded path is the best of every path.
+    std::vector<Index> observations = model.encode(std::vector<std::string>{ "dizzy", "normal", "cold", "cold", "dizzy" });
+    path = model.decode(observations);
+    double best = 0.0;
+    forEachPath(2, observations.size(), [&](const std::vector<Index>& states)
+    {
+        best = std::max(best, pathProbability(model, states, observations));
+    });
+    EXPECT_NEAR(std::exp(path.logProbability), best, 1e-15);
+    EXPECT_NEAR(pathProbability(model, path.states, observations), best, 1e-15);
+
+    EXPECT_TRUE(model.decode({}).states.empty());
+}
+
+TEST(HiddenMarkovModelTest, forwardBackwardMatchesEnumeration)
+{
+    DiscreteHiddenMarkovModel model(3, 4);
+    model.randomize(5);
+    std::vector<Index> observations = { 0, 3, 1, 1, 2, 0 };
+
+    double total = 0.0;
+    std::vector<double> expected(observations.size() * 3, 0.0);
+    forEachPath(3, observations.size(), [&](const std::vector<Index>& states)
+    {
+        double p = pathProbability(model, states, observations);
+        total += p;
+        for (std::size_t t = 0; t < states.size(); ++t)
+            expected[t * 3 + states[t]] += p;
+    });
+
+    EXPECT_NEAR(model.logLikelihood(observations), std::log(total), 1e-10);
+    std::vector<double> gamma = model.posteriors(observations);
+    ASSERT_EQ(gamma.size(), expected.size());
+    for (std::size_t k = 0; k < gamma.size(); ++k)
+        EXPECT_NEAR(gamma[k], expected[k] / total, 1e-12);
+
+    // Scaling keeps long sequences from underflowing.
+    std::vector<Index> longSequence(20000);
+    for (std::size_t t = 0; t < longSequence.size(); ++t)
+        longSequence[t] = static_cast<Index>(t % 4);
+    double logLikelihood = model.logLikelihood(longSequence);
+    EXPECT_TRUE(std::isfinite(logLikelihood));
+    EXPECT_LT(logLikelihood, -1000.0);
+    EXPECT_TRUE(std::isfinite(model.decode(longSequence).logProbability));
+}
+
+TEST(HiddenMarkovModelTest, impossibleObservations)
+{
+    DiscreteHiddenMarkovModel model(2, 2);
+    model.setEmissionProbabilities({ 1.0, 0.0,
+                                     1.0, 0.0 });
+    EXPECT_EQ(model.logLikelihood({ 0, 1 }), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(model.decode({ 0, 1 }).logProbability, -std::numeric_limits<double>::infinity());
+    for (double p : model.posteriors({ 0, 1 }))
+        EXPECT_EQ(p, 0.0);
+}
+
+TEST(HiddenMarkovModelTest, baumWelchImprovesLikelihood)
+{
+    // A source with two clearly different states: one mostly emits 0 and 1, the other 2 and 3.
+    DiscreteHiddenMarkovModel source(2, 4);
+    source.setTransitionProbabilities({ 0.9, 0.1,
+                                        0.2, 0.8 });
+    source.setEmissionProbabilities({ 0.45, 0.45, 0.05, 0.05,
+                                      0.05, 0.05, 0.45, 0.45 });
+    auto sequences = sampleSequences(source, 200, 50, 11);
+
+    DiscreteHiddenMarkovModel model(2, 4);
+    model.randomize(3);
+    double sourceLikelihood = 0.0;
+    for (const auto& sequence : sequences)
+        sourceLikelihood += source.logLikelihood(sequence);
+
+    // The likelihood never decreases from one iteration to the next.
+    double previous = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 5; ++i)
+    {
+        BaumWelchResult step = model.train(sequences, 1);
+        EXPECT_EQ(step.iterations, 1u);
+        EXPECT_GE(step.logLikelihood, previous - 1e-9);
+        previous = step.logLikelihood;
+    }
+
+    BaumWelchResult result = model.train(sequences, 500, 1e-8);
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.logLikelihood, previous);
+    // The fitted model explains the data at least about as well as the source did.
+    EXPECT_GT(result.logLikelihood, sourceLikelihood - 5.0);
+
+    // The learned states separate the two emission groups, in either order.
+    Index low = model.getEmissionProbability(0, 0) > model.getEmissionProbability(1, 0) ? 0 : 1;
+    EXPECT_GT(model.getEmissionProbability(low, 0) + model.getEmissionProbability(low, 1), 0.8);
+    EXPECT_GT(model.getEmissionProbability(1 - low, 2) + model.getEmissionProbability(1 - low, 3), 0.8);
+    EXPECT_NEAR(model.getTransitionProbability(low, low), 0.9, 0.05);
+
+    auto matrix = model.getTransitionMatrix();
+    EXPECT_NEAR(matrix[0][0] + matrix[0][1], 1.0, 1e-12);
+}
+
+TEST(HiddenMarkovModelTest, symbolsAndErrors)
+{
+    std::vector<std::string> words = { "abba", "baab", "abc" };
+    auto model = HiddenMarkovModel<char>::fromSequences(2, words);
+    EXPECT_EQ(model.getSymbols(), (std::vector<char>{ 'a', 'b', 'c' }));
+    EXPECT_EQ(model.findSymbol('c'), 2u);
+    EXPECT_EQ(model.findSymbol('z'), HiddenMarkovModel<char>::NO_SYMBOL);
+    EXPECT_EQ(model.getEmissionProbability(0, 'z'), 0.0);
+    EXPECT_NEAR(model.getEmissionProbability(0, 'a'), 1.0 / 3.0, 1e-12);
+
+    model.randomize(1);
+    BaumWelchResult result = model.trainFrom(words, 10);
+    EXPECT_GT(result.iterations, 0u);
+    EXPECT_TRUE(std::isfinite(model.sequenceLogLikelihood(std::string("cab"))));
+    EXPECT_EQ(model.sequencePosteriors(std::string("ab")).size(), 4u);
+
+    try
+    {
+        model.decodeSequence(std::string("az"));
+        FAIL() << "Expected an unknown symbol to throw.";
+    }
+    catch (const error::MIAException& e)
+    {
+        EXPECT_EQ(e.getCode(), error::ErrorCode::Cannot_Find_Mapped_Value);
+    }
+    EXPECT_THROW(model.decode({ 3 }), error::MIAException);
+    EXPECT_THROW(DiscreteHiddenMarkovModel(0, 2), error::MIAException);
+    EXPECT_THROW(model.setInitialProbabilities({ 1.0 }), error::MIAException);
+    EXPECT_THROW(model.setTransitionProbabilities({ 1.0, -1.0, 0.5, 0.5 }), error::MIAException);
+    EXPECT_THROW(model.setEmissionProbabilities({ 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 }), error::MIAException);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file NGramMarkovModel_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file tests the higher-order NGramMarkovModel.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "NGramMarkovModel.hpp"
+#include "MIAException.hpp"
+
+using namespace markov_models;
+
+// Test sequences to use as data.
+const std::vector<std::string> words =
+{ "abc", "abd", "abc", "bcd" };
+
+TEST(NGramMarkovModelTest, rejectsInvalidOrder)
+{
+    EXPECT_THROW(NGramMarkovModel(0), error::MIAException);
+    EXPECT_THROW(NGramMarkovModel(NGramMarkovModel::MAX_ORDER + 1), error::MIAException);
+    EXPECT_THROW(NGramMarkovModel(2, 10), error::MIAException);
+    EXPECT_NO_THROW(NGramMarkovModel(NGramMarkovModel::MAX_ORDER));
+}
+
+TEST(NGramMarkovModelTest, countsEveryOrder)
+{
+    NGramMarkovModel model(2, words);
+    EXPECT_EQ(model.getCount("", 'a'), 3u);
+    EXPECT_EQ(model.getCount("a", 'b'), 3u);
+    EXPECT_EQ(model.getCount("ab", 'c'), 2u);
+    EXPECT_EQ(model.getCount("ab", 'd'), 1u);
+    // Only the last two characters are used as the context.
+    EXPECT_EQ(model.getCount("zab", 'c'), 2u);
+    EXPECT_EQ(model.getCount("ba", 'c'), 0u);
+    EXPECT_EQ(model.getAlphabet().size(), 4u);
+}
+
+TEST(NGramMarkovModelTest, distributionsAreNormalized)
+{
+    NGramMarkovModel model(3, words);
+    for (const std::string context : { "", "a", "ab", "abc", "bc", "zzz", "dcba" })
+    {
+        double sum = 0.0;
+        for (const auto& [next, probability] : model.getDistribution(context))
+        {
+            EXPECT_GE(probability, 0.0);
+            sum += probability;
+        }
+        EXPECT_NEAR(sum, 1.0, 1e-9) << "context: " << context;
+    }
+}
+
+TEST(NGramMarkovModelTest, longerContextsSharpenAndUnseenContextsBackOff)
+{
+    NGramMarkovModel model(3, words);
+    // Every sequence starts with 'a' or 'b', so the start context strongly prefers them.
+    EXPECT_GT(model.getProbability("", 'a'), model.getProbability("", 'c'));
+    // "ab" was followed by 'c' twice and 'd' once.
+    EXPECT_GT(model.getProbability("ab", 'c'), model.getProbability("ab", 'd'));
+    EXPECT_GT(model.getProbability("ab", 'd'), model.getProbability("ab", 'a'));
+    // Characters never seen get no probability.
+    EXPECT_EQ(model.getProbability("ab", 'z'), 0.0);
+
+    // A context made of unseen characters falls back to the order-0 frequencies.
+    std::vector<std::pair<char, double>> unseen = model.getDistribution("qq");
+    std::uint64_t total = 0;
+    for (const auto& [next, probability] : unseen)
+        total += model.getCount("", next);
+    for (const auto& [next, probability] : unseen)
+        EXPECT_NEAR(probability, model.getCount("", next) / static_cast<double>(total), 1e-12);
+}
+
+TEST(NGramMarkovModelTest, generatesFromTheModel)
+{
+    NGramMarkovModel model(4, { "banana", "bandana", "cabana" });
+    auto generated = model.generateStrings("", 20, 100, 5);
+    ASSERT_EQ(generated.size(), 100u);
+    for (const auto& text : generated)
+    {
+        EXPECT_LE(text.size(), 20u);
+        for (char c : text)
+            EXPECT_NE(std::string("abncd").find(c), std::string::npos);
+    }
+    EXPECT_EQ(generated, model.generateStrings("", 20, 100, 5));
+
+    std::mt19937_64 rng(3);
+    std::string extended = model.generate("ban", 10, rng);
+    EXPECT_EQ(extended.substr(0, 3), "ban");
+}
+
+TEST(NGramMarkovModelTest, memoryStaysBounded)
+{
+    NGramMarkovModel model(8, 2048);
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string text(20, ' ');
+        for (char& c : text)
+            c = static_cast<char>(letter(rng));
+        model.addSequence(text);
+    }
+    EXPECT_LE(model.getEntryCount(), model.getMaxEntries());
+    EXPECT_GT(model.getPruneThreshold(), 0u);
+    EXPECT_LE(model.getMemoryUsage(), 4 * model.getMaxEntries() * 16 + 256);
+
+    // Pruning keeps the order-0 counts, so the model can still generate.
+    double sum = 0.0;
+    for (const auto& [next, probability] : model.getDistribution("abcdefgh"))
+        sum += probability;
+    EXPECT_NEAR(sum, 1.0, 1e-9);
+
+    model.clear();
+    EXPECT_EQ(model.getEntryCount(), 0u);
+    EXPECT_TRUE(model.getAlphabet().empty());
+}
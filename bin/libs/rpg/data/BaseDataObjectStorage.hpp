@@ -7,10 +7,12 @@
  */
 #pragma once
 
-#include <unordered_map>
 #include <string>
 #include <iostream>
 
+#include "DenseIdMap.hpp"
+#include "Handle.hpp"
+
 namespace data
 {
     /**
@@ -25,8 +27,11 @@ namespace data
     class BaseDataObjectStorage
     {
     public:
-        /// Define a storage map for data ID to data storage.
-        using DataStorageMap = std::unordered_map<uint32_t, dataStorageType>;
+        /**
+         * Define a storage map for data ID to data storage. IDs come from small dense registries,
+         * so a DenseIdMap (array-indexed, contiguous) replaces a hash map with the same interface.
+         */
+        using DataStorageMap = DenseIdMap<dataStorageType>;
 
         virtual ~BaseDataObjectStorage() = default;
 
@@ -35,6 +40,12 @@ namespace data
          * a reference to a default-constructed value (or error) may be returned, depending on implementation.
          * Overloads support lookup by name, ID, or a reference key object.
          *
+         * The returned reference is only valid until the storage next changes. The objects are
+         * kept in a DenseIdMap, where adding an object can reallocate the entries and removing
+         * one moves the last entry into its place. Since get() may add the object it is asked
+         * for, a reference from one get() call can dangle after another: copy the value, or
+         * call get() again after any call which may add or remove an object.
+         *
          * @param name[const std::string&] - The string identifier of the object.
          *        id[uint32_t] - The numeric identifier of the object.
          *        keyObject[const dataType&] - A key-type object (holding ID and name).
@@ -44,6 +55,22 @@ namespace data
         virtual dataStorageType& get(uint32_t id) = 0;
         virtual dataStorageType& get(const dataType& keyObject) = 0;
 
+        /**
+         * Gets the object for a registry handle (see Registry::getHandle()). Stored objects are
+         * found by indexing, with no name or ID hashing; an object not yet stored falls back to
+         * get(uint32_t), which adds it as that overload does. Derived classes which declare their
+         * own get() overloads must bring this one into scope with a using-declaration. The
+         * returned reference is invalidated like the other overloads' (see above).
+         *
+         * @param handle[Handle<dataType>] - The handle of the object.
+         * @return A reference to the stored data object.
+         */
+        dataStorageType& get(Handle<dataType> handle)
+        {
+            auto it = dataStore.find(handle.getID());
+            return it != dataStore.end() ? it->second : get(handle.getID());
+        }
+
         /**
          * Serializes the container contents to a string.
          * Format and encoding must be defined by the derived class.
@@ -60,12 +87,15 @@ namespace data
 
         /**
          * Returns a mutable reference to the internal data storage map.
-         * Useful for low-level manipulation or iteration.
+         * Useful for low-level manipulation or iteration. Adding or removing objects (including
+         * through get()) invalidates iterators and references into it.
          *
          * @return A reference to the internal data map.
          */
         DataStorageMap& getMap()
         { return dataStore; }
+        const DataStorageMap& getMap() const
+        { return dataStore; }
         
     protected:
         /// Map of the data ID to the associated data storage instance.
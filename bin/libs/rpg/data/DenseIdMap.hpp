@@ -0,0 +1,210 @@
+/**
+ * @file DenseIdMap.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: A map from small dense IDs (such as registry IDs) to values, stored as a
+ * sparse set so lookups are an array index and iteration is over contiguous memory.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace data
+{
+    /**
+     * A sparse set keyed by ID. The entries live in one contiguous array (the dense array),
+     * and a flat array indexed by ID holds each entry's position in it (or NO_POSITION if
+     * the ID is absent). Lookups, insertions and removals are constant time without
+     * hashing, and iterating visits only the stored entries, back to back.
+     *
+     * The interface mirrors the parts of std::unordered_map used by the data storage classes
+     * (find(), emplace(), erase(), at(), iteration over (id, value) pairs), so code written
+     * against the map keeps working. Like an unordered map, the iteration order is unspecified:
+     * entries are kept in insertion order until one is erased, which moves the last entry
+     * into its place. Erasing or inserting invalidates iterators and references.
+     *
+     * Memory for the index grows with the largest ID stored (4 bytes per ID), so this
+     * suits the small ID ranges (1..N) handed out by the registries.
+     *
+     * @tparam valueType The type of the stored values.
+     */
+    template<typename valueType>
+    class DenseIdMap
+    {
+    public:
+        using key_type = uint32_t;
+        using mapped_type = valueType;
+        /// The stored entry. The ID (first) must not be modified through an iterator.
+        using value_type = std::pair<uint32_t, valueType>;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        /// The index value of an absent ID.
+        static constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+
+        /// Returns an iterator to the first entry.
+        iterator begin() { return entries.begin(); }
+        const_iterator begin() const { return entries.begin(); }
+        const_iterator cbegin() const { return entries.cbegin(); }
+
+        /// Returns an iterator past the last entry.
+        iterator end() { return entries.end(); }
+        const_iterator end() const { return entries.end(); }
+        const_iterator cend() const { return entries.cend(); }
+
+        /// Returns the number of entries.
+        size_type size() const
+        { return entries.size(); }
+
+        /// Returns true if there are no entries.
+        bool empty() const
+        { return entries.empty(); }
+
+        /// Removes every entry.
+        void clear()
+        {
+            entries.clear();
+            positions.clear();
+        }
+
+        /**
+         * Reserves space for IDs up to a maximum, so later insertions do not reallocate.
+         * @param maxId[uint32_t] - The largest ID expected.
+         */
+        void reserve(uint32_t maxId)
+        {
+            if (positions.size() <= maxId)
+                positions.resize(static_cast<size_type>(maxId) + 1, NO_POSITION);
+            entries.reserve(static_cast<size_type>(maxId) + 1);
+        }
+
+        /**
+         * Finds the entry for an ID.
+         * @param id[uint32_t] - The ID.
+         * @return An iterator to the entry, or end() if the ID is absent.
+         */
+        iterator find(uint32_t id)
+        {
+            uint32_t position = positionOf(id);
+            return position == NO_POSITION ? entries.end() : entries.begin() + position;
+        }
+        const_iterator find(uint32_t id) const
+        {
+            uint32_t position = positionOf(id);
+            return position == NO_POSITION ? entries.end() : entries.begin() + position;
+        }
+
+        /// Returns true if the ID has an entry.
+        bool contains(uint32_t id) const
+        { return positionOf(id) != NO_POSITION; }
+
+        /// Returns 1 if the ID has an entry, 0 otherwise.
+        size_type count(uint32_t id) const
+        { return contains(id) ? 1 : 0; }
+
+        /**
+         * Gets the value for an ID.
+         * @param id[uint32_t] - The ID.
+         * @return A reference to the value.
+         * @throws std::out_of_range if the ID is absent (as std::unordered_map::at()).
+         */
+        valueType& at(uint32_t id)
+        {
+            uint32_t position = positionOf(id);
+            if (position == NO_POSITION)
+                throw std::out_of_range("DenseIdMap::at: ID " + std::to_string(id) + " not found.");
+            return entries[position].second;
+        }
+        const valueType& at(uint32_t id) const
+        {
+            uint32_t position = positionOf(id);
+            if (position == NO_POSITION)
+                throw std::out_of_range("DenseIdMap::at: ID " + std::to_string(id) + " not found.");
+            return entries[position].second;
+        }
+
+        /// Gets the value for an ID, inserting a default-constructed value if it is absent.
+        valueType& operator[](uint32_t id)
+        { return emplace(id).first->second; }
+
+        /**
+         * Inserts a value for an ID if the ID is absent.
+         * @param id[uint32_t] - The ID.
+         * @param args - The arguments to construct the value from.
+         * @return An iterator to the entry for the ID, and true if it was inserted
+         *         (false if the ID already had an entry, which is left unchanged).
+         * @throws std::out_of_range if the ID is NO_POSITION.
+         */
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(uint32_t id, Args&&... args)
+        {
+            uint32_t position = positionOf(id);
+            if (position != NO_POSITION)
+                return { entries.begin() + position, false };
+            if (id == NO_POSITION)
+                throw std::out_of_range("DenseIdMap::emplace: ID " + std::to_string(id) + " is reserved.");
+
+            if (positions.size() <= id)
+                positions.resize(static_cast<size_type>(id) + 1, NO_POSITION);
+            entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(id),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+            positions[id] = static_cast<uint32_t>(entries.size() - 1);
+            return { entries.end() - 1, true };
+        }
+
+        /// Inserts an (id, value) pair if the ID is absent (see emplace()).
+        std::pair<iterator, bool> insert(const value_type& entry)
+        { return emplace(entry.first, entry.second); }
+
+        /**
+         * Removes an entry. The last entry moves into its place.
+         * @param it[const_iterator] - The entry to remove.
+         * @return An iterator to the entry now at the removed position (or end()), so
+         *         `it = erase(it)` loops still visit every entry once.
+         */
+        iterator erase(const_iterator it)
+        {
+            size_type position = static_cast<size_type>(it - entries.cbegin());
+            positions[entries[position].first] = NO_POSITION;
+            if (position + 1 != entries.size())
+            {
+                entries[position] = std::move(entries.back());
+                positions[entries[position].first] = static_cast<uint32_t>(position);
+            }
+            entries.pop_back();
+            return entries.begin() + static_cast<std::ptrdiff_t>(position);
+        }
+
+        /**
+         * Removes the entry for an ID, if any.
+         * @param id[uint32_t] - The ID.
+         * @return The number of entries removed (0 or 1).
+         */
+        size_type erase(uint32_t id)
+        {
+            const_iterator it = find(id);
+            if (it == entries.cend())
+                return 0;
+            erase(it);
+            return 1;
+        }
+
+    private:
+        /// Returns the position of an ID in the dense array, or NO_POSITION.
+        uint32_t positionOf(uint32_t id) const
+        { return id < positions.size() ? positions[id] : NO_POSITION; }
+
+        /// The entries, back to back.
+        std::vector<value_type> entries;
+        /// The position of each ID in entries, indexed by ID.
+        std::vector<uint32_t> positions;
+    }; // class DenseIdMap
+
+} // namespace data
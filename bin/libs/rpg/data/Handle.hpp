@@ -0,0 +1,58 @@
+/**
+ * @file Handle.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: A typed handle to an object held in a registry, resolved once from a name
+ * and then used for lookups which need no hashing.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace data
+{
+    /**
+     * A typed reference to a registry object (e.g., Handle<Vital>). A handle holds the ID of
+     * the object, which the registries and the data storage classes both index by, so
+     * resolving one is a direct array access rather than a name or ID hash lookup.
+     *
+     * Handles are obtained from Registry::getHandle() (or rpg::NamedHandle for well-known
+     * names). The type parameter keeps, for example, a vital handle from being used with a
+     * wallet. A handle stays valid as long as the registry is not reloaded with different IDs.
+     *
+     * @tparam T The type of object the handle refers to.
+     */
+    template<typename T>
+    class Handle
+    {
+    public:
+        /// The ID of a handle which refers to nothing.
+        static constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+        /// Constructs an invalid handle.
+        constexpr Handle() = default;
+
+        /**
+         * Constructs a handle for an ID. Prefer Registry::getHandle(), which checks the ID.
+         * @param id[uint32_t] - The ID of the object.
+         */
+        constexpr explicit Handle(uint32_t id) : id(id) { }
+
+        /// Returns the ID of the object.
+        constexpr uint32_t getID() const
+        { return id; }
+
+        /// Returns true if the handle refers to an object.
+        constexpr bool isValid() const
+        { return id != INVALID_ID; }
+
+        /// Handles are equal if they refer to the same object.
+        constexpr bool operator==(const Handle& other) const = default;
+
+    private:
+        /// The ID of the object, or INVALID_ID.
+        uint32_t id{INVALID_ID};
+    }; // class Handle
+
+} // namespace data
@@ -25,7 +25,7 @@ namespace currency
          * in the form of a name (std::string), ID (uint32_t), or a Currency object, and attempts to fetch
          * the corresponding Currency instance from the registry.
          *
-         * @tparam T The type of identifier: std::string, uint32_t, or Currency.
+         * @tparam T The type of identifier: std::string, uint32_t, Currency, or data::Handle<Currency>.
          * @param identifier The identifier used to locate the Currency in the registry.
          * @return Pointer to the corresponding Currency object.
          * @throws MIA_THROW with Undefined_RPG_Value if the object is not found.
@@ -90,7 +90,12 @@ namespace currency
             unsigned int newQuantity = it->second.getQuantity() + quantity;
             it->second.set(newQuantity);
         }
-    }    
+    }
+    void Wallet::add(data::Handle<Currency> handle, uint32_t quantity)
+    {
+        const Currency* curr = helper_methods::getFromRegistry(handle);
+        add(*curr, quantity);
+    }
 
 
     // remove() methods...
@@ -138,6 +143,11 @@ namespace currency
         }
         it->second.set(amount);
     }
+    void Wallet::update(data::Handle<Currency> handle, unsigned int amount)
+    {
+        const Currency* curr = helper_methods::getFromRegistry(handle);
+        update(*curr, amount);
+    }
       
 
     // has() methods...
@@ -163,6 +173,11 @@ namespace currency
             return true;
         return false;
     }
+    bool Wallet::has(data::Handle<Currency> handle, unsigned int quantity) const
+    {
+        const Currency* curr = helper_methods::getFromRegistry(handle);
+        return has(*curr, quantity);
+    }
 
 
     void Wallet::dump(std::ostream& os) const
@@ -40,6 +40,8 @@ namespace currency
         CurrencyQuantity& get(const std::string& name) override;
         CurrencyQuantity& get(uint32_t id) override;
         CurrencyQuantity& get(const Currency& currency) override;
+        /// Handle lookups (see BaseDataObjectStorage::get(Handle)).
+        using data::BaseDataObjectStorage<Currency, CurrencyQuantity>::get;
         
         /**
          * Adds a specified currency to the container.
@@ -49,11 +51,13 @@ namespace currency
          * @param name[const std::string&] - The name of the currency (e.g., "gold", "silver").
          *        id[uint32_t] - The ID of the currency.
          *        currency[const Currency&] - The Currency object.
+         *        handle[data::Handle<Currency>] - A handle from the CurrencyRegistry.
          * @param quantity[uint32_t] - The amount to add.
          */
         void add(const std::string& name, uint32_t quantity);
         void add(uint32_t id, uint32_t quantity);
         void add(const Currency& currency, uint32_t quantity);
+        void add(data::Handle<Currency> handle, uint32_t quantity);
 
         /**
          * Removes a specified currency from the container.
@@ -74,11 +78,13 @@ namespace currency
          * @param name[const std::string&] - The name of the currency (e.g., "gold", "silver").
          *        id[uint32_t] - The ID of the currency.
          *        currency[const Currency&] - The Currency object.
+         *        handle[data::Handle<Currency>] - A handle from the CurrencyRegistry.
          * @param amount[int] - The signed amount to update (positive = add, negative = remove).
          */
         void update(const std::string& name, unsigned int amount);
         void update(uint32_t id, unsigned int amount);
         void update(const Currency& currency, unsigned int amount);
+        void update(data::Handle<Currency> handle, unsigned int amount);
 
         /**
          * Checks if the container has at least the specified quantity of a currency.
@@ -87,12 +93,14 @@ namespace currency
          * @param name[const std::string&] - The name of the currency (e.g., "gold", "silver").
          *        id[uint32_t] - The ID of the currency.
          *        currency[const Currency&] - The Currency object.
+         *        handle[data::Handle<Currency>] - A handle from the CurrencyRegistry.
          * @param quantity[uint32_t] - The required amount.
          * @return True if the container has enough; false otherwise.
          */
         bool has(const std::string& name, unsigned int quantity) const;
         bool has(uint32_t id, unsigned int quantity) const;
         bool has(const Currency& currency, unsigned int quantity) const;
+        bool has(data::Handle<Currency> handle, unsigned int quantity) const;
 
         /**
          * Dumps the container's contents to the provided output stream.
@@ -185,6 +185,22 @@ namespace currency
             << "has for non-existent ID should throw MIAException.";
     }
 
+    // Test adding, updating and checking currency by registry handle
+    TEST_F(Wallet_T, WritesByHandle) 
+    {
+        data::Handle<Currency> coinHandle = CurrencyRegistry::getInstance().getHandle("Coin");
+        container.add(coinHandle, 75);
+        EXPECT_EQ(container.get(coin).getQuantity(), 75) << "add(handle, 75) should set quantity to 75.";
+        container.update(coinHandle, 50);
+        EXPECT_EQ(container.get(coinHandle).getQuantity(), 50) << "update(handle, 50) should set quantity to 50.";
+        EXPECT_TRUE(container.has(coinHandle, 25)) << "has(handle, 25) should return true.";
+        EXPECT_FALSE(container.has(coinHandle, 50)) << "has(handle, 50) should return false.";
+        EXPECT_THROW(container.update(data::Handle<Currency>(), 25), error::MIAException)
+            << "update for an invalid handle should throw MIAException.";
+        EXPECT_THROW(container.has(data::Handle<Currency>(999), 1), error::MIAException)
+            << "has for an unknown handle should throw MIAException.";
+    }
+
     // Test getting quantity of unknown currency returns zero
     TEST_F(Wallet_T, GetForUnknownCurrencyReturnsZero) 
     {
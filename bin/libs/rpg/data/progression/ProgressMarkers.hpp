@@ -38,6 +38,8 @@ namespace progress
         ProgressValue& get(const std::string& name) override;
         ProgressValue& get(uint32_t id) override;
         ProgressValue& get(const ProgressMarker& progressMarker) override;
+        /// Handle lookups (see BaseDataObjectStorage::get(Handle)).
+        using data::BaseDataObjectStorage<ProgressMarker, ProgressValue>::get;
         
         /**
          * Adds a specified progress marker to the container.
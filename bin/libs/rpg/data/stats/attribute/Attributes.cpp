@@ -24,7 +24,7 @@ namespace stats
          * in the form of a name (std::string), ID (uint32_t), or a Attribute object, and attempts to fetch
          * the corresponding Attribute instance from the registry.
          *
-         * @tparam T The type of identifier: std::string, uint32_t, or Attribute.
+         * @tparam T The type of identifier: std::string, uint32_t, Attribute, or data::Handle<Attribute>.
          * @param identifier The identifier used to locate the Attribute in the registry.
          * @return Pointer to the corresponding Attribute object.
          * @throws MIA_THROW with Undefined_RPG_Value if the object is not found.
@@ -82,6 +82,11 @@ namespace stats
             
         dataStore.emplace(id, AttributeData(current));
     }
+    void Attributes::add(data::Handle<Attribute> handle, int current)
+    {
+        const Attribute* attribute = helper_methods::getAttributeFromRegistry(handle);
+        add(*attribute, current);
+    }
     
     
     // update() methods...
@@ -108,6 +113,11 @@ namespace stats
             it->second.setCurrent(value);
         }
     }
+    void Attributes::update(data::Handle<Attribute> handle, int value)
+    {
+        const Attribute* attribute = helper_methods::getAttributeFromRegistry(handle);
+        update(*attribute, value);
+    }
     
     
     // addModifier() methods...
@@ -137,6 +147,7 @@ namespace stats
         {
             // The data is not found so add a default one, then update the current.
             add(attribute, attribute.getBaseValue());
+            it = dataStore.find(attribute.getID());
         }
         
         rpg::Modifier<int> mod = rpg::Modifier<int>(sourceID, sourceType, value);
@@ -34,6 +34,8 @@ namespace stats
         AttributeData& get(const std::string& name) override;
         AttributeData& get(uint32_t id) override;
         AttributeData& get(const Attribute& attribute) override;
+        /// Handle lookups (see BaseDataObjectStorage::get(Handle)).
+        using data::BaseDataObjectStorage<Attribute, AttributeData>::get;
         
         /**
          * Adds a new Attribute with specified values.
@@ -41,6 +43,7 @@ namespace stats
          * @param name[const std::string&] The name of the Attribute.
          *        id[uint32_t] The ID of the Attribute.
          *        Attribute[const Attribute&] The Attribute object.
+         *        handle[data::Handle<Attribute>] - A handle from the AttributeRegistry.
          * @param current[int] The initial current value.
          * @param min[int] The minimum value.
          * @param max[int] The base maximum value.
@@ -48,6 +51,7 @@ namespace stats
         void add(const std::string& name, int current);
         void add(uint32_t id, int current);
         void add(const Attribute& attribute, int current);
+        void add(data::Handle<Attribute> handle, int current);
         
         /**
          * Updates the current value of a Attribute Data object. 
@@ -55,11 +59,13 @@ namespace stats
          * @param name[const std::string&] The name of the Attribute.
          *        id[uint32_t] The ID of the Attribute.
          *        Attribute[const Attribute&] The Attribute object.
+         *        handle[data::Handle<Attribute>] - A handle from the AttributeRegistry.
          * @param value[int] The new current value.
          */
         void update(const std::string& name, int value);
         void update(uint32_t id, int value);
         void update(const Attribute& attribute, int value);
+        void update(data::Handle<Attribute> handle, int value);
         
         /**
          * Adds a modifier to a Attribute's current value.
@@ -142,6 +142,23 @@ namespace stats
             << "update(dexterity, 150) should update current value to 150.";
     }
 
+    // Test add and update with a registry handle
+    TEST_F(Attributes_T, writeByHandle)
+    {
+        data::Handle<Attribute> wisdomHandle = AttributeRegistry::getInstance().getHandle("Wisdom");
+        attributes.update(wisdomHandle, 200);
+        EXPECT_EQ(attributes.get(wisdom).getCurrent(), 200)
+            << "update(handle, 200) should update current value to 200.";
+
+        attributes.remove(wisdom);
+        attributes.add(wisdomHandle, 10);
+        EXPECT_EQ(attributes.get(wisdomHandle).getCurrent(), 10)
+            << "add(handle, 10) should add the attribute with current value 10.";
+
+        EXPECT_THROW(attributes.update(data::Handle<Attribute>(), 300), error::MIAException);
+        EXPECT_THROW(attributes.add(data::Handle<Attribute>(999), 300), error::MIAException);
+    }
+
     // Test addModifier with string name
     TEST_F(Attributes_T, addModifierByName)
     {
@@ -160,6 +177,15 @@ namespace stats
                      error::MIAException);
     }
 
+    // Test addModifier on an attribute which is not stored yet
+    TEST_F(Attributes_T, addModifierToUnstoredAttribute)
+    {
+        attributes.remove(strength);
+        attributes.addModifier(strength, 2, rpg::ModifierSourceType::BUFF, 10);
+        EXPECT_EQ(attributes.get(strength).getCurrent(), 85)
+            << "addModifier() should add the attribute at its base value, then apply the modifier.";
+    }
+
     // Test addModifier with uint32_t ID
     TEST_F(Attributes_T, addModifierById)
     {
@@ -27,7 +27,7 @@ namespace stats
          * in the form of a name (std::string), ID (uint32_t), or a Vital object, and attempts to fetch
          * the corresponding Vital instance from the registry.
          *
-         * @tparam T The type of identifier: std::string, uint32_t, or Vital.
+         * @tparam T The type of identifier: std::string, uint32_t, Vital, or data::Handle<Vital>.
          * @param identifier The identifier used to locate the Vital in the registry.
          * @return Pointer to the corresponding Vital object.
          * @throws MIA_THROW with Undefined_RPG_Value if the object is not found.
@@ -94,6 +94,11 @@ namespace stats
             
         dataStore.emplace(id, VitalData(current, min, max));
     }
+    void Vitals::add(data::Handle<Vital> handle, int current, int min, int max)
+    {
+        const Vital* vital = helper_methods::getVitalFromRegistry(handle);
+        add(*vital, current, min, max);
+    }
 
 
     // update(..) methods.
@@ -115,6 +120,7 @@ namespace stats
             // The data is not found so add a default one, then update the current.
             // TODO - setting the current here to baseMax... This may not always be best/desired.
             add(vital, vital.getBaseMax(), vital.getBaseMin(), vital.getBaseMax());
+            it = dataStore.find(vital.getID());
         }
         
         if (target == VitalDataTarget::CURRENT)
@@ -146,6 +152,11 @@ namespace stats
             it->second.setCurrent(it->second.getCurrent()); // If correction is needed.
         }
     }
+    void Vitals::update(data::Handle<Vital> handle, VitalDataTarget target, int value)
+    {
+        const Vital* vital = helper_methods::getVitalFromRegistry(handle);
+        update(*vital, target, value);
+    }
     
     
     // addModifier(..) methods.
@@ -179,6 +190,7 @@ namespace stats
             // The data is not found so add a default one, then update the current.
             // TODO - setting the current here to baseMax... This may not always be best/desired.
             add(vital, vital.getBaseMax(), vital.getBaseMin(), vital.getBaseMax());
+            it = dataStore.find(vital.getID());
         }
         
         rpg::Modifier<int> mod = rpg::Modifier<int>(sourceID, sourceType, value);
@@ -209,6 +221,7 @@ namespace stats
             // The data is not found so add a default one, then update the current.
             // TODO - setting the current here to baseMax... This may not always be best/desired.
             add(vital, vital.getBaseMax(), vital.getBaseMin(), vital.getBaseMax());
+            it = dataStore.find(vital.getID());
         }
 
         it->second.addModifier(mod, target);
@@ -292,6 +305,11 @@ namespace stats
             
         return false;
     }
+    bool Vitals::has(data::Handle<Vital> handle, int value) const
+    {
+        const Vital* vital = helper_methods::getVitalFromRegistry(handle);
+        return has(*vital, value);
+    }
 
     void Vitals::dump(std::ostream& os) const
     {
@@ -37,6 +37,8 @@ namespace stats
         VitalData& get(const std::string& name) override;
         VitalData& get(uint32_t id) override;
         VitalData& get(const Vital& vital) override;
+        /// Handle lookups (see BaseDataObjectStorage::get(Handle)).
+        using data::BaseDataObjectStorage<Vital, VitalData>::get;
         
         /**
          * Adds a new vital with specified values.
@@ -44,6 +46,7 @@ namespace stats
          * @param name[const std::string&] The name of the vital.
          *        id[uint32_t] The ID of the vital.
          *        vital[const Vital&] The Vital object.
+         *        handle[data::Handle<Vital>] - A handle from the VitalRegistry.
          * @param current[int] The initial current value.
          * @param min[int] The minimum value.
          * @param max[int] The base maximum value.
@@ -51,6 +54,7 @@ namespace stats
         void add(const std::string& name, int current, int min, int max);
         void add(uint32_t id, int current, int min, int max);
         void add(const Vital& vital, int current, int min, int max);
+        void add(data::Handle<Vital> handle, int current, int min, int max);
 
         /**
          * Updates a value of a Vital Data object. This uses the target to determine which 
@@ -59,12 +63,14 @@ namespace stats
          * @param name[const std::string&] The name of the vital.
          *        id[uint32_t] The ID of the vital.
          *        vital[const Vital&] The Vital object.
+         *        handle[data::Handle<Vital>] - A handle from the VitalRegistry.
          * @param target[VitalDataTarget] - The target value to modify.
          * @param value[int] The new current value.
          */
         void update(const std::string& name, VitalDataTarget target, int value);
         void update(uint32_t id, VitalDataTarget target, int value);
         void update(const Vital& vital, VitalDataTarget target, int value);
+        void update(data::Handle<Vital> handle, VitalDataTarget target, int value);
         
         /**
          * Adds a modifier to a vital's max or min value. This uses the target to determine 
@@ -156,12 +162,14 @@ namespace stats
          * @param name[const std::string&] - The name (std::string)
          *        id[uint32_t] - The ID (uint32_t)
          *        vital[const Vital&] - The vital (Vital object)
+         *        handle[data::Handle<Vital>] - A handle from the VitalRegistry
          * @param value[uint32_t] - The required amount.
          * @return True if the current vital has enough; false otherwise.
          */
         bool has(const std::string& name, int value) const;
         bool has(uint32_t id, int value) const;
         bool has(const Vital& vital, int value) const;
+        bool has(data::Handle<Vital> handle, int value) const;
 
         /**
          * Dumps the container contents to a stream, primarily for debugging.
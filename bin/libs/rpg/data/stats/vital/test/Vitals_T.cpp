@@ -60,6 +60,20 @@ TEST_F(Vitals_T, get)
     EXPECT_THROW(vitals.get("invalid"), error::MIAException);
 }
 
+TEST_F(Vitals_T, getByHandle)
+{
+    vitals.add("Health", 80, 0, 100);
+    data::Handle<Vital> healthHandle = VitalRegistry::getInstance().getHandle("Health");
+    EXPECT_EQ(&vitals.get(healthHandle), &vitals.get("Health"));
+    EXPECT_EQ(vitals.get(healthHandle).getCurrent(), 80);
+
+    // A vital not yet stored is added, as with the other get() overloads.
+    data::Handle<Vital> manaHandle = VitalRegistry::getInstance().getHandle("Mana");
+    EXPECT_EQ(vitals.get(manaHandle).getCurrentMax(), vitals.get("Mana").getCurrentMax());
+
+    EXPECT_THROW(vitals.get(data::Handle<Vital>()), error::MIAException);
+}
+
 TEST_F(Vitals_T, add)
 {
     EXPECT_NO_THROW(vitals.add("Health", 80, 0, 100));
@@ -178,6 +192,22 @@ TEST_F(Vitals_T, AddremoveModifier)
     // The resulting max may wrap, clamp, or just increase depending on implementation
 }
 
+TEST_F(Vitals_T, writesToUnstoredVitals)
+{
+    // Writes to a vital which is not stored yet add it with its base values first.
+    EXPECT_NO_THROW(vitals.update("Mana", VitalDataTarget::CURRENT, 40));
+    EXPECT_EQ(vitals.get("Mana").getCurrent(), 40);
+    EXPECT_EQ(vitals.get("Mana").getCurrentMax(), 100);
+
+    EXPECT_NO_THROW(vitals.addModifier("Rage", 1, rpg::ModifierSourceType::ATTRIBUTE, 20,
+                                       VitalDataTarget::CURRENT_MAX));
+    EXPECT_EQ(vitals.get("Rage").getCurrentMax(), 120);
+
+    rpg::Modifier<int> mod(2, rpg::ModifierSourceType::ITEM, 5);
+    EXPECT_NO_THROW(vitals.addModifier(health, mod, VitalDataTarget::CURRENT_MAX));
+    EXPECT_EQ(vitals.get(health).getCurrentMax(), 105);
+}
+
 TEST_F(Vitals_T, remove)
 {
     vitals.add("Health", 80, 0, 100);
@@ -209,6 +239,23 @@ TEST_F(Vitals_T, has)
     EXPECT_THROW(vitals.has("invalid", 5), error::MIAException);
 }
 
+TEST_F(Vitals_T, writeByHandle)
+{
+    data::Handle<Vital> healthHandle = VitalRegistry::getInstance().getHandle("Health");
+    vitals.add(healthHandle, 80, 0, 100);
+    EXPECT_EQ(vitals.get("Health").getCurrent(), 80);
+
+    EXPECT_NO_THROW(vitals.update(healthHandle, VitalDataTarget::CURRENT, 60));
+    EXPECT_EQ(vitals.get(healthHandle).getCurrent(), 60);
+    EXPECT_TRUE(vitals.has(healthHandle, 60));
+    EXPECT_FALSE(vitals.has(healthHandle, 61));
+
+    // Invalid and unknown handles throw like unknown names.
+    EXPECT_THROW(vitals.update(data::Handle<Vital>(), VitalDataTarget::CURRENT, 1), error::MIAException);
+    EXPECT_THROW(vitals.has(data::Handle<Vital>(999), 1), error::MIAException);
+    EXPECT_THROW(vitals.add(data::Handle<Vital>(), 1, 0, 1), error::MIAException);
+}
+
 TEST_F(Vitals_T, GetVitalMaxMin)
 {
     vitals.add("Health", 80, 0, 100);
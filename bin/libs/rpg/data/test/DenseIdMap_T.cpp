@@ -0,0 +1,127 @@
+/**
+ * @file DenseIdMap_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Google Test suite for the DenseIdMap class.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "DenseIdMap.hpp"
+
+
+namespace data
+{
+    TEST(DenseIdMap_T, InsertFindAndAt)
+    {
+        DenseIdMap<std::string> ids;
+        EXPECT_TRUE(ids.empty());
+        EXPECT_EQ(ids.find(3), ids.end());
+
+        auto [it, inserted] = ids.emplace(3, "three");
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(it->first, 3u);
+        EXPECT_EQ(it->second, "three");
+
+        // Emplacing an existing ID leaves it unchanged, as with std::unordered_map.
+        auto again = ids.emplace(3, "other");
+        EXPECT_FALSE(again.second);
+        EXPECT_EQ(again.first->second, "three");
+
+        ids.insert({ 1, "one" });
+        ids[7] = "seven";
+        EXPECT_EQ(ids.size(), 3u);
+        EXPECT_EQ(ids.at(1), "one");
+        EXPECT_EQ(ids.at(7), "seven");
+        EXPECT_TRUE(ids.contains(7));
+        EXPECT_EQ(ids.count(2), 0u);
+        EXPECT_THROW(ids.at(2), std::out_of_range);
+        EXPECT_THROW(ids.at(100), std::out_of_range);
+        EXPECT_THROW(ids.emplace(DenseIdMap<std::string>::NO_POSITION, "bad"), std::out_of_range);
+    }
+
+    TEST(DenseIdMap_T, IteratesContiguouslyLikeAMap)
+    {
+        DenseIdMap<int> ids;
+        for (uint32_t id = 1; id <= 5; ++id)
+            ids.emplace(id, static_cast<int>(id * 10));
+
+        // Entries are stored back to back.
+        EXPECT_EQ(&*(ids.begin() + 4) - &*ids.begin(), 4);
+
+        // Structured bindings and mutable references work as they do over a map.
+        int total = 0;
+        for (auto& [id, value] : ids)
+        {
+            value += 1;
+            total += static_cast<int>(id);
+        }
+        EXPECT_EQ(total, 15);
+        for (const auto& entry : ids)
+            EXPECT_EQ(entry.second, static_cast<int>(entry.first * 10 + 1));
+    }
+
+    TEST(DenseIdMap_T, EraseKeepsIndexConsistent)
+    {
+        DenseIdMap<int> ids;
+        for (uint32_t id = 1; id <= 6; ++id)
+            ids.emplace(id, static_cast<int>(id));
+
+        EXPECT_EQ(ids.erase(2u), 1u);
+        EXPECT_EQ(ids.erase(2u), 0u);
+        EXPECT_EQ(ids.find(2), ids.end());
+        EXPECT_EQ(ids.at(6), 6);
+
+        // Erasing while iterating visits every remaining entry once.
+        int visited = 0;
+        for (auto it = ids.begin(); it != ids.end();)
+        {
+            ++visited;
+            it = (it->first % 2 == 1) ? ids.erase(it) : it + 1;
+        }
+        EXPECT_EQ(visited, 5);
+        EXPECT_EQ(ids.size(), 2u);
+        EXPECT_EQ(ids.at(4), 4);
+        EXPECT_EQ(ids.at(6), 6);
+
+        ids.clear();
+        EXPECT_TRUE(ids.empty());
+        EXPECT_FALSE(ids.contains(4));
+    }
+
+    TEST(DenseIdMap_T, MatchesUnorderedMap)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<uint32_t> pickId(1, 64);
+        std::uniform_int_distribution<int> pickAction(0, 2);
+
+        DenseIdMap<int> dense;
+        std::unordered_map<uint32_t, int> reference;
+        for (int step = 0; step < 5000; ++step)
+        {
+            uint32_t id = pickId(rng);
+            switch (pickAction(rng))
+            {
+                case 0:
+                    EXPECT_EQ(dense.emplace(id, step).second, reference.emplace(id, step).second);
+                    break;
+                case 1:
+                    EXPECT_EQ(dense.erase(id), reference.erase(id));
+                    break;
+                default:
+                    EXPECT_EQ(dense.find(id) == dense.end(), reference.find(id) == reference.end());
+                    break;
+            }
+        }
+        ASSERT_EQ(dense.size(), reference.size());
+        std::map<uint32_t, int> denseSorted(dense.begin(), dense.end());
+        std::map<uint32_t, int> referenceSorted(reference.begin(), reference.end());
+        EXPECT_EQ(denseSorted, referenceSorted);
+    }
+
+} // namespace data
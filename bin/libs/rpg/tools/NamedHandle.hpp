@@ -0,0 +1,74 @@
+/**
+ * @file NamedHandle.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: A handle to a well-known registry object, named by a string literal and
+ * resolved once (per registry load) instead of on every access.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Handle.hpp"
+
+namespace rpg
+{
+    /**
+     * Interns the name of a well-known registry object (e.g., "Health"). It is constructed
+     * at compile time from a string literal and looks the name up the first time get() is
+     * called. The resulting handle is cached along with the registry's load generation, so
+     * later calls cost one comparison until the registry is reloaded. Safe to share between
+     * threads.
+     *
+     * Example:
+     *     const rpg::NamedHandle<stats::VitalRegistry> health{"Health"};
+     *     int current = player.getVitals().get(health.get()).getCurrent();
+     *
+     * @tparam RegistryType The registry the name belongs to (e.g., VitalRegistry).
+     */
+    template<typename RegistryType>
+    class NamedHandle
+    {
+    public:
+        /// The type of object the handle refers to.
+        using ObjectType = typename RegistryType::ObjectType;
+
+        /**
+         * Constructs an unresolved handle.
+         * @param name[std::string_view] - The name of the object (must outlive the handle, e.g., a literal).
+         */
+        constexpr explicit NamedHandle(std::string_view name) : name(name) { }
+
+        /**
+         * Gets the handle, resolving the name if the registry has been (re)loaded since the last call.
+         * @return [data::Handle<ObjectType>] - The handle, or an invalid handle if the name is not registered.
+         */
+        data::Handle<ObjectType> get() const
+        {
+            const auto& registry = RegistryType::getInstance();
+            // The high half holds the generation the handle was resolved for (plus one, so 0 means never).
+            uint64_t generation = static_cast<uint64_t>(registry.getGeneration()) + 1;
+            uint64_t cached = resolved.load(std::memory_order_acquire);
+            if ((cached >> 32) != generation)
+            {
+                cached = (generation << 32) | registry.getHandle(std::string(name)).getID();
+                resolved.store(cached, std::memory_order_release);
+            }
+            return data::Handle<ObjectType>(static_cast<uint32_t>(cached));
+        }
+
+        /// Returns the name of the object.
+        constexpr std::string_view getName() const
+        { return name; }
+
+    private:
+        /// The name of the object.
+        std::string_view name;
+        /// The cached handle ID (low half) and the registry generation it is valid for (high half).
+        mutable std::atomic<uint64_t> resolved{0};
+    }; // class NamedHandle
+
+} // namespace rpg
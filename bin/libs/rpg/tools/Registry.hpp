@@ -7,11 +7,16 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include <string>
 #include <fstream>
 #include <stdexcept>
 #include <nlohmann/json.hpp>
 
+#include "Handle.hpp"
+#include "Error.hpp"
+#include "MIAException.hpp"
+
 namespace rpg
 {
     /**
@@ -23,6 +28,9 @@ namespace rpg
      * This pattern enables the base class to provide functionality (like a singleton instance)
      * for the derived class, while allowing derived classes to implement type-specific behavior.
      *
+     * Objects are stored contiguously in a vector indexed by ID (registry IDs are small and
+     * dense), so a data::Handle<T> resolves with a single indexed load.
+     *
      * @tparam Derived The concrete registry class inheriting from this base.
      * @tparam T The type of object stored in the registry.
      */
@@ -30,6 +38,12 @@ namespace rpg
     class Registry
     {
     public:
+        /// The type of object stored in the registry.
+        using ObjectType = T;
+
+        /// The largest ID an object may have (the objects are indexed by ID).
+        static constexpr uint32_t MAX_ID = (1u << 20) - 1;
+
         // Delete copy constructor and assignment operator for singleton
         Registry(const Registry&) = delete;
         Registry& operator=(const Registry&) = delete;
@@ -91,8 +105,7 @@ namespace rpg
          */
         const T* getByID(uint32_t id) const
         {
-            auto it = objects.find(id);
-            return it != objects.end() ? &it->second : nullptr;
+            return contains(id) ? &objects[id] : nullptr;
         }
 
         /**
@@ -107,14 +120,65 @@ namespace rpg
         }
 
         /**
-         * Dumps all objects to the provided output stream.
+         * Gets a handle to an object by its name. The name is looked up once here, so
+         * callers which access the same object repeatedly should keep the handle.
+         * @param name The name of the object.
+         * @return A handle to the object, or an invalid handle if not found.
+         */
+        data::Handle<T> getHandle(const std::string& name) const
+        {
+            auto it = nameToId.find(name);
+            return it != nameToId.end() ? data::Handle<T>(it->second) : data::Handle<T>();
+        }
+
+        /**
+         * Gets a handle to an object by its ID.
+         * @param id The unique ID.
+         * @return A handle to the object, or an invalid handle if not found.
+         */
+        data::Handle<T> getHandle(uint32_t id) const
+        {
+            return contains(id) ? data::Handle<T>(id) : data::Handle<T>();
+        }
+
+        /**
+         * Gets the object a handle refers to with a single indexed load. The handle is
+         * bounds checked, since an invalid handle (e.g., from getHandle() with an unknown
+         * name) or one from before a reload can hold any ID.
+         * @param handle A valid handle from this registry (see getHandle()).
+         * @return Reference to the object.
+         * @throws MIA_THROW with Undefined_RPG_Value if the handle refers to no object.
+         */
+        const T& get(data::Handle<T> handle) const
+        {
+            if (!contains(handle.getID()))
+            {
+                MIA_THROW(error::ErrorCode::Undefined_RPG_Value,
+                          "No registry object has ID " + std::to_string(handle.getID()) + ".");
+            }
+            return objects[handle.getID()];
+        }
+
+        /**
+         * Returns the number of times the registry has been loaded. Cached handles
+         * (see rpg::NamedHandle) use this to notice a reload.
+         * @return The load generation.
+         */
+        uint32_t getGeneration() const
+        {
+            return generation;
+        }
+
+        /**
+         * Dumps all objects to the provided output stream, in ID order.
          * @param os The output stream (defaults to std::cout).
          */
         virtual void dump(std::ostream& os = std::cout) const
         {
-            for (const auto& [id, obj] : objects)
+            for (uint32_t id = 0; id < objects.size(); ++id)
             {
-                os << "ID: " << id << ", " << toString(obj) << "\n";
+                if (hasObject[id])
+                    os << "ID: " << id << ", " << toString(objects[id]) << "\n";
             }
         }        
 
@@ -145,7 +209,7 @@ namespace rpg
         /**
          * Loads objects from a JSON object by extracting the array for the derived class's key.
          * @param data The JSON object containing the array.
-         * @throws std::runtime_error if the key is missing or not an array.
+         * @throws std::runtime_error if the key is missing or not an array, or an ID is above MAX_ID.
          */
         void loadFromJson(const nlohmann::json& data)
         {
@@ -156,17 +220,35 @@ namespace rpg
                 throw std::runtime_error("JSON key '" + key + "' is not an array");
 
             objects.clear();
+            hasObject.clear();
             nameToId.clear();
+            ++generation;
             for (const auto& item : data[key])
             {
                 T obj = parseJson(item);
                 uint32_t id = item["id"].get<uint32_t>();
+                if (id > MAX_ID)
+                    throw std::runtime_error("Registry ID " + std::to_string(id) + " is too large.");
+                if (id >= objects.size())
+                {
+                    objects.resize(id + 1);
+                    hasObject.resize(id + 1, false);
+                }
                 objects[id] = std::move(obj);
+                hasObject[id] = true;
                 nameToId[item["name"].get<std::string>()] = id;
             }
         }
 
-        std::unordered_map<uint32_t, T> objects; ///< Map of ID to object.
+        /// Returns true if an object with the ID is registered.
+        bool contains(uint32_t id) const
+        {
+            return id < hasObject.size() && hasObject[id];
+        }
+
+        std::vector<T> objects; ///< The objects, indexed by ID.
+        std::vector<bool> hasObject; ///< True for each ID with an object.
         std::unordered_map<std::string, uint32_t> nameToId; ///< Map of name to ID.
+        uint32_t generation{0}; ///< The number of times the registry has been loaded.
     };
 } // namespace rpg
@@ -8,6 +8,7 @@
 
 #include "Error.hpp"
 #include "MIAException.hpp"
+#include "Handle.hpp"
 
 namespace rpg
 {
@@ -22,8 +23,9 @@ namespace rpg
          *
          * @tparam RegistryType The type of registry (e.g., CurrencyRegistry, VitalRegistry, etc).
          * @tparam ObjType The type of the object (e.g., Currency, Vital, etc).
-         * @tparam SearchType The type of the identifier (std::string for name, uint32_t for ID, or ObjType for object).
-         * @param identifier The identifier used to query the ObjType (name, ID, or ObjType object).
+         * @tparam SearchType The type of the identifier (std::string for name, uint32_t for ID, ObjType for
+         *         object, or data::Handle<ObjType> for a registry handle).
+         * @param identifier The identifier used to query the ObjType (name, ID, ObjType object or handle).
          * @return Pointer to the ObjType object if found; nullptr otherwise.
          */
         template<typename RegistryType, typename ObjType, typename SearchType>
@@ -38,7 +40,8 @@ namespace rpg
             {
                 object = RegistryType::getInstance().getByID(identifier);
             }
-            else if constexpr (std::is_same_v<SearchType, ObjType>)
+            else if constexpr (std::is_same_v<SearchType, ObjType> ||
+                               std::is_same_v<SearchType, data::Handle<ObjType>>)
             {
                 object = RegistryType::getInstance().getByID(identifier.getID());
             }
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include "Registry.hpp"
+#include "NamedHandle.hpp"
 
 using json = nlohmann::json;
 
@@ -93,3 +94,42 @@ TEST_F(RegistryTest, Dump_OutputIsNotEmpty)
     EXPECT_NE(output.find("DummyObject{id=1, name=Foo}"), std::string::npos);
     EXPECT_NE(output.find("DummyObject{id=2, name=Bar}"), std::string::npos);
 }
+
+TEST_F(RegistryTest, GetHandle_ResolvesToObject) 
+{
+    auto& registry = rpg::DummyRegistry::getInstance();
+    data::Handle<rpg::DummyObject> bar = registry.getHandle("Bar");
+    ASSERT_TRUE(bar.isValid());
+    EXPECT_EQ(bar.getID(), 2u);
+    EXPECT_EQ(registry.get(bar).name, "Bar");
+    EXPECT_EQ(&registry.get(bar), registry.getByID(2));
+    EXPECT_EQ(registry.getHandle(1), registry.getHandle("Foo"));
+
+    EXPECT_FALSE(registry.getHandle("Invalid").isValid());
+    EXPECT_FALSE(registry.getHandle(999).isValid());
+    EXPECT_FALSE(data::Handle<rpg::DummyObject>().isValid());
+
+    // Resolving an invalid or unknown handle throws instead of reading past the objects.
+    EXPECT_THROW(registry.get(registry.getHandle("Invalid")), error::MIAException);
+    EXPECT_THROW(registry.get(data::Handle<rpg::DummyObject>(999)), error::MIAException);
+    EXPECT_THROW(registry.get(data::Handle<rpg::DummyObject>(0)), error::MIAException);
+}
+
+TEST_F(RegistryTest, NamedHandle_ResolvesOncePerLoad) 
+{
+    auto& registry = rpg::DummyRegistry::getInstance();
+    static const rpg::NamedHandle<rpg::DummyRegistry> foo{"Foo"};
+    static constexpr rpg::NamedHandle<rpg::DummyRegistry> missing{"Missing"};
+    EXPECT_EQ(foo.getName(), "Foo");
+    EXPECT_EQ(registry.get(foo.get()).name, "Foo");
+    EXPECT_EQ(foo.get(), foo.get());
+    EXPECT_FALSE(missing.get().isValid());
+
+    // Reloading with new IDs bumps the generation, so the handle resolves again.
+    uint32_t generation = registry.getGeneration();
+    registry.loadFromString(R"({ "dummy": [ {"id": 7, "name": "Foo"} ]})");
+    EXPECT_EQ(registry.getGeneration(), generation + 1);
+    EXPECT_EQ(foo.get().getID(), 7u);
+    EXPECT_EQ(registry.get(foo.get()).name, "Foo");
+    EXPECT_EQ(registry.getByID(1), nullptr);
+}
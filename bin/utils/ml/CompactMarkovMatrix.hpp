@@ -0,0 +1,531 @@
+/**
+ * @file CompactMarkovMatrix.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This header defines a compact alternative to ProbabilityMatrix for first-order
+ *     Markov models. States are interned to dense indices and the transitions are
+ *     stored in compressed sparse row (CSR) form: one contiguous array of successor
+ *     indices and counts, with an offset per state marking where its row begins.
+ *     Each row also stores the running (prefix) sum of its counts, and a Walker/Vose
+ *     alias table built once after training so a successor can be sampled in
+ *     constant time with a single random draw.
+ *
+ *     Compared with nested unordered maps, this removes a heap node per transition,
+ *     which matters most for models with small alphabets such as characters.
+ *
+ *     The same free functions used with ProbabilityMatrix (trainMatrix, hasState,
+ *     getTransitions, getStates, printProbabilityMatrix, clearMatrix) are overloaded
+ *     for CompactMarkovMatrix, so it can be used as the storage of AbstractMarkovModel.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "MarkovModels.hpp"
+
+namespace markov_models
+{
+    /**
+     * A first-order transition matrix stored in CSR form with integer counts.
+     * @tparam T - The type of the states (must be hashable).
+     */
+    template <typename T>
+    class CompactMarkovMatrix
+    {
+    public:
+        /// The dense index of a state.
+        using Index = std::uint32_t;
+
+        /// Returned by find() for states which are not in the matrix.
+        static constexpr Index NO_STATE = std::numeric_limits<Index>::max();
+
+        /// Constructs an empty matrix.
+        CompactMarkovMatrix() = default;
+
+        /**
+         * Constructs a matrix by counting the transitions in a list of sequences.
+         * @param sequences[const std::vector<std::vector<T>>&] - The sequences to count.
+         */
+        explicit CompactMarkovMatrix(const std::vector<std::vector<T>>& sequences)
+        { train(sequences); }
+
+        /**
+         * Replaces the contents of the matrix with the transitions counted in a list of sequences.
+         * @param sequences[const std::vector<std::vector<T>>&] - The sequences to count.
+         */
+        void train(const std::vector<std::vector<T>>& sequences)
+        {
+            clear();
+            addCounts(countTransitions<T>(sequences));
+        }
+
+        /**
+         * Adds transition counts to the matrix and rebuilds the rows, without recounting
+         * the sequences the matrix was trained on.
+         * @param newCounts[const TransitionCounts<T>&] - The counts to add.
+         */
+        void addCounts(const TransitionCounts<T>& newCounts)
+        {
+            std::unordered_map<std::uint64_t, std::uint64_t> pairCounts;
+            pairCounts.reserve(columns.size());
+            for (Index row = 0; row + 1 < rowOffsets.size(); ++row)
+            {
+                for (Index i = rowBegin(row); i < rowEnd(row); ++i)
+                    pairCounts[pairKey(row, columns[i])] = counts[i];
+            }
+            for (const auto& [input, outputs] : newCounts)
+            {
+                Index from = intern(input);
+                for (const auto& [output, count] : outputs)
+                    pairCounts[pairKey(from, intern(output))] += count;
+            }
+            build(pairCounts);
+        }
+
+        /**
+         * Returns the index of a state.
+         * @param state[const T&] - The state.
+         * @return [Index] - The index, or NO_STATE if the state has never been seen.
+         */
+        Index find(const T& state) const
+        {
+            auto it = indices.find(state);
+            return it != indices.end() ? it->second : NO_STATE;
+        }
+
+        /**
+         * Returns the state with an index.
+         * @param index[Index] - The index (less than getStateCount()).
+         * @return [const T&] - The state.
+         */
+        const T& getState(Index index) const
+        { return states[index]; }
+
+        /// Returns the number of interned states, including those with no successors.
+        std::size_t getStateCount() const
+        { return states.size(); }
+
+        /// Returns the number of distinct transitions.
+        std::size_t getTransitionCount() const
+        { return columns.size(); }
+
+        /// Returns the first entry of a state's row in getColumns() and getCounts().
+        Index rowBegin(Index index) const
+        { return rowOffsets[index]; }
+
+        /// Returns one past the last entry of a state's row in getColumns() and getCounts().
+        Index rowEnd(Index index) const
+        { return rowOffsets[index + 1]; }
+
+        /// Returns the successor index of every transition, row by row.
+        const std::vector<Index>& getColumns() const
+        { return columns; }
+
+        /// Returns the count of every transition, row by row.
+        const std::vector<std::uint32_t>& getCounts() const
+        { return counts; }
+
+        /// Returns the running sum of the counts within each row.
+        const std::vector<std::uint64_t>& getCumulativeCounts() const
+        { return cumulative; }
+
+        /// Returns every interned state in order of its index.
+        const std::vector<T>& getStateTable() const
+        { return states; }
+
+        /// Returns where each row begins in getColumns() (with one extra entry marking the end).
+        const std::vector<Index>& getRowOffsets() const
+        { return rowOffsets; }
+
+        /// Returns the chance of keeping each entry's own column when sampling (alias table).
+        const std::vector<float>& getAliasProbabilities() const
+        { return aliasProbabilities; }
+
+        /// Returns the successor used instead of each entry's column otherwise (alias table).
+        const std::vector<Index>& getAliases() const
+        { return aliases; }
+
+        /**
+         * Returns the total count of the transitions out of a state.
+         * @param index[Index] - The state index.
+         * @return [std::uint64_t] - The sum of the row's counts (0 if it has no successors).
+         */
+        std::uint64_t getRowTotal(Index index) const
+        { return rowEnd(index) > rowBegin(index) ? cumulative[rowEnd(index) - 1] : 0; }
+
+        /**
+         * Checks if a state has any successors (the meaning of hasState() for ProbabilityMatrix).
+         * @param state[const T&] - The state to check.
+         * @return [bool] - True if the state has at least one transition.
+         */
+        bool hasSuccessors(const T& state) const
+        {
+            Index index = find(state);
+            return index != NO_STATE && rowEnd(index) > rowBegin(index);
+        }
+
+        /**
+         * Returns the probability of a transition.
+         * @param from[const T&] - The current state.
+         * @param to[const T&] - The next state.
+         * @return [double] - The probability, or 0 if the transition was never seen.
+         */
+        double getProbability(const T& from, const T& to) const
+        {
+            Index row = find(from), column = find(to);
+            if (row == NO_STATE || column == NO_STATE)
+                return 0.0;
+            auto first = columns.begin() + rowBegin(row), last = columns.begin() + rowEnd(row);
+            auto it = std::lower_bound(first, last, column);
+            if (it == last || *it != column)
+                return 0.0;
+            return static_cast<double>(counts[it - columns.begin()]) / static_cast<double>(getRowTotal(row));
+        }
+
+        /**
+         * Returns the successors of a state and their probabilities.
+         * @param state[const T&] - The current state.
+         * @return [std::vector<std::pair<T, double>>] - The successors (empty if there are none).
+         */
+        std::vector<std::pair<T, double>> getTransitions(const T& state) const
+        {
+            std::vector<std::pair<T, double>> transitions;
+            Index row = find(state);
+            if (row == NO_STATE)
+                return transitions;
+            double total = static_cast<double>(getRowTotal(row));
+            for (Index i = rowBegin(row); i < rowEnd(row); ++i)
+                transitions.emplace_back(states[columns[i]], static_cast<double>(counts[i]) / total);
+            return transitions;
+        }
+
+        /**
+         * Samples a successor of a state from its alias table in constant time.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param index[Index] - The state index, which must have successors.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [Index] - The index of the sampled successor.
+         */
+        template <typename RNG>
+        Index sampleNext(Index index, RNG& rng) const
+        {
+            Index begin = rowBegin(index);
+            double width = static_cast<double>(rowEnd(index) - begin);
+            // One draw picks both the column (integer part) and the coin flip (fraction).
+            double draw = std::uniform_real_distribution<double>(0.0, width)(rng);
+            Index column = std::min(static_cast<Index>(draw), static_cast<Index>(width) - 1);
+            Index entry = begin + column;
+            return draw - column < aliasProbabilities[entry] ? columns[entry] : aliases[entry];
+        }
+
+        /**
+         * Samples a successor of a state in constant time.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param state[const T&] - The current state.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [const T&] - The sampled successor.
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+         */
+        template <typename RNG>
+        const T& sampleNext(const T& state, RNG& rng) const
+        {
+            Index index = find(state);
+            if (index == NO_STATE || rowEnd(index) == rowBegin(index))
+            {
+                throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value,
+                                          "The state has no successors in the probability matrix.");
+            }
+            return states[sampleNext(index, rng)];
+        }
+
+        /**
+         * Returns the approximate number of bytes used by the matrix.
+         * @return [std::size_t] - The memory used by the arrays and the state index.
+         */
+        std::size_t getMemoryUsage() const
+        {
+            return states.capacity() * sizeof(T) + rowOffsets.capacity() * sizeof(Index) +
+                   columns.capacity() * sizeof(Index) + counts.capacity() * sizeof(std::uint32_t) +
+                   cumulative.capacity() * sizeof(std::uint64_t) +
+                   aliasProbabilities.capacity() * sizeof(float) + aliases.capacity() * sizeof(Index) +
+                   indices.size() * (sizeof(T) + sizeof(Index) + 2 * sizeof(void*)) +
+                   indices.bucket_count() * sizeof(void*);
+        }
+
+        /// Removes every state and transition.
+        void clear()
+        {
+            states.clear();
+            indices.clear();
+            rowOffsets.assign(1, 0);
+            columns.clear();
+            counts.clear();
+            cumulative.clear();
+            aliasProbabilities.clear();
+            aliases.clear();
+        }
+
+    private:
+        /// Returns the index of a state, adding it if it is new.
+        Index intern(const T& state)
+        {
+            auto [it, inserted] = indices.try_emplace(state, static_cast<Index>(states.size()));
+            if (inserted)
+                states.push_back(state);
+            return it->second;
+        }
+
+        /// Packs a transition into a key which sorts by row, then by column.
+        static std::uint64_t pairKey(Index from, Index to)
+        { return (static_cast<std::uint64_t>(from) << 32) | to; }
+
+        /// Builds the CSR arrays from the count of each transition (keyed by pairKey()).
+        void build(const std::unordered_map<std::uint64_t, std::uint64_t>& pairCounts)
+        {
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> sorted(pairCounts.begin(), pairCounts.end());
+            std::sort(sorted.begin(), sorted.end());
+
+            rowOffsets.assign(states.size() + 1, 0);
+            columns.clear();
+            counts.clear();
+            columns.reserve(sorted.size());
+            counts.reserve(sorted.size());
+            for (const auto& [key, count] : sorted)
+            {
+                columns.push_back(static_cast<Index>(key & 0xffffffffu));
+                counts.push_back(static_cast<std::uint32_t>(std::min<std::uint64_t>(count, std::numeric_limits<std::uint32_t>::max())));
+                ++rowOffsets[(key >> 32) + 1];
+            }
+            for (std::size_t i = 1; i < rowOffsets.size(); ++i)
+                rowOffsets[i] += rowOffsets[i - 1];
+
+            cumulative.resize(counts.size());
+            for (std::size_t row = 0; row + 1 < rowOffsets.size(); ++row)
+            {
+                std::uint64_t sum = 0;
+                for (Index i = rowOffsets[row]; i < rowOffsets[row + 1]; ++i)
+                    cumulative[i] = sum += counts[i];
+            }
+            buildAliasTables();
+        }
+
+        /**
+         * Builds the alias table of every row with Vose's method. Each entry of a row is
+         * scaled so the row's average is 1, then entries below 1 are topped up from an
+         * entry above 1, which becomes their alias.
+         */
+        void buildAliasTables()
+        {
+            aliasProbabilities.assign(counts.size(), 1.0f);
+            aliases.assign(columns.begin(), columns.end());
+            std::vector<double> scaled;
+            std::vector<Index> small, large;
+            for (std::size_t row = 0; row + 1 < rowOffsets.size(); ++row)
+            {
+                Index begin = rowOffsets[row], end = rowOffsets[row + 1];
+                if (end - begin < 2)
+                    continue;
+                double factor = static_cast<double>(end - begin) / static_cast<double>(cumulative[end - 1]);
+                scaled.resize(end - begin);
+                small.clear();
+                large.clear();
+                for (Index i = 0; i < end - begin; ++i)
+                {
+                    scaled[i] = counts[begin + i] * factor;
+                    (scaled[i] < 1.0 ? small : large).push_back(i);
+                }
+                while (!small.empty() && !large.empty())
+                {
+                    Index less = small.back(), more = large.back();
+                    small.pop_back();
+                    aliasProbabilities[begin + less] = static_cast<float>(scaled[less]);
+                    aliases[begin + less] = columns[begin + more];
+                    scaled[more] -= 1.0 - scaled[less];
+                    if (scaled[more] < 1.0)
+                    {
+                        large.pop_back();
+                        small.push_back(more);
+                    }
+                }
+                // Whatever is left is 1 up to rounding, so it never uses its alias.
+                for (Index i : small)
+                    aliasProbabilities[begin + i] = 1.0f;
+                for (Index i : large)
+                    aliasProbabilities[begin + i] = 1.0f;
+            }
+        }
+
+        /// The states in order of their index.
+        std::vector<T> states;
+        /// The index of each state.
+        std::unordered_map<T, Index> indices;
+        /// Where each state's row begins in columns and counts (one extra entry marks the end).
+        std::vector<Index> rowOffsets{0};
+        /// The successor index of each transition, sorted within each row.
+        std::vector<Index> columns;
+        /// The number of times each transition was seen.
+        std::vector<std::uint32_t> counts;
+        /// The running sum of counts within each row.
+        std::vector<std::uint64_t> cumulative;
+        /// The chance of keeping each entry's own column when it is drawn (alias table).
+        std::vector<float> aliasProbabilities;
+        /// The successor index used instead of each entry's column otherwise (alias table).
+        std::vector<Index> aliases;
+    }; // class CompactMarkovMatrix
+
+
+    /**
+     * Trains a compact matrix from a list of sequences (see CompactMarkovMatrix::train()).
+     * @tparam T - The type of the state.
+     * @param matrix[CompactMarkovMatrix<T>&] - The matrix to replace.
+     * @param sequences[const std::vector<std::vector<T>>&] - The sequences to count.
+     */
+    template <typename T>
+    void trainMatrix(CompactMarkovMatrix<T>& matrix, const std::vector<std::vector<T>>& sequences)
+    {
+        matrix.train(sequences);
+    }
+
+    /**
+     * Adds new transition counts to a compact matrix (see CompactMarkovMatrix::addCounts()).
+     * The matrix keeps its own counts, so the running totals are not used.
+     * @tparam T - The type of the state.
+     * @param matrix[CompactMarkovMatrix<T>&] - The matrix to update.
+     * @param totals[TransitionCounts<T>&] - Unused.
+     * @param counts[const TransitionCounts<T>&] - The new counts.
+     */
+    template <typename T>
+    void updateMatrix(CompactMarkovMatrix<T>& matrix, TransitionCounts<T>& /*totals*/,
+                      const TransitionCounts<T>& counts)
+    {
+        matrix.addCounts(counts);
+    }
+
+    /**
+     * Retrieves the successor probabilities for a given input state.
+     * @tparam T - The type of the state.
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state for which successors are requested.
+     * @return [std::vector<std::pair<T, double>>] - The successors (empty if the state is not found).
+     */
+    template <typename T>
+    std::vector<std::pair<T, double>> getTransitions(const CompactMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.getTransitions(state);
+    }
+
+    /**
+     * Checks if a given state has successors in the matrix.
+     * @tparam T - The type of the state.
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The state to check.
+     * @return [bool] - true if the state has successors, false otherwise.
+     */
+    template <typename T>
+    bool hasState(const CompactMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.hasSuccessors(state);
+    }
+
+    /**
+     * Returns a vector containing all states which have successors.
+     * @tparam T - The type of the state.
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix.
+     * @return [std::vector<T>] - A vector of the states.
+     */
+    template <typename T>
+    std::vector<T> getStates(const CompactMarkovMatrix<T>& matrix)
+    {
+        std::vector<T> states;
+        for (typename CompactMarkovMatrix<T>::Index i = 0; i < matrix.getStateCount(); ++i)
+        {
+            if (matrix.rowEnd(i) > matrix.rowBegin(i))
+                states.push_back(matrix.getState(i));
+        }
+        return states;
+    }
+
+    /**
+     * Samples the next state from a compact matrix in constant time (see CompactMarkovMatrix::sampleNext()).
+     * @tparam T - The type of the state.
+     * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state.
+     * @param rng[RNG&] - The random engine to draw from.
+     * @return [T] - The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+     */
+    template <typename T, typename RNG>
+    T sampleNextState(const CompactMarkovMatrix<T>& matrix, const T& state, RNG& rng)
+    {
+        return matrix.sampleNext(state, rng);
+    }
+
+    /**
+     * Samples the next state using the calling thread's default random engine.
+     * @tparam T - The type of the state.
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state.
+     * @return [T] - The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+     */
+    template <typename T>
+    T sampleNextState(const CompactMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.sampleNext(state, defaultRandomEngine());
+    }
+
+    /**
+     * Prints the transitions for a specific state.
+     * @tparam T - The type of the state.
+     * @param state[const T&] - The state whose transitions are to be printed.
+     * @param transitions[const std::vector<std::pair<T, double>>&] - The successor states and their probabilities.
+     * @param os[std::ostream&] - The output stream to write to (defaults to std::cout).
+     */
+    template <typename T>
+    void printTransition(const T& state,
+                         const std::vector<std::pair<T, double>>& transitions,
+                         std::ostream& os = std::cout)
+    {
+        os << state << " -> { ";
+        for (const auto& [next, prob] : transitions)
+        {
+            os << next << ": " << prob << ", ";
+        }
+        os << "}\n";
+    }
+
+    /**
+     * Prints the entire matrix to the specified output stream.
+     * @tparam T - The type of the state.
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix to print.
+     * @param os[std::ostream&] - The output stream to write to (defaults to std::cout).
+     */
+    template <typename T>
+    void printProbabilityMatrix(const CompactMarkovMatrix<T>& matrix, std::ostream& os = std::cout)
+    {
+        for (const T& state : getStates(matrix))
+        {
+            printTransition(state, matrix.getTransitions(state), os);
+        }
+    }
+
+    /**
+     * Clears all entries from the matrix.
+     * @tparam T - The type of the state.
+     * @param matrix[CompactMarkovMatrix<T>&] - The matrix to clear.
+     */
+    template <typename T>
+    void clearMatrix(CompactMarkovMatrix<T>& matrix)
+    {
+        matrix.clear();
+    }
+} // namespace markov_models
@@ -0,0 +1,154 @@
+/**
+ * @file MarkovModelFile.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This file implements the layout and file mapping of saved Markov models.
+ */
+
+#include <cstdio>
+
+#include "MarkovModelFile.hpp"
+// Used for the IS_LINUX platform check.
+#include "Constants.hpp"
+
+#ifdef IS_LINUX
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    /// Rounds an offset up to the next multiple of 8 bytes.
+    std::size_t align8(std::size_t offset)
+    {
+        return (offset + 7) & ~std::size_t(7);
+    }
+} // anonymous namespace
+
+
+namespace markov_models
+{
+    ModelFileLayout computeModelFileLayout(std::size_t stateSize, std::size_t stateCount, std::size_t transitionCount)
+    {
+        ModelFileLayout layout;
+        std::size_t offset = align8(sizeof(ModelFileHeader));
+        auto section = [&offset](std::size_t& start, std::size_t bytes)
+        {
+            start = offset;
+            offset = align8(offset + bytes);
+        };
+        section(layout.states, stateSize * stateCount);
+        section(layout.sortedStates, stateSize * stateCount);
+        section(layout.sortedIndices, sizeof(std::uint32_t) * stateCount);
+        section(layout.rowOffsets, sizeof(std::uint32_t) * (stateCount + 1));
+        section(layout.columns, sizeof(std::uint32_t) * transitionCount);
+        section(layout.counts, sizeof(std::uint32_t) * transitionCount);
+        section(layout.cumulative, sizeof(std::uint64_t) * transitionCount);
+        section(layout.aliasProbabilities, sizeof(float) * transitionCount);
+        section(layout.aliases, sizeof(std::uint32_t) * transitionCount);
+        layout.total = offset;
+        return layout;
+    }
+
+
+    ModelFileMapping::ModelFileMapping(const std::string& filePath)
+    {
+    #ifdef IS_LINUX
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to open model file: " + filePath);
+        }
+        struct stat fileInfo;
+        if (::fstat(fd, &fileInfo) == 0 && fileInfo.st_size > 0)
+        {
+            std::size_t fileSize = static_cast<std::size_t>(fileInfo.st_size);
+            // A shared read-only mapping lets every process using the model share its pages.
+            void* mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                ::close(fd);
+                bytes = static_cast<const unsigned char*>(mapping);
+                length = fileSize;
+                mapped = true;
+                return;
+            }
+        }
+        ::close(fd);
+    #endif
+
+        // Read the file into 8-byte aligned memory instead.
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(filePath.c_str(), "rb"), &std::fclose);
+        if (!file)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to open model file: " + filePath);
+        }
+        std::fseek(file.get(), 0, SEEK_END);
+        long fileSize = std::ftell(file.get());
+        std::fseek(file.get(), 0, SEEK_SET);
+        if (fileSize < 0)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to read model file: " + filePath);
+        }
+        length = static_cast<std::size_t>(fileSize);
+        copy.resize((length + 7) / 8);
+        if (std::fread(copy.data(), 1, length, file.get()) != length)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to read model file: " + filePath);
+        }
+        bytes = reinterpret_cast<const unsigned char*>(copy.data());
+    }
+
+
+    ModelFileMapping::~ModelFileMapping()
+    {
+    #ifdef IS_LINUX
+        if (mapped)
+            ::munmap(const_cast<unsigned char*>(bytes), length);
+    #endif
+    }
+
+
+    ModelFileLayout ModelFileMapping::validate(std::size_t stateSize) const
+    {
+        if (length < sizeof(ModelFileHeader) ||
+            std::memcmp(header().magic, MODEL_FILE_MAGIC, sizeof(MODEL_FILE_MAGIC)) != 0)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File, "Not a model file.");
+        }
+        if (header().byteOrder != MODEL_FILE_BYTE_ORDER)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File,
+                                      "The model file was written with a different byte order.");
+        }
+        if (header().version != MODEL_FILE_VERSION)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File,
+                                      "Unsupported model file version " + std::to_string(header().version) + ".");
+        }
+        if (header().stateSize != stateSize)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File,
+                                      "The model file holds states of a different type.");
+        }
+        if (header().stateCount >= CompactMarkovMatrix<char>::NO_STATE ||
+            header().transitionCount >= CompactMarkovMatrix<char>::NO_STATE)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File, "The model file is too large.");
+        }
+
+        ModelFileLayout layout = computeModelFileLayout(stateSize, header().stateCount, header().transitionCount);
+        if (length < layout.total)
+        {
+            throw error::MIAException(error::ErrorCode::Invalid_Model_File, "The model file is truncated.");
+        }
+        return layout;
+    }
+} // namespace markov_models
@@ -0,0 +1,578 @@
+/**
+ * @file MarkovModelFile.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     This header defines a versioned binary file format for trained CompactMarkovMatrix
+ *     models, and MappedMarkovMatrix, a read-only matrix which uses such a file in place.
+ *
+ *     The file holds a fixed header followed by the state table, a sorted copy of the
+ *     states for lookups, the CSR rows, the counts and the alias tables, each section
+ *     aligned to 8 bytes. Nothing needs to be decoded or rebuilt on load, so a file can
+ *     be memory mapped and sampled from immediately, and the read-only mapping is shared
+ *     between every process using the same model. Files are written in native byte order;
+ *     loading a file written on a machine of a different byte order is rejected.
+ *
+ *     On load, the header and section sizes are checked, and so is every index (row
+ *     offsets, successor columns, aliases and the sorted state indices), since these are
+ *     used unchecked afterwards. This reads those sections once; the states, counts and
+ *     alias probabilities are not read until they are used.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "CompactMarkovMatrix.hpp"
+#include "MIAException.hpp"
+#include "BasicUtilities.hpp"
+
+namespace markov_models
+{
+    /// The first bytes of every model file.
+    constexpr char MODEL_FILE_MAGIC[8] = {'M', 'I', 'A', 'M', 'A', 'R', 'K', 'V'};
+
+    /// The current version of the model file format.
+    constexpr std::uint32_t MODEL_FILE_VERSION = 1;
+
+    /// Written as a number to detect files of a different byte order.
+    constexpr std::uint32_t MODEL_FILE_BYTE_ORDER = 0x01020304;
+
+    /**
+     * The fixed header at the start of a model file.
+     */
+    struct ModelFileHeader
+    {
+        char magic[8];                      ///< MODEL_FILE_MAGIC.
+        std::uint32_t version;              ///< MODEL_FILE_VERSION.
+        std::uint32_t byteOrder;            ///< MODEL_FILE_BYTE_ORDER in the writer's byte order.
+        std::uint32_t stateSize;            ///< sizeof(T) of the states.
+        std::uint32_t reserved;             ///< Zero.
+        std::uint64_t stateCount;           ///< The number of states.
+        std::uint64_t transitionCount;      ///< The number of transitions.
+    };
+
+    /**
+     * The byte offset of each section of a model file.
+     */
+    struct ModelFileLayout
+    {
+        std::size_t states{0};              ///< The states in index order (T).
+        std::size_t sortedStates{0};        ///< The states in sorted order (T).
+        std::size_t sortedIndices{0};       ///< The index of each sorted state (uint32).
+        std::size_t rowOffsets{0};          ///< The CSR row offsets, stateCount + 1 entries (uint32).
+        std::size_t columns{0};             ///< The successor of each transition (uint32).
+        std::size_t counts{0};              ///< The count of each transition (uint32).
+        std::size_t cumulative{0};          ///< The running count sums within each row (uint64).
+        std::size_t aliasProbabilities{0};  ///< The alias table probabilities (float).
+        std::size_t aliases{0};             ///< The alias table successors (uint32).
+        std::size_t total{0};               ///< The size of the whole file.
+    };
+
+    /**
+     * Computes where each section of a model file begins.
+     * @param stateSize[std::size_t] - sizeof(T) of the states.
+     * @param stateCount[std::size_t] - The number of states.
+     * @param transitionCount[std::size_t] - The number of transitions.
+     * @return [ModelFileLayout] - The section offsets.
+     */
+    ModelFileLayout computeModelFileLayout(std::size_t stateSize, std::size_t stateCount, std::size_t transitionCount);
+
+    /**
+     * @class ModelFileMapping
+     * @brief A read-only view of a whole model file: a shared memory mapping where
+     * available, otherwise a copy read into memory.
+     */
+    class ModelFileMapping
+    {
+    public:
+        /**
+         * Maps (or reads) a file.
+         * @param filePath[const std::string&] - The path of the file.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be opened or read.
+         */
+        explicit ModelFileMapping(const std::string& filePath);
+
+        /// Unmaps the file.
+        ~ModelFileMapping();
+
+        ModelFileMapping(const ModelFileMapping&) = delete;
+        ModelFileMapping& operator=(const ModelFileMapping&) = delete;
+
+        /// Returns the first byte of the file.
+        const unsigned char* data() const
+        { return bytes; }
+
+        /// Returns the size of the file in bytes.
+        std::size_t size() const
+        { return length; }
+
+        /// Returns true if the file is memory mapped rather than copied.
+        bool isMapped() const
+        { return mapped; }
+
+        /**
+         * Checks the header of the file and the size of its sections.
+         * @param stateSize[std::size_t] - sizeof(T) of the expected states.
+         * @return [ModelFileLayout] - The section offsets.
+         * @throws MIAException(Invalid_Model_File) - If the header or size is wrong.
+         */
+        ModelFileLayout validate(std::size_t stateSize) const;
+
+        /// Returns the header (only valid after validate()).
+        const ModelFileHeader& header() const
+        { return *reinterpret_cast<const ModelFileHeader*>(bytes); }
+
+    private:
+        /// The file contents.
+        const unsigned char* bytes{nullptr};
+        /// The file size.
+        std::size_t length{0};
+        /// True if bytes is a memory mapping.
+        bool mapped{false};
+        /// The copy of the file when it is not mapped (8-byte aligned).
+        std::vector<std::uint64_t> copy;
+    }; // class ModelFileMapping
+
+    /**
+     * A read-only first-order transition matrix used in place from a model file.
+     * It offers the same lookups and constant-time sampling as CompactMarkovMatrix, and
+     * copies of it share the same mapping.
+     * @tparam T - The type of the states (trivially copyable and ordered with <).
+     */
+    template <typename T>
+    class MappedMarkovMatrix
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Model files can only hold trivially copyable states.");
+
+    public:
+        /// The dense index of a state.
+        using Index = std::uint32_t;
+
+        /// Returned by find() for states which are not in the matrix.
+        static constexpr Index NO_STATE = std::numeric_limits<Index>::max();
+
+        /// Constructs an empty matrix.
+        MappedMarkovMatrix() = default;
+
+        /**
+         * Opens a model file.
+         * @param filePath[const std::string&] - The path of the file.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         * @throws MIAException(Invalid_Model_File) - If the file is not a valid model of T.
+         */
+        explicit MappedMarkovMatrix(const std::string& filePath)
+        { open(filePath); }
+
+        /**
+         * Replaces the matrix with the contents of a model file.
+         * @param filePath[const std::string&] - The path of the file.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         * @throws MIAException(Invalid_Model_File) - If the file is not a valid model of T.
+         */
+        void open(const std::string& filePath)
+        {
+            auto mapping = std::make_shared<const ModelFileMapping>(filePath);
+            ModelFileLayout layout = mapping->validate(sizeof(T));
+            const unsigned char* base = mapping->data();
+            std::size_t stateTotal = mapping->header().stateCount;
+            std::size_t transitionTotal = mapping->header().transitionCount;
+
+            // Every index read from the file is used unchecked afterwards, so check that the
+            // rows stay inside the transition arrays and every index names a state.
+            const Index* offsets = reinterpret_cast<const Index*>(base + layout.rowOffsets);
+            bool validOffsets = offsets[0] == 0 && offsets[stateTotal] == transitionTotal;
+            for (std::size_t i = 0; validOffsets && i < stateTotal; ++i)
+                validOffsets = offsets[i] <= offsets[i + 1];
+            if (!validOffsets)
+            {
+                throw error::MIAException(error::ErrorCode::Invalid_Model_File,
+                                          "The row offsets of model file " + filePath + " are invalid.");
+            }
+            auto inRange = [stateTotal](const Index* indices, std::size_t count)
+            {
+                return std::all_of(indices, indices + count, [stateTotal](Index index) { return index < stateTotal; });
+            };
+            if (!inRange(reinterpret_cast<const Index*>(base + layout.sortedIndices), stateTotal) ||
+                !inRange(reinterpret_cast<const Index*>(base + layout.columns), transitionTotal) ||
+                !inRange(reinterpret_cast<const Index*>(base + layout.aliases), transitionTotal))
+            {
+                throw error::MIAException(error::ErrorCode::Invalid_Model_File,
+                                          "Model file " + filePath + " refers to states which are not in it.");
+            }
+
+            file = std::move(mapping);
+            stateCount = stateTotal;
+            transitionCount = transitionTotal;
+            states = reinterpret_cast<const T*>(base + layout.states);
+            sortedStates = reinterpret_cast<const T*>(base + layout.sortedStates);
+            sortedIndices = reinterpret_cast<const Index*>(base + layout.sortedIndices);
+            rowOffsets = offsets;
+            columns = reinterpret_cast<const Index*>(base + layout.columns);
+            counts = reinterpret_cast<const std::uint32_t*>(base + layout.counts);
+            cumulative = reinterpret_cast<const std::uint64_t*>(base + layout.cumulative);
+            aliasProbabilities = reinterpret_cast<const float*>(base + layout.aliasProbabilities);
+            aliases = reinterpret_cast<const Index*>(base + layout.aliases);
+        }
+
+        /// Returns true if the matrix is backed by a memory mapping (rather than a copy).
+        bool isMapped() const
+        { return file && file->isMapped(); }
+
+        /**
+         * Returns the index of a state (a binary search of the sorted states).
+         * @param state[const T&] - The state.
+         * @return [Index] - The index, or NO_STATE if the state is not in the matrix.
+         */
+        Index find(const T& state) const
+        {
+            const T* last = sortedStates + stateCount;
+            const T* it = std::lower_bound(sortedStates, last, state);
+            return (it != last && !(state < *it)) ? sortedIndices[it - sortedStates] : NO_STATE;
+        }
+
+        /// Returns the state with an index.
+        const T& getState(Index index) const
+        { return states[index]; }
+
+        /// Returns the number of states.
+        std::size_t getStateCount() const
+        { return stateCount; }
+
+        /// Returns the number of distinct transitions.
+        std::size_t getTransitionCount() const
+        { return transitionCount; }
+
+        /// Returns the first entry of a state's row.
+        Index rowBegin(Index index) const
+        { return rowOffsets[index]; }
+
+        /// Returns one past the last entry of a state's row.
+        Index rowEnd(Index index) const
+        { return rowOffsets[index + 1]; }
+
+        /// Returns the count of a transition entry.
+        std::uint32_t getCount(Index entry) const
+        { return counts[entry]; }
+
+        /// Returns the successor index of a transition entry.
+        Index getColumn(Index entry) const
+        { return columns[entry]; }
+
+        /// Returns the total count of the transitions out of a state.
+        std::uint64_t getRowTotal(Index index) const
+        { return rowEnd(index) > rowBegin(index) ? cumulative[rowEnd(index) - 1] : 0; }
+
+        /// Returns true if a state has at least one transition.
+        bool hasSuccessors(const T& state) const
+        {
+            Index index = find(state);
+            return index != NO_STATE && rowEnd(index) > rowBegin(index);
+        }
+
+        /**
+         * Returns the probability of a transition.
+         * @param from[const T&] - The current state.
+         * @param to[const T&] - The next state.
+         * @return [double] - The probability, or 0 if the transition is not in the matrix.
+         */
+        double getProbability(const T& from, const T& to) const
+        {
+            Index row = find(from), column = find(to);
+            if (row == NO_STATE || column == NO_STATE)
+                return 0.0;
+            const Index* first = columns + rowBegin(row);
+            const Index* last = columns + rowEnd(row);
+            const Index* it = std::lower_bound(first, last, column);
+            if (it == last || *it != column)
+                return 0.0;
+            return static_cast<double>(counts[it - columns]) / static_cast<double>(getRowTotal(row));
+        }
+
+        /**
+         * Returns the successors of a state and their probabilities.
+         * @param state[const T&] - The current state.
+         * @return [std::vector<std::pair<T, double>>] - The successors (empty if there are none).
+         */
+        std::vector<std::pair<T, double>> getTransitions(const T& state) const
+        {
+            std::vector<std::pair<T, double>> transitions;
+            Index row = find(state);
+            if (row == NO_STATE)
+                return transitions;
+            double total = static_cast<double>(getRowTotal(row));
+            for (Index i = rowBegin(row); i < rowEnd(row); ++i)
+                transitions.emplace_back(states[columns[i]], static_cast<double>(counts[i]) / total);
+            return transitions;
+        }
+
+        /**
+         * Samples a successor of a state from its alias table in constant time.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param index[Index] - The state index, which must have successors.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [Index] - The index of the sampled successor.
+         */
+        template <typename RNG>
+        Index sampleNext(Index index, RNG& rng) const
+        {
+            Index begin = rowBegin(index);
+            double width = static_cast<double>(rowEnd(index) - begin);
+            double draw = std::uniform_real_distribution<double>(0.0, width)(rng);
+            Index column = std::min(static_cast<Index>(draw), static_cast<Index>(width) - 1);
+            Index entry = begin + column;
+            return draw - column < aliasProbabilities[entry] ? columns[entry] : aliases[entry];
+        }
+
+        /**
+         * Samples a successor of a state in constant time.
+         * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+         * @param state[const T&] - The current state.
+         * @param rng[RNG&] - The random engine to draw from.
+         * @return [const T&] - The sampled successor.
+         * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+         */
+        template <typename RNG>
+        const T& sampleNext(const T& state, RNG& rng) const
+        {
+            Index index = find(state);
+            if (index == NO_STATE || rowEnd(index) == rowBegin(index))
+            {
+                throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value,
+                                          "The state has no successors in the probability matrix.");
+            }
+            return states[sampleNext(index, rng)];
+        }
+
+        /// Releases the file; the matrix becomes empty.
+        void clear()
+        { *this = MappedMarkovMatrix(); }
+
+    private:
+        /// The file the arrays point into, shared by copies of this matrix.
+        std::shared_ptr<const ModelFileMapping> file;
+        /// The number of states.
+        std::size_t stateCount{0};
+        /// The number of transitions.
+        std::size_t transitionCount{0};
+        /// The sections of the file (see ModelFileLayout).
+        const T* states{nullptr};
+        const T* sortedStates{nullptr};
+        const Index* sortedIndices{nullptr};
+        const Index* rowOffsets{nullptr};
+        const Index* columns{nullptr};
+        const std::uint32_t* counts{nullptr};
+        const std::uint64_t* cumulative{nullptr};
+        const float* aliasProbabilities{nullptr};
+        const Index* aliases{nullptr};
+    }; // class MappedMarkovMatrix
+
+
+    /**
+     * Writes a compact matrix to a model file.
+     * @tparam T - The type of the state (trivially copyable and ordered with <).
+     * @param matrix[const CompactMarkovMatrix<T>&] - The matrix to save.
+     * @param filePath[const std::string&] - The path of the file to write. An existing file is
+     *        replaced atomically, so matrices which have it open keep reading the old model.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be written.
+     */
+    template <typename T>
+    void saveMatrix(const CompactMarkovMatrix<T>& matrix, const std::string& filePath)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Model files can only hold trivially copyable states.");
+        using Index = typename CompactMarkovMatrix<T>::Index;
+
+        const std::vector<T>& states = matrix.getStateTable();
+        std::vector<Index> sortedIndices(states.size());
+        std::iota(sortedIndices.begin(), sortedIndices.end(), Index(0));
+        std::sort(sortedIndices.begin(), sortedIndices.end(),
+                  [&states](Index a, Index b) { return states[a] < states[b]; });
+        std::vector<T> sortedStates;
+        sortedStates.reserve(states.size());
+        for (Index index : sortedIndices)
+            sortedStates.push_back(states[index]);
+
+        ModelFileHeader header{};
+        std::memcpy(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic));
+        header.version = MODEL_FILE_VERSION;
+        header.byteOrder = MODEL_FILE_BYTE_ORDER;
+        header.stateSize = sizeof(T);
+        header.stateCount = states.size();
+        header.transitionCount = matrix.getTransitionCount();
+        ModelFileLayout layout = computeModelFileLayout(sizeof(T), header.stateCount, header.transitionCount);
+
+        // Write a temporary file and rename it over the target, so processes which have the
+        // old file mapped keep their pages instead of seeing it truncated under them.
+        bool written = BasicUtilities::replaceFile(filePath, [&](std::ofstream& out)
+        {
+            auto writeAt = [&out](std::size_t offset, const void* data, std::size_t size)
+            {
+                static const char padding[8] = {};
+                std::size_t position = static_cast<std::size_t>(out.tellp());
+                out.write(padding, static_cast<std::streamsize>(offset - position));
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+            writeAt(0, &header, sizeof(header));
+            writeAt(layout.states, states.data(), states.size() * sizeof(T));
+            writeAt(layout.sortedStates, sortedStates.data(), sortedStates.size() * sizeof(T));
+            writeAt(layout.sortedIndices, sortedIndices.data(), sortedIndices.size() * sizeof(Index));
+            writeAt(layout.rowOffsets, matrix.getRowOffsets().data(), (states.size() + 1) * sizeof(Index));
+            writeAt(layout.columns, matrix.getColumns().data(), matrix.getColumns().size() * sizeof(Index));
+            writeAt(layout.counts, matrix.getCounts().data(), matrix.getCounts().size() * sizeof(std::uint32_t));
+            writeAt(layout.cumulative, matrix.getCumulativeCounts().data(),
+                    matrix.getCumulativeCounts().size() * sizeof(std::uint64_t));
+            writeAt(layout.aliasProbabilities, matrix.getAliasProbabilities().data(),
+                    matrix.getAliasProbabilities().size() * sizeof(float));
+            writeAt(layout.aliases, matrix.getAliases().data(), matrix.getAliases().size() * sizeof(Index));
+            writeAt(layout.total, nullptr, 0);
+        });
+        if (!written)
+        {
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File,
+                                      "Failed to write model file: " + filePath);
+        }
+    }
+
+    /**
+     * Opens a model file in place (see MappedMarkovMatrix::open()).
+     * @tparam T - The type of the state.
+     * @param matrix[MappedMarkovMatrix<T>&] - The matrix to replace.
+     * @param filePath[const std::string&] - The path of the file.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+     * @throws MIAException(Invalid_Model_File) - If the file is not a valid model of T.
+     */
+    template <typename T>
+    void loadMatrix(MappedMarkovMatrix<T>& matrix, const std::string& filePath)
+    {
+        matrix.open(filePath);
+    }
+
+    /**
+     * Loads a model file into a compact matrix, which can then be updated with new counts.
+     * @tparam T - The type of the state.
+     * @param matrix[CompactMarkovMatrix<T>&] - The matrix to replace.
+     * @param filePath[const std::string&] - The path of the file.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+     * @throws MIAException(Invalid_Model_File) - If the file is not a valid model of T.
+     */
+    template <typename T>
+    void loadMatrix(CompactMarkovMatrix<T>& matrix, const std::string& filePath)
+    {
+        MappedMarkovMatrix<T> mapped(filePath);
+        TransitionCounts<T> counts;
+        for (typename MappedMarkovMatrix<T>::Index row = 0; row < mapped.getStateCount(); ++row)
+        {
+            for (auto i = mapped.rowBegin(row); i < mapped.rowEnd(row); ++i)
+                counts[mapped.getState(row)][mapped.getState(mapped.getColumn(i))] = mapped.getCount(i);
+        }
+        matrix.clear();
+        matrix.addCounts(counts);
+    }
+
+    /**
+     * Retrieves the successor probabilities for a given input state.
+     * @tparam T - The type of the state.
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state for which successors are requested.
+     * @return [std::vector<std::pair<T, double>>] - The successors (empty if the state is not found).
+     */
+    template <typename T>
+    std::vector<std::pair<T, double>> getTransitions(const MappedMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.getTransitions(state);
+    }
+
+    /**
+     * Checks if a given state has successors in the matrix.
+     * @tparam T - The type of the state.
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The state to check.
+     * @return [bool] - true if the state has successors, false otherwise.
+     */
+    template <typename T>
+    bool hasState(const MappedMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.hasSuccessors(state);
+    }
+
+    /**
+     * Returns a vector containing all states which have successors.
+     * @tparam T - The type of the state.
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix.
+     * @return [std::vector<T>] - A vector of the states.
+     */
+    template <typename T>
+    std::vector<T> getStates(const MappedMarkovMatrix<T>& matrix)
+    {
+        std::vector<T> states;
+        for (typename MappedMarkovMatrix<T>::Index i = 0; i < matrix.getStateCount(); ++i)
+        {
+            if (matrix.rowEnd(i) > matrix.rowBegin(i))
+                states.push_back(matrix.getState(i));
+        }
+        return states;
+    }
+
+    /**
+     * Samples the next state from a mapped matrix in constant time.
+     * @tparam T - The type of the state.
+     * @tparam RNG - A uniform random bit generator (e.g., std::mt19937_64).
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state.
+     * @param rng[RNG&] - The random engine to draw from.
+     * @return [T] - The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+     */
+    template <typename T, typename RNG>
+    T sampleNextState(const MappedMarkovMatrix<T>& matrix, const T& state, RNG& rng)
+    {
+        return matrix.sampleNext(state, rng);
+    }
+
+    /**
+     * Samples the next state using the calling thread's default random engine.
+     * @tparam T - The type of the state.
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix.
+     * @param state[const T&] - The current state.
+     * @return [T] - The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+     */
+    template <typename T>
+    T sampleNextState(const MappedMarkovMatrix<T>& matrix, const T& state)
+    {
+        return matrix.sampleNext(state, defaultRandomEngine());
+    }
+
+    /**
+     * Prints the entire matrix to the specified output stream.
+     * @tparam T - The type of the state.
+     * @param matrix[const MappedMarkovMatrix<T>&] - The matrix to print.
+     * @param os[std::ostream&] - The output stream to write to (defaults to std::cout).
+     */
+    template <typename T>
+    void printProbabilityMatrix(const MappedMarkovMatrix<T>& matrix, std::ostream& os = std::cout)
+    {
+        for (const T& state : getStates(matrix))
+        {
+            printTransition(state, matrix.getTransitions(state), os);
+        }
+    }
+
+    /**
+     * Releases the file of a mapped matrix.
+     * @tparam T - The type of the state.
+     * @param matrix[MappedMarkovMatrix<T>&] - The matrix to clear.
+     */
+    template <typename T>
+    void clearMatrix(MappedMarkovMatrix<T>& matrix)
+    {
+        matrix.clear();
+    }
+} // namespace markov_models
@@ -18,9 +18,17 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 #include <iostream>
+#include <random>
+
+// Used for throwing errors when sampling a state with no successors.
+#include "MIAException.hpp"
+// Used to count transitions in parallel.
+#include "TaskScheduler.hpp"
 
 
 namespace markov_models
@@ -35,50 +43,198 @@ namespace markov_models
 
 
     /**
-     * Generates a probability transition matrix from a list of input sequences.
-     * 
-     * Each sequence is a vector of elements of type T. The function counts transitions
-     * from each element to its successor in the sequence, and then normalizes the counts
-     * to obtain transition probabilities.
-     *
-     * @tparam T - The type of elements in the sequences (e.g., char, std::string, etc.)
-     * @param sequences[const std::vector<std::vector<T>>&] - A vector of sequences, where 
-     *     each sequence is a vector of type T.
-     * @return [ProbabilityMatrix] - A probability matrix representing transition probabilities 
-     *     between states.
+     * Type alias for raw transition counts.
+     * TransitionCounts<T> maps a state of type T to a map of successor states and the
+     * number of times each transition was seen.
      */
     template <typename T>
-    ProbabilityMatrix<T> generateProbabilityMatrix(const std::vector<std::vector<T>>& sequences) 
+    using TransitionCounts = std::unordered_map<T, std::unordered_map<T, std::uint64_t>>;
+
+    /// The default number of transitions counted by each parallel work unit.
+    constexpr std::size_t DEFAULT_COUNT_CHUNK = std::size_t(1) << 16;
+
+    /**
+     * Counts the transitions which start at positions [begin, end) of one sequence.
+     * @tparam T - The type of the state.
+     * @tparam Sequence - Any indexable sequence whose elements convert to T (e.g., std::string for char).
+     * @param counts[TransitionCounts<T>&] - The counts to add to.
+     * @param sequence[const Sequence&] - The sequence.
+     * @param begin[std::size_t] - The first position.
+     * @param end[std::size_t] - One past the last position (clamped to the last transition).
+     */
+    template <typename T, typename Sequence>
+    void countTransitions(TransitionCounts<T>& counts, const Sequence& sequence, std::size_t begin, std::size_t end)
     {
-        std::unordered_map<T, std::unordered_map<T, int>> countMatrix;
+        end = std::min<std::size_t>(end, sequence.size() > 0 ? sequence.size() - 1 : 0);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            counts[static_cast<T>(sequence[i])][static_cast<T>(sequence[i + 1])]++;
+        }
+    }
 
-        // Count occurrences for each type in all sequences.
-        for (const auto& seq : sequences) 
+    /**
+     * Adds one set of transition counts into another.
+     * @tparam T - The type of the state.
+     * @param into[TransitionCounts<T>&] - The counts to add to.
+     * @param from[const TransitionCounts<T>&] - The counts to add.
+     */
+    template <typename T>
+    void mergeCounts(TransitionCounts<T>& into, const TransitionCounts<T>& from)
+    {
+        for (const auto& [input, outputs] : from)
         {
-            for (size_t i=0; i+1<seq.size(); ++i) 
+            auto& row = into[input];
+            for (const auto& [output, count] : outputs)
             {
-                countMatrix[seq[i]][seq[i + 1]]++;
+                row[output] += count;
             }
         }
+    }
 
-        // Normalize occurrences to probabilities.
-        ProbabilityMatrix<T> probMatrix;
-        for (const auto& [input, outputs] : countMatrix) 
+    /**
+     * Counts every transition in a list of sequences using all cores of the shared TaskScheduler.
+     *
+     * The sequences are read in place and split into chunks of up to chunkSize transitions
+     * (a long sequence is split into several chunks). Each shard counts a contiguous run of
+     * chunks into its own map, then the shards are merged pairwise in parallel (a tree reduction).
+     * @tparam T - The type of the state.
+     * @tparam Sequences - A container of indexable sequences (e.g., std::vector<std::string> for char).
+     * @param sequences[const Sequences&] - The sequences to count.
+     * @param chunkSize[std::size_t] - The most transitions per work unit.
+     * @return [TransitionCounts<T>] - The counts.
+     */
+    template <typename T, typename Sequences>
+    TransitionCounts<T> countTransitions(const Sequences& sequences, std::size_t chunkSize = DEFAULT_COUNT_CHUNK)
+    {
+        struct Chunk
+        {
+            std::size_t sequence;
+            std::size_t begin;
+            std::size_t end;
+        };
+        chunkSize = std::max<std::size_t>(chunkSize, 1);
+        std::vector<Chunk> chunks;
+        for (std::size_t s = 0; s < sequences.size(); ++s)
+        {
+            std::size_t transitions = sequences[s].size() > 0 ? sequences[s].size() - 1 : 0;
+            for (std::size_t begin = 0; begin < transitions; begin += chunkSize)
+                chunks.push_back({s, begin, std::min(transitions, begin + chunkSize)});
+        }
+
+        threading::TaskScheduler& scheduler = threading::TaskScheduler::getShared();
+        std::size_t shardCount = std::min(chunks.size(), scheduler.getThreadCount() + 1);
+        if (shardCount <= 1)
+        {
+            TransitionCounts<T> counts;
+            for (const Chunk& chunk : chunks)
+                countTransitions(counts, sequences[chunk.sequence], chunk.begin, chunk.end);
+            return counts;
+        }
+
+        std::vector<TransitionCounts<T>> shards(shardCount);
+        scheduler.parallelFor(0, shardCount, [&](std::size_t shard)
+        {
+            std::size_t first = shard * chunks.size() / shardCount;
+            std::size_t last = (shard + 1) * chunks.size() / shardCount;
+            for (std::size_t c = first; c < last; ++c)
+                countTransitions(shards[shard], sequences[chunks[c].sequence], chunks[c].begin, chunks[c].end);
+        }, 1);
+
+        for (std::size_t step = 1; step < shardCount; step *= 2)
+        {
+            std::size_t pairs = (shardCount + 2 * step - 1) / (2 * step);
+            scheduler.parallelFor(0, pairs, [&](std::size_t pair)
+            {
+                std::size_t into = pair * 2 * step;
+                if (into + step < shardCount)
+                {
+                    mergeCounts(shards[into], shards[into + step]);
+                    TransitionCounts<T>().swap(shards[into + step]);
+                }
+            }, 1);
+        }
+        return std::move(shards[0]);
+    }
+
+    /**
+     * Normalizes the counts of the given rows into a probability matrix.
+     * @tparam T - The type of the state.
+     * @param matrix[ProbabilityMatrix<T>&] - The matrix whose rows are replaced.
+     * @param counts[const TransitionCounts<T>&] - The counts of every row.
+     * @param rows[const TransitionCounts<T>&] - The rows to normalize (only the keys are used).
+     */
+    template <typename T>
+    void normalizeRows(ProbabilityMatrix<T>& matrix, const TransitionCounts<T>& counts, const TransitionCounts<T>& rows)
+    {
+        for (const auto& [input, _] : rows)
         {
-            int total = 0;
-            for (const auto& [_, count] : outputs) 
+            const auto& outputs = counts.at(input);
+            std::uint64_t total = 0;
+            for (const auto& [__, count] : outputs) 
             {
                 total += count;
             }
+            auto& row = matrix[input];
+            row.clear();
             for (const auto& [output, count] : outputs) 
             {
-                probMatrix[input][output] = static_cast<double>(count) / total;
+                row[output] = static_cast<double>(count) / total;
             }
         }
+    }
 
+    /**
+     * Generates a probability transition matrix from a list of input sequences.
+     * 
+     * Each sequence is a vector of elements of type T. The function counts transitions
+     * from each element to its successor in the sequence (in parallel, see countTransitions()),
+     * and then normalizes the counts to obtain transition probabilities.
+     *
+     * @tparam T - The type of elements in the sequences (e.g., char, std::string, etc.)
+     * @param sequences[const std::vector<std::vector<T>>&] - A vector of sequences, where 
+     *     each sequence is a vector of type T.
+     * @return [ProbabilityMatrix] - A probability matrix representing transition probabilities 
+     *     between states.
+     */
+    template <typename T>
+    ProbabilityMatrix<T> generateProbabilityMatrix(const std::vector<std::vector<T>>& sequences) 
+    {
+        TransitionCounts<T> counts = countTransitions<T>(sequences);
+        ProbabilityMatrix<T> probMatrix;
+        normalizeRows(probMatrix, counts, counts);
         return probMatrix;
     }
 
+    /**
+     * Replaces the contents of a probability matrix with one generated from a list of
+     * input sequences (see generateProbabilityMatrix()). Overloaded for each matrix type
+     * so that models can train any of them in the same way.
+     * @tparam T - The type of elements in the sequences.
+     * @param matrix[ProbabilityMatrix<T>&] - The matrix to replace.
+     * @param sequences[const std::vector<std::vector<T>>&] - A vector of sequences.
+     */
+    template <typename T>
+    void trainMatrix(ProbabilityMatrix<T>& matrix, const std::vector<std::vector<T>>& sequences)
+    {
+        matrix = generateProbabilityMatrix(sequences);
+    }
+
+    /**
+     * Adds new transition counts to a probability matrix. A ProbabilityMatrix only holds
+     * probabilities, so the running counts are kept alongside it and only the rows which
+     * received new counts are renormalized. Overloaded for each matrix type.
+     * @tparam T - The type of the state.
+     * @param matrix[ProbabilityMatrix<T>&] - The matrix to update.
+     * @param totals[TransitionCounts<T>&] - The counts the matrix was built from (updated).
+     * @param counts[const TransitionCounts<T>&] - The new counts.
+     */
+    template <typename T>
+    void updateMatrix(ProbabilityMatrix<T>& matrix, TransitionCounts<T>& totals, const TransitionCounts<T>& counts)
+    {
+        mergeCounts(totals, counts);
+        normalizeRows(matrix, totals, counts);
+    }
+
     /**
      * Retrieves the successor probabilities for a given input state.
      * @tparam T - The type of the state.
@@ -132,20 +288,66 @@ namespace markov_models
         return states;
     }
 
+    /**
+     * Returns the random engine used when no engine is passed to a sampling function.
+     * Each thread has its own engine, seeded from std::random_device.
+     * @return [std::mt19937_64&] - The calling thread's engine.
+     */
+    inline std::mt19937_64& defaultRandomEngine()
+    {
+        thread_local std::mt19937_64 engine(std::random_device{}());
+        return engine;
+    }
+
     /**
      * Samples the next state from the probability distribution of a given state.
      * Uses a random number generator to select a successor state weighted by
-     * the transition probabilities.
+     * the transition probabilities. This walks the successors of the state, so it
+     * is linear in their number; CompactMarkovMatrix samples in constant time.
      * 
      * @tparam T The type of the state.
+     * @tparam RNG A uniform random bit generator (e.g., std::mt19937_64).
+     * @param matrix[const ProbabilityMatrix<T>&] - The probability matrix.
+     * @param state[const T&] - The current state from which to sample the next state.
+     * @param rng[RNG&] - The random engine to draw from.
+     * @return The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
+     */
+    template <typename T, typename RNG>
+    T sampleNextState(const ProbabilityMatrix<T>& matrix, const T& state, RNG& rng) 
+    {
+        auto it = matrix.find(state);
+        if (it == matrix.end() || it->second.empty())
+        {
+            throw error::MIAException(error::ErrorCode::Cannot_Find_Mapped_Value,
+                                      "The state has no successors in the probability matrix.");
+        }
+
+        double target = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        const T* last = nullptr;
+        for (const auto& [next, probability] : it->second)
+        {
+            last = &next;
+            target -= probability;
+            if (target < 0.0)
+                return next;
+        }
+        // Only reached when rounding leaves the probabilities summing to just under 1.
+        return *last;
+    }
+
+    /**
+     * Samples the next state using the calling thread's default random engine.
+     * @tparam T The type of the state.
      * @param matrix[const ProbabilityMatrix<T>&] - The probability matrix.
      * @param state[const T&] - The current state from which to sample the next state.
      * @return The sampled next state.
+     * @throws MIAException(Cannot_Find_Mapped_Value) - If the state has no successors.
      */
     template <typename T>
     T sampleNextState(const ProbabilityMatrix<T>& matrix, const T& state) 
     {
-        // TODO - implement this.
+        return sampleNextState(matrix, state, defaultRandomEngine());
     }
 
     /**
@@ -0,0 +1,135 @@
+/**
+ * @file CompactMarkovMatrix_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: 
+ *     This file is for testing the CSR-based CompactMarkovMatrix.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include "CompactMarkovMatrix.hpp"
+
+using namespace markov_models;
+
+// Test data setup
+const std::vector<std::vector<char>> charSequences = {
+    {'a', 'b', 'a', 'c'},
+    {'a', 'b', 'b'},
+    {'b', 'a'}
+};
+
+TEST(CompactMarkovMatrixTest, MatchesProbabilityMatrix) 
+{
+    CompactMarkovMatrix<char> compact(charSequences);
+    auto matrix = generateProbabilityMatrix(charSequences);
+
+    for (const auto& [from, successors] : matrix)
+    {
+        for (const auto& [to, probability] : successors)
+            EXPECT_NEAR(compact.getProbability(from, to), probability, 1e-12);
+        EXPECT_EQ(compact.getTransitions(from).size(), successors.size());
+    }
+    EXPECT_EQ(compact.getProbability('c', 'a'), 0.0);
+    EXPECT_EQ(compact.getProbability('z', 'a'), 0.0);
+}
+
+TEST(CompactMarkovMatrixTest, RowsAreContiguous) 
+{
+    CompactMarkovMatrix<char> compact(charSequences);
+    ASSERT_EQ(compact.getStateCount(), 3u);
+    // a->b (2), a->c (1), b->a (2), b->b (1).
+    ASSERT_EQ(compact.getTransitionCount(), 4u);
+
+    auto a = compact.find('a');
+    ASSERT_NE(a, CompactMarkovMatrix<char>::NO_STATE);
+    EXPECT_EQ(compact.rowEnd(a) - compact.rowBegin(a), 2u);
+    EXPECT_EQ(compact.getRowTotal(a), 3u);
+
+    // The cumulative counts end each row with the row total.
+    const auto& counts = compact.getCounts();
+    const auto& cumulative = compact.getCumulativeCounts();
+    for (std::uint32_t row = 0; row < compact.getStateCount(); ++row)
+    {
+        std::uint64_t sum = 0;
+        for (auto i = compact.rowBegin(row); i < compact.rowEnd(row); ++i)
+        {
+            sum += counts[i];
+            EXPECT_EQ(cumulative[i], sum);
+            if (i > compact.rowBegin(row))
+            {
+                EXPECT_LT(compact.getColumns()[i - 1], compact.getColumns()[i]);
+            }
+        }
+    }
+}
+
+TEST(CompactMarkovMatrixTest, StatesWithoutSuccessors) 
+{
+    CompactMarkovMatrix<char> compact(charSequences);
+    // 'c' is interned but only ever ends a sequence.
+    EXPECT_NE(compact.find('c'), CompactMarkovMatrix<char>::NO_STATE);
+    EXPECT_FALSE(hasState(compact, 'c'));
+    EXPECT_TRUE(hasState(compact, 'a'));
+    EXPECT_TRUE(getTransitions(compact, 'c').empty());
+    EXPECT_EQ(getStates(compact).size(), 2u);
+}
+
+TEST(CompactMarkovMatrixTest, UsesLessMemoryThanNestedMaps) 
+{
+    std::vector<std::vector<char>> text(1);
+    const std::string words = "the quick brown fox jumps over the lazy dog and keeps running ";
+    for (int i = 0; i < 200; ++i)
+        text[0].insert(text[0].end(), words.begin(), words.end());
+
+    CompactMarkovMatrix<char> compact(text);
+    auto matrix = generateProbabilityMatrix(text);
+
+    // Each nested map entry is at least a heap node holding a pointer and a key/value pair,
+    // and each map has its bucket array (allocator overhead is not counted).
+    std::size_t nested = 0;
+    for (const auto& [state, successors] : matrix)
+        nested += successors.size() * (sizeof(void*) + sizeof(std::pair<const char, double>)) +
+                  successors.bucket_count() * sizeof(void*) + sizeof(successors);
+    EXPECT_LT(compact.getMemoryUsage(), nested);
+}
+
+TEST(CompactMarkovMatrixTest, PrintAndClear) 
+{
+    CompactMarkovMatrix<char> compact;
+    trainMatrix(compact, charSequences);
+
+    std::ostringstream out;
+    printProbabilityMatrix(compact, out);
+    EXPECT_NE(out.str().find("a -> { "), std::string::npos);
+
+    clearMatrix(compact);
+    EXPECT_EQ(compact.getStateCount(), 0u);
+    EXPECT_EQ(compact.getTransitionCount(), 0u);
+    EXPECT_FALSE(hasState(compact, 'a'));
+}
+
+TEST(CompactMarkovMatrixTest, AliasSamplingFollowsCounts) 
+{
+    // Uneven weights: x -> a (1), x -> b (2), x -> c (3), x -> d (4).
+    std::vector<std::vector<char>> sequences = {{'x', 'a'}};
+    for (int i = 0; i < 2; ++i) sequences.push_back({'x', 'b'});
+    for (int i = 0; i < 3; ++i) sequences.push_back({'x', 'c'});
+    for (int i = 0; i < 4; ++i) sequences.push_back({'x', 'd'});
+    CompactMarkovMatrix<char> compact(sequences);
+
+    std::mt19937_64 rng(7);
+    std::map<char, int> seen;
+    const int draws = 100000;
+    for (int i = 0; i < draws; ++i)
+        ++seen[sampleNextState(compact, 'x', rng)];
+    for (const auto& [next, probability] : compact.getTransitions('x'))
+        EXPECT_NEAR(seen[next] / static_cast<double>(draws), probability, 0.01);
+    EXPECT_EQ(seen.size(), 4u);
+
+    EXPECT_THROW(sampleNextState(compact, 'a', rng), error::MIAException);
+    EXPECT_THROW(sampleNextState(compact, 'z', rng), error::MIAException);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file MarkovModelFile_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: 
+ *     This file is for testing saving Markov models and using them from mapped files.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include "MarkovModelFile.hpp"
+
+using namespace markov_models;
+
+namespace
+{
+    /// Returns a path in the temporary directory.
+    std::string tempPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    /// Builds a matrix over random integer sequences.
+    CompactMarkovMatrix<int> randomMatrix()
+    {
+        std::mt19937_64 rng(3);
+        std::uniform_int_distribution<int> state(-50, 50);
+        std::vector<std::vector<int>> sequences(200, std::vector<int>(40));
+        for (auto& sequence : sequences)
+            for (int& value : sequence)
+                value = state(rng);
+        return CompactMarkovMatrix<int>(sequences);
+    }
+} // anonymous namespace
+
+TEST(MarkovModelFileTest, RoundTripsInPlace) 
+{
+    CompactMarkovMatrix<int> compact = randomMatrix();
+    std::string path = tempPath("MarkovModelFile_T_roundtrip.mkv");
+    saveMatrix(compact, path);
+
+    MappedMarkovMatrix<int> mapped(path);
+#ifdef __linux__
+    EXPECT_TRUE(mapped.isMapped());
+#endif
+    ASSERT_EQ(mapped.getStateCount(), compact.getStateCount());
+    ASSERT_EQ(mapped.getTransitionCount(), compact.getTransitionCount());
+    for (int from = -51; from <= 51; ++from)
+    {
+        EXPECT_EQ(mapped.find(from), compact.find(from));
+        EXPECT_EQ(hasState(mapped, from), hasState(compact, from));
+        for (int to = -50; to <= 50; to += 7)
+            EXPECT_EQ(mapped.getProbability(from, to), compact.getProbability(from, to));
+    }
+
+    // The alias tables are stored too, so the same engine gives the same samples.
+    std::mt19937_64 a(9), b(9);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(sampleNextState(mapped, i % 101 - 50, a), sampleNextState(compact, i % 101 - 50, b));
+
+    // Copies share the mapping and remain valid after the original is cleared.
+    MappedMarkovMatrix<int> copy = mapped;
+    clearMatrix(mapped);
+    EXPECT_EQ(mapped.getStateCount(), 0u);
+    EXPECT_EQ(copy.getStateCount(), compact.getStateCount());
+    std::filesystem::remove(path);
+}
+
+TEST(MarkovModelFileTest, LoadsIntoCompactMatrix) 
+{
+    CompactMarkovMatrix<int> compact = randomMatrix();
+    std::string path = tempPath("MarkovModelFile_T_load.mkv");
+    saveMatrix(compact, path);
+
+    CompactMarkovMatrix<int> loaded;
+    loadMatrix(loaded, path);
+    EXPECT_EQ(loaded.getTransitionCount(), compact.getTransitionCount());
+    for (int from = -50; from <= 50; ++from)
+        for (int to = -50; to <= 50; to += 3)
+            EXPECT_NEAR(loaded.getProbability(from, to), compact.getProbability(from, to), 1e-12);
+    std::filesystem::remove(path);
+}
+
+TEST(MarkovModelFileTest, SavingReplacesOpenFiles) 
+{
+    std::string path = tempPath("MarkovModelFile_T_replace.mkv");
+    saveMatrix(CompactMarkovMatrix<char>({{'a', 'b', 'a'}}), path);
+    MappedMarkovMatrix<char> open(path);
+
+    // Saving over a file which is in use leaves the open matrix reading the old model.
+    saveMatrix(CompactMarkovMatrix<char>({{'x', 'y', 'z', 'x'}}), path);
+    EXPECT_EQ(open.getStateCount(), 2u);
+    EXPECT_EQ(open.getProbability('a', 'b'), 1.0);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    MappedMarkovMatrix<char> reopened(path);
+    EXPECT_EQ(reopened.getStateCount(), 3u);
+    EXPECT_EQ(reopened.getProbability('y', 'z'), 1.0);
+    std::filesystem::remove(path);
+}
+
+TEST(MarkovModelFileTest, RejectsInvalidFiles) 
+{
+    EXPECT_THROW(MappedMarkovMatrix<int>(tempPath("MarkovModelFile_T_missing.mkv")), error::MIAException);
+
+    std::string garbage = tempPath("MarkovModelFile_T_garbage.mkv");
+    std::ofstream(garbage, std::ios::binary) << "definitely not a model file, but long enough for a header";
+    try
+    {
+        MappedMarkovMatrix<int> matrix(garbage);
+        FAIL() << "Expected an invalid model file error.";
+    }
+    catch (const error::MIAException& e)
+    {
+        EXPECT_EQ(e.getCode(), error::ErrorCode::Invalid_Model_File);
+    }
+
+    // A model of one state type cannot be opened as another.
+    std::string chars = tempPath("MarkovModelFile_T_chars.mkv");
+    saveMatrix(CompactMarkovMatrix<char>({{'a', 'b', 'a'}}), chars);
+    EXPECT_NO_THROW(MappedMarkovMatrix<char>{chars});
+    EXPECT_THROW(MappedMarkovMatrix<int>{chars}, error::MIAException);
+
+    // A truncated file is rejected.
+    std::filesystem::resize_file(chars, std::filesystem::file_size(chars) - 8);
+    EXPECT_THROW(MappedMarkovMatrix<char>{chars}, error::MIAException);
+
+    std::filesystem::remove(garbage);
+    std::filesystem::remove(chars);
+}
+
+TEST(MarkovModelFileTest, RejectsOutOfRangeIndices) 
+{
+    std::string path = tempPath("MarkovModelFile_T_indices.mkv");
+    CompactMarkovMatrix<char> compact({{'a', 'b', 'c', 'a'}});
+    ModelFileLayout layout = computeModelFileLayout(sizeof(char), compact.getStateCount(),
+                                                    compact.getTransitionCount());
+
+    // Overwrites one index in a freshly saved file and expects opening it to fail.
+    auto expectRejected = [&](std::size_t offset, std::uint32_t value)
+    {
+        saveMatrix(compact, path);
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        try
+        {
+            MappedMarkovMatrix<char> matrix(path);
+            FAIL() << "Expected an invalid model file error for offset " << offset << ".";
+        }
+        catch (const error::MIAException& e)
+        {
+            EXPECT_EQ(e.getCode(), error::ErrorCode::Invalid_Model_File);
+        }
+        CompactMarkovMatrix<char> loaded;
+        EXPECT_THROW(loadMatrix(loaded, path), error::MIAException);
+    };
+    expectRejected(layout.columns, 3);
+    expectRejected(layout.aliases + sizeof(std::uint32_t), 1000);
+    expectRejected(layout.sortedIndices, 7);
+    // Row offsets which decrease.
+    expectRejected(layout.rowOffsets + sizeof(std::uint32_t), 3);
+
+    saveMatrix(compact, path);
+    EXPECT_NO_THROW(MappedMarkovMatrix<char>{path});
+    std::filesystem::remove(path);
+}
@@ -7,6 +7,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
 #include "MarkovModels.hpp"
 
 using namespace markov_models;
@@ -70,3 +72,64 @@ TEST(ClearMatrixTest, EmptiesMatrix)
     EXPECT_TRUE(matrix.empty());
 }
 
+TEST(SampleNextStateTest, FollowsProbabilities) 
+{
+    auto matrix = generateProbabilityMatrix(charSequences);
+    std::mt19937_64 rng(42);
+    // a -> b has probability 2/3 and a -> c has probability 1/3.
+    int b = 0, c = 0;
+    for (int i = 0; i < 30000; ++i)
+    {
+        char next = sampleNextState(matrix, 'a', rng);
+        ASSERT_TRUE(next == 'b' || next == 'c');
+        (next == 'b' ? b : c)++;
+    }
+    EXPECT_NEAR(b / 30000.0, 2.0 / 3.0, 0.02);
+    EXPECT_NEAR(c / 30000.0, 1.0 / 3.0, 0.02);
+}
+
+TEST(SampleNextStateTest, ThrowsWithoutSuccessors) 
+{
+    auto matrix = generateProbabilityMatrix(charSequences);
+    EXPECT_THROW(sampleNextState(matrix, 'c'), error::MIAException);
+    EXPECT_THROW(sampleNextState(matrix, 'z'), error::MIAException);
+}
+
+TEST(CountTransitionsTest, ShardedCountsMatchSerialCounts) 
+{
+    // One long sequence (split across chunks) and many short ones.
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<int> letter('a', 'h');
+    std::vector<std::string> text(1, std::string(50000, ' '));
+    for (char& c : text[0])
+        c = static_cast<char>(letter(rng));
+    for (int i = 0; i < 500; ++i)
+        text.push_back(text[0].substr(i * 7, i % 13));
+
+    TransitionCounts<char> serial;
+    for (const auto& sequence : text)
+        countTransitions<char>(serial, sequence, 0, sequence.size());
+
+    // Small chunks force many shards and reduction steps.
+    TransitionCounts<char> sharded = countTransitions<char>(text, 97);
+    EXPECT_EQ(sharded, serial);
+    EXPECT_EQ(countTransitions<char>(text), serial);
+    EXPECT_TRUE(countTransitions<char>(std::vector<std::string>{"", "a"}).empty());
+}
+
+TEST(UpdateMatrixTest, UpdateMatchesRetraining) 
+{
+    std::vector<std::vector<char>> first(charSequences.begin(), charSequences.begin() + 2);
+    std::vector<std::vector<char>> second(charSequences.begin() + 2, charSequences.end());
+
+    ProbabilityMatrix<char> matrix;
+    TransitionCounts<char> totals;
+    updateMatrix(matrix, totals, countTransitions<char>(first));
+    updateMatrix(matrix, totals, countTransitions<char>(second));
+
+    auto expected = generateProbabilityMatrix(charSequences);
+    ASSERT_EQ(matrix.size(), expected.size());
+    for (const auto& [from, successors] : expected)
+        for (const auto& [to, probability] : successors)
+            EXPECT_NEAR(matrix[from][to], probability, 1e-12);
+}
@@ -0,0 +1,413 @@
+/**
+ * @file InputBackend.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the batched input backends used by VirtualKeyStrokes.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+// The associated header file.
+#include "InputBackend.hpp"
+// Used for waiting between uinput writes.
+#include "Timing.hpp"
+// Used for preprocessor definitions.
+#include "Constants.hpp"
+// Used for error handling.
+#include "MIAException.hpp"
+
+#if defined(IS_LINUX)
+    #include <cstring>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <linux/uinput.h>
+    #include <X11/Xlib.h>
+    #include <X11/extensions/XTest.h>
+#endif
+
+namespace virtual_keys
+{
+    void InputBatch::add(InputEvent::Type type, bool pressed, std::uint32_t code, int delay)
+    {
+        InputEvent event;
+        event.type = type;
+        event.pressed = pressed;
+        event.code = code;
+        event.delay = std::chrono::milliseconds(std::max(delay, 0));
+        events.push_back(event);
+    }
+
+
+    void InputBatch::addKey(std::uint32_t code, int holdTime, int gap)
+    {
+        add(InputEvent::Type::KEY, true, code, gap);
+        add(InputEvent::Type::KEY, false, code, holdTime);
+    }
+
+
+    void InputBatch::addCharacter(char character, int holdTime, int gap)
+    {
+        unsigned char ch = static_cast<unsigned char>(character);
+        if (!std::isupper(ch))
+        {
+            addKey(ch, holdTime, gap);
+            return;
+        }
+
+        // Capitals are typed as shift plus the lower case key.
+        add(InputEvent::Type::KEY, true, keysym::SHIFT_L, gap);
+        addKey(static_cast<std::uint32_t>(std::tolower(ch)), holdTime);
+        add(InputEvent::Type::KEY, false, keysym::SHIFT_L, 0);
+    }
+
+
+    void InputBatch::addText(const std::string& text, int holdTime, int gap)
+    {
+        for (std::size_t i = 0; i < text.size(); ++i)
+            addCharacter(text[i], holdTime, i == 0 ? 0 : gap);
+    }
+
+
+    void InputBatch::addClick(std::uint32_t number, int holdTime, int gap)
+    {
+        add(InputEvent::Type::BUTTON, true, number, gap);
+        add(InputEvent::Type::BUTTON, false, number, holdTime);
+    }
+
+
+    void InputBatch::addMove(int x, int y, int gap)
+    {
+        add(InputEvent::Type::MOVE_TO, false, 0, gap);
+        events.back().x = x;
+        events.back().y = y;
+    }
+
+
+    std::chrono::milliseconds InputBatch::getDuration() const
+    {
+        std::chrono::milliseconds total(0);
+        for (const InputEvent& event : events)
+            total += event.delay;
+        return total;
+    }
+
+
+    void NullInputBackend::send(const InputBatch& batch)
+    {
+        const std::vector<InputEvent>& batchEvents = batch.getEvents();
+        events.insert(events.end(), batchEvents.begin(), batchEvents.end());
+        ++batchCount;
+    }
+} // namespace virtual_keys
+
+
+#if defined(IS_LINUX)
+namespace
+{
+    using virtual_keys::InputBatch;
+    using virtual_keys::InputEvent;
+
+    /**
+     * @class XTestInputBackend
+     * @brief Queues each batch as XTest requests on one X connection and flushes it once.
+     *
+     * The delay of each event is passed to the X server, which plays the events back in order,
+     * so send() returns without waiting for the delays.
+     */
+    class XTestInputBackend : public virtual_keys::InputBackend
+    {
+    public:
+        /**
+         * @brief Opens the default display.
+         * @throws MIAException(Input_Backend_Unavailable) - If there is no display or no XTest extension.
+         */
+        XTestInputBackend() : display(XOpenDisplay(nullptr))
+        {
+            int eventBase, errorBase, major, minor;
+            if (display != nullptr && XTestQueryExtension(display, &eventBase, &errorBase, &major, &minor))
+                return;
+            if (display != nullptr)
+                XCloseDisplay(display);
+            throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable,
+                                      "xtest: no X display with the XTest extension");
+        }
+
+        ~XTestInputBackend() override
+        { XCloseDisplay(display); }
+
+        XTestInputBackend(const XTestInputBackend&) = delete;
+        XTestInputBackend& operator=(const XTestInputBackend&) = delete;
+
+        std::string getName() const override
+        { return "xtest"; }
+
+        void send(const InputBatch& batch) override
+        {
+            // Delays of skipped (unmapped) keys are carried to the next event.
+            unsigned long delay = 0;
+            for (const InputEvent& event : batch.getEvents())
+            {
+                delay += static_cast<unsigned long>(event.delay.count());
+                switch (event.type)
+                {
+                    case InputEvent::Type::KEY:
+                    {
+                        KeyCode keyCode = getKeyCode(event.code);
+                        if (keyCode == 0)
+                            continue;
+                        XTestFakeKeyEvent(display, keyCode, event.pressed ? True : False, delay);
+                        break;
+                    }
+                    case InputEvent::Type::BUTTON:
+                        XTestFakeButtonEvent(display, event.code, event.pressed ? True : False, delay);
+                        break;
+                    case InputEvent::Type::MOVE_TO:
+                        XTestFakeMotionEvent(display, -1, event.x, event.y, delay);
+                        break;
+                }
+                delay = 0;
+            }
+            XFlush(display);
+        }
+
+    private:
+        /// Returns the key code for a key identifier (0 if the keyboard has none), caching lookups.
+        KeyCode getKeyCode(std::uint32_t code)
+        {
+            auto [it, inserted] = keyCodes.try_emplace(code, 0);
+            if (inserted)
+                it->second = XKeysymToKeycode(display, static_cast<KeySym>(code));
+            return it->second;
+        }
+
+        /// The X connection the requests are queued on.
+        Display* display;
+        /// Cached key codes for each key identifier.
+        std::unordered_map<std::uint32_t, KeyCode> keyCodes;
+    }; // class XTestInputBackend
+
+
+    /**
+     * @class UinputInputBackend
+     * @brief Injects events through a virtual keyboard and pointer created with /dev/uinput.
+     *
+     * Events between two delays are written with a single write() call. Mouse positions use an
+     * absolute axis spanning the X screen size (1920x1080 if no display is available).
+     */
+    class UinputInputBackend : public virtual_keys::InputBackend
+    {
+    public:
+        /**
+         * @brief Creates the virtual device.
+         * @throws MIAException(Input_Backend_Unavailable) - If /dev/uinput cannot be used.
+         */
+        UinputInputBackend() : fd(open("/dev/uinput", O_WRONLY | O_NONBLOCK))
+        {
+            if (fd < 0 || !setup())
+            {
+                if (fd >= 0)
+                    close(fd);
+                throw error::MIAException(error::ErrorCode::Input_Backend_Unavailable,
+                                          "uinput: unable to create a device with /dev/uinput");
+            }
+        }
+
+        ~UinputInputBackend() override
+        {
+            ioctl(fd, UI_DEV_DESTROY);
+            close(fd);
+        }
+
+        UinputInputBackend(const UinputInputBackend&) = delete;
+        UinputInputBackend& operator=(const UinputInputBackend&) = delete;
+
+        std::string getName() const override
+        { return "uinput"; }
+
+        void send(const InputBatch& batch) override
+        {
+            std::vector<input_event> pending;
+            for (const InputEvent& event : batch.getEvents())
+            {
+                if (event.delay.count() > 0)
+                {
+                    flush(pending);
+                    timing::sleepFor(event.delay);
+                }
+                switch (event.type)
+                {
+                    case InputEvent::Type::KEY:
+                    {
+                        int keyCode = toLinuxKey(event.code);
+                        if (keyCode >= 0)
+                            append(pending, EV_KEY, keyCode, event.pressed ? 1 : 0);
+                        break;
+                    }
+                    case InputEvent::Type::BUTTON:
+                        if (event.code == virtual_keys::button::SCROLL_UP || event.code == virtual_keys::button::SCROLL_DOWN)
+                        {
+                            // The wheel has no release, so each click is a single step.
+                            if (event.pressed)
+                                append(pending, EV_REL, REL_WHEEL, event.code == virtual_keys::button::SCROLL_UP ? 1 : -1);
+                        }
+                        else
+                        {
+                            append(pending, EV_KEY, toLinuxButton(event.code), event.pressed ? 1 : 0);
+                        }
+                        break;
+                    case InputEvent::Type::MOVE_TO:
+                        append(pending, EV_ABS, ABS_X, event.x, false);
+                        append(pending, EV_ABS, ABS_Y, event.y);
+                        break;
+                }
+            }
+            flush(pending);
+        }
+
+    private:
+        /// Returns the Linux key code for a key identifier, or -1 if there is none.
+        static int toLinuxKey(std::uint32_t code)
+        {
+            static const int letters[26] = {
+                KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I, KEY_J, KEY_K, KEY_L, KEY_M,
+                KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R, KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z
+            };
+            if (code >= 'a' && code <= 'z')
+                return letters[code - 'a'];
+            if (code >= '1' && code <= '9')
+                return KEY_1 + static_cast<int>(code - '1');
+            switch (code)
+            {
+                case '0': return KEY_0;
+                case ' ': return KEY_SPACE;
+                case '-': return KEY_MINUS;
+                case '=': return KEY_EQUAL;
+                case '\\': return KEY_BACKSLASH;
+                case '/': return KEY_SLASH;
+                case virtual_keys::keysym::TAB: return KEY_TAB;
+                case virtual_keys::keysym::RETURN: return KEY_ENTER;
+                case virtual_keys::keysym::NUM_LOCK: return KEY_NUMLOCK;
+                case virtual_keys::keysym::SHIFT_L: return KEY_LEFTSHIFT;
+                default: return -1;
+            }
+        }
+
+        /// Returns the Linux button code for a button number.
+        static int toLinuxButton(std::uint32_t number)
+        {
+            if (number == virtual_keys::button::RIGHT)
+                return BTN_RIGHT;
+            if (number == virtual_keys::button::MIDDLE)
+                return BTN_MIDDLE;
+            return BTN_LEFT;
+        }
+
+        /// Appends an event, followed by a report unless more of the same report follows.
+        static void append(std::vector<input_event>& events, int type, int code, int value, bool report = true)
+        {
+            input_event event{};
+            event.type = static_cast<__u16>(type);
+            event.code = static_cast<__u16>(code);
+            event.value = value;
+            events.push_back(event);
+            if (report)
+                append(events, EV_SYN, SYN_REPORT, 0, false);
+        }
+
+        /// Writes the pending events with one call.
+        void flush(std::vector<input_event>& events)
+        {
+            if (!events.empty())
+            {
+                ssize_t written = write(fd, events.data(), events.size() * sizeof(input_event));
+                (void)written; // A full kernel buffer drops the events, as a real device would.
+            }
+            events.clear();
+        }
+
+        /// Enables the keys, buttons and axes used, then creates the device.
+        bool setup()
+        {
+            bool ok = ioctl(fd, UI_SET_EVBIT, EV_KEY) == 0 && ioctl(fd, UI_SET_EVBIT, EV_SYN) == 0 &&
+                      ioctl(fd, UI_SET_EVBIT, EV_REL) == 0 && ioctl(fd, UI_SET_RELBIT, REL_WHEEL) == 0 &&
+                      ioctl(fd, UI_SET_EVBIT, EV_ABS) == 0;
+            for (int key = KEY_ESC; ok && key <= KEY_NUMLOCK; ++key)
+                ok = ioctl(fd, UI_SET_KEYBIT, key) == 0;
+            for (int btn : {BTN_LEFT, BTN_RIGHT, BTN_MIDDLE})
+                ok = ok && ioctl(fd, UI_SET_KEYBIT, btn) == 0;
+
+            int width = 1920, height = 1080;
+            if (Display* display = XOpenDisplay(nullptr))
+            {
+                width = DisplayWidth(display, DefaultScreen(display));
+                height = DisplayHeight(display, DefaultScreen(display));
+                XCloseDisplay(display);
+            }
+            for (auto [axis, size] : {std::pair{ABS_X, width}, std::pair{ABS_Y, height}})
+            {
+                uinput_abs_setup abs{};
+                abs.code = static_cast<__u16>(axis);
+                abs.absinfo.maximum = size - 1;
+                ok = ok && ioctl(fd, UI_SET_ABSBIT, axis) == 0 && ioctl(fd, UI_ABS_SETUP, &abs) == 0;
+            }
+
+            uinput_setup device{};
+            device.id.bustype = BUS_VIRTUAL;
+            std::strncpy(device.name, "MIA virtual input", UINPUT_MAX_NAME_SIZE - 1);
+            return ok && ioctl(fd, UI_DEV_SETUP, &device) == 0 && ioctl(fd, UI_DEV_CREATE) == 0;
+        }
+
+        /// The /dev/uinput file descriptor.
+        int fd;
+    }; // class UinputInputBackend
+} // anonymous namespace
+#endif
+
+
+namespace virtual_keys
+{
+    InputBackend::Type InputBackend::stringToType(const std::string& name)
+    {
+        std::string input = name;
+        std::transform(input.begin(), input.end(), input.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (input == "auto")
+            return Type::AUTO;
+        if (input == "xtest")
+            return Type::XTEST;
+        if (input == "uinput")
+            return Type::UINPUT;
+        if (input == "null" || input == "none")
+            return Type::NONE;
+        throw error::MIAException(error::ErrorCode::Invalid_Argument, "Unknown input backend: " + name);
+    }
+
+
+    std::unique_ptr<InputBackend> InputBackend::create(Type type)
+    {
+        if (type == Type::NONE)
+            return std::make_unique<NullInputBackend>();
+
+    #if defined(IS_LINUX)
+        if (type == Type::XTEST)
+            return std::make_unique<XTestInputBackend>();
+        if (type == Type::UINPUT)
+            return std::make_unique<UinputInputBackend>();
+
+        // AUTO prefers XTest, which needs no special permissions.
+        try
+        {
+            return std::make_unique<XTestInputBackend>();
+        }
+        catch (const error::MIAException&)
+        {
+            return std::make_unique<UinputInputBackend>();
+        }
+    #else
+        throw error::MIAException(error::ErrorCode::Linux_Only_Feature, "Batched input backends");
+    #endif
+    }
+} // namespace virtual_keys
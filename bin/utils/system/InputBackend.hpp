@@ -0,0 +1,240 @@
+/**
+ * @file InputBackend.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Declares the input backends used by VirtualKeyStrokes to inject keyboard and mouse
+ *     events in batches. An InputBatch describes a run of key, button and motion events
+ *     (with the delay before each one), and a backend submits the whole batch at once: the
+ *     XTest backend queues every event in a single X request (the server applies the
+ *     delays), the uinput backend writes arrays of input_event structures to a virtual
+ *     device, and the null backend records the events for headless tests.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace virtual_keys
+{
+    /**
+     * @namespace keysym
+     * @brief Key identifiers used by InputEvent. Printable ASCII characters are their own
+     * identifier, and the named keys use the matching X11 keysym values.
+     */
+    namespace keysym
+    {
+        constexpr std::uint32_t TAB = 0xff09;       ///< The tab key.
+        constexpr std::uint32_t RETURN = 0xff0d;    ///< The enter key.
+        constexpr std::uint32_t NUM_LOCK = 0xff7f;  ///< The num lock key.
+        constexpr std::uint32_t SHIFT_L = 0xffe1;   ///< The left shift key.
+    } // namespace keysym
+
+    /**
+     * @namespace button
+     * @brief Mouse button numbers used by InputEvent (following the X11 numbering).
+     */
+    namespace button
+    {
+        constexpr std::uint32_t LEFT = 1;           ///< The left mouse button.
+        constexpr std::uint32_t MIDDLE = 2;         ///< The middle mouse button.
+        constexpr std::uint32_t RIGHT = 3;          ///< The right mouse button.
+        constexpr std::uint32_t SCROLL_UP = 4;      ///< One step of the wheel away from the user.
+        constexpr std::uint32_t SCROLL_DOWN = 5;    ///< One step of the wheel toward the user.
+    } // namespace button
+
+    /**
+     * @brief A single keyboard or mouse event.
+     */
+    struct InputEvent
+    {
+        /// The kinds of events.
+        enum class Type : std::uint8_t
+        {
+            KEY,      ///< A key (code is a key identifier, see keysym) is pressed or released.
+            BUTTON,   ///< A mouse button (code is a button number) is pressed or released.
+            MOVE_TO   ///< The mouse moves to the absolute position (x, y).
+        };
+
+        Type type{Type::KEY};                   ///< The kind of event.
+        bool pressed{false};                    ///< True for a press, false for a release.
+        std::uint32_t code{0};                  ///< The key identifier or button number.
+        std::int32_t x{0};                      ///< The x coordinate for MOVE_TO.
+        std::int32_t y{0};                      ///< The y coordinate for MOVE_TO.
+        std::chrono::milliseconds delay{0};     ///< The time to wait before this event.
+
+        /// Compares every field, mainly for tests.
+        bool operator==(const InputEvent& other) const = default;
+    };
+
+    /**
+     * @class InputBatch
+     * @brief Builds the list of events for a series of key presses, clicks and mouse moves.
+     */
+    class InputBatch
+    {
+    public:
+        /**
+         * @brief Appends a press and release of a key.
+         * @param code[std::uint32_t] - The key identifier (see keysym).
+         * @param holdTime[int] - The time (ms) to hold the key down.
+         * @param gap[int] - The time (ms) to wait before pressing the key.
+         */
+        void addKey(std::uint32_t code, int holdTime = 0, int gap = 0);
+
+        /**
+         * @brief Appends the key presses which type a character, holding shift for capitals.
+         * @param character[char] - The character (see VirtualKeyStrokes::canPress()).
+         * @param holdTime[int] - The time (ms) to hold the key down.
+         * @param gap[int] - The time (ms) to wait before pressing the key.
+         */
+        void addCharacter(char character, int holdTime = 0, int gap = 0);
+
+        /**
+         * @brief Appends the key presses which type a string.
+         * @param text[const std::string&] - The text to type.
+         * @param holdTime[int] - The time (ms) to hold each key down.
+         * @param gap[int] - The time (ms) to wait between the keys.
+         */
+        void addText(const std::string& text, int holdTime = 0, int gap = 0);
+
+        /**
+         * @brief Appends a press and release of a mouse button.
+         * @param number[std::uint32_t] - The button number (see button).
+         * @param holdTime[int] - The time (ms) to hold the button down.
+         * @param gap[int] - The time (ms) to wait before pressing the button.
+         */
+        void addClick(std::uint32_t number, int holdTime = 0, int gap = 0);
+
+        /**
+         * @brief Appends a move of the mouse to an absolute position.
+         * @param x[int] - The x coordinate.
+         * @param y[int] - The y coordinate.
+         * @param gap[int] - The time (ms) to wait before moving.
+         */
+        void addMove(int x, int y, int gap = 0);
+
+        /**
+         * @brief Returns the events in order.
+         * @return [const std::vector<InputEvent>&] - The events.
+         */
+        const std::vector<InputEvent>& getEvents() const
+        { return events; }
+
+        /**
+         * @brief Returns the sum of the delays of all events.
+         * @return [std::chrono::milliseconds] - The time the batch takes to play back.
+         */
+        std::chrono::milliseconds getDuration() const;
+
+        /**
+         * @brief Removes all events.
+         */
+        void clear()
+        { events.clear(); }
+
+    private:
+        /// Appends an event.
+        void add(InputEvent::Type type, bool pressed, std::uint32_t code, int delay);
+
+        /// The events in order.
+        std::vector<InputEvent> events;
+    }; // class InputBatch
+
+    /**
+     * @class InputBackend
+     * @brief The interface for injecting batches of input events into the system.
+     */
+    class InputBackend
+    {
+    public:
+        /// The available backends.
+        enum class Type
+        {
+            AUTO,     ///< XTest if an X display is available, otherwise uinput.
+            XTEST,    ///< Batched XTest requests to the X server (Linux).
+            UINPUT,   ///< A virtual device through /dev/uinput (Linux).
+            NONE      ///< Records the events without injecting them (all platforms).
+        };
+
+        /**
+         * @brief Converts a name ("auto", "xtest", "uinput" or "null") to a backend type.
+         * @param name[const std::string&] - The name (case insensitive).
+         * @return [Type] - The backend type.
+         * @throws MIAException(Invalid_Argument) - If the name is unknown.
+         */
+        static Type stringToType(const std::string& name);
+
+        /**
+         * @brief Opens a backend.
+         * @param type[Type] - The backend to open.
+         * @return [std::unique_ptr<InputBackend>] - The opened backend.
+         * @throws MIAException(Input_Backend_Unavailable) - If the backend cannot be opened.
+         * @throws MIAException(Linux_Only_Feature) - If XTest or uinput is requested on another platform.
+         */
+        static std::unique_ptr<InputBackend> create(Type type);
+
+        /// Virtual destructor.
+        virtual ~InputBackend() = default;
+
+        /**
+         * @brief Returns the name of the backend (e.g., "xtest").
+         * @return [std::string] - The backend name.
+         */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Injects all events of a batch in order, honoring each event's delay.
+         *
+         * Backends submit the events with as few system calls as possible. The call may return
+         * before the delays have elapsed if the system plays them back (as XTest does).
+         * @param batch[const InputBatch&] - The events to inject.
+         */
+        virtual void send(const InputBatch& batch) = 0;
+    }; // class InputBackend
+
+    /**
+     * @class NullInputBackend
+     * @brief Records the events sent to it instead of injecting them. Used for headless tests.
+     */
+    class NullInputBackend : public InputBackend
+    {
+    public:
+        std::string getName() const override
+        { return "null"; }
+
+        void send(const InputBatch& batch) override;
+
+        /**
+         * @brief Returns every event sent so far.
+         * @return [const std::vector<InputEvent>&] - The recorded events.
+         */
+        const std::vector<InputEvent>& getEvents() const
+        { return events; }
+
+        /**
+         * @brief Returns the number of send() calls.
+         * @return [std::size_t] - The number of batches sent.
+         */
+        std::size_t getBatchCount() const
+        { return batchCount; }
+
+        /**
+         * @brief Forgets the recorded events and batches.
+         */
+        void clear()
+        {
+            events.clear();
+            batchCount = 0;
+        }
+
+    private:
+        /// Every recorded event.
+        std::vector<InputEvent> events;
+        /// The number of send() calls.
+        std::size_t batchCount{0};
+    }; // class NullInputBackend
+} // namespace virtual_keys
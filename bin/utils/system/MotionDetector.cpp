@@ -0,0 +1,209 @@
+/**
+ * @file MotionDetector.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the frame-differencing motion detector.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+// The associated header file.
+#include "MotionDetector.hpp"
+// Used for capturing at a fixed interval.
+#include "Timing.hpp"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace screen
+{
+    MotionDetector::MotionDetector(const MotionOptions& options) : options(options)
+    {
+        this->options.scale = std::max(this->options.scale, 1);
+        this->options.distance = std::max(this->options.distance, 1);
+        this->options.minTiles = std::max<std::size_t>(this->options.minTiles, 1);
+    }
+
+
+    void MotionDetector::watch(const Region& region, Callback callback)
+    {
+        watches.push_back({region, std::move(callback)});
+    }
+
+
+    void MotionDetector::reset()
+    {
+        frameCount = 0;
+        std::fill(moving.begin(), moving.end(), 0);
+    }
+
+
+    std::size_t MotionDetector::process(const Frame& frame)
+    {
+        if (frame.getWidth() != frameWidth || frame.getHeight() != frameHeight || ring.empty())
+        {
+            frameWidth = frame.getWidth();
+            frameHeight = frame.getHeight();
+            int width = frameWidth / options.scale;
+            int height = frameHeight / options.scale;
+            columns = (width + TILE_SIZE - 1) / TILE_SIZE;
+            rows = (height + TILE_SIZE - 1) / TILE_SIZE;
+            // Padding (always zero) lets the tile sums run on whole 16-byte blocks.
+            imageStride = (width + 15) / 16 * 16;
+            imageRows = rows * TILE_SIZE;
+            ring.assign(static_cast<std::size_t>(options.distance) + 1,
+                        std::vector<std::uint8_t>(static_cast<std::size_t>(imageStride) * imageRows, 0));
+            sums.assign(static_cast<std::size_t>(imageStride / TILE_SIZE) * rows, 0);
+            moving.assign(static_cast<std::size_t>(columns) * rows, 0);
+            frameCount = 0;
+        }
+
+        std::vector<std::uint8_t>& current = ring[frameCount % ring.size()];
+        downsample(frame, current);
+        ++frameCount;
+
+        std::fill(moving.begin(), moving.end(), 0);
+        if (frameCount <= static_cast<std::uint64_t>(options.distance))
+            return 0;
+
+        compare(current, ring[(frameCount - 1 - options.distance) % ring.size()]);
+
+        // A tile moves when its mean absolute difference exceeds the threshold.
+        const std::uint32_t limit = static_cast<std::uint32_t>(std::max(options.tileThreshold, 0)) * TILE_SIZE * TILE_SIZE;
+        const int pitch = imageStride / TILE_SIZE;
+        std::size_t count = 0;
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int column = 0; column < columns; ++column)
+            {
+                bool moved = sums[static_cast<std::size_t>(row) * pitch + column] > limit;
+                moving[static_cast<std::size_t>(row) * columns + column] = moved ? 1 : 0;
+                count += moved ? 1 : 0;
+            }
+        }
+
+        if (count > 0)
+        {
+            for (const Watch& watched : watches)
+            {
+                std::optional<MotionEvent> event = getMotion(watched.region);
+                if (event)
+                    watched.callback(*event);
+            }
+        }
+        return count;
+    }
+
+
+    std::optional<MotionEvent> MotionDetector::getMotion(const Region& requested) const
+    {
+        if (frameCount <= static_cast<std::uint64_t>(options.distance))
+            return std::nullopt;
+
+        Region region = Frame(nullptr, frameWidth, frameHeight, 0).clip(requested);
+        const int tilePixels = TILE_SIZE * options.scale;
+        if (region.width == 0 || region.height == 0)
+            return std::nullopt;
+
+        // The tiles overlapping the region.
+        int firstColumn = region.x / tilePixels, lastColumn = std::min((region.x + region.width - 1) / tilePixels, columns - 1);
+        int firstRow = region.y / tilePixels, lastRow = std::min((region.y + region.height - 1) / tilePixels, rows - 1);
+
+        MotionEvent event;
+        int left = frameWidth, top = frameHeight, right = 0, bottom = 0;
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+            {
+                if (!isTileMoving(column, row))
+                    continue;
+                ++event.tiles;
+                left = std::min(left, column * tilePixels);
+                top = std::min(top, row * tilePixels);
+                right = std::max(right, (column + 1) * tilePixels);
+                bottom = std::max(bottom, (row + 1) * tilePixels);
+            }
+        }
+        if (event.tiles < options.minTiles)
+            return std::nullopt;
+
+        right = std::min(right, frameWidth);
+        bottom = std::min(bottom, frameHeight);
+        event.region = {left, top, right - left, bottom - top};
+        event.frameIndex = frameCount - 1;
+        return event;
+    }
+
+
+    void MotionDetector::downsample(const Frame& frame, std::vector<std::uint8_t>& image) const
+    {
+        const int scale = options.scale;
+        const int width = frameWidth / scale;
+        const int height = frameHeight / scale;
+        const std::uint32_t area = static_cast<std::uint32_t>(scale * scale);
+        std::vector<std::uint32_t> totals(static_cast<std::size_t>(width));
+
+        for (int y = 0; y < height; ++y)
+        {
+            std::fill(totals.begin(), totals.end(), 0);
+            for (int line = 0; line < scale; ++line)
+            {
+                const std::uint32_t* pixels = frame.getRow(y * scale + line);
+                for (int x = 0; x < width * scale; ++x)
+                {
+                    // Luma approximated as (red + 2 * green + blue) / 4.
+                    std::uint32_t pixel = pixels[x];
+                    totals[x / scale] += (((pixel >> 16) & 0xff) + 2 * ((pixel >> 8) & 0xff) + (pixel & 0xff)) >> 2;
+                }
+            }
+            std::uint8_t* out = image.data() + static_cast<std::size_t>(y) * imageStride;
+            for (int x = 0; x < width; ++x)
+                out[x] = static_cast<std::uint8_t>(totals[x] / area);
+        }
+    }
+
+
+    void MotionDetector::compare(const std::vector<std::uint8_t>& current, const std::vector<std::uint8_t>& previous)
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        const int pitch = imageStride / TILE_SIZE;
+        for (int y = 0; y < imageRows; ++y)
+        {
+            const std::uint8_t* a = current.data() + static_cast<std::size_t>(y) * imageStride;
+            const std::uint8_t* b = previous.data() + static_cast<std::size_t>(y) * imageStride;
+            std::uint32_t* tileSums = sums.data() + static_cast<std::size_t>(y / TILE_SIZE) * pitch;
+            int x = 0;
+        #if defined(__SSE2__)
+            // Each 16-byte block spans two tiles, and psadbw sums each 8-byte half separately.
+            for (; x + 16 <= imageStride; x += 16)
+            {
+                __m128i sad = _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x)),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x)));
+                tileSums[x / TILE_SIZE] += static_cast<std::uint32_t>(_mm_cvtsi128_si32(sad));
+                tileSums[x / TILE_SIZE + 1] += static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sad, 8)));
+            }
+        #endif
+            for (; x < imageStride; ++x)
+                tileSums[x / TILE_SIZE] += static_cast<std::uint32_t>(std::abs(a[x] - b[x]));
+        }
+    }
+
+
+    std::optional<MotionEvent> waitForMotion(ScreenSource& source, MotionDetector& detector, const Region& region,
+                                             std::chrono::milliseconds timeout, std::chrono::milliseconds interval)
+    {
+        detector.reset();
+        const timing::Clock::time_point end = timing::Clock::now() + timeout;
+        timing::Timeline timeline;
+        while (true)
+        {
+            detector.process(source.capture());
+            std::optional<MotionEvent> event = detector.getMotion(region);
+            if (event || timing::Clock::now() + interval > end)
+                return event;
+            timeline.waitFor(interval);
+        }
+    }
+} // namespace screen
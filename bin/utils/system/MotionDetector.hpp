@@ -0,0 +1,179 @@
+/**
+ * @file MotionDetector.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Declares a frame-differencing motion detector. Each captured frame is downsampled to a
+ *     small grayscale image and kept in a ring, and the newest image is compared with an older
+ *     one in 8x8 tiles using the sum of absolute differences (SSE2 where available). Watched
+ *     regions get a callback as soon as enough of their tiles change, so motion is detected
+ *     within one captured frame rather than after a fixed delay.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// Used for the frames and regions.
+#include "ScreenCapture.hpp"
+
+namespace screen
+{
+    /**
+     * @brief Options which control the sensitivity of a MotionDetector.
+     */
+    struct MotionOptions
+    {
+        /// Each side of a downsampled pixel covers this many frame pixels.
+        int scale{4};
+        /// Frames are compared with the frame this many frames earlier (1 = the previous frame).
+        int distance{1};
+        /// A tile moves when the mean absolute difference of its pixels exceeds this (0 - 255).
+        int tileThreshold{16};
+        /// A watched region reports motion when at least this many of its tiles move.
+        std::size_t minTiles{1};
+    };
+
+    /**
+     * @brief Motion detected within a watched region.
+     */
+    struct MotionEvent
+    {
+        Region region{};                ///< The bounding box of the moving tiles, in frame coordinates.
+        std::size_t tiles{0};           ///< The number of moving tiles in the watched region.
+        std::uint64_t frameIndex{0};    ///< The number of the frame (counting from 0) which showed the motion.
+    };
+
+    /**
+     * @class MotionDetector
+     * @brief Detects changes between frames, tile by tile.
+     *
+     * Each tile covers TILE_SIZE x TILE_SIZE downsampled pixels, i.e., TILE_SIZE * scale frame
+     * pixels on each side. Nothing is reported until enough frames have been seen to compare.
+     * The ring is reset if the frame size changes.
+     */
+    class MotionDetector
+    {
+    public:
+        /// The width and height of a tile, in downsampled pixels.
+        static constexpr int TILE_SIZE = 8;
+
+        /// Called with the motion in a watched region.
+        using Callback = std::function<void(const MotionEvent&)>;
+
+        /**
+         * @brief Constructs a detector with no frames and no watched regions.
+         * @param options[const MotionOptions&] - The detector sensitivity.
+         */
+        explicit MotionDetector(const MotionOptions& options = {});
+
+        /**
+         * @brief Adds a region to watch. Its callback is called from process() on each frame
+         * where the region moves.
+         * @param region[const Region&] - The region in frame coordinates (default = the whole frame).
+         * @param callback[Callback] - Called with the motion.
+         */
+        void watch(const Region& region, Callback callback);
+
+        /**
+         * @brief Removes every watched region.
+         */
+        void clearWatches()
+        { watches.clear(); }
+
+        /**
+         * @brief Adds a frame and reports the motion since the frame distance frames earlier.
+         * @param frame[const Frame&] - The new frame.
+         * @return [std::size_t] - The number of moving tiles in the whole frame.
+         */
+        std::size_t process(const Frame& frame);
+
+        /**
+         * @brief Returns the motion within a region in the last processed frame.
+         * @param region[const Region&] - The region in frame coordinates (default = the whole frame).
+         * @return [std::optional<MotionEvent>] - The motion, or nothing if fewer than minTiles tiles moved.
+         */
+        std::optional<MotionEvent> getMotion(const Region& region = {}) const;
+
+        /**
+         * @brief Forgets every frame, so the next frames are not compared with older ones.
+         */
+        void reset();
+
+        /**
+         * @brief Returns whether a tile moved in the last processed frame.
+         * @param column[int] - The tile column.
+         * @param row[int] - The tile row.
+         * @return [bool] - True if the tile moved.
+         */
+        bool isTileMoving(int column, int row) const
+        { return moving[static_cast<std::size_t>(row) * columns + column] != 0; }
+
+        /// Returns the number of tile columns of the last processed frame.
+        int getColumns() const
+        { return columns; }
+
+        /// Returns the number of tile rows of the last processed frame.
+        int getRows() const
+        { return rows; }
+
+        /// Returns the number of frames processed since the last reset.
+        std::uint64_t getFrameCount() const
+        { return frameCount; }
+
+    private:
+        /// A watched region and its callback.
+        struct Watch
+        {
+            Region region;
+            Callback callback;
+        };
+
+        /// Averages the luma of each scale x scale block of frame into image.
+        void downsample(const Frame& frame, std::vector<std::uint8_t>& image) const;
+
+        /// Sums the absolute differences between two images for each tile into sums.
+        void compare(const std::vector<std::uint8_t>& current, const std::vector<std::uint8_t>& previous);
+
+        /// The detector sensitivity.
+        MotionOptions options;
+        /// The watched regions.
+        std::vector<Watch> watches;
+        /// The downsampled images, with rows padded to a multiple of 16 bytes.
+        std::vector<std::vector<std::uint8_t>> ring;
+        /// The frame size the ring was built for.
+        int frameWidth{0};
+        int frameHeight{0};
+        /// The padded row length and row count of the downsampled images.
+        int imageStride{0};
+        int imageRows{0};
+        /// The tile grid size.
+        int columns{0};
+        int rows{0};
+        /// One entry per tile, non-zero if it moved in the last frame.
+        std::vector<std::uint8_t> moving;
+        /// The per-tile sums of absolute differences, imageStride / TILE_SIZE per tile row.
+        std::vector<std::uint32_t> sums;
+        /// The number of frames processed since the last reset.
+        std::uint64_t frameCount{0};
+    }; // class MotionDetector
+
+    /**
+     * @brief Captures frames until a region moves or the time runs out.
+     *
+     * Frames are captured at a fixed interval on a drift-free timeline (see timing::Timeline).
+     * The detector is reset first, so only motion after the call is reported.
+     * @param source[ScreenSource&] - The source to capture.
+     * @param detector[MotionDetector&] - The detector (its watched regions are also called).
+     * @param region[const Region&] - The region to wait for, in frame coordinates (empty = the whole frame).
+     * @param timeout[std::chrono::milliseconds] - The longest time to wait.
+     * @param interval[std::chrono::milliseconds] - The time between captures (default = 16 ms).
+     * @return [std::optional<MotionEvent>] - The motion, or nothing if the time ran out.
+     */
+    std::optional<MotionEvent> waitForMotion(ScreenSource& source, MotionDetector& detector, const Region& region,
+                                             std::chrono::milliseconds timeout,
+                                             std::chrono::milliseconds interval = std::chrono::milliseconds(16));
+} // namespace screen
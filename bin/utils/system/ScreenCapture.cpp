@@ -0,0 +1,543 @@
+/**
+ * @file ScreenCapture.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description: Implements the screen capture sources and the pixel search kernels.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+// The associated header file.
+#include "ScreenCapture.hpp"
+// Used for preprocessor definitions.
+#include "Constants.hpp"
+// Used for error handling.
+#include "MIAException.hpp"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(IS_LINUX)
+    #include <sys/ipc.h>
+    #include <sys/shm.h>
+    #include <X11/Xlib.h>
+    #include <X11/Xutil.h>
+    #include <X11/extensions/XShm.h>
+#elif defined(IS_WINDOWS)
+    #include <windows.h>
+#endif
+
+namespace
+{
+    using screen::Frame;
+    using screen::Point;
+    using screen::Region;
+
+    /**
+     * @brief Tests whether each component of a pixel is within a range.
+     *
+     * The SSE2 form tests four pixels at once: a saturating subtraction is zero exactly when a
+     * byte is not below the minimum (or not above the maximum), so a pixel matches when all
+     * four bytes of both differences are zero. The top byte of high is 0xff so that the unused
+     * byte of each pixel always passes.
+     */
+    struct RangeKernel
+    {
+        explicit RangeKernel(const screen::ColorRange& range) :
+            low(screen::packColor(range.min)), high(screen::packColor(range.max) | 0xff000000u)
+        { }
+
+        bool test(std::uint32_t pixel) const
+        {
+            for (int shift = 0; shift < 24; shift += 8)
+            {
+                std::uint32_t value = (pixel >> shift) & 0xff;
+                if (value < ((low >> shift) & 0xff) || value > ((high >> shift) & 0xff))
+                    return false;
+            }
+            return true;
+        }
+
+    #if defined(__SSE2__)
+        /// Returns a mask with bit i set if pixel i of the four pixels matches.
+        int test4(const std::uint32_t* pixels) const
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+            __m128i below = _mm_subs_epu8(_mm_set1_epi32(static_cast<int>(low)), values);
+            __m128i above = _mm_subs_epu8(values, _mm_set1_epi32(static_cast<int>(high)));
+            __m128i inside = _mm_cmpeq_epi32(_mm_or_si128(below, above), _mm_setzero_si128());
+            return _mm_movemask_ps(_mm_castsi128_ps(inside));
+        }
+    #endif
+
+        std::uint32_t low;
+        std::uint32_t high;
+    };
+
+    /**
+     * @brief Tests whether one component of a pixel exceeds either other component by more than a margin.
+     */
+    struct DominantKernel
+    {
+        DominantKernel(screen::Channel channel, int margin) : margin(margin)
+        {
+            // Shifts of the red, green and blue components in a packed pixel.
+            switch (channel)
+            {
+                case screen::Channel::RED:   shift = 16; other1 = 8;  other2 = 0; break;
+                case screen::Channel::GREEN: shift = 8;  other1 = 16; other2 = 0; break;
+                case screen::Channel::BLUE:  shift = 0;  other1 = 16; other2 = 8; break;
+            }
+        }
+
+        bool test(std::uint32_t pixel) const
+        {
+            int value = static_cast<int>((pixel >> shift) & 0xff);
+            return value > static_cast<int>((pixel >> other1) & 0xff) + margin ||
+                   value > static_cast<int>((pixel >> other2) & 0xff) + margin;
+        }
+
+    #if defined(__SSE2__)
+        /// Returns a mask with bit i set if pixel i of the four pixels matches.
+        int test4(const std::uint32_t* pixels) const
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+            __m128i mask = _mm_set1_epi32(0xff);
+            __m128i extra = _mm_set1_epi32(margin);
+            __m128i value = _mm_and_si128(_mm_srl_epi32(values, _mm_cvtsi32_si128(shift)), mask);
+            __m128i first = _mm_add_epi32(_mm_and_si128(_mm_srl_epi32(values, _mm_cvtsi32_si128(other1)), mask), extra);
+            __m128i second = _mm_add_epi32(_mm_and_si128(_mm_srl_epi32(values, _mm_cvtsi32_si128(other2)), mask), extra);
+            __m128i match = _mm_or_si128(_mm_cmpgt_epi32(value, first), _mm_cmpgt_epi32(value, second));
+            return _mm_movemask_ps(_mm_castsi128_ps(match));
+        }
+    #endif
+
+        int margin;
+        int shift{16};
+        int other1{8};
+        int other2{0};
+    };
+
+    /// Returns the first matching pixel of a region in row order.
+    template<typename Kernel>
+    std::optional<Point> findFirst(const Frame& frame, const Region& requested, const Kernel& kernel)
+    {
+        Region region = frame.clip(requested);
+        for (int y = region.y; y < region.y + region.height; ++y)
+        {
+            const std::uint32_t* row = frame.getRow(y) + region.x;
+            int x = 0;
+        #if defined(__SSE2__)
+            for (; x + 4 <= region.width; x += 4)
+            {
+                int mask = kernel.test4(row + x);
+                if (mask != 0)
+                    return Point{region.x + x + std::countr_zero(static_cast<unsigned int>(mask)), y};
+            }
+        #endif
+            for (; x < region.width; ++x)
+                if (kernel.test(row[x]))
+                    return Point{region.x + x, y};
+        }
+        return std::nullopt;
+    }
+
+    /// Returns the number of matching pixels in a region.
+    template<typename Kernel>
+    std::size_t countAll(const Frame& frame, const Region& requested, const Kernel& kernel)
+    {
+        Region region = frame.clip(requested);
+        std::size_t count = 0;
+        for (int y = region.y; y < region.y + region.height; ++y)
+        {
+            const std::uint32_t* row = frame.getRow(y) + region.x;
+            int x = 0;
+        #if defined(__SSE2__)
+            for (; x + 4 <= region.width; x += 4)
+                count += static_cast<std::size_t>(std::popcount(static_cast<unsigned int>(kernel.test4(row + x))));
+        #endif
+            for (; x < region.width; ++x)
+                count += kernel.test(row[x]) ? 1 : 0;
+        }
+        return count;
+    }
+
+    /// Reads the next whitespace separated number of a PPM header, skipping comments.
+    bool readHeaderValue(std::istream& in, int& value)
+    {
+        in >> std::ws;
+        while (in.peek() == '#')
+        {
+            std::string comment;
+            std::getline(in, comment);
+            in >> std::ws;
+        }
+        return static_cast<bool>(in >> value);
+    }
+} // anonymous namespace
+
+
+namespace screen
+{
+    Frame::Frame(int width, int height) :
+        storage(static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)), 0),
+        pixels(storage.data()), width(std::max(width, 0)), height(std::max(height, 0)), stride(std::max(width, 0))
+    { }
+
+
+    Frame::Frame(std::uint32_t* pixels, int width, int height, int stride) :
+        pixels(pixels), width(width), height(height), stride(stride)
+    { }
+
+
+    Frame::Frame(const Frame& other) : Frame(other.width, other.height)
+    {
+        for (int y = 0; y < height; ++y)
+            std::memcpy(getRow(y), other.getRow(y), static_cast<std::size_t>(width) * sizeof(std::uint32_t));
+    }
+
+
+    Frame& Frame::operator=(const Frame& other)
+    {
+        if (this != &other)
+            *this = Frame(other);
+        return *this;
+    }
+
+
+    void Frame::fill(const Region& region, const Color& color)
+    {
+        Region clipped = clip(region);
+        for (int y = clipped.y; y < clipped.y + clipped.height; ++y)
+            std::fill_n(getRow(y) + clipped.x, clipped.width, packColor(color));
+    }
+
+
+    Region Frame::clip(const Region& region) const
+    {
+        int left = std::clamp(region.x, 0, width);
+        int top = std::clamp(region.y, 0, height);
+        int right = region.width > 0 ? std::clamp(region.x + region.width, left, width) : width;
+        int bottom = region.height > 0 ? std::clamp(region.y + region.height, top, height) : height;
+        return {left, top, right - left, bottom - top};
+    }
+
+
+    Frame readPPM(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, path);
+
+        std::string magic;
+        int width = 0, height = 0, maxValue = 0;
+        in >> magic;
+        if (magic != "P6" || !readHeaderValue(in, width) || !readHeaderValue(in, height) ||
+            !readHeaderValue(in, maxValue) || width <= 0 || height <= 0 || maxValue != 255)
+            throw error::MIAException(error::ErrorCode::Invalid_Argument, "Not an 8-bit binary PPM image: " + path);
+        in.get(); // The single whitespace character ending the header.
+
+        Frame frame(width, height);
+        std::vector<unsigned char> row(static_cast<std::size_t>(width) * 3);
+        for (int y = 0; y < height; ++y)
+        {
+            if (!in.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row.size())))
+                throw error::MIAException(error::ErrorCode::Invalid_Argument, "Truncated PPM image: " + path);
+            std::uint32_t* pixels = frame.getRow(y);
+            for (int x = 0; x < width; ++x)
+                pixels[x] = packColor({row[3 * x], row[3 * x + 1], row[3 * x + 2]});
+        }
+        return frame;
+    }
+
+
+    void writePPM(const Frame& frame, const std::string& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, path);
+
+        out << "P6\n" << frame.getWidth() << " " << frame.getHeight() << "\n255\n";
+        std::vector<unsigned char> row(static_cast<std::size_t>(frame.getWidth()) * 3);
+        for (int y = 0; y < frame.getHeight(); ++y)
+        {
+            const std::uint32_t* pixels = frame.getRow(y);
+            for (int x = 0; x < frame.getWidth(); ++x)
+            {
+                Color color = unpackColor(pixels[x]);
+                row[3 * x] = color.red;
+                row[3 * x + 1] = color.green;
+                row[3 * x + 2] = color.blue;
+            }
+            out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+        }
+        if (!out)
+            throw error::MIAException(error::ErrorCode::Failed_To_Open_File, path);
+    }
+
+
+    std::optional<Point> findColor(const Frame& frame, const ColorRange& range, const Region& region)
+    {
+        return findFirst(frame, region, RangeKernel(range));
+    }
+
+
+    std::size_t countColor(const Frame& frame, const ColorRange& range, const Region& region)
+    {
+        return countAll(frame, region, RangeKernel(range));
+    }
+
+
+    std::optional<Point> findDominant(const Frame& frame, Channel channel, int margin, const Region& region)
+    {
+        return findFirst(frame, region, DominantKernel(channel, margin));
+    }
+} // namespace screen
+
+
+#if defined(IS_LINUX)
+namespace
+{
+    /**
+     * @class XShmScreenSource
+     * @brief Captures the screen with the MIT-SHM extension.
+     *
+     * The X server writes each capture directly into a shared memory segment, which the frame
+     * views without copying. If the extension is unavailable (e.g., a remote display), each
+     * capture falls back to a regular XGetImage request copied into the frame.
+     */
+    class XShmScreenSource : public screen::ScreenSource
+    {
+    public:
+        /**
+         * @brief Opens the default display and prepares the capture buffer.
+         * @param requested[const screen::Region&] - The region to capture, clipped to the screen.
+         * @throws MIAException(Screen_Capture_Unavailable) - If there is no display or it is not 24/32-bit.
+         */
+        explicit XShmScreenSource(const screen::Region& requested) : display(XOpenDisplay(nullptr))
+        {
+            if (display == nullptr)
+                throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "xshm: no X display");
+            root = DefaultRootWindow(display);
+
+            int screenNumber = DefaultScreen(display);
+            region = screen::Frame(nullptr, DisplayWidth(display, screenNumber),
+                                   DisplayHeight(display, screenNumber), 0).clip(requested);
+            if (region.width == 0 || region.height == 0)
+                fail("xshm: the region is outside the screen");
+
+            if (XShmQueryExtension(display))
+            {
+                image = XShmCreateImage(display, DefaultVisual(display, screenNumber),
+                                        static_cast<unsigned int>(DefaultDepth(display, screenNumber)),
+                                        ZPixmap, nullptr, &segment,
+                                        static_cast<unsigned int>(region.width), static_cast<unsigned int>(region.height));
+                if (image == nullptr || image->bits_per_pixel != 32)
+                    fail("xshm: only 24 and 32-bit displays are supported");
+
+                segment.shmid = shmget(IPC_PRIVATE, static_cast<std::size_t>(image->bytes_per_line) * image->height,
+                                       IPC_CREAT | 0600);
+                if (segment.shmid < 0)
+                    fail("xshm: unable to allocate shared memory");
+                segment.shmaddr = image->data = static_cast<char*>(shmat(segment.shmid, nullptr, 0));
+                segment.readOnly = False;
+                attached = segment.shmaddr != reinterpret_cast<char*>(-1) && XShmAttach(display, &segment);
+                XSync(display, False);
+                // The segment is freed once both processes detach, even if this one crashes.
+                shmctl(segment.shmid, IPC_RMID, nullptr);
+                if (!attached)
+                    fail("xshm: unable to attach shared memory");
+
+                frame = screen::Frame(reinterpret_cast<std::uint32_t*>(image->data), region.width, region.height,
+                                      image->bytes_per_line / 4);
+            }
+            else
+            {
+                frame = screen::Frame(region.width, region.height);
+            }
+        }
+
+        ~XShmScreenSource() override
+        { release(); }
+
+        XShmScreenSource(const XShmScreenSource&) = delete;
+        XShmScreenSource& operator=(const XShmScreenSource&) = delete;
+
+        std::string getName() const override
+        { return attached ? "xshm" : "xgetimage"; }
+
+        screen::Region getRegion() const override
+        { return region; }
+
+        const screen::Frame& capture() override
+        {
+            if (attached)
+            {
+                if (!XShmGetImage(display, root, image, region.x, region.y, AllPlanes))
+                    throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "xshm: capture failed");
+                return frame;
+            }
+
+            XImage* copy = XGetImage(display, root, region.x, region.y, static_cast<unsigned int>(region.width),
+                                     static_cast<unsigned int>(region.height), AllPlanes, ZPixmap);
+            if (copy == nullptr || copy->bits_per_pixel != 32)
+            {
+                if (copy != nullptr)
+                    XDestroyImage(copy);
+                throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "xgetimage: capture failed");
+            }
+            for (int y = 0; y < region.height; ++y)
+                std::memcpy(frame.getRow(y), copy->data + static_cast<std::size_t>(y) * copy->bytes_per_line,
+                            static_cast<std::size_t>(region.width) * sizeof(std::uint32_t));
+            XDestroyImage(copy);
+            return frame;
+        }
+
+    private:
+        /// Releases everything acquired so far and throws.
+        [[noreturn]] void fail(const std::string& message)
+        {
+            release();
+            throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, message);
+        }
+
+        /// Detaches the shared memory and closes the display.
+        void release()
+        {
+            if (display == nullptr)
+                return;
+            if (attached)
+                XShmDetach(display, &segment);
+            if (image != nullptr)
+            {
+                image->data = nullptr; // The data is the shared segment, not owned by the image.
+                XDestroyImage(image);
+            }
+            if (segment.shmaddr != nullptr && segment.shmaddr != reinterpret_cast<char*>(-1))
+                shmdt(segment.shmaddr);
+            XCloseDisplay(display);
+            display = nullptr;
+        }
+
+        /// The X connection.
+        Display* display;
+        /// The root window of the default screen.
+        Window root{0};
+        /// The captured region in screen coordinates.
+        screen::Region region{};
+        /// The shared memory segment.
+        XShmSegmentInfo segment{};
+        /// The image describing the shared memory segment.
+        XImage* image{nullptr};
+        /// True if the shared memory segment is attached to the X server.
+        bool attached{false};
+        /// The frame returned by capture().
+        screen::Frame frame;
+    }; // class XShmScreenSource
+} // anonymous namespace
+#elif defined(IS_WINDOWS)
+namespace
+{
+    /**
+     * @class GdiScreenSource
+     * @brief Captures the screen with a single BitBlt into a top-down 32-bit DIB section,
+     * which the frame views without copying.
+     */
+    class GdiScreenSource : public screen::ScreenSource
+    {
+    public:
+        /**
+         * @brief Prepares the capture buffer.
+         * @param requested[const screen::Region&] - The region to capture, clipped to the screen.
+         * @throws MIAException(Screen_Capture_Unavailable) - If the buffer cannot be created.
+         */
+        explicit GdiScreenSource(const screen::Region& requested)
+        {
+            region = screen::Frame(nullptr, GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN), 0).clip(requested);
+            screenDc = GetDC(NULL);
+            memoryDc = CreateCompatibleDC(screenDc);
+
+            BITMAPINFO info{};
+            info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            info.bmiHeader.biWidth = region.width;
+            info.bmiHeader.biHeight = -region.height; // Negative for top-down rows.
+            info.bmiHeader.biPlanes = 1;
+            info.bmiHeader.biBitCount = 32;
+            info.bmiHeader.biCompression = BI_RGB;
+            void* bits = nullptr;
+            bitmap = CreateDIBSection(memoryDc, &info, DIB_RGB_COLORS, &bits, NULL, 0);
+            if (bitmap == NULL || region.width == 0 || region.height == 0)
+            {
+                release();
+                throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "gdi: unable to create a capture buffer");
+            }
+            previous = SelectObject(memoryDc, bitmap);
+            frame = screen::Frame(static_cast<std::uint32_t*>(bits), region.width, region.height, region.width);
+        }
+
+        ~GdiScreenSource() override
+        { release(); }
+
+        GdiScreenSource(const GdiScreenSource&) = delete;
+        GdiScreenSource& operator=(const GdiScreenSource&) = delete;
+
+        std::string getName() const override
+        { return "gdi"; }
+
+        screen::Region getRegion() const override
+        { return region; }
+
+        const screen::Frame& capture() override
+        {
+            if (!BitBlt(memoryDc, 0, 0, region.width, region.height, screenDc, region.x, region.y, SRCCOPY))
+                throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "gdi: capture failed");
+            GdiFlush();
+            return frame;
+        }
+
+    private:
+        /// Releases the GDI objects.
+        void release()
+        {
+            if (previous != NULL)
+                SelectObject(memoryDc, previous);
+            if (bitmap != NULL)
+                DeleteObject(bitmap);
+            if (memoryDc != NULL)
+                DeleteDC(memoryDc);
+            if (screenDc != NULL)
+                ReleaseDC(NULL, screenDc);
+            previous = bitmap = NULL;
+            memoryDc = screenDc = NULL;
+        }
+
+        /// The captured region in screen coordinates.
+        screen::Region region{};
+        HDC screenDc{NULL};
+        HDC memoryDc{NULL};
+        HBITMAP bitmap{NULL};
+        HGDIOBJ previous{NULL};
+        /// The frame returned by capture().
+        screen::Frame frame;
+    }; // class GdiScreenSource
+} // anonymous namespace
+#endif
+
+
+namespace screen
+{
+    std::unique_ptr<ScreenSource> ScreenSource::create(const Region& region)
+    {
+    #if defined(IS_LINUX)
+        return std::make_unique<XShmScreenSource>(region);
+    #elif defined(IS_WINDOWS)
+        return std::make_unique<GdiScreenSource>(region);
+    #else
+        throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "No screen capture for this platform");
+    #endif
+    }
+} // namespace screen
@@ -0,0 +1,335 @@
+/**
+ * @file ScreenCapture.hpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Declares a screen capture layer and pixel search kernels. A ScreenSource grabs a whole
+ *     region of the screen into a Frame in a single request (MIT-SHM shared memory on Linux,
+ *     a DIB section on Windows), and the search functions scan every pixel of a frame in one
+ *     pass using SSE2 where available. This replaces querying the screen one pixel at a time.
+ *     A FileScreenSource serves frames loaded from PPM files so capture code can be tested
+ *     without a display.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace screen
+{
+    /**
+     * @brief An RGB color.
+     */
+    struct Color
+    {
+        std::uint8_t red{0};     ///< The red component.
+        std::uint8_t green{0};   ///< The green component.
+        std::uint8_t blue{0};    ///< The blue component.
+
+        /// Compares every component.
+        bool operator==(const Color& other) const = default;
+    };
+
+    /**
+     * @brief A pixel position.
+     */
+    struct Point
+    {
+        int x{0};   ///< The x coordinate.
+        int y{0};   ///< The y coordinate.
+
+        /// Compares both coordinates.
+        bool operator==(const Point& other) const = default;
+    };
+
+    /**
+     * @brief A rectangle of pixels. A region with no width or height means the whole frame or screen.
+     */
+    struct Region
+    {
+        int x{0};        ///< The left edge.
+        int y{0};        ///< The top edge.
+        int width{0};    ///< The width, or 0 for everything right of x.
+        int height{0};   ///< The height, or 0 for everything below y.
+    };
+
+    /**
+     * @brief An inclusive range of colors, per component.
+     */
+    struct ColorRange
+    {
+        Color min{};                        ///< The smallest value of each component.
+        Color max{255, 255, 255};           ///< The largest value of each component.
+
+        /// Returns true if every component of color is within the range.
+        bool contains(const Color& color) const
+        {
+            return color.red >= min.red && color.red <= max.red &&
+                   color.green >= min.green && color.green <= max.green &&
+                   color.blue >= min.blue && color.blue <= max.blue;
+        }
+    };
+
+    /// The color components, used to select a dominant component.
+    enum class Channel
+    {
+        RED,
+        GREEN,
+        BLUE
+    };
+
+    /**
+     * @brief Packs a color into the frame pixel format (0xXXRRGGBB, the top byte is ignored).
+     * @param color[const Color&] - The color.
+     * @return [std::uint32_t] - The packed pixel.
+     */
+    constexpr std::uint32_t packColor(const Color& color)
+    {
+        return (static_cast<std::uint32_t>(color.red) << 16) |
+               (static_cast<std::uint32_t>(color.green) << 8) | color.blue;
+    }
+
+    /**
+     * @brief Unpacks a frame pixel into a color.
+     * @param pixel[std::uint32_t] - The packed pixel.
+     * @return [Color] - The color.
+     */
+    constexpr Color unpackColor(std::uint32_t pixel)
+    {
+        return {static_cast<std::uint8_t>(pixel >> 16), static_cast<std::uint8_t>(pixel >> 8),
+                static_cast<std::uint8_t>(pixel)};
+    }
+
+    /**
+     * @class Frame
+     * @brief A 32-bit image, either owning its pixels or viewing a capture buffer.
+     *
+     * Pixels are stored row by row as 0xXXRRGGBB, which is the native layout of 24-bit X11
+     * images and Windows DIBs on little-endian machines, so captures need no conversion.
+     * Copying a frame always produces an owning copy.
+     */
+    class Frame
+    {
+    public:
+        /// Constructs an empty frame.
+        Frame() = default;
+
+        /**
+         * @brief Constructs a black frame which owns its pixels.
+         * @param width[int] - The width in pixels.
+         * @param height[int] - The height in pixels.
+         */
+        Frame(int width, int height);
+
+        /**
+         * @brief Constructs a frame viewing pixels owned elsewhere (e.g., a shared memory segment).
+         * @param pixels[std::uint32_t*] - The first pixel of the first row.
+         * @param width[int] - The width in pixels.
+         * @param height[int] - The height in pixels.
+         * @param stride[int] - The distance between rows, in pixels.
+         */
+        Frame(std::uint32_t* pixels, int width, int height, int stride);
+
+        Frame(const Frame& other);
+        Frame& operator=(const Frame& other);
+        Frame(Frame&&) noexcept = default;
+        Frame& operator=(Frame&&) noexcept = default;
+
+        /// Returns the width in pixels.
+        int getWidth() const
+        { return width; }
+
+        /// Returns the height in pixels.
+        int getHeight() const
+        { return height; }
+
+        /// Returns the distance between rows, in pixels.
+        int getStride() const
+        { return stride; }
+
+        /// Returns true if the frame has no pixels.
+        bool empty() const
+        { return width == 0 || height == 0; }
+
+        /// Returns the pixels of row y.
+        const std::uint32_t* getRow(int y) const
+        { return pixels + static_cast<std::size_t>(y) * stride; }
+
+        /// Returns the pixels of row y.
+        std::uint32_t* getRow(int y)
+        { return pixels + static_cast<std::size_t>(y) * stride; }
+
+        /**
+         * @brief Returns the color of a pixel. The position must be within the frame.
+         * @param x[int] - The x coordinate.
+         * @param y[int] - The y coordinate.
+         * @return [Color] - The color.
+         */
+        Color getPixel(int x, int y) const
+        { return unpackColor(getRow(y)[x]); }
+
+        /**
+         * @brief Sets the color of a pixel. The position must be within the frame.
+         * @param x[int] - The x coordinate.
+         * @param y[int] - The y coordinate.
+         * @param color[const Color&] - The color.
+         */
+        void setPixel(int x, int y, const Color& color)
+        { getRow(y)[x] = packColor(color); }
+
+        /**
+         * @brief Fills a region with a color.
+         * @param region[const Region&] - The region, clipped to the frame.
+         * @param color[const Color&] - The color.
+         */
+        void fill(const Region& region, const Color& color);
+
+        /**
+         * @brief Clips a region to the frame, expanding an empty width or height to the frame edge.
+         * @param region[const Region&] - The region.
+         * @return [Region] - The part of the region inside the frame (possibly empty).
+         */
+        Region clip(const Region& region) const;
+
+    private:
+        /// The pixels if this frame owns them.
+        std::vector<std::uint32_t> storage;
+        /// The first pixel of the first row.
+        std::uint32_t* pixels{nullptr};
+        /// The width in pixels.
+        int width{0};
+        /// The height in pixels.
+        int height{0};
+        /// The distance between rows, in pixels.
+        int stride{0};
+    }; // class Frame
+
+    /**
+     * @brief Reads a binary PPM (P6) image with 8-bit components.
+     * @param path[const std::string&] - The file path.
+     * @return [Frame] - The image.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+     * @throws MIAException(Invalid_Argument) - If the file is not a supported PPM image.
+     */
+    Frame readPPM(const std::string& path);
+
+    /**
+     * @brief Writes a frame as a binary PPM (P6) image.
+     * @param frame[const Frame&] - The frame.
+     * @param path[const std::string&] - The file path.
+     * @throws MIAException(Failed_To_Open_File) - If the file cannot be written.
+     */
+    void writePPM(const Frame& frame, const std::string& path);
+
+    /**
+     * @brief Finds the first pixel (in row order) whose color is within a range.
+     * @param frame[const Frame&] - The frame to search.
+     * @param range[const ColorRange&] - The colors to find.
+     * @param region[const Region&] - The part of the frame to search (default = all).
+     * @return [std::optional<Point>] - The position in frame coordinates, or nothing if none match.
+     */
+    std::optional<Point> findColor(const Frame& frame, const ColorRange& range, const Region& region = {});
+
+    /**
+     * @brief Counts the pixels whose color is within a range.
+     * @param frame[const Frame&] - The frame to search.
+     * @param range[const ColorRange&] - The colors to count.
+     * @param region[const Region&] - The part of the frame to search (default = all).
+     * @return [std::size_t] - The number of matching pixels.
+     */
+    std::size_t countColor(const Frame& frame, const ColorRange& range, const Region& region = {});
+
+    /**
+     * @brief Finds the first pixel (in row order) where one component exceeds either of the
+     * other two by more than a margin (e.g., a red object on a blue or green background).
+     * @param frame[const Frame&] - The frame to search.
+     * @param channel[Channel] - The component which must dominate.
+     * @param margin[int] - The amount by which it must exceed another component.
+     * @param region[const Region&] - The part of the frame to search (default = all).
+     * @return [std::optional<Point>] - The position in frame coordinates, or nothing if none match.
+     */
+    std::optional<Point> findDominant(const Frame& frame, Channel channel, int margin, const Region& region = {});
+
+    /**
+     * @class ScreenSource
+     * @brief The interface for capturing a region of the screen as whole frames.
+     */
+    class ScreenSource
+    {
+    public:
+        /**
+         * @brief Opens the native capture source for this platform (MIT-SHM on Linux, GDI on Windows).
+         * @param region[const Region&] - The region of the screen to capture (default = whole screen).
+         * @return [std::unique_ptr<ScreenSource>] - The opened source.
+         * @throws MIAException(Screen_Capture_Unavailable) - If the screen cannot be captured.
+         */
+        static std::unique_ptr<ScreenSource> create(const Region& region = {});
+
+        /// Virtual destructor.
+        virtual ~ScreenSource() = default;
+
+        /**
+         * @brief Returns the name of the source (e.g., "xshm").
+         * @return [std::string] - The source name.
+         */
+        virtual std::string getName() const = 0;
+
+        /**
+         * @brief Returns the region of the screen captured by this source.
+         * @return [Region] - The captured region in screen coordinates.
+         */
+        virtual Region getRegion() const = 0;
+
+        /**
+         * @brief Captures the region. The returned frame is reused, so it is only valid until the next capture.
+         * @return [const Frame&] - The captured pixels, where (0, 0) is the top left of the region.
+         * @throws MIAException(Screen_Capture_Unavailable) - If the capture fails.
+         */
+        virtual const Frame& capture() = 0;
+    }; // class ScreenSource
+
+    /**
+     * @class FileScreenSource
+     * @brief Serves a fixed frame (e.g., loaded from a PPM file) in place of the screen.
+     */
+    class FileScreenSource : public ScreenSource
+    {
+    public:
+        /**
+         * @brief Constructs a source serving a PPM image.
+         * @param path[const std::string&] - The PPM file path.
+         * @throws MIAException(Failed_To_Open_File) - If the file cannot be read.
+         * @throws MIAException(Invalid_Argument) - If the file is not a supported PPM image.
+         */
+        explicit FileScreenSource(const std::string& path) : frame(readPPM(path)) { }
+
+        /**
+         * @brief Constructs a source serving a frame.
+         * @param frame[Frame] - The frame to serve.
+         */
+        explicit FileScreenSource(Frame frame) : frame(std::move(frame)) { }
+
+        std::string getName() const override
+        { return "file"; }
+
+        Region getRegion() const override
+        { return {0, 0, frame.getWidth(), frame.getHeight()}; }
+
+        const Frame& capture() override
+        { return frame; }
+
+        /**
+         * @brief Replaces the frame served by later captures.
+         * @param next[Frame] - The new frame.
+         */
+        void setFrame(Frame next)
+        { frame = std::move(next); }
+
+    private:
+        /// The frame served by capture().
+        Frame frame;
+    }; // class FileScreenSource
+} // namespace screen
@@ -5,17 +5,54 @@
  * Description: Implements system-level timing utilities for causing the current
  *     thread to sleep for specified durations in milliseconds, seconds (integral 
  *     and fractional), and minutes. Uses C++ standard library facilities to ensure 
- *     cross-platform compatibility.
+ *     cross-platform compatibility. sleepUntil(), sleepFor() and Timeline wait against
+ *     absolute deadlines using a hybrid sleep-then-spin wait for sub-millisecond accuracy.
  */
 
 #include <thread>
 #include <chrono>
+#include <cmath>
 
 // Include the associated header file.
 #include "Timing.hpp"
 
+#if defined(IS_LINUX)
+    #include <cerrno>
+    #include <time.h>
+#endif
+
 namespace timing
 {
+    void sleepUntil(Clock::time_point deadline, std::chrono::nanoseconds spinThreshold)
+    {
+        Clock::time_point spinStart = deadline - spinThreshold;
+        if (Clock::now() < spinStart)
+        {
+#if defined(IS_LINUX)
+            // steady_clock is CLOCK_MONOTONIC on Linux, so its epoch can be used directly.
+            auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(spinStart.time_since_epoch());
+            timespec wakeTime{};
+            wakeTime.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+            wakeTime.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, nullptr) == EINTR) 
+            { }
+#else
+            std::this_thread::sleep_until(spinStart);
+#endif
+        }
+        
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+
+
+    void sleepFor(std::chrono::nanoseconds duration)
+    {
+        if (duration.count() > 0)
+            sleepUntil(Clock::now() + duration);
+    }
+
+
     void sleepMilliseconds(int time)
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(time));
@@ -35,4 +72,53 @@ namespace timing
     {
         std::this_thread::sleep_for(std::chrono::duration<double>(time));
     }
+
+
+    void JitterStats::record(std::chrono::nanoseconds lateness)
+    {
+        std::int64_t sample = lateness.count();
+        if (count == 0 || sample < min)
+            min = sample;
+        if (count == 0 || sample > max)
+            max = sample;
+        
+        // Welford's online update keeps the variance numerically stable over long runs.
+        ++count;
+        double delta = static_cast<double>(sample) - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (static_cast<double>(sample) - mean);
+    }
+
+
+    std::chrono::nanoseconds JitterStats::getStdDev() const
+    {
+        if (count < 2)
+            return std::chrono::nanoseconds(0);
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(std::sqrt(m2 / static_cast<double>(count - 1))));
+    }
+
+
+    Timeline::Timeline(std::chrono::nanoseconds maxLag, std::chrono::nanoseconds spinThreshold) :
+        deadline(Clock::now()),
+        maxLag(maxLag),
+        spinThreshold(spinThreshold)
+    { }
+
+
+    void Timeline::waitFor(std::chrono::nanoseconds interval)
+    {
+        deadline += interval;
+        Clock::time_point now = Clock::now();
+        if (now - deadline > maxLag)
+        {
+            // Drop only the missed backlog; this wait still lasts its full interval.
+            ++resyncCount;
+            deadline = now + interval;
+            sleepUntil(deadline, spinThreshold);
+            return;
+        }
+        
+        sleepUntil(deadline, spinThreshold);
+        stats.record(Clock::now() - deadline);
+    }
 } // namespace timing
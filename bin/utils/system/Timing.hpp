@@ -6,13 +6,157 @@
  *    interface for time-based operations such as delays, timing measurements, and 
  *    duration conversions. This header is part of the system utilities module and 
  *    may be extended with additional timing-related functionality.
+ *
+ *    sleepUntil() and sleepFor() wait on absolute deadlines: the thread sleeps in the kernel until shortly before
+ *    the deadline and then spins for the remainder, giving sub-millisecond accuracy. The
+ *    Timeline class chains such deadlines so that a series of waits does not drift.
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+
+// Used for preprocessor definitions.
+#include "Constants.hpp"
+
 namespace timing
 {    
+    /// The monotonic clock used for all deadlines.
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * The time before a deadline at which sleeping switches to spinning. The kernel may wake
+     * a sleeping thread late by up to a scheduler tick, so the last stretch is spun instead.
+     * Windows timers are much coarser than Linux timers, so it spins for longer there.
+     */
+#if defined(IS_WINDOWS)
+    constexpr std::chrono::nanoseconds DEFAULT_SPIN_THRESHOLD = std::chrono::milliseconds(2);
+#else
+    constexpr std::chrono::nanoseconds DEFAULT_SPIN_THRESHOLD = std::chrono::microseconds(200);
+#endif
+
+    /**
+     * Causes the current thread to sleep until an absolute deadline. The thread sleeps until
+     * spinThreshold before the deadline (using clock_nanosleep with TIMER_ABSTIME on Linux) and
+     * then spins, yielding, until the deadline. Returns immediately if the deadline has passed.
+     * @param deadline[Clock::time_point] - The time to wake at.
+     * @param spinThreshold[std::chrono::nanoseconds] - How long before the deadline to start spinning.
+     */
+    void sleepUntil(Clock::time_point deadline, 
+                    std::chrono::nanoseconds spinThreshold = DEFAULT_SPIN_THRESHOLD);
+
+    /**
+     * Causes the current thread to sleep for a precise duration (see sleepUntil()).
+     * @param duration[std::chrono::nanoseconds] - Time to sleep.
+     */
+    void sleepFor(std::chrono::nanoseconds duration);
+
+    /**
+     * Accumulates statistics of how late a series of wakeups were relative to their deadlines.
+     */
+    class JitterStats
+    {
+    public:
+        /**
+         * Records one wakeup.
+         * @param lateness[std::chrono::nanoseconds] - The wake time minus the deadline.
+         */
+        void record(std::chrono::nanoseconds lateness);
+
+        /// Clears all recorded samples.
+        void reset()
+        { *this = JitterStats(); }
+
+        /// Returns the number of recorded samples.
+        std::uint64_t getCount() const
+        { return count; }
+
+        /// Returns the smallest lateness, or zero if there are no samples.
+        std::chrono::nanoseconds getMin() const
+        { return std::chrono::nanoseconds(min); }
+
+        /// Returns the largest lateness, or zero if there are no samples.
+        std::chrono::nanoseconds getMax() const
+        { return std::chrono::nanoseconds(max); }
+
+        /// Returns the mean lateness, or zero if there are no samples.
+        std::chrono::nanoseconds getMean() const
+        { return std::chrono::nanoseconds(static_cast<std::int64_t>(mean)); }
+
+        /// Returns the standard deviation of the lateness, or zero if there are fewer than two samples.
+        std::chrono::nanoseconds getStdDev() const;
+
+    private:
+        std::uint64_t count{0};  ///< The number of samples.
+        std::int64_t min{0};     ///< The smallest sample (ns).
+        std::int64_t max{0};     ///< The largest sample (ns).
+        double mean{0.0};        ///< The running mean (ns).
+        double m2{0.0};          ///< The running sum of squared deviations (ns^2), per Welford.
+    }; // class JitterStats
+
+    /**
+     * A drift-free sequence of waits. Each wait advances an absolute deadline by its interval
+     * (rather than sleeping for the interval from "now"), so time spent working between waits
+     * and wakeup latency do not accumulate over long runs.
+     *
+     * If the timeline falls further behind than the maximum lag (e.g. after the caller was
+     * paused), it resynchronizes by waiting the interval from the current time instead of running
+     * the missed waits back to back. Resynchronized waits are counted by getResyncCount() rather
+     * than recorded in the lateness statistics.
+     */
+    class Timeline
+    {
+    public:
+        /**
+         * Constructs a timeline starting now.
+         * @param maxLag[std::chrono::nanoseconds] - How far behind the timeline may fall before it resynchronizes.
+         * @param spinThreshold[std::chrono::nanoseconds] - Passed to sleepUntil().
+         */
+        explicit Timeline(std::chrono::nanoseconds maxLag = std::chrono::milliseconds(100),
+                          std::chrono::nanoseconds spinThreshold = DEFAULT_SPIN_THRESHOLD);
+
+        /**
+         * Advances the deadline by an interval and sleeps until it, recording the lateness. If the
+         * deadline is more than the maximum lag in the past, sleeps for the interval from now instead.
+         * @param interval[std::chrono::nanoseconds] - The time from the previous deadline.
+         */
+        void waitFor(std::chrono::nanoseconds interval);
+
+        /**
+         * Advances the deadline by an interval without sleeping. Used to account for time the
+         * caller spent waiting by other means (e.g. holding a key for a set duration).
+         * @param interval[std::chrono::nanoseconds] - The time from the previous deadline.
+         */
+        void advance(std::chrono::nanoseconds interval)
+        { deadline += interval; }
+
+        /// Restarts the timeline from the current time.
+        void resync()
+        { deadline = Clock::now(); }
+
+        /// Returns the current deadline.
+        Clock::time_point getDeadline() const
+        { return deadline; }
+
+        /// Returns the number of times the timeline resynchronized after falling behind.
+        std::uint64_t getResyncCount() const
+        { return resyncCount; }
+
+        /// Returns the lateness statistics of the waits so far.
+        const JitterStats& getStats() const
+        { return stats; }
+
+    private:
+        Clock::time_point deadline;              ///< The deadline of the last wait.
+        std::chrono::nanoseconds maxLag;         ///< The lag at which the timeline resynchronizes.
+        std::chrono::nanoseconds spinThreshold;  ///< Passed to sleepUntil().
+        std::uint64_t resyncCount{0};            ///< The number of resynchronizations.
+        JitterStats stats;                       ///< The lateness of each wait.
+    }; // class Timeline
+
     /**
-     * Causes the current thread to sleep for some number of milliseconds.
+     * Causes the current thread to sleep for some number of milliseconds. This is a plain sleep;
+     * use sleepFor() or a Timeline where wakeup accuracy or cadence matters.
      * @param time[int] - Time to sleep in milliseconds.
      */
     void sleepMilliseconds(int time);
@@ -30,7 +174,8 @@ namespace timing
     void sleepSeconds(int time);
 
     /**
-     * Causes the current thread to sleep for some number of fractional seconds.
+     * Causes the current thread to sleep for some number of fractional seconds. This is a plain sleep;
+     * use sleepFor() or a Timeline where wakeup accuracy or cadence matters.
      * @param time[double] - Time to sleep in fractional seconds.
      */
     void sleepSeconds(double time);
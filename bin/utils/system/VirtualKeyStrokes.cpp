@@ -47,8 +47,9 @@ namespace virtual_keys
     VirtualKeyStrokes::~VirtualKeyStrokes()
     {
     #if __linux__
-        delete xdo;
-        XCloseDisplay(display);
+        xdo_free(xdo);
+        if (display != nullptr)
+            XCloseDisplay(display);
     #endif
     }
     
@@ -133,8 +134,29 @@ namespace virtual_keys
     }
     
     
+    bool VirtualKeyStrokes::sendBatch(const InputBatch& batch)
+    {
+        if (!backend)
+            return false;
+        backend->send(batch);
+        return true;
+    }
+    
+    
     void VirtualKeyStrokes::press(const char& character, int holdTime, bool verboseMode)
     {
+        if (backend)
+        {
+            if (!canPress(character))
+                throw error::MIAException(error::ErrorCode::Invalid_Character_Input, std::to_string(character));
+            InputBatch batch;
+            batch.addCharacter(character, holdTime);
+            sendBatch(batch);
+            if (verboseMode)
+                std::cout << character << std::endl;
+            return;
+        }
+        
 
         if (std::isdigit(character)) 
         {
@@ -172,6 +194,14 @@ namespace virtual_keys
     }
     
     
+    bool VirtualKeyStrokes::canPress(char character)
+    {
+        unsigned char ch = static_cast<unsigned char>(character);
+        return std::isdigit(ch) || std::isalpha(ch) || character == ' ' || character == '-' ||
+               character == '=' || character == '\\' || character == '/';
+    }
+    
+    
     void VirtualKeyStrokes::defaultSleep() const
     {
         timing::sleepMilliseconds(globalSleep);
@@ -280,6 +310,15 @@ namespace virtual_keys
             return; // TODO - this method should not silently return.
         }
         
+        InputBatch batch;
+        batch.addKey(static_cast<std::uint32_t>('0' + num), holdTime);
+        if (sendBatch(batch))
+        {
+            if (verboseMode)
+                std::cout << num << std::endl;
+            return;
+        }
+        
     #if defined(IS_WINDOWS)        
         int keyCode = 0x30 + num;
         
@@ -304,6 +343,16 @@ namespace virtual_keys
     
     void VirtualKeyStrokes::pressChar(char ch, int holdTime, bool verboseMode)
     {
+        if (backend && std::isalpha(static_cast<unsigned char>(ch)))
+        {
+            InputBatch batch;
+            batch.addCharacter(ch, holdTime);
+            sendBatch(batch);
+            if (verboseMode)
+                std::cout << ch << std::endl;
+            return;
+        }
+        
     #if defined(IS_WINDOWS)
         if (!std::isalpha(static_cast<unsigned char>(ch)))
             return;
@@ -468,84 +517,79 @@ namespace virtual_keys
 
     
     //Prints the current location of the mouse curser after some wait time.
-    void VirtualKeyStrokes::findMouseCoords(int wait)
+    screen::Point VirtualKeyStrokes::getMousePosition()
     {
-    #if defined(IS_WINDOWS)    
+    #if defined(IS_WINDOWS)
         POINT cursor;
+        GetCursorPos(&cursor);
+        return {cursor.x, cursor.y};
+    #elif defined(__linux__)
+        if (display == nullptr)
+            throw error::MIAException(error::ErrorCode::Screen_Capture_Unavailable, "No X display");
+        Window rootReturn, childReturn;
+        int rootX = 0, rootY = 0, windowX = 0, windowY = 0;
+        unsigned int mask = 0;
+        XQueryPointer(display, DefaultRootWindow(display), &rootReturn, &childReturn,
+                      &rootX, &rootY, &windowX, &windowY, &mask);
+        return {rootX, rootY};
+    #endif
+    }
     
+    
+    void VirtualKeyStrokes::findMouseCoords(int wait)
+    {
         timing::sleepMilliseconds(wait);
-        GetCursorPos(&cursor);
+        screen::Point cursor = getMousePosition();
     
         std::cout << ".." << std::endl;
-        int x = cursor.x, y = cursor.y;
-        std::cout << "The mouse curse is at: " << x << ", " << y << std::endl;
+        std::cout << "The mouse curse is at: " << cursor.x << ", " << cursor.y << std::endl;
         std::cout << ".." << std::endl;
-    #elif defined(__linux__)
-        throw error::MIAException(error::ErrorCode::Windows_Only_Feature);
-    #endif
     }
     
     
     // Prints the pixel color at a scan of ranges in a 100 x 100 grid from the mouse location.
     void VirtualKeyStrokes::getPixelColor()
     {
-    #if defined(IS_WINDOWS)
-        POINT cursor;
-        GetCursorPos(&cursor);
-    
-        HDC dc = GetDC(NULL);
-        COLORREF color;
-        int red=0,green=0,blue=0;
+        screen::Point cursor = getMousePosition();
     
         std::cout << "...Scanning." << std::endl;
     
-        for (int i=cursor.x;i<cursor.x+100;i+=4)
+        // One capture of the whole grid rather than one screen query per pixel.
+        auto source = screen::ScreenSource::create({cursor.x, cursor.y, 100, 100});
+        const screen::Frame& frame = source->capture();
+        screen::Region region = source->getRegion();
+    
+        for (int i = 0; i < frame.getWidth(); i += 4)
         {
-            for (int j=cursor.y+2;j<cursor.y+100;j+=4)
+            for (int j = 2; j < frame.getHeight(); j += 4)
             {
-                color = GetPixel(dc, i, j);
-    
-                getRGB(color, red, green, blue);
-    
-                std::cout << "(x,y): " << "(" << i << "," << j << ")" << std::endl;
-                std::cout << "Red: " << red << "  --  " << "Green: " << green << "  --  " << "Blue: " << blue << std::endl;
+                screen::Color color = frame.getPixel(i, j);
+                std::cout << "(x,y): " << "(" << region.x + i << "," << region.y + j << ")" << std::endl;
+                std::cout << "Red: " << +color.red << "  --  " << "Green: " << +color.green 
+                          << "  --  " << "Blue: " << +color.blue << std::endl;
             }
         }
-        ReleaseDC(NULL, dc);
     
         std::cout << "...Finished." << std::endl;
-    #elif defined(__linux__)
-        throw error::MIAException(error::ErrorCode::Windows_Only_Feature);
-    #endif
     }
     
     
     // Prints the pixel color at the cursor location.
     void VirtualKeyStrokes::getPixelColorAtMouse()
     {
-    #if defined(IS_WINDOWS)
-        POINT cursor;
-        GetCursorPos(&cursor);
-    
-        HDC dc = GetDC(NULL);
+        screen::Point cursor = getMousePosition();
     
         std::cout << "...Scanning." << std::endl;
     
-        COLORREF color = GetPixel(dc, cursor.x, cursor.y);
-    
-        int red = 0, green = 0, blue = 0;
-        getRGB(color, red, green, blue);
+        auto source = screen::ScreenSource::create({cursor.x, cursor.y, 1, 1});
+        screen::Color color = source->capture().getPixel(0, 0);
+        int red = color.red, green = color.green, blue = color.blue;
     
         std::cout << "(x,y): " << "(" << cursor.x << "," << cursor.y << ")" << std::endl;
         std::cout << "Red: " << red << "  --  " << "Green: " << green << "  --  " << "Blue: " << blue << std::endl;
         std::cout << "RGB: (" << red << "," << green << "," << blue << ")" << std::endl;
     
-        ReleaseDC(NULL, dc);
-    
         std::cout << "...Finished." << std::endl;
-    #elif defined(__linux__)
-        throw error::MIAException(error::ErrorCode::Windows_Only_Feature);
-    #endif
     }
     
     
@@ -629,6 +673,17 @@ namespace virtual_keys
     
     void VirtualKeyStrokes::mouseClick(VirtualKeyStrokes::ClickType clickType, int holdTime, bool verboseMode)
     {
+        if (backend && clickType != VirtualKeyStrokes::ClickType::UNKNOWN)
+        {
+            InputBatch batch;
+            batch.addClick(clickType == ClickType::LEFT_CLICK ? button::LEFT :
+                           clickType == ClickType::RIGHT_CLICK ? button::RIGHT : button::MIDDLE, holdTime);
+            sendBatch(batch);
+            if (verboseMode)
+                std::cout << clickTypeToString(clickType) << std::endl;
+            return;
+        }
+        
         switch(clickType)
         {
             case VirtualKeyStrokes::ClickType::LEFT_CLICK:
@@ -645,6 +700,36 @@ namespace virtual_keys
     
     void VirtualKeyStrokes::pressSpecialButton(VirtualKeyStrokes::SpecialButton specialButton, int holdTime, bool verboseMode)
     {
+        if (backend && specialButton != VirtualKeyStrokes::SpecialButton::UNKNOWN)
+        {
+            InputBatch batch;
+            switch(specialButton)
+            {
+                case VirtualKeyStrokes::SpecialButton::ENTER:
+                    batch.addKey(keysym::RETURN, holdTime);
+                    break;
+                case VirtualKeyStrokes::SpecialButton::TAB:
+                    batch.addKey(keysym::TAB, holdTime);
+                    break;
+                case VirtualKeyStrokes::SpecialButton::SPACE:
+                    batch.addKey(' ', holdTime);
+                    break;
+                case VirtualKeyStrokes::SpecialButton::NUM_LOCK:
+                    batch.addKey(keysym::NUM_LOCK, holdTime);
+                    break;
+                case VirtualKeyStrokes::SpecialButton::SCROLL_DOWN:
+                    batch.addClick(button::SCROLL_DOWN);
+                    break;
+                default:
+                    batch.addClick(button::SCROLL_UP);
+                    break;
+            }
+            sendBatch(batch);
+            if (verboseMode)
+                std::cout << specialButtonToString(specialButton) << std::endl;
+            return;
+        }
+        
         switch(specialButton)
         {
             case VirtualKeyStrokes::SpecialButton::ENTER:
@@ -673,6 +758,11 @@ namespace virtual_keys
     
     void VirtualKeyStrokes::moveMouseTo(int x, int y)
     {
+        InputBatch batch;
+        batch.addMove(x, y);
+        if (sendBatch(batch))
+            return;
+        
 	#if defined(IS_WINDOWS)
         SetCursorPos(x,y);
         timing::sleepMilliseconds(40);
@@ -776,6 +866,20 @@ namespace virtual_keys
     
     void VirtualKeyStrokes::type(const std::string& word, int holdTime, bool verboseMode)
     {
+        if (backend)
+        {
+            // The whole word is sent as one batch, with the default sleep between the keys.
+            for (char letter : word)
+                if (!canPress(letter))
+                    throw error::MIAException(error::ErrorCode::Invalid_Character_Input, std::to_string(letter));
+            InputBatch batch;
+            batch.addText(word, holdTime, globalSleep);
+            sendBatch(batch);
+            if (verboseMode)
+                std::cout << word << std::endl;
+            return;
+        }
+        
         int size = word.size();
         for(int i=0;i<size;i++)
         {
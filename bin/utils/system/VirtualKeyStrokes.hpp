@@ -14,9 +14,14 @@
 #include <chrono>
 #include <iostream>
 #include <cstdio>
+#include <memory>
 
 /// Used for preprocessor definitions.
 #include "Constants.hpp"
+/// Used for batched input injection.
+#include "InputBackend.hpp"
+/// Used for capturing screen pixels.
+#include "ScreenCapture.hpp"
 
 #if defined(IS_WINDOWS)
     #include <windows.h>
@@ -105,6 +110,26 @@ namespace virtual_keys
          * Main destructor for the VirtualKeyStrokes object.
          */
         ~VirtualKeyStrokes();
+
+        /**
+         * @brief Sets the backend used to inject input, or restores the default (xdo on Linux,
+         * SendInput on Windows) when given nullptr.
+         *
+         * With a backend set, type(), press(), pressChar(), pressNumber(), mouseClick(),
+         * pressSpecialButton() and moveMouseTo() each send all of their events (including the
+         * hold times and the gaps between typed keys) as one batch. The XTest backend lets the X
+         * server play the delays back, so these calls may return before the input completes.
+         * @param newBackend[std::unique_ptr<InputBackend>] - The backend to use.
+         */
+        void setBackend(std::unique_ptr<InputBackend> newBackend)
+        { backend = std::move(newBackend); }
+
+        /**
+         * @brief Returns the backend used to inject input.
+         * @return [InputBackend*] - The backend, or nullptr if the default is used.
+         */
+        InputBackend* getBackend() const
+        { return backend.get(); }
     
         /**
          * This will simulate a key press.
@@ -114,6 +139,13 @@ namespace virtual_keys
          * @throw [MIAException] - Throws if an unsupported character is entered.
          */
         void press(const char& character, int holdTime = 0, bool verboseMode = false);
+
+        /**
+         * Checks whether a character can be simulated by press() (and therefore type()).
+         * @param character[char] - The character to check.
+         * @return [bool] - True if press() supports the character; false if it would throw.
+         */
+        static bool canPress(char character);
     
         /**
          * This will simulate the key presses for a string.
@@ -205,27 +237,38 @@ namespace virtual_keys
         void paste();
     
         // Other useful functions.
+        
+        /**
+         * @brief Returns the current position of the mouse cursor.
+         * @return [screen::Point] - The cursor position in screen coordinates.
+         * @throws MIAException(Screen_Capture_Unavailable) - If there is no display (Linux).
+         */
+        screen::Point getMousePosition();
+        
+        /**
+         * @brief Waits, then prints the position of the mouse cursor.
+         * @param waitTime[int] - The time (ms) to wait before reading the position.
+         */
         void findMouseCoords(int waitTime);
         
         /**
          * @brief Scans and prints RGB color values of pixels in a 100x100 grid offset from the mouse cursor.
          *
-         * This function captures the screen and iterates over a grid region starting from the mouse cursor’s
-         * position, sampling every 4 pixels horizontally and vertically. For each sampled point, it retrieves
-         * the RGB values and prints the coordinates and corresponding color values.
+         * This function captures the 100x100 region at the mouse cursor in a single frame (see
+         * screen::ScreenSource) and then prints the coordinates and RGB values of every 4th pixel
+         * horizontally and vertically.
          * 
          * Useful for scanning a region rather than a single pixel.
+         * @throws MIAException(Screen_Capture_Unavailable) - If the screen cannot be captured.
          */
         void getPixelColor();
         
         /**
          * @brief Retrieves and prints the RGB color values of the pixel under the mouse cursor.
          *
-         * This function uses the Windows API to get the current position of the mouse cursor,
-         * reads the color of the pixel at that position from the screen, and then prints the
-         * RGB components along with the cursor's coordinates to the standard output.
-         * It uses `GetCursorPos` to retrieve the cursor location, `GetPixel` to obtain the pixel
-         * color, and `getRGB` to extract the red, green, and blue components.
+         * Captures the single pixel at the cursor's position and prints the RGB components
+         * along with the cursor's coordinates to the standard output.
+         * @throws MIAException(Screen_Capture_Unavailable) - If the screen cannot be captured.
          */
         void getPixelColorAtMouse();
         
@@ -238,6 +281,16 @@ namespace virtual_keys
         /// Global time to sleep between each key press (in ms).
         int globalSleep = 10;
     
+        /// The backend used to inject input, or nullptr to use the default.
+        std::unique_ptr<InputBackend> backend;
+        
+        /**
+         * @brief Sends one batch to the backend, if one is set.
+         * @param batch[const InputBatch&] - The events to send.
+         * @return [bool] - True if a backend sent the batch; false if the default should be used.
+         */
+        bool sendBatch(const InputBatch& batch);
+    
     #if defined(IS_WINDOWS)
     
         INPUT ip;
@@ -0,0 +1,103 @@
+/**
+ * @file InputBackend_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for building input batches and sending them through the null backend.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "InputBackend.hpp"
+#include "VirtualKeyStrokes.hpp"
+#include "MIAException.hpp"
+
+using namespace virtual_keys;
+
+namespace
+{
+    /// Builds a key event for comparisons.
+    InputEvent key(std::uint32_t code, bool pressed, int delay = 0)
+    {
+        InputEvent event;
+        event.type = InputEvent::Type::KEY;
+        event.code = code;
+        event.pressed = pressed;
+        event.delay = std::chrono::milliseconds(delay);
+        return event;
+    }
+} // anonymous namespace
+
+TEST(InputBatchTest, TypesTextWithShiftAndDelays)
+{
+    InputBatch batch;
+    batch.addText("aB", 5, 10);
+
+    const std::vector<InputEvent> expected = {
+        key('a', true), key('a', false, 5),
+        key(keysym::SHIFT_L, true, 10), key('b', true), key('b', false, 5), key(keysym::SHIFT_L, false)
+    };
+    EXPECT_EQ(batch.getEvents(), expected);
+    EXPECT_EQ(batch.getDuration(), std::chrono::milliseconds(20));
+}
+
+TEST(InputBatchTest, AddsClicksAndMoves)
+{
+    InputBatch batch;
+    batch.addMove(10, 20);
+    batch.addClick(button::RIGHT, 3, 1);
+
+    const std::vector<InputEvent>& events = batch.getEvents();
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].type, InputEvent::Type::MOVE_TO);
+    EXPECT_EQ(events[0].x, 10);
+    EXPECT_EQ(events[0].y, 20);
+    EXPECT_EQ(events[1].type, InputEvent::Type::BUTTON);
+    EXPECT_EQ(events[1].code, button::RIGHT);
+    EXPECT_TRUE(events[1].pressed);
+    EXPECT_EQ(events[1].delay.count(), 1);
+    EXPECT_FALSE(events[2].pressed);
+    EXPECT_EQ(events[2].delay.count(), 3);
+}
+
+TEST(InputBackendTest, CreatesBackendsByName)
+{
+    EXPECT_EQ(InputBackend::stringToType("XTest"), InputBackend::Type::XTEST);
+    EXPECT_EQ(InputBackend::stringToType("uinput"), InputBackend::Type::UINPUT);
+    EXPECT_EQ(InputBackend::stringToType("null"), InputBackend::Type::NONE);
+    EXPECT_EQ(InputBackend::stringToType("auto"), InputBackend::Type::AUTO);
+    EXPECT_THROW(InputBackend::stringToType("xdo"), error::MIAException);
+
+    std::unique_ptr<InputBackend> backend = InputBackend::create(InputBackend::Type::NONE);
+    ASSERT_NE(backend, nullptr);
+    EXPECT_EQ(backend->getName(), "null");
+}
+
+TEST(InputBackendTest, VirtualKeyStrokesSendsOneBatchPerCall)
+{
+    VirtualKeyStrokes keys;
+    auto recorder = std::make_unique<NullInputBackend>();
+    NullInputBackend* backend = recorder.get();
+    keys.setBackend(std::move(recorder));
+
+    keys.type("hello world", 2);
+    EXPECT_EQ(backend->getBatchCount(), 1u);
+    EXPECT_EQ(backend->getEvents().size(), 22u);
+
+    keys.pressSpecialButton(VirtualKeyStrokes::SpecialButton::ENTER);
+    keys.mouseClick(VirtualKeyStrokes::ClickType::LEFT_CLICK, 4);
+    keys.pressNumber(7);
+    keys.moveMouseTo(1, 2);
+    EXPECT_EQ(backend->getBatchCount(), 5u);
+
+    const std::vector<InputEvent>& events = backend->getEvents();
+    EXPECT_EQ(events[22], key(keysym::RETURN, true));
+    EXPECT_EQ(events[24].code, button::LEFT);
+    EXPECT_EQ(events[26], key('7', true));
+    EXPECT_EQ(events.back().type, InputEvent::Type::MOVE_TO);
+
+    EXPECT_THROW(keys.type("a.b"), error::MIAException);
+    EXPECT_EQ(backend->getBatchCount(), 5u);
+}
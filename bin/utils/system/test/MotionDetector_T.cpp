@@ -0,0 +1,125 @@
+/**
+ * @file MotionDetector_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for the frame-differencing motion detector.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+#include "MotionDetector.hpp"
+
+using namespace screen;
+
+namespace
+{
+    /// Returns a gray frame with a white square.
+    Frame frameWithSquare(int x, int y, int size)
+    {
+        Frame frame(200, 120);
+        frame.fill({}, {60, 60, 60});
+        frame.fill({x, y, size, size}, {255, 255, 255});
+        return frame;
+    }
+} // anonymous namespace
+
+TEST(MotionDetectorTest, ReportsMovedSquare)
+{
+    MotionDetector detector; // Tiles of 32 x 32 frame pixels.
+    std::vector<MotionEvent> events;
+    detector.watch({}, [&events](const MotionEvent& event) { events.push_back(event); });
+
+    EXPECT_EQ(detector.process(frameWithSquare(10, 10, 20)), 0u); // Nothing to compare with yet.
+    EXPECT_EQ(detector.process(frameWithSquare(10, 10, 20)), 0u);
+    EXPECT_TRUE(events.empty());
+    EXPECT_EQ(detector.getColumns(), 7);
+    EXPECT_EQ(detector.getRows(), 4);
+
+    // Moving the square changes the tile it left and the tile it entered.
+    EXPECT_EQ(detector.process(frameWithSquare(138, 74, 20)), 2u);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].tiles, 2u);
+    EXPECT_EQ(events[0].frameIndex, 2u);
+    EXPECT_EQ(events[0].region.x, 0);
+    EXPECT_EQ(events[0].region.y, 0);
+    EXPECT_EQ(events[0].region.width, 160);
+    EXPECT_EQ(events[0].region.height, 96);
+    EXPECT_TRUE(detector.isTileMoving(0, 0));
+    EXPECT_TRUE(detector.isTileMoving(4, 2));
+    EXPECT_FALSE(detector.isTileMoving(2, 1));
+}
+
+TEST(MotionDetectorTest, OnlyReportsWatchedRegions)
+{
+    MotionOptions options;
+    options.minTiles = 1;
+    MotionDetector detector(options);
+    int calls = 0;
+    detector.watch({100, 0, 100, 120}, [&calls](const MotionEvent&) { ++calls; });
+
+    detector.process(frameWithSquare(10, 10, 20));
+    detector.process(frameWithSquare(40, 10, 20)); // Motion only in the left half.
+    EXPECT_EQ(calls, 0);
+    ASSERT_TRUE(detector.getMotion({0, 0, 100, 120}).has_value());
+    EXPECT_FALSE(detector.getMotion({100, 0, 100, 120}).has_value());
+
+    detector.process(frameWithSquare(150, 10, 20));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(MotionDetectorTest, IgnoresSmallChanges)
+{
+    MotionDetector detector;
+    Frame frame = frameWithSquare(10, 10, 20);
+    detector.process(frame);
+    frame.setPixel(100, 100, {255, 0, 0}); // A single pixel barely changes its tile.
+    frame.fill({0, 0, 200, 120}, {62, 62, 62}); // Nor does a small change in brightness.
+    frame.fill({10, 10, 20, 20}, {255, 255, 255});
+    EXPECT_EQ(detector.process(frame), 0u);
+}
+
+TEST(MotionDetectorTest, ComparesAcrossDistance)
+{
+    MotionOptions options;
+    options.distance = 2;
+    MotionDetector detector(options);
+    detector.process(frameWithSquare(10, 10, 20));
+    detector.process(frameWithSquare(10, 10, 20));
+    EXPECT_FALSE(detector.getMotion().has_value());
+
+    // A square that moves then returns within the distance is not reported.
+    detector.process(frameWithSquare(10, 10, 20));
+    detector.process(frameWithSquare(100, 50, 20));
+    EXPECT_TRUE(detector.getMotion().has_value());
+    EXPECT_EQ(detector.process(frameWithSquare(10, 10, 20)), 0u);
+}
+
+TEST(MotionDetectorTest, WaitsForMotion)
+{
+    FileScreenSource source(frameWithSquare(10, 10, 20));
+    MotionDetector detector;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(waitForMotion(source, detector, {}, std::chrono::milliseconds(40), std::chrono::milliseconds(5)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+
+    // A source which changes on every capture moves immediately.
+    struct FlashingSource : public ScreenSource
+    {
+        std::string getName() const override { return "flashing"; }
+        Region getRegion() const override { return {0, 0, 200, 120}; }
+        const Frame& capture() override
+        {
+            current = frameWithSquare(++count % 2 == 0 ? 10 : 100, 10, 20);
+            return current;
+        }
+        Frame current;
+        int count{0};
+    } flashing;
+    std::optional<MotionEvent> event = waitForMotion(flashing, detector, {}, std::chrono::milliseconds(1000),
+                                                     std::chrono::milliseconds(5));
+    ASSERT_TRUE(event.has_value());
+    EXPECT_EQ(event->frameIndex, 1u);
+}
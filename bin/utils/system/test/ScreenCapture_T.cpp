@@ -0,0 +1,99 @@
+/**
+ * @file ScreenCapture_T.cpp
+ * @author Antonius Torode
+ * @date 10/19/2026
+ * Description:
+ *     Tests for the frame pixel search kernels and the PPM-backed screen source.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+
+#include "ScreenCapture.hpp"
+#include "MIAException.hpp"
+
+using namespace screen;
+
+TEST(ScreenCaptureTest, FindsFirstColorInRange)
+{
+    // An odd width exercises both the four-pixel and the single-pixel paths.
+    Frame frame(37, 20);
+    frame.fill({}, {10, 20, 30});
+    frame.setPixel(35, 4, {200, 50, 50});
+    frame.setPixel(9, 12, {210, 40, 60});
+
+    ColorRange red{{180, 0, 0}, {255, 80, 80}};
+    std::optional<Point> found = findColor(frame, red);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, (Point{35, 4}));
+    EXPECT_EQ(countColor(frame, red), 2u);
+
+    // Limited to a region, the first match is the one in that region.
+    found = findColor(frame, red, {0, 10, 20, 5});
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, (Point{9, 12}));
+    EXPECT_FALSE(findColor(frame, red, {0, 0, 30, 10}).has_value());
+}
+
+TEST(ScreenCaptureTest, MatchesScalarSearch)
+{
+    Frame frame(61, 7);
+    for (int y = 0; y < frame.getHeight(); ++y)
+        for (int x = 0; x < frame.getWidth(); ++x)
+            frame.setPixel(x, y, {static_cast<std::uint8_t>(x * 4), static_cast<std::uint8_t>(y * 30),
+                                  static_cast<std::uint8_t>((x * y) % 256)});
+
+    ColorRange range{{40, 30, 0}, {120, 120, 100}};
+    std::size_t expected = 0;
+    for (int y = 0; y < frame.getHeight(); ++y)
+        for (int x = 0; x < frame.getWidth(); ++x)
+            expected += range.contains(frame.getPixel(x, y)) ? 1 : 0;
+    EXPECT_EQ(countColor(frame, range), expected);
+    EXPECT_EQ(countColor(frame, range, {100, 100, 5, 5}), 0u); // Outside the frame.
+}
+
+TEST(ScreenCaptureTest, FindsDominantChannel)
+{
+    Frame frame(16, 4);
+    frame.fill({}, {100, 100, 100});
+    frame.setPixel(6, 2, {140, 130, 100}); // Red exceeds blue by 40, but green by only 10.
+    frame.setPixel(3, 3, {120, 100, 100}); // Not enough.
+
+    std::optional<Point> found = findDominant(frame, Channel::RED, 35);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, (Point{6, 2}));
+    EXPECT_FALSE(findDominant(frame, Channel::BLUE, 35).has_value());
+}
+
+TEST(ScreenCaptureTest, FileSourceRoundTrip)
+{
+    Frame frame(5, 3);
+    frame.setPixel(4, 2, {1, 2, 3});
+    frame.setPixel(0, 1, {255, 128, 0});
+    const std::string path = (std::filesystem::temp_directory_path() / "ScreenCapture_T.ppm").string();
+    writePPM(frame, path);
+
+    FileScreenSource source(path);
+    const Frame& captured = source.capture();
+    ASSERT_EQ(captured.getWidth(), 5);
+    ASSERT_EQ(captured.getHeight(), 3);
+    EXPECT_EQ(captured.getPixel(4, 2), (Color{1, 2, 3}));
+    EXPECT_EQ(captured.getPixel(0, 1), (Color{255, 128, 0}));
+    EXPECT_EQ(source.getName(), "file");
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(readPPM(path), error::MIAException);
+}
+
+TEST(ScreenCaptureTest, CopiesViewsIntoOwnedFrames)
+{
+    std::uint32_t pixels[8] = {0, 0, 0, 0, 0, packColor({9, 8, 7}), 0, 0};
+    Frame view(pixels, 2, 2, 4); // Rows are four pixels apart.
+    EXPECT_EQ(view.getPixel(1, 1), (Color{9, 8, 7}));
+
+    Frame copy = view;
+    pixels[5] = 0;
+    EXPECT_EQ(copy.getPixel(1, 1), (Color{9, 8, 7}));
+    EXPECT_EQ(copy.getStride(), 2);
+}
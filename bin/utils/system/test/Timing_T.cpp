@@ -89,3 +89,97 @@ TEST(TimingTest, SleepMinutesZero)
 
     EXPECT_LT(elapsed, 50);
 }
+
+TEST(TimingTest, SleepUntilNeverWakesEarly) 
+{
+    // Only the ordering is asserted: how late a wakeup is depends on the load of the machine
+    // (e.g. a parallel ctest run), so lateness is summarized rather than bounded tightly.
+    JitterStats lateness;
+    for (int i = 0; i < 20; ++i)
+    {
+        auto deadline = Clock::now() + std::chrono::milliseconds(2);
+        sleepUntil(deadline);
+        auto late = Clock::now() - deadline;
+        EXPECT_GE(late.count(), 0);
+        lateness.record(late);
+    }
+
+    EXPECT_EQ(lateness.getCount(), 20u);
+    EXPECT_GE(lateness.getMin().count(), 0);
+    EXPECT_LE(lateness.getMin(), lateness.getMean());
+    EXPECT_LE(lateness.getMean(), lateness.getMax());
+
+    // A deadline in the past returns immediately.
+    auto start = Clock::now();
+    sleepUntil(start - std::chrono::milliseconds(10));
+    EXPECT_LT(Clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST(TimingTest, TimelineDoesNotDrift) 
+{
+    Timeline timeline;
+    auto start = timeline.getDeadline();
+
+    // Simulated work between waits would add 100 x 0.3 ms of drift with relative sleeps.
+    for (int i = 0; i < 100; ++i)
+    {
+        auto busyUntil = Clock::now() + std::chrono::microseconds(300);
+        while (Clock::now() < busyUntil) { }
+        timeline.waitFor(std::chrono::milliseconds(1));
+    }
+    auto elapsed = Clock::now() - start;
+    auto scheduled = timeline.getDeadline() - start;
+
+    // The deadlines are the sum of the intervals, regardless of the time spent working, unless
+    // the timeline had to resync after being descheduled for longer than its maximum lag.
+    EXPECT_EQ(timeline.getStats().getCount() + timeline.getResyncCount(), 100u);
+    if (timeline.getResyncCount() == 0)
+    {
+        EXPECT_EQ(scheduled, std::chrono::milliseconds(100));
+    }
+    EXPECT_GE(scheduled, std::chrono::milliseconds(100));
+    EXPECT_GE(elapsed, scheduled);
+
+    const JitterStats& stats = timeline.getStats();
+    EXPECT_GE(stats.getMin().count(), 0);
+    EXPECT_LE(stats.getMin(), stats.getMean());
+    EXPECT_LE(stats.getMean(), stats.getMax());
+}
+
+TEST(TimingTest, TimelineResyncsAfterFallingBehind) 
+{
+    Timeline timeline(std::chrono::milliseconds(10));
+    sleepFor(std::chrono::milliseconds(30));
+
+    // The first wait is too far behind and resyncs rather than returning immediately for each
+    // missed interval, but still waits its own interval from now; the next one is on schedule.
+    auto start = Clock::now();
+    timeline.waitFor(std::chrono::milliseconds(5));
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(5));
+    EXPECT_EQ(timeline.getResyncCount(), 1u);
+    EXPECT_EQ(timeline.getStats().getCount(), 0u);
+    
+    start = Clock::now();
+    timeline.waitFor(std::chrono::milliseconds(5));
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(4));
+    EXPECT_EQ(timeline.getStats().getCount(), 1u);
+}
+
+TEST(TimingTest, JitterStatsSummarizesSamples) 
+{
+    JitterStats stats;
+    EXPECT_EQ(stats.getCount(), 0u);
+    EXPECT_EQ(stats.getStdDev().count(), 0);
+
+    for (int sample : {2, 4, 4, 4, 5, 5, 7, 9})
+        stats.record(std::chrono::nanoseconds(sample));
+
+    EXPECT_EQ(stats.getCount(), 8u);
+    EXPECT_EQ(stats.getMin().count(), 2);
+    EXPECT_EQ(stats.getMax().count(), 9);
+    EXPECT_EQ(stats.getMean().count(), 5);
+    EXPECT_EQ(stats.getStdDev().count(), 2); // Sample standard deviation ~2.14.
+
+    stats.reset();
+    EXPECT_EQ(stats.getCount(), 0u);
+}